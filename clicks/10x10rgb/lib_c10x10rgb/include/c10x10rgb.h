@@ -108,6 +108,22 @@
 #define C10X10RGB_CTRL_PIN_HIGH         0x01 
 /** \} */
 
+/**
+ * \defgroup encoder Bitstream Encoder
+ * \{
+ */
+#define C10X10RGB_ENC_SYMBOL_ZERO       0x08
+#define C10X10RGB_ENC_SYMBOL_ONE        0x0E
+#define C10X10RGB_ENC_BYTES_PER_LED     12
+#define C10X10RGB_ENC_RESET_BYTES       24
+#define C10X10RGB_ENC_FRAME_SIZE        ( NUM_MATRIX_BYTE * C10X10RGB_ENC_BYTES_PER_LED + \
+                                          C10X10RGB_ENC_RESET_BYTES )
+
+#define C10X10RGB_GAMMA_DISABLE         0x00
+#define C10X10RGB_GAMMA_ENABLE          0x01
+#define C10X10RGB_BRIGHTNESS_MAX        0xFF
+/** \} */
+
 /**
  * \defgroup colors Colors
  * \{
@@ -159,6 +175,8 @@
 
 typedef void ( *drv_logic_t ) ( void );
 
+typedef void ( *drv_bulk_write_t ) ( uint8_t *data_buf, uint16_t len );
+
 /**
  * @brief Byte object definition.
  */
@@ -208,9 +226,15 @@ typedef struct
     // Function pointers
     drv_logic_t logic_zero;
     drv_logic_t logic_one;
+    drv_bulk_write_t bulk_write;
     
     uint32_t matrix[ NUM_MATRIX_BYTE ];
 
+    // Encoder state, buffers are supplied by the application
+    uint8_t *level_lut;
+    uint8_t *tx_buf;
+    uint8_t tx_valid;
+
 } c10x10rgb_t;
 
 /**
@@ -225,6 +249,7 @@ typedef struct
     // Function pointers
     drv_logic_t logic_zero;
     drv_logic_t logic_one;
+    drv_bulk_write_t bulk_write;
 
 } c10x10rgb_cfg_t;
 
@@ -246,7 +271,8 @@ extern "C"{
  * @param cfg  Click configuration structure.
  *
  * @description This function initializes Click configuration structure to init state.
- * @note All used pins will be set to unconnected state.
+ * @note All used pins will be set to unconnected state. The bulk_write function
+ * is set to NULL, assign it before init to send frames as an encoded bitstream.
  */
 void c10x10rgb_cfg_setup ( c10x10rgb_cfg_t *cfg, drv_logic_t logic_zero, drv_logic_t logic_one );
 
@@ -275,7 +301,8 @@ void c10x10rgb_write_data ( c10x10rgb_t *ctx, uint32_t w_data );
  * @param c10x10rgb     Click object.
  * @param screen_color  Screen color value.
  * 
- * @description This function fills the whole display with the value: { screen_color }.
+ * @description This function fills the matrix buffer with the value: { screen_color }
+ *              and shows it.
  */
 void c10x10rgb_fill_screen ( c10x10rgb_t *ctx, uint32_t screen_color );
 
@@ -336,6 +363,58 @@ void c10x10rgb_display_string ( c10x10rgb_t *ctx, c10x10rgb_byte_t *data_obj,
  */
 void c10x10rgb_demo_rainbow ( c10x10rgb_t *ctx, uint8_t brightness, uint16_t speed_ms );
 
+/**
+ * @brief Set level function.
+ * 
+ * @param c10x10rgb     Click object.
+ * @param brightness    Brightness value [0-255].
+ * @param gamma         Gamma correction ( C10X10RGB_GAMMA_DISABLE or C10X10RGB_GAMMA_ENABLE ).
+ * 
+ * @description This function builds the per-channel level table applied to every 
+ *              color component while the frame is encoded.
+ * @note Does nothing unless a level table is attached with #c10x10rgb_enc_attach.
+ */
+void c10x10rgb_set_level ( c10x10rgb_t *ctx, uint8_t brightness, uint8_t gamma );
+
+/**
+ * @brief Attach encoder buffers function.
+ * 
+ * @param c10x10rgb     Click object.
+ * @param tx_buf        Bitstream buffer of C10X10RGB_ENC_FRAME_SIZE bytes, NULL to detach.
+ * @param level_lut     Level table of 256 bytes, NULL to send colors unscaled.
+ * 
+ * @description This function attaches the encoder buffers. Without a bitstream buffer 
+ *              every frame is sent bit by bit through the logic functions and bulk_write 
+ *              is not used. The level table is reset to full brightness without gamma.
+ */
+void c10x10rgb_enc_attach ( c10x10rgb_t *ctx, uint8_t *tx_buf, uint8_t *level_lut );
+
+/**
+ * @brief Encode frame function.
+ * 
+ * @param c10x10rgb     Click object.
+ * 
+ * @returns 1 if the encoded frame differs from the previous one or no bitstream 
+ *          buffer is attached, 0 otherwise.
+ * 
+ * @description This function encodes the matrix buffer into the WS2812 symbol bitstream.
+ *              Each data bit becomes a 4-bit symbol ( 0 - 1000b, 1 - 1110b ) looked up per 
+ *              nibble, followed by C10X10RGB_ENC_RESET_BYTES zero bytes of reset time.
+ * @note The bitstream expects a 3.2 MHz SPI clock ( 312.5 ns per symbol bit ).
+ */
+uint8_t c10x10rgb_encode_frame ( c10x10rgb_t *ctx );
+
+/**
+ * @brief Show function.
+ * 
+ * @param c10x10rgb     Click object.
+ * 
+ * @description This function displays the matrix buffer. The frame is sent in one 
+ *              bulk_write call when available, or bit by bit through the logic functions 
+ *              otherwise. Transmission is skipped if the frame did not change.
+ */
+void c10x10rgb_show ( c10x10rgb_t *ctx );
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,6 +29,35 @@
 
 #include "c10x10rgb.h"
 #include "c10x10rgb_ascii_matrix.h"
+#include <string.h>
+
+// ------------------------------------------------------------------ CONSTANTS
+
+static const uint8_t drv_gamma_lut[ 256 ] =
+{
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255
+};
+
+static const uint16_t drv_symbol_lut[ 16 ] =
+{
+    0x8888, 0x888E, 0x88E8, 0x88EE, 0x8E88, 0x8E8E, 0x8EE8, 0x8EEE,
+    0xE888, 0xE88E, 0xE8E8, 0xE8EE, 0xEE88, 0xEE8E, 0xEEE8, 0xEEEE
+};
 
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
@@ -43,6 +72,10 @@ static void drv_show_delay ( uint16_t wait_ms );
 
 static uint32_t drv_color_wheel ( uint8_t wheel_pos, uint8_t brightness );
 
+static uint8_t drv_encode_byte ( uint8_t *tx_buf, uint8_t data_byte );
+
+static uint8_t drv_level ( c10x10rgb_t *ctx, uint8_t component );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void c10x10rgb_cfg_setup ( c10x10rgb_cfg_t *cfg, drv_logic_t logic_zero, drv_logic_t logic_one )
@@ -53,6 +86,7 @@ void c10x10rgb_cfg_setup ( c10x10rgb_cfg_t *cfg, drv_logic_t logic_zero, drv_log
 
     cfg->logic_zero = logic_zero;
     cfg->logic_one = logic_one;
+    cfg->bulk_write = NULL;
 }
 
 C10X10RGB_RETVAL c10x10rgb_init ( c10x10rgb_t *ctx, c10x10rgb_cfg_t *cfg )
@@ -66,6 +100,11 @@ C10X10RGB_RETVAL c10x10rgb_init ( c10x10rgb_t *ctx, c10x10rgb_cfg_t *cfg )
     // Function pointers 
     ctx->logic_zero = cfg->logic_zero;
     ctx->logic_one = cfg->logic_one;
+    ctx->bulk_write = cfg->bulk_write;
+
+    ctx->level_lut = NULL;
+    ctx->tx_buf = NULL;
+    ctx->tx_valid = 0;
 
     digital_out_low( &ctx->di_pin );
     Delay_100ms( );
@@ -98,8 +137,9 @@ void c10x10rgb_fill_screen ( c10x10rgb_t *ctx, uint32_t screen_color )
     uint8_t cnt = 0;
     for ( cnt = 0; cnt < NUM_MATRIX_BYTE; cnt++ )
     {
-        c10x10rgb_write_data( ctx, screen_color );
+        ctx->matrix[ cnt ] = screen_color;
     }
+    drv_show_screen( ctx );
 }
 
 uint32_t c10x10rgb_make_color ( uint8_t red, uint8_t green, uint8_t blue, uint8_t brightness ) 
@@ -209,17 +249,91 @@ void c10x10rgb_demo_rainbow ( c10x10rgb_t *ctx, uint8_t brightness, uint16_t spe
     }
 }
 
-// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+void c10x10rgb_set_level ( c10x10rgb_t *ctx, uint8_t brightness, uint8_t gamma )
+{
+    uint16_t cnt = 0;
+    uint8_t level = 0;
 
-static void drv_show_screen ( c10x10rgb_t *ctx )
+    if ( NULL == ctx->level_lut )
+    {
+        return;
+    }
+    for ( cnt = 0; cnt < 256; cnt++ )
+    {
+        level = ( gamma == C10X10RGB_GAMMA_ENABLE ) ? drv_gamma_lut[ cnt ] : ( uint8_t ) cnt;
+        ctx->level_lut[ cnt ] = ( ( uint16_t ) level * brightness + 127 ) / 255;
+    }
+    ctx->tx_valid = 0;
+}
+
+void c10x10rgb_enc_attach ( c10x10rgb_t *ctx, uint8_t *tx_buf, uint8_t *level_lut )
+{
+    ctx->tx_buf = tx_buf;
+    ctx->level_lut = level_lut;
+    if ( NULL != tx_buf )
+    {
+        memset ( tx_buf, 0, C10X10RGB_ENC_FRAME_SIZE );
+    }
+    c10x10rgb_set_level( ctx, C10X10RGB_BRIGHTNESS_MAX, C10X10RGB_GAMMA_DISABLE );
+    ctx->tx_valid = 0;
+}
+
+uint8_t c10x10rgb_encode_frame ( c10x10rgb_t *ctx )
+{
+    uint8_t *tx_ptr = ctx->tx_buf;
+    uint8_t changed = 0;
+    uint8_t cnt = 0;
+    uint32_t color = 0;
+
+    if ( NULL == tx_ptr )
+    {
+        return 1;
+    }
+    for ( cnt = 0; cnt < NUM_MATRIX_BYTE; cnt++ )
+    {
+        color = ctx->matrix[ cnt ];
+        changed |= drv_encode_byte( tx_ptr, drv_level( ctx, ( color >> 16 ) & 0xFF ) );
+        changed |= drv_encode_byte( tx_ptr + 4, drv_level( ctx, ( color >> 8 ) & 0xFF ) );
+        changed |= drv_encode_byte( tx_ptr + 8, drv_level( ctx, color & 0xFF ) );
+        tx_ptr += C10X10RGB_ENC_BYTES_PER_LED;
+    }
+    return changed;
+}
+
+void c10x10rgb_show ( c10x10rgb_t *ctx )
 {
     uint8_t cnt = 0;
+    uint32_t color = 0;
+
+    if ( !c10x10rgb_encode_frame( ctx ) && ctx->tx_valid )
+    {
+        return;
+    }
+    ctx->tx_valid = 1;
+
+    if ( ( NULL != ctx->bulk_write ) && ( NULL != ctx->tx_buf ) )
+    {
+        ctx->bulk_write( ctx->tx_buf, C10X10RGB_ENC_FRAME_SIZE );
+        return;
+    }
+
     for ( cnt = 0; cnt < NUM_MATRIX_BYTE; cnt++ )
     {
-        c10x10rgb_write_data( ctx, ctx->matrix[ cnt ] );
+        color = ctx->matrix[ cnt ];
+        color = ( ( uint32_t ) drv_level( ctx, ( color >> 16 ) & 0xFF ) << 16 ) |
+                ( ( uint32_t ) drv_level( ctx, ( color >> 8 ) & 0xFF ) << 8 ) |
+                drv_level( ctx, color & 0xFF );
+        c10x10rgb_write_data( ctx, color );
     }
 }
 
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void drv_show_screen ( c10x10rgb_t *ctx )
+{
+    c10x10rgb_show( ctx );
+}
+
 static void drv_matrix_add_scroll_buf ( drv_scroll_buf_t *scroll_buf_obj,
                                         c10x10rgb_byte_t *data_array, uint8_t data_len )
 {
@@ -317,5 +431,29 @@ static uint32_t drv_color_wheel ( uint8_t wheel_pos, uint8_t brightness )
     return c10x10rgb_make_color( 255 - wheel_pos * 3, wheel_pos * 3, 0, brightness );
 }
 
+static uint8_t drv_encode_byte ( uint8_t *tx_buf, uint8_t data_byte )
+{
+    uint16_t sym_hi = drv_symbol_lut[ data_byte >> 4 ];
+    uint16_t sym_lo = drv_symbol_lut[ data_byte & 0x0F ];
+    uint8_t changed = 0;
+
+    changed |= tx_buf[ 0 ] ^ ( uint8_t ) ( sym_hi >> 8 );
+    changed |= tx_buf[ 1 ] ^ ( uint8_t ) sym_hi;
+    changed |= tx_buf[ 2 ] ^ ( uint8_t ) ( sym_lo >> 8 );
+    changed |= tx_buf[ 3 ] ^ ( uint8_t ) sym_lo;
+
+    tx_buf[ 0 ] = sym_hi >> 8;
+    tx_buf[ 1 ] = sym_hi;
+    tx_buf[ 2 ] = sym_lo >> 8;
+    tx_buf[ 3 ] = sym_lo;
+
+    return ( changed != 0 );
+}
+
+static uint8_t drv_level ( c10x10rgb_t *ctx, uint8_t component )
+{
+    return ( NULL != ctx->level_lut ) ? ctx->level_lut[ component ] : component;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -187,9 +187,9 @@ void c16x9_generic_write ( c16x9_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
@@ -91,6 +91,8 @@ extern "C"{
  */
 #define C3GAA_RSP_OK                            "OK"
 #define C3GAA_RSP_ERROR                         "ERROR"
+#define C3GAA_RSP_SEND_OK                       "SEND OK"
+#define C3GAA_RSP_SEND_FAIL                     "SEND FAIL"
 
 /**
  * @brief 3G-AA driver buffer size.
@@ -100,6 +102,28 @@ extern "C"{
 #define C3GAA_RX_DRV_BUFFER_SIZE                256
 #define C3GAA_TX_DRV_BUFFER_SIZE                256
 
+/**
+ * @brief 3G-AA socket stream settings.
+ * @details Specified settings for binary socket streaming of 3G-AA Click driver.
+ * @note QISEND accepts at most 1460 bytes per command.
+ */
+#define C3GAA_SOCKET_MTU                        1460
+#define C3GAA_SOCKET_RX_BUFFER_SIZE             512
+#define C3GAA_SOCKET_LINE_SIZE                  64
+#define C3GAA_SOCKET_TX_PIECE_SIZE              64
+#define C3GAA_SOCKET_RTS_THRESHOLD              128
+#define C3GAA_SOCKET_TIMEOUT_MS                 10000
+
+/**
+ * @brief 3G-AA socket stream flow control settings.
+ * @details Specified hardware flow control settings of 3G-AA Click driver.
+ * @note Hardware flow control must also be enabled in the module with AT+IFC=2,2.
+ */
+#define C3GAA_FLOW_CONTROL_OFF                  0
+#define C3GAA_FLOW_CONTROL_ON                   1
+#define C3GAA_PIN_STATE_ACTIVE                  0
+#define C3GAA_PIN_STATE_INACTIVE                1
+
 /*! @} */ // c3gaa_set
 
 /**
@@ -178,6 +202,28 @@ typedef struct
 
 } c3gaa_cfg_t;
 
+/**
+ * @brief 3G-AA Click socket stream object.
+ * @details Socket stream object definition of 3G-AA Click driver. Received
+ * payload is fetched into the ring buffer with QIRD after the +QIURC "recv" URC is parsed.
+ */
+typedef struct
+{
+    uint8_t  socket_id;                                 /**< Module socket identifier. */
+    uint8_t  flow_control;                              /**< RTS/CTS flow control enable. */
+    uint8_t  closed;                                    /**< Socket closed by the remote side. */
+
+    uint8_t  rx_buf[ C3GAA_SOCKET_RX_BUFFER_SIZE ];     /**< Received payload ring buffer. */
+    uint16_t rx_head;                                   /**< Ring buffer write index. */
+    uint16_t rx_tail;                                   /**< Ring buffer read index. */
+    uint16_t rx_count;                                  /**< Number of bytes in ring buffer. */
+    uint8_t  rx_pending;                                /**< Unread data reported by the module. */
+
+    uint8_t  line_buf[ C3GAA_SOCKET_LINE_SIZE ];        /**< Response line buffer. */
+    uint8_t  line_len;                                  /**< Response line length. */
+
+} c3gaa_socket_t;
+
 /**
  * @brief 3G-AA Click return value data.
  * @details Predefined enum values for driver return values.
@@ -387,6 +433,70 @@ void c3gaa_send_sms_text ( c3gaa_t *ctx, uint8_t *phone_number, uint8_t *sms_tex
  */
 err_t c3gaa_send_sms_pdu ( c3gaa_t *ctx, uint8_t *service_center_number, uint8_t *phone_number, uint8_t *sms_text );
 
+/**
+ * @brief 3G-AA socket stream init function.
+ * @details This function binds the socket stream object to an already created and
+ * connected module socket and clears its receive ring buffer.
+ * @param[out] sock : Socket stream object.
+ * See #c3gaa_socket_t object definition for detailed explanation.
+ * @param[in] socket_id : Connect ID used with AT+QIOPEN.
+ * @param[in] flow_control : @li @c 0 - RTS/CTS flow control off,
+ *                           @li @c 1 - RTS/CTS flow control on.
+ * @return Nothing.
+ * @note None.
+ */
+void c3gaa_socket_init ( c3gaa_socket_t *sock, uint8_t socket_id, uint8_t flow_control );
+
+/**
+ * @brief 3G-AA socket stream write function.
+ * @details This function sends a binary buffer of any length to the socket. The buffer
+ * is split into chunks of up to C3GAA_SOCKET_MTU bytes, each sent after the QISEND
+ * prompt straight from the caller buffer, without copying or quoting.
+ * @param[in] ctx : Click context object.
+ * See #c3gaa_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c3gaa_socket_t object definition for detailed explanation.
+ * @param[in] data_in : Data buffer for sending.
+ * @param[in] len : Number of bytes for sending.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout,
+ *         @li @c -3 - Command error.
+ * See #c3gaa_return_value_t definition for detailed explanation.
+ * @note URCs received while sending are processed, so incoming data is not lost.
+ */
+err_t c3gaa_socket_write ( c3gaa_t *ctx, c3gaa_socket_t *sock, uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief 3G-AA socket stream process function.
+ * @details This function parses all bytes received from the module, and after the
+ * +QIURC "recv" URC fetches the payload into the socket ring buffer with QIRD.
+ * When flow control is on, RTS is released while the ring buffer is nearly full.
+ * @param[in] ctx : Click context object.
+ * See #c3gaa_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c3gaa_socket_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout,
+ *         @li @c -3 - Command error.
+ * See #c3gaa_return_value_t definition for detailed explanation.
+ * @note All module UART traffic must go through this function while the stream is used.
+ */
+err_t c3gaa_socket_process ( c3gaa_t *ctx, c3gaa_socket_t *sock );
+
+/**
+ * @brief 3G-AA socket stream read function.
+ * @details This function reads received payload from the socket ring buffer.
+ * @param[in] ctx : Click context object.
+ * See #c3gaa_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c3gaa_socket_t object definition for detailed explanation.
+ * @param[out] data_out : Output read data.
+ * @param[in] len : Maximal number of bytes to be read.
+ * @return Number of bytes read.
+ * @note None.
+ */
+uint16_t c3gaa_socket_read ( c3gaa_t *ctx, c3gaa_socket_t *sock, uint8_t *data_out, uint16_t len );
+
 #ifdef __cplusplus
 }
 #endif
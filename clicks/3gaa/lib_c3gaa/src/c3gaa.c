@@ -103,6 +103,101 @@ static int16_t encode_phone_number ( uint8_t *phone_number, uint8_t *output_buff
  */
 static void c3gaa_str_cut_chr ( uint8_t *str, uint8_t chr );
 
+/**
+ * @brief Socket stream line states.
+ * @details Return values of the socket stream line parser.
+ */
+#define C3GAA_STREAM_LINE_NONE            0
+#define C3GAA_STREAM_LINE_READY           1
+
+/**
+ * @brief 3G-AA stream read byte function.
+ * @details This function reads a single byte from the UART ring buffer,
+ * polling every millisecond until the timeout expires.
+ * @param[in] ctx : Click context object.
+ * @param[out] rx_byte : Read byte.
+ * @param[in] timeout_ms : Timeout in milliseconds.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout.
+ */
+static err_t c3gaa_stream_read_byte ( c3gaa_t *ctx, uint8_t *rx_byte, uint16_t timeout_ms );
+
+/**
+ * @brief 3G-AA stream write raw function.
+ * @details This function writes data to the module in small pieces,
+ * waiting for CTS before each piece when flow control is on.
+ * @param[in] ctx : Click context object.
+ * @param[in] sock : Socket stream object.
+ * @param[in] data_in : Data buffer for sending.
+ * @param[in] len : Number of bytes for sending.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout.
+ */
+static err_t c3gaa_stream_write_raw ( c3gaa_t *ctx, c3gaa_socket_t *sock, uint8_t *data_in, uint16_t len );
+
+/**
+ * @brief 3G-AA stream send socket command function.
+ * @details This function sends a socket command in format AT+CMD=<socket>,<len>.
+ * @param[in] ctx : Click context object.
+ * @param[in] sock : Socket stream object.
+ * @param[in] cmd : AT command.
+ * @param[in] len : Length parameter.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout.
+ */
+static err_t c3gaa_stream_send_cmd ( c3gaa_t *ctx, c3gaa_socket_t *sock, const char *cmd, uint16_t len );
+
+/**
+ * @brief 3G-AA stream feed line function.
+ * @details This function adds a received byte to the response line buffer.
+ * @param[in] sock : Socket stream object.
+ * @param[in] rx_byte : Received byte.
+ * @return @li @c 0 - Line not complete,
+ *         @li @c 1 - Line complete and stored in line buffer.
+ */
+static uint8_t c3gaa_stream_feed_line ( c3gaa_socket_t *sock, uint8_t rx_byte );
+
+/**
+ * @brief 3G-AA stream handle URC function.
+ * @details This function updates the socket state from a complete URC line.
+ * @param[in] sock : Socket stream object.
+ * @return Nothing.
+ */
+static void c3gaa_stream_handle_urc ( c3gaa_socket_t *sock );
+
+/**
+ * @brief 3G-AA stream wait response function.
+ * @details This function waits for the final response line, while handling
+ * URC lines and, for QIRD, storing the binary payload.
+ * @param[in] ctx : Click context object.
+ * @param[in] sock : Socket stream object.
+ * @param[in] rd_len : Number of bytes requested with QIRD, 0 for other commands.
+ * @return @li @c  0 - OK received,
+ *         @li @c -2 - Timeout,
+ *         @li @c -3 - ERROR received.
+ */
+static err_t c3gaa_stream_wait_rsp ( c3gaa_t *ctx, c3gaa_socket_t *sock, uint16_t rd_len );
+
+/**
+ * @brief 3G-AA stream parse number function.
+ * @details This function parses a decimal number after the selected
+ * comma separated field of a line.
+ * @param[in] line : Response line.
+ * @param[in] field : Zero based comma separated field index.
+ * @return Parsed number.
+ */
+static uint16_t c3gaa_stream_parse_num ( uint8_t *line, uint8_t field );
+
+/**
+ * @brief 3G-AA stream update RTS function.
+ * @details This function asserts RTS while the ring buffer has room for
+ * more data and releases it otherwise.
+ * @param[in] ctx : Click context object.
+ * @param[in] sock : Socket stream object.
+ * @return Nothing.
+ */
+static void c3gaa_stream_update_rts ( c3gaa_t *ctx, c3gaa_socket_t *sock );
+
 void c3gaa_cfg_setup ( c3gaa_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -327,6 +422,128 @@ err_t c3gaa_send_sms_pdu ( c3gaa_t *ctx, uint8_t *service_center_number, uint8_t
     return C3GAA_OK;
 }
 
+void c3gaa_socket_init ( c3gaa_socket_t *sock, uint8_t socket_id, uint8_t flow_control )
+{
+    sock->socket_id = socket_id;
+    sock->flow_control = flow_control;
+    sock->closed = 0;
+    sock->rx_head = 0;
+    sock->rx_tail = 0;
+    sock->rx_count = 0;
+    sock->rx_pending = 0;
+    sock->line_len = 0;
+}
+
+err_t c3gaa_socket_write ( c3gaa_t *ctx, c3gaa_socket_t *sock, uint8_t *data_in, uint32_t len )
+{
+    uint16_t chunk_len;
+    uint8_t rx_byte;
+    err_t error_flag;
+
+    while ( len > 0 )
+    {
+        chunk_len = C3GAA_SOCKET_MTU;
+        if ( len < C3GAA_SOCKET_MTU )
+        {
+            chunk_len = ( uint16_t ) len;
+        }
+
+        error_flag = c3gaa_stream_send_cmd( ctx, sock, C3GAA_CMD_QISEND, chunk_len );
+        if ( C3GAA_OK != error_flag )
+        {
+            return error_flag;
+        }
+
+        // Wait for the > prompt of the data mode, it follows the command echo on the same line.
+        for ( ; ; )
+        {
+            if ( C3GAA_OK != c3gaa_stream_read_byte( ctx, &rx_byte, C3GAA_SOCKET_TIMEOUT_MS ) )
+            {
+                return C3GAA_ERROR_TIMEOUT;
+            }
+            if ( '>' == rx_byte )
+            {
+                sock->line_len = 0;
+                break;
+            }
+            if ( C3GAA_STREAM_LINE_READY == c3gaa_stream_feed_line( sock, rx_byte ) )
+            {
+                if ( strstr( sock->line_buf, C3GAA_RSP_ERROR ) )
+                {
+                    return C3GAA_ERROR_CMD;
+                }
+                c3gaa_stream_handle_urc( sock );
+            }
+        }
+
+        error_flag = c3gaa_stream_write_raw( ctx, sock, data_in, chunk_len );
+        if ( C3GAA_OK == error_flag )
+        {
+            error_flag = c3gaa_stream_wait_rsp( ctx, sock, 0 );
+        }
+        if ( C3GAA_OK != error_flag )
+        {
+            return error_flag;
+        }
+
+        data_in += chunk_len;
+        len -= chunk_len;
+    }
+    return C3GAA_OK;
+}
+
+err_t c3gaa_socket_process ( c3gaa_t *ctx, c3gaa_socket_t *sock )
+{
+    uint16_t fetch_len;
+    uint8_t rx_byte;
+    err_t error_flag = C3GAA_OK;
+
+    while ( uart_read( &ctx->uart, &rx_byte, 1 ) > 0 )
+    {
+        if ( C3GAA_STREAM_LINE_READY == c3gaa_stream_feed_line( sock, rx_byte ) )
+        {
+            c3gaa_stream_handle_urc( sock );
+        }
+    }
+
+    fetch_len = 0;
+    if ( sock->rx_pending )
+    {
+        fetch_len = C3GAA_SOCKET_RX_BUFFER_SIZE - sock->rx_count;
+    }
+    if ( fetch_len > C3GAA_SOCKET_MTU )
+    {
+        fetch_len = C3GAA_SOCKET_MTU;
+    }
+
+    if ( fetch_len > 0 )
+    {
+        error_flag = c3gaa_stream_send_cmd( ctx, sock, C3GAA_CMD_QIRD, fetch_len );
+        if ( C3GAA_OK == error_flag )
+        {
+            error_flag = c3gaa_stream_wait_rsp( ctx, sock, fetch_len );
+        }
+    }
+
+    c3gaa_stream_update_rts( ctx, sock );
+    return error_flag;
+}
+
+uint16_t c3gaa_socket_read ( c3gaa_t *ctx, c3gaa_socket_t *sock, uint8_t *data_out, uint16_t len )
+{
+    uint16_t cnt = 0;
+
+    while ( ( cnt < len ) && ( sock->rx_count > 0 ) )
+    {
+        data_out[ cnt++ ] = sock->rx_buf[ sock->rx_tail ];
+        sock->rx_tail = ( sock->rx_tail + 1 ) % C3GAA_SOCKET_RX_BUFFER_SIZE;
+        sock->rx_count--;
+    }
+
+    c3gaa_stream_update_rts( ctx, sock );
+    return cnt;
+}
+
 static int16_t pdu_encode ( uint8_t *service_center_number, uint8_t *phone_number, uint8_t *sms_text,
                             uint8_t *output_buffer, uint16_t buffer_size )
 {
@@ -482,4 +699,206 @@ static void c3gaa_str_cut_chr ( uint8_t *str, uint8_t chr )
     }
 }
 
+static err_t c3gaa_stream_read_byte ( c3gaa_t *ctx, uint8_t *rx_byte, uint16_t timeout_ms )
+{
+    while ( uart_read( &ctx->uart, rx_byte, 1 ) <= 0 )
+    {
+        if ( 0 == timeout_ms-- )
+        {
+            return C3GAA_ERROR_TIMEOUT;
+        }
+        Delay_ms ( 1 );
+    }
+    return C3GAA_OK;
+}
+
+static err_t c3gaa_stream_write_raw ( c3gaa_t *ctx, c3gaa_socket_t *sock, uint8_t *data_in, uint16_t len )
+{
+    uint16_t piece_len;
+    uint16_t timeout_ms;
+    err_t written;
+
+    // The timeout restarts on every accepted piece and covers both CTS and a full TX buffer.
+    timeout_ms = C3GAA_SOCKET_TIMEOUT_MS;
+    while ( len > 0 )
+    {
+        if ( ( C3GAA_FLOW_CONTROL_ON != sock->flow_control ) || 
+             ( C3GAA_PIN_STATE_ACTIVE == c3gaa_get_cts_pin( ctx ) ) )
+        {
+            piece_len = C3GAA_SOCKET_TX_PIECE_SIZE;
+            if ( len < C3GAA_SOCKET_TX_PIECE_SIZE )
+            {
+                piece_len = len;
+            }
+
+            written = uart_write( &ctx->uart, data_in, piece_len );
+            if ( written > 0 )
+            {
+                data_in += written;
+                len -= written;
+                timeout_ms = C3GAA_SOCKET_TIMEOUT_MS;
+                continue;
+            }
+        }
+        if ( 0 == timeout_ms-- )
+        {
+            return C3GAA_ERROR_TIMEOUT;
+        }
+        Delay_ms ( 1 );
+    }
+    return C3GAA_OK;
+}
+
+static err_t c3gaa_stream_send_cmd ( c3gaa_t *ctx, c3gaa_socket_t *sock, const char *cmd, uint16_t len )
+{
+    uint8_t final_cmd[ 32 ] = { 0 };
+    uint8_t num_buf[ 6 ] = { 0 };
+
+    strcpy( final_cmd, cmd );
+    strcat( final_cmd, "=" );
+    uint8_to_str( sock->socket_id, num_buf );
+    c3gaa_str_cut_chr( num_buf, ' ' );
+    strcat( final_cmd, num_buf );
+    strcat( final_cmd, "," );
+    uint16_to_str( len, num_buf );
+    c3gaa_str_cut_chr( num_buf, ' ' );
+    strcat( final_cmd, num_buf );
+    strcat( final_cmd, "\r" );
+
+    return c3gaa_stream_write_raw( ctx, sock, final_cmd, strlen( final_cmd ) );
+}
+
+static uint8_t c3gaa_stream_feed_line ( c3gaa_socket_t *sock, uint8_t rx_byte )
+{
+    if ( '\r' == rx_byte )
+    {
+        return C3GAA_STREAM_LINE_NONE;
+    }
+    if ( '\n' == rx_byte )
+    {
+        if ( 0 == sock->line_len )
+        {
+            return C3GAA_STREAM_LINE_NONE;
+        }
+        sock->line_buf[ sock->line_len ] = 0;
+        sock->line_len = 0;
+        return C3GAA_STREAM_LINE_READY;
+    }
+    if ( sock->line_len < ( C3GAA_SOCKET_LINE_SIZE - 1 ) )
+    {
+        sock->line_buf[ sock->line_len++ ] = rx_byte;
+    }
+    return C3GAA_STREAM_LINE_NONE;
+}
+
+static void c3gaa_stream_handle_urc ( c3gaa_socket_t *sock )
+{
+    // +QIURC: "recv",<connectID> only reports that unread data is available.
+    if ( ( 0 == strncmp( sock->line_buf, "+QIURC: \"recv\"", 14 ) ) && 
+         ( c3gaa_stream_parse_num( sock->line_buf, 1 ) == sock->socket_id ) )
+    {
+        sock->rx_pending = 1;
+    }
+    else if ( ( 0 == strncmp( sock->line_buf, "+QIURC: \"closed\"", 16 ) ) && 
+              ( c3gaa_stream_parse_num( sock->line_buf, 1 ) == sock->socket_id ) )
+    {
+        sock->closed = 1;
+        sock->rx_pending = 0;
+    }
+}
+
+static err_t c3gaa_stream_wait_rsp ( c3gaa_t *ctx, c3gaa_socket_t *sock, uint16_t rd_len )
+{
+    uint16_t data_len;
+    uint8_t rx_byte;
+
+    for ( ; ; )
+    {
+        if ( C3GAA_OK != c3gaa_stream_read_byte( ctx, &rx_byte, C3GAA_SOCKET_TIMEOUT_MS ) )
+        {
+            return C3GAA_ERROR_TIMEOUT;
+        }
+
+        if ( C3GAA_STREAM_LINE_READY == c3gaa_stream_feed_line( sock, rx_byte ) )
+        {
+            // +QIRD: <read_actual_length> is followed by exactly that many raw bytes.
+            if ( rd_len && ( 0 == strncmp( sock->line_buf, "+QIRD:", 6 ) ) )
+            {
+                data_len = c3gaa_stream_parse_num( sock->line_buf + 6, 0 );
+                if ( data_len < rd_len )
+                {
+                    sock->rx_pending = 0;
+                }
+                while ( data_len-- )
+                {
+                    if ( C3GAA_OK != c3gaa_stream_read_byte( ctx, &rx_byte, C3GAA_SOCKET_TIMEOUT_MS ) )
+                    {
+                        return C3GAA_ERROR_TIMEOUT;
+                    }
+                    if ( sock->rx_count < C3GAA_SOCKET_RX_BUFFER_SIZE )
+                    {
+                        sock->rx_buf[ sock->rx_head ] = rx_byte;
+                        sock->rx_head = ( sock->rx_head + 1 ) % C3GAA_SOCKET_RX_BUFFER_SIZE;
+                        sock->rx_count++;
+                    }
+                }
+            }
+            else if ( ( 0 == strcmp( sock->line_buf, C3GAA_RSP_OK ) ) || 
+                      ( 0 == strcmp( sock->line_buf, C3GAA_RSP_SEND_OK ) ) )
+            {
+                return C3GAA_OK;
+            }
+            else if ( strstr( sock->line_buf, C3GAA_RSP_ERROR ) || 
+                      strstr( sock->line_buf, C3GAA_RSP_SEND_FAIL ) )
+            {
+                return C3GAA_ERROR_CMD;
+            }
+            else
+            {
+                c3gaa_stream_handle_urc( sock );
+            }
+        }
+    }
+}
+
+static uint16_t c3gaa_stream_parse_num ( uint8_t *line, uint8_t field )
+{
+    uint16_t num = 0;
+
+    while ( field && *line )
+    {
+        if ( ',' == *line )
+        {
+            field--;
+        }
+        line++;
+    }
+    while ( ' ' == *line )
+    {
+        line++;
+    }
+    while ( ( *line >= '0' ) && ( *line <= '9' ) )
+    {
+        num = num * 10 + ( *line - '0' );
+        line++;
+    }
+    return num;
+}
+
+static void c3gaa_stream_update_rts ( c3gaa_t *ctx, c3gaa_socket_t *sock )
+{
+    if ( C3GAA_FLOW_CONTROL_ON != sock->flow_control )
+    {
+        return;
+    }
+    if ( ( C3GAA_SOCKET_RX_BUFFER_SIZE - sock->rx_count ) < C3GAA_SOCKET_RTS_THRESHOLD )
+    {
+        c3gaa_set_rts_pin( ctx, C3GAA_PIN_STATE_INACTIVE );
+    }
+    else
+    {
+        c3gaa_set_rts_pin( ctx, C3GAA_PIN_STATE_ACTIVE );
+    }
+}
+
 // ------------------------------------------------------------------------- END
@@ -110,6 +110,30 @@ extern "C"{
 #define C3GSARA_RX_DRV_BUFFER_SIZE                  256
 #define C3GSARA_TX_DRV_BUFFER_SIZE                  256
 
+/**
+ * @brief 3G SARA socket stream settings.
+ * @details Specified settings for binary socket streaming of 3G SARA Click driver.
+ * @note Binary USOWR accepts at most 1024 bytes per command, and the module requires
+ * a 50 ms guard time between the @ prompt and the payload.
+ */
+#define C3GSARA_SOCKET_MTU                          1024
+#define C3GSARA_SOCKET_RX_BUFFER_SIZE               512
+#define C3GSARA_SOCKET_LINE_SIZE                    64
+#define C3GSARA_SOCKET_TX_PIECE_SIZE                64
+#define C3GSARA_SOCKET_RTS_THRESHOLD                128
+#define C3GSARA_SOCKET_TIMEOUT_MS                   10000
+#define C3GSARA_SOCKET_PROMPT_GUARD_MS              50
+
+/**
+ * @brief 3G SARA socket stream flow control settings.
+ * @details Specified hardware flow control settings of 3G SARA Click driver.
+ * @note Hardware flow control must also be enabled in the module with AT+IFC=2,2.
+ */
+#define C3GSARA_FLOW_CONTROL_OFF                    0
+#define C3GSARA_FLOW_CONTROL_ON                     1
+#define C3GSARA_PIN_STATE_ACTIVE                    0
+#define C3GSARA_PIN_STATE_INACTIVE                  1
+
 /*! @} */ // c3gsara_set
 
 /**
@@ -188,6 +212,28 @@ typedef struct
 
 } c3gsara_cfg_t;
 
+/**
+ * @brief 3G SARA Click socket stream object.
+ * @details Socket stream object definition of 3G SARA Click driver. Received
+ * payload is collected in the ring buffer as soon as the +UUSORD URC is parsed.
+ */
+typedef struct
+{
+    uint8_t  socket_id;                                   /**< Module socket identifier. */
+    uint8_t  flow_control;                                /**< RTS/CTS flow control enable. */
+    uint8_t  closed;                                      /**< Socket closed by the remote side. */
+
+    uint8_t  rx_buf[ C3GSARA_SOCKET_RX_BUFFER_SIZE ];     /**< Received payload ring buffer. */
+    uint16_t rx_head;                                     /**< Ring buffer write index. */
+    uint16_t rx_tail;                                     /**< Ring buffer read index. */
+    uint16_t rx_count;                                    /**< Number of bytes in ring buffer. */
+    uint16_t rx_pending;                                  /**< Bytes reported by the module and not yet fetched. */
+
+    uint8_t  line_buf[ C3GSARA_SOCKET_LINE_SIZE ];        /**< Response line buffer. */
+    uint8_t  line_len;                                    /**< Response line length. */
+
+} c3gsara_socket_t;
+
 /**
  * @brief 3G SARA Click return value data.
  * @details Predefined enum values for driver return values.
@@ -409,6 +455,70 @@ void c3gsara_send_sms_text ( c3gsara_t *ctx, uint8_t *phone_number, uint8_t *sms
  */
 err_t c3gsara_send_sms_pdu ( c3gsara_t *ctx, uint8_t *service_center_number, uint8_t *phone_number, uint8_t *sms_text );
 
+/**
+ * @brief 3G SARA socket stream init function.
+ * @details This function binds the socket stream object to an already created and
+ * connected module socket and clears its receive ring buffer.
+ * @param[out] sock : Socket stream object.
+ * See #c3gsara_socket_t object definition for detailed explanation.
+ * @param[in] socket_id : Socket identifier returned by AT+USOCR.
+ * @param[in] flow_control : @li @c 0 - RTS/CTS flow control off,
+ *                           @li @c 1 - RTS/CTS flow control on.
+ * @return Nothing.
+ * @note None.
+ */
+void c3gsara_socket_init ( c3gsara_socket_t *sock, uint8_t socket_id, uint8_t flow_control );
+
+/**
+ * @brief 3G SARA socket stream write function.
+ * @details This function sends a binary buffer of any length to the socket. The buffer
+ * is split into chunks of up to C3GSARA_SOCKET_MTU bytes, each sent in the binary
+ * USOWR data mode straight from the caller buffer, without copying or quoting.
+ * @param[in] ctx : Click context object.
+ * See #c3gsara_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c3gsara_socket_t object definition for detailed explanation.
+ * @param[in] data_in : Data buffer for sending.
+ * @param[in] len : Number of bytes for sending.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout,
+ *         @li @c -3 - Command error.
+ * See #c3gsara_return_value_t definition for detailed explanation.
+ * @note URCs received while sending are processed, so incoming data is not lost.
+ */
+err_t c3gsara_socket_write ( c3gsara_t *ctx, c3gsara_socket_t *sock, uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief 3G SARA socket stream process function.
+ * @details This function parses all bytes received from the module, and on the
+ * +UUSORD URC fetches the announced payload into the socket ring buffer with USORD.
+ * When flow control is on, RTS is released while the ring buffer is nearly full.
+ * @param[in] ctx : Click context object.
+ * See #c3gsara_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c3gsara_socket_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout,
+ *         @li @c -3 - Command error.
+ * See #c3gsara_return_value_t definition for detailed explanation.
+ * @note All module UART traffic must go through this function while the stream is used.
+ */
+err_t c3gsara_socket_process ( c3gsara_t *ctx, c3gsara_socket_t *sock );
+
+/**
+ * @brief 3G SARA socket stream read function.
+ * @details This function reads received payload from the socket ring buffer.
+ * @param[in] ctx : Click context object.
+ * See #c3gsara_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c3gsara_socket_t object definition for detailed explanation.
+ * @param[out] data_out : Output read data.
+ * @param[in] len : Maximal number of bytes to be read.
+ * @return Number of bytes read.
+ * @note None.
+ */
+uint16_t c3gsara_socket_read ( c3gsara_t *ctx, c3gsara_socket_t *sock, uint8_t *data_out, uint16_t len );
+
 #ifdef __cplusplus
 }
 #endif
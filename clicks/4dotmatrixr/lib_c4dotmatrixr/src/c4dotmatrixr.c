@@ -100,9 +100,9 @@ void c4dotmatrixr_generic_write ( c4dotmatrixr_t *ctx, uint8_t reg, uint8_t *dat
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 ); 
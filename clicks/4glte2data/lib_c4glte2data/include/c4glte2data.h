@@ -116,6 +116,30 @@ extern "C"{
  */
 #define DRV_BUFFER_SIZE                                 256
 
+/**
+ * @brief 4G LTE 2 Data socket stream settings.
+ * @details Specified settings for binary socket streaming of 4G LTE 2 Data Click driver.
+ * @note Binary USOWR accepts at most 1024 bytes per command on LARA-R2, and the module requires
+ * a 50 ms guard time between the @ prompt and the payload.
+ */
+#define C4GLTE2DATA_SOCKET_MTU                          1024
+#define C4GLTE2DATA_SOCKET_RX_BUFFER_SIZE               512
+#define C4GLTE2DATA_SOCKET_LINE_SIZE                    64
+#define C4GLTE2DATA_SOCKET_TX_PIECE_SIZE                64
+#define C4GLTE2DATA_SOCKET_RTS_THRESHOLD                128
+#define C4GLTE2DATA_SOCKET_TIMEOUT_MS                   10000
+#define C4GLTE2DATA_SOCKET_PROMPT_GUARD_MS              50
+
+/**
+ * @brief 4G LTE 2 Data socket stream flow control settings.
+ * @details Specified hardware flow control settings of 4G LTE 2 Data Click driver.
+ * @note Hardware flow control must also be enabled in the module with AT+IFC=2,2.
+ */
+#define C4GLTE2DATA_FLOW_CONTROL_OFF                    0
+#define C4GLTE2DATA_FLOW_CONTROL_ON                     1
+#define C4GLTE2DATA_PIN_STATE_ACTIVE                    0
+#define C4GLTE2DATA_PIN_STATE_INACTIVE                  1
+
 /*! @} */ // c4glte2data_cmd
 
 /**
@@ -194,6 +218,28 @@ typedef struct
 
 } c4glte2data_cfg_t;
 
+/**
+ * @brief 4G LTE 2 Data Click socket stream object.
+ * @details Socket stream object definition of 4G LTE 2 Data Click driver. Received
+ * payload is collected in the ring buffer as soon as the +UUSORD URC is parsed.
+ */
+typedef struct
+{
+    uint8_t  socket_id;                                   /**< Module socket identifier. */
+    uint8_t  flow_control;                                /**< RTS/CTS flow control enable. */
+    uint8_t  closed;                                      /**< Socket closed by the remote side. */
+
+    uint8_t  rx_buf[ C4GLTE2DATA_SOCKET_RX_BUFFER_SIZE ]; /**< Received payload ring buffer. */
+    uint16_t rx_head;                                     /**< Ring buffer write index. */
+    uint16_t rx_tail;                                     /**< Ring buffer read index. */
+    uint16_t rx_count;                                    /**< Number of bytes in ring buffer. */
+    uint16_t rx_pending;                                  /**< Bytes reported by the module and not yet fetched. */
+
+    char     line_buf[ C4GLTE2DATA_SOCKET_LINE_SIZE ];    /**< Response line buffer. */
+    uint8_t  line_len;                                    /**< Response line length. */
+
+} c4glte2data_socket_t;
+
 /**
  * @brief 4G LTE 2 Data Click return value data.
  * @details Predefined enum values for driver return values.
@@ -416,6 +462,70 @@ void c4glte2data_send_sms_text ( c4glte2data_t *ctx, char *phone_number, char *s
  */
 err_t c4glte2data_send_sms_pdu ( c4glte2data_t *ctx, char *service_center_number, char *phone_number, char *sms_text );
 
+/**
+ * @brief 4G LTE 2 Data socket stream init function.
+ * @details This function binds the socket stream object to an already created and
+ * connected module socket and clears its receive ring buffer.
+ * @param[out] sock : Socket stream object.
+ * See #c4glte2data_socket_t object definition for detailed explanation.
+ * @param[in] socket_id : Socket identifier returned by AT+USOCR.
+ * @param[in] flow_control : @li @c 0 - RTS/CTS flow control off,
+ *                           @li @c 1 - RTS/CTS flow control on.
+ * @return Nothing.
+ * @note None.
+ */
+void c4glte2data_socket_init ( c4glte2data_socket_t *sock, uint8_t socket_id, uint8_t flow_control );
+
+/**
+ * @brief 4G LTE 2 Data socket stream write function.
+ * @details This function sends a binary buffer of any length to the socket. The buffer
+ * is split into chunks of up to C4GLTE2DATA_SOCKET_MTU bytes, each sent in the binary
+ * USOWR data mode straight from the caller buffer, without copying or quoting.
+ * @param[in] ctx : Click context object.
+ * See #c4glte2data_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c4glte2data_socket_t object definition for detailed explanation.
+ * @param[in] data_in : Data buffer for sending.
+ * @param[in] len : Number of bytes for sending.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout,
+ *         @li @c -3 - Command error.
+ * See #c4glte2data_return_value_t definition for detailed explanation.
+ * @note URCs received while sending are processed, so incoming data is not lost.
+ */
+err_t c4glte2data_socket_write ( c4glte2data_t *ctx, c4glte2data_socket_t *sock, uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief 4G LTE 2 Data socket stream process function.
+ * @details This function parses all bytes received from the module, and on the
+ * +UUSORD URC fetches the announced payload into the socket ring buffer with USORD.
+ * When flow control is on, RTS is released while the ring buffer is nearly full.
+ * @param[in] ctx : Click context object.
+ * See #c4glte2data_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c4glte2data_socket_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout,
+ *         @li @c -3 - Command error.
+ * See #c4glte2data_return_value_t definition for detailed explanation.
+ * @note All module UART traffic must go through this function while the stream is used.
+ */
+err_t c4glte2data_socket_process ( c4glte2data_t *ctx, c4glte2data_socket_t *sock );
+
+/**
+ * @brief 4G LTE 2 Data socket stream read function.
+ * @details This function reads received payload from the socket ring buffer.
+ * @param[in] ctx : Click context object.
+ * See #c4glte2data_t object definition for detailed explanation.
+ * @param[in,out] sock : Socket stream object.
+ * See #c4glte2data_socket_t object definition for detailed explanation.
+ * @param[out] data_out : Output read data.
+ * @param[in] len : Maximal number of bytes to be read.
+ * @return Number of bytes read.
+ * @note None.
+ */
+uint16_t c4glte2data_socket_read ( c4glte2data_t *ctx, c4glte2data_socket_t *sock, uint8_t *data_out, uint16_t len );
+
 #ifdef __cplusplus
 }
 #endif
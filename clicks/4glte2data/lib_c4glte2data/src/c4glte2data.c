@@ -102,6 +102,100 @@ static int16_t encode_phone_number ( char *phone_number, uint8_t *output_buffer,
  */
 static void c4glte2data_str_cut_chr ( char *str, char chr );
 
+/**
+ * @brief Socket stream line states.
+ * @details Return values of the socket stream line parser.
+ */
+#define C4GLTE2DATA_STREAM_LINE_NONE            0
+#define C4GLTE2DATA_STREAM_LINE_READY           1
+
+/**
+ * @brief 4G LTE 2 Data stream read byte function.
+ * @details This function reads a single byte from the UART ring buffer,
+ * polling every millisecond until the timeout expires.
+ * @param[in] ctx : Click context object.
+ * @param[out] rx_byte : Read byte.
+ * @param[in] timeout_ms : Timeout in milliseconds.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout.
+ */
+static err_t c4glte2data_stream_read_byte ( c4glte2data_t *ctx, uint8_t *rx_byte, uint16_t timeout_ms );
+
+/**
+ * @brief 4G LTE 2 Data stream write raw function.
+ * @details This function writes data to the module in small pieces,
+ * waiting for CTS before each piece when flow control is on.
+ * @param[in] ctx : Click context object.
+ * @param[in] sock : Socket stream object.
+ * @param[in] data_in : Data buffer for sending.
+ * @param[in] len : Number of bytes for sending.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout.
+ */
+static err_t c4glte2data_stream_write_raw ( c4glte2data_t *ctx, c4glte2data_socket_t *sock, uint8_t *data_in, uint16_t len );
+
+/**
+ * @brief 4G LTE 2 Data stream send socket command function.
+ * @details This function sends a socket command in format AT+CMD=<socket>,<len>.
+ * @param[in] ctx : Click context object.
+ * @param[in] sock : Socket stream object.
+ * @param[in] cmd : AT command.
+ * @param[in] len : Length parameter.
+ * @return @li @c  0 - Success,
+ *         @li @c -2 - Timeout.
+ */
+static err_t c4glte2data_stream_send_cmd ( c4glte2data_t *ctx, c4glte2data_socket_t *sock, const char *cmd, uint16_t len );
+
+/**
+ * @brief 4G LTE 2 Data stream feed line function.
+ * @details This function adds a received byte to the response line buffer.
+ * @param[in] sock : Socket stream object.
+ * @param[in] rx_byte : Received byte.
+ * @return @li @c 0 - Line not complete,
+ *         @li @c 1 - Line complete and stored in line buffer.
+ */
+static uint8_t c4glte2data_stream_feed_line ( c4glte2data_socket_t *sock, uint8_t rx_byte );
+
+/**
+ * @brief 4G LTE 2 Data stream handle URC function.
+ * @details This function updates the socket state from a complete URC line.
+ * @param[in] sock : Socket stream object.
+ * @return Nothing.
+ */
+static void c4glte2data_stream_handle_urc ( c4glte2data_socket_t *sock );
+
+/**
+ * @brief 4G LTE 2 Data stream wait response function.
+ * @details This function waits for the final OK or ERROR response line,
+ * while handling URC lines and, for USORD, storing the binary payload.
+ * @param[in] ctx : Click context object.
+ * @param[in] sock : Socket stream object.
+ * @return @li @c  0 - OK received,
+ *         @li @c -2 - Timeout,
+ *         @li @c -3 - ERROR received.
+ */
+static err_t c4glte2data_stream_wait_rsp ( c4glte2data_t *ctx, c4glte2data_socket_t *sock );
+
+/**
+ * @brief 4G LTE 2 Data stream parse number function.
+ * @details This function parses a decimal number after the selected
+ * comma separated field of a line.
+ * @param[in] line : Response line.
+ * @param[in] field : Zero based comma separated field index.
+ * @return Parsed number.
+ */
+static uint16_t c4glte2data_stream_parse_num ( char *line, uint8_t field );
+
+/**
+ * @brief 4G LTE 2 Data stream update RTS function.
+ * @details This function asserts RTS while the ring buffer has room for
+ * more data and releases it otherwise.
+ * @param[in] ctx : Click context object.
+ * @param[in] sock : Socket stream object.
+ * @return Nothing.
+ */
+static void c4glte2data_stream_update_rts ( c4glte2data_t *ctx, c4glte2data_socket_t *sock );
+
 void c4glte2data_cfg_setup ( c4glte2data_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -352,6 +446,129 @@ err_t c4glte2data_send_sms_pdu ( c4glte2data_t *ctx, char *service_center_number
     return C4GLTE2DATA_OK;
 }
 
+void c4glte2data_socket_init ( c4glte2data_socket_t *sock, uint8_t socket_id, uint8_t flow_control )
+{
+    sock->socket_id = socket_id;
+    sock->flow_control = flow_control;
+    sock->closed = 0;
+    sock->rx_head = 0;
+    sock->rx_tail = 0;
+    sock->rx_count = 0;
+    sock->rx_pending = 0;
+    sock->line_len = 0;
+}
+
+err_t c4glte2data_socket_write ( c4glte2data_t *ctx, c4glte2data_socket_t *sock, uint8_t *data_in, uint32_t len )
+{
+    uint16_t chunk_len;
+    uint8_t rx_byte;
+    err_t error_flag;
+
+    while ( len > 0 )
+    {
+        chunk_len = C4GLTE2DATA_SOCKET_MTU;
+        if ( len < C4GLTE2DATA_SOCKET_MTU )
+        {
+            chunk_len = ( uint16_t ) len;
+        }
+
+        error_flag = c4glte2data_stream_send_cmd( ctx, sock, C4GLTE2DATA_CMD_USOWR, chunk_len );
+        if ( C4GLTE2DATA_OK != error_flag )
+        {
+            return error_flag;
+        }
+
+        // Wait for the @ prompt of the binary data mode, it follows the command echo on the same line.
+        for ( ; ; )
+        {
+            if ( C4GLTE2DATA_OK != c4glte2data_stream_read_byte( ctx, &rx_byte, C4GLTE2DATA_SOCKET_TIMEOUT_MS ) )
+            {
+                return C4GLTE2DATA_ERROR_TIMEOUT;
+            }
+            if ( '@' == rx_byte )
+            {
+                sock->line_len = 0;
+                break;
+            }
+            if ( C4GLTE2DATA_STREAM_LINE_READY == c4glte2data_stream_feed_line( sock, rx_byte ) )
+            {
+                if ( strstr( sock->line_buf, C4GLTE2DATA_RSP_ERROR ) )
+                {
+                    return C4GLTE2DATA_ERROR_CMD;
+                }
+                c4glte2data_stream_handle_urc( sock );
+            }
+        }
+        Delay_ms ( C4GLTE2DATA_SOCKET_PROMPT_GUARD_MS );
+
+        error_flag = c4glte2data_stream_write_raw( ctx, sock, data_in, chunk_len );
+        if ( C4GLTE2DATA_OK == error_flag )
+        {
+            error_flag = c4glte2data_stream_wait_rsp( ctx, sock );
+        }
+        if ( C4GLTE2DATA_OK != error_flag )
+        {
+            return error_flag;
+        }
+
+        data_in += chunk_len;
+        len -= chunk_len;
+    }
+    return C4GLTE2DATA_OK;
+}
+
+err_t c4glte2data_socket_process ( c4glte2data_t *ctx, c4glte2data_socket_t *sock )
+{
+    uint16_t fetch_len;
+    uint8_t rx_byte;
+    err_t error_flag = C4GLTE2DATA_OK;
+
+    while ( uart_read( &ctx->uart, &rx_byte, 1 ) > 0 )
+    {
+        if ( C4GLTE2DATA_STREAM_LINE_READY == c4glte2data_stream_feed_line( sock, rx_byte ) )
+        {
+            c4glte2data_stream_handle_urc( sock );
+        }
+    }
+
+    fetch_len = C4GLTE2DATA_SOCKET_RX_BUFFER_SIZE - sock->rx_count;
+    if ( fetch_len > sock->rx_pending )
+    {
+        fetch_len = sock->rx_pending;
+    }
+    if ( fetch_len > C4GLTE2DATA_SOCKET_MTU )
+    {
+        fetch_len = C4GLTE2DATA_SOCKET_MTU;
+    }
+
+    if ( fetch_len > 0 )
+    {
+        error_flag = c4glte2data_stream_send_cmd( ctx, sock, C4GLTE2DATA_CMD_USORD, fetch_len );
+        if ( C4GLTE2DATA_OK == error_flag )
+        {
+            error_flag = c4glte2data_stream_wait_rsp( ctx, sock );
+        }
+    }
+
+    c4glte2data_stream_update_rts( ctx, sock );
+    return error_flag;
+}
+
+uint16_t c4glte2data_socket_read ( c4glte2data_t *ctx, c4glte2data_socket_t *sock, uint8_t *data_out, uint16_t len )
+{
+    uint16_t cnt = 0;
+
+    while ( ( cnt < len ) && ( sock->rx_count > 0 ) )
+    {
+        data_out[ cnt++ ] = sock->rx_buf[ sock->rx_tail ];
+        sock->rx_tail = ( sock->rx_tail + 1 ) % C4GLTE2DATA_SOCKET_RX_BUFFER_SIZE;
+        sock->rx_count--;
+    }
+
+    c4glte2data_stream_update_rts( ctx, sock );
+    return cnt;
+}
+
 static int16_t pdu_encode( char *service_center_number, char *phone_number, char *sms_text,
                            uint8_t *output_buffer, uint16_t buffer_size )
 {
@@ -507,4 +724,217 @@ static void c4glte2data_str_cut_chr ( char *str, char chr )
     }
 }
 
+static err_t c4glte2data_stream_read_byte ( c4glte2data_t *ctx, uint8_t *rx_byte, uint16_t timeout_ms )
+{
+    while ( uart_read( &ctx->uart, rx_byte, 1 ) <= 0 )
+    {
+        if ( 0 == timeout_ms-- )
+        {
+            return C4GLTE2DATA_ERROR_TIMEOUT;
+        }
+        Delay_ms ( 1 );
+    }
+    return C4GLTE2DATA_OK;
+}
+
+static err_t c4glte2data_stream_write_raw ( c4glte2data_t *ctx, c4glte2data_socket_t *sock, uint8_t *data_in, uint16_t len )
+{
+    uint16_t piece_len;
+    uint16_t timeout_ms;
+    err_t written;
+
+    // The timeout restarts on every accepted piece and covers both CTS and a full TX buffer.
+    timeout_ms = C4GLTE2DATA_SOCKET_TIMEOUT_MS;
+    while ( len > 0 )
+    {
+        if ( ( C4GLTE2DATA_FLOW_CONTROL_ON != sock->flow_control ) || 
+             ( C4GLTE2DATA_PIN_STATE_ACTIVE == c4glte2data_get_cts_pin( ctx ) ) )
+        {
+            piece_len = C4GLTE2DATA_SOCKET_TX_PIECE_SIZE;
+            if ( len < C4GLTE2DATA_SOCKET_TX_PIECE_SIZE )
+            {
+                piece_len = len;
+            }
+
+            written = uart_write( &ctx->uart, data_in, piece_len );
+            if ( written > 0 )
+            {
+                data_in += written;
+                len -= written;
+                timeout_ms = C4GLTE2DATA_SOCKET_TIMEOUT_MS;
+                continue;
+            }
+        }
+        if ( 0 == timeout_ms-- )
+        {
+            return C4GLTE2DATA_ERROR_TIMEOUT;
+        }
+        Delay_ms ( 1 );
+    }
+    return C4GLTE2DATA_OK;
+}
+
+static err_t c4glte2data_stream_send_cmd ( c4glte2data_t *ctx, c4glte2data_socket_t *sock, const char *cmd, uint16_t len )
+{
+    char final_cmd[ 32 ] = { 0 };
+    char num_buf[ 6 ] = { 0 };
+
+    strcpy( final_cmd, cmd );
+    strcat( final_cmd, "=" );
+    uint8_to_str( sock->socket_id, num_buf );
+    c4glte2data_str_cut_chr( num_buf, ' ' );
+    strcat( final_cmd, num_buf );
+    strcat( final_cmd, "," );
+    uint16_to_str( len, num_buf );
+    c4glte2data_str_cut_chr( num_buf, ' ' );
+    strcat( final_cmd, num_buf );
+    strcat( final_cmd, "\r" );
+
+    return c4glte2data_stream_write_raw( ctx, sock, ( uint8_t * ) final_cmd, strlen( final_cmd ) );
+}
+
+static uint8_t c4glte2data_stream_feed_line ( c4glte2data_socket_t *sock, uint8_t rx_byte )
+{
+    if ( '\r' == rx_byte )
+    {
+        return C4GLTE2DATA_STREAM_LINE_NONE;
+    }
+    if ( '\n' == rx_byte )
+    {
+        if ( 0 == sock->line_len )
+        {
+            return C4GLTE2DATA_STREAM_LINE_NONE;
+        }
+        sock->line_buf[ sock->line_len ] = 0;
+        sock->line_len = 0;
+        return C4GLTE2DATA_STREAM_LINE_READY;
+    }
+    if ( sock->line_len < ( C4GLTE2DATA_SOCKET_LINE_SIZE - 1 ) )
+    {
+        sock->line_buf[ sock->line_len++ ] = rx_byte;
+    }
+    return C4GLTE2DATA_STREAM_LINE_NONE;
+}
+
+static void c4glte2data_stream_handle_urc ( c4glte2data_socket_t *sock )
+{
+    // +UUSORD reports the total number of unread bytes of the socket.
+    if ( ( 0 == strncmp( sock->line_buf, "+UUSORD:", 8 ) ) && 
+         ( c4glte2data_stream_parse_num( sock->line_buf + 8, 0 ) == sock->socket_id ) )
+    {
+        sock->rx_pending = c4glte2data_stream_parse_num( sock->line_buf + 8, 1 );
+    }
+    else if ( ( 0 == strncmp( sock->line_buf, "+UUSOCL:", 8 ) ) && 
+              ( c4glte2data_stream_parse_num( sock->line_buf + 8, 0 ) == sock->socket_id ) )
+    {
+        sock->closed = 1;
+        sock->rx_pending = 0;
+    }
+}
+
+static err_t c4glte2data_stream_wait_rsp ( c4glte2data_t *ctx, c4glte2data_socket_t *sock )
+{
+    uint16_t data_len;
+    uint8_t rx_byte;
+
+    for ( ; ; )
+    {
+        if ( C4GLTE2DATA_OK != c4glte2data_stream_read_byte( ctx, &rx_byte, C4GLTE2DATA_SOCKET_TIMEOUT_MS ) )
+        {
+            return C4GLTE2DATA_ERROR_TIMEOUT;
+        }
+
+        // +USORD: <socket>,<length>,"<binary data>" - the payload is taken by length.
+        if ( ( '"' == rx_byte ) && ( sock->line_len >= 7 ) && 
+             ( 0 == strncmp( sock->line_buf, "+USORD:", 7 ) ) )
+        {
+            sock->line_buf[ sock->line_len ] = 0;
+            data_len = c4glte2data_stream_parse_num( sock->line_buf + 7, 1 );
+            if ( data_len > sock->rx_pending )
+            {
+                sock->rx_pending = data_len;
+            }
+            sock->rx_pending -= data_len;
+            while ( data_len-- )
+            {
+                if ( C4GLTE2DATA_OK != c4glte2data_stream_read_byte( ctx, &rx_byte, C4GLTE2DATA_SOCKET_TIMEOUT_MS ) )
+                {
+                    return C4GLTE2DATA_ERROR_TIMEOUT;
+                }
+                if ( sock->rx_count < C4GLTE2DATA_SOCKET_RX_BUFFER_SIZE )
+                {
+                    sock->rx_buf[ sock->rx_head ] = rx_byte;
+                    sock->rx_head = ( sock->rx_head + 1 ) % C4GLTE2DATA_SOCKET_RX_BUFFER_SIZE;
+                    sock->rx_count++;
+                }
+            }
+            // Drop the header so the closing quote is not taken for a new payload, then skip it.
+            sock->line_buf[ 0 ] = 0;
+            sock->line_len = 0;
+            if ( C4GLTE2DATA_OK != c4glte2data_stream_read_byte( ctx, &rx_byte, C4GLTE2DATA_SOCKET_TIMEOUT_MS ) )
+            {
+                return C4GLTE2DATA_ERROR_TIMEOUT;
+            }
+            if ( '"' != rx_byte )
+            {
+                c4glte2data_stream_feed_line( sock, rx_byte );
+            }
+            continue;
+        }
+
+        if ( C4GLTE2DATA_STREAM_LINE_READY == c4glte2data_stream_feed_line( sock, rx_byte ) )
+        {
+            if ( 0 == strcmp( sock->line_buf, C4GLTE2DATA_RSP_OK ) )
+            {
+                return C4GLTE2DATA_OK;
+            }
+            if ( strstr( sock->line_buf, C4GLTE2DATA_RSP_ERROR ) )
+            {
+                return C4GLTE2DATA_ERROR_CMD;
+            }
+            c4glte2data_stream_handle_urc( sock );
+        }
+    }
+}
+
+static uint16_t c4glte2data_stream_parse_num ( char *line, uint8_t field )
+{
+    uint16_t num = 0;
+
+    while ( field && *line )
+    {
+        if ( ',' == *line )
+        {
+            field--;
+        }
+        line++;
+    }
+    while ( ' ' == *line )
+    {
+        line++;
+    }
+    while ( ( *line >= '0' ) && ( *line <= '9' ) )
+    {
+        num = num * 10 + ( *line - '0' );
+        line++;
+    }
+    return num;
+}
+
+static void c4glte2data_stream_update_rts ( c4glte2data_t *ctx, c4glte2data_socket_t *sock )
+{
+    if ( C4GLTE2DATA_FLOW_CONTROL_ON != sock->flow_control )
+    {
+        return;
+    }
+    if ( ( C4GLTE2DATA_SOCKET_RX_BUFFER_SIZE - sock->rx_count ) < C4GLTE2DATA_SOCKET_RTS_THRESHOLD )
+    {
+        c4glte2data_set_rts_pin( ctx, C4GLTE2DATA_PIN_STATE_INACTIVE );
+    }
+    else
+    {
+        c4glte2data_set_rts_pin( ctx, C4GLTE2DATA_PIN_STATE_ACTIVE );
+    }
+}
+
 // ------------------------------------------------------------------------- END
@@ -253,9 +253,9 @@ static void c6dofimu12_i2c_write ( c6dofimu12_t *ctx, uint8_t reg, uint8_t *data
     
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
 
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );    
@@ -277,20 +277,13 @@ static void c6dofimu12_spi_write ( c6dofimu12_t *ctx, uint8_t reg, uint8_t *data
 static void c6dofimu12_spi_read ( c6dofimu12_t *ctx, uint8_t reg, uint8_t *data_buf, uint16_t len )
 {
     uint8_t tx_buf[ 2 ];
-    uint8_t rx_buf[ 265 ] = { 0 };
-    uint16_t cnt;
 
     tx_buf[ 0 ] = reg | C6DOFIMU12_SPI_CMD_READ;
     tx_buf[ 1 ] = C6DOFIMU12_SPI_COMMUNICATION_DUMMY;
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write_then_read( &ctx->spi, tx_buf, 2, rx_buf, len );
+    spi_master_write_then_read( &ctx->spi, tx_buf, 2, data_buf, len );
     spi_master_deselect_device( ctx->chip_select );    
-
-    for ( cnt = 0; cnt < len; cnt++ )
-    {
-        data_buf[ cnt ] = rx_buf [ cnt ];
-    }
 }
 
 // ------------------------------------------------------------------------- END
@@ -409,9 +409,9 @@ static err_t c6dofimu14_i2c_write ( c6dofimu14_t *ctx, uint8_t reg, uint8_t *dat
 
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ ) 
+    for ( cnt = 0; cnt < len; cnt++ ) 
     {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
+        tx_buf[ cnt + 1 ] = data_in[ cnt ];
     }
 
     return i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
@@ -424,16 +424,13 @@ static err_t c6dofimu14_i2c_read ( c6dofimu14_t *ctx, uint8_t reg, uint8_t *data
 
 static err_t c6dofimu14_spi_write ( c6dofimu14_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
-    uint8_t tx_buf[ 257 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg & C6DOFIMU14_SPI_WRITE_MASK;
-    for ( cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
@@ -637,9 +637,9 @@ static void c6dofimu15_i2c_write ( c6dofimu15_t *ctx, uint8_t reg, uint8_t *data
     
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
 
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );    
@@ -652,19 +652,14 @@ static void c6dofimu15_i2c_read ( c6dofimu15_t *ctx, uint8_t reg, uint8_t *data_
 
 static void c6dofimu15_spi_write ( c6dofimu15_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
-    uint8_t tx_buf[ 265 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg;
     tx_buf[ 0 ] &= C6DOFIMU15_WR_BIT_MASK;
-
-    for ( cnt = 1; cnt <= len; cnt++ )
-    {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
-    }
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    spi_master_write( &ctx->spi, tx_buf, 1 );
+    spi_master_write( &ctx->spi, data_buf, len );
     spi_master_deselect_device( ctx->chip_select );     
 }
 
@@ -211,9 +211,9 @@ static void c6dofimu2_i2c_write ( c6dofimu2_t *ctx, uint8_t reg, uint8_t *data_b
     
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
 
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );  
@@ -226,36 +226,28 @@ static void c6dofimu2_i2c_read ( c6dofimu2_t *ctx, uint8_t reg, uint8_t *data_bu
 
 static void c6dofimu2_spi_write ( c6dofimu2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
-    uint8_t tx_buf[ 265 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ )
-    {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
-    }
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    spi_master_write( &ctx->spi, tx_buf, 1 );
+    spi_master_write( &ctx->spi, data_buf, len );
     spi_master_deselect_device( ctx->chip_select );  
 }
 
 static void c6dofimu2_spi_read ( c6dofimu2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
     uint8_t tx_buf[ 1 ];
-    uint8_t rx_buf[ 265 ];
-    uint8_t cnt;
+    uint8_t dummy_byte;
 
     tx_buf[ 0 ] = reg | 0x80;
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write_then_read( &ctx->spi, tx_buf, 1, rx_buf, len + 1 );
+    spi_master_write( &ctx->spi, tx_buf, 1 );
+    spi_master_read( &ctx->spi, &dummy_byte, 1 );
+    spi_master_read( &ctx->spi, data_buf, len );
     spi_master_deselect_device( ctx->chip_select ); 
-
-    for ( cnt = 0; cnt < len; cnt++ )
-    {
-        data_buf[ cnt ] = rx_buf [ cnt + 1];
-    }
 }
 
 // ------------------------------------------------------------------------- END
@@ -233,25 +233,27 @@ void c6dofimu3_multi_write ( c6dofimu3_t *ctx, uint8_t reg, uint8_t *p_tx_data,
     uint16_t n_cnt;
     uint8_t tx_buf[ 256 ];
 
-    tx_buf[ 0 ] = reg;
-
-    for ( n_cnt = 0; n_cnt < n_bytes; n_cnt++ )
-    {
-        tx_buf[ n_cnt + 2 ] = p_tx_data[ n_cnt ];
-    }
-
     if ( ctx->master_sel == C6DOFIMU3_MASTER_I2C )
     {
+        tx_buf[ 0 ] = reg;
+
+        for ( n_cnt = 0; n_cnt < n_bytes; n_cnt++ )
+        {
+            tx_buf[ n_cnt + 1 ] = p_tx_data[ n_cnt ];
+        }
+
         i2c_master_write( &ctx->i2c, tx_buf, n_bytes + 1 );  
     }
     else
     {
+        tx_buf[ 0 ] = reg;
         tx_buf[ 0 ] |= C6DOFIMU3_BIT_MASK_SPI_CMD_WRITE;
         tx_buf[ 1 ] = reg;
         tx_buf[ 1 ] &= C6DOFIMU3_BIT_MASK_BIT_7;
 
         spi_master_select_device( ctx->chip_select );
-        spi_master_write( &ctx->spi, tx_buf, n_bytes + 2 );
+        spi_master_write( &ctx->spi, tx_buf, 2 );
+        spi_master_write( &ctx->spi, p_tx_data, n_bytes );
         spi_master_deselect_device( ctx->chip_select );     
         Delay_1ms( );   
     }
@@ -450,21 +452,16 @@ static void c6dofimu3_i2c_read ( c6dofimu3_t *ctx, uint8_t reg, uint8_t *read_da
 
 static void c6dofimu3_spi_write ( c6dofimu3_t *ctx, uint8_t reg, uint8_t *tx_data, uint8_t len )
 {
-    uint8_t tx_buf[ 3 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 2 ];
 
     tx_buf[ 0 ] = reg;
     tx_buf[ 0 ] |= C6DOFIMU3_BIT_MASK_SPI_CMD_WRITE;
     tx_buf[ 1 ] = reg;
     tx_buf[ 1 ] &= C6DOFIMU3_BIT_MASK_BIT_7;
 
-    for ( cnt = 0; cnt < len; cnt++ )
-    {
-        tx_buf[ cnt + 2 ] = tx_data[ cnt ]; 
-    }
-
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, len + 2 );
+    spi_master_write( &ctx->spi, tx_buf, 2 );
+    spi_master_write( &ctx->spi, tx_data, len );
     spi_master_deselect_device( ctx->chip_select );     
     Delay_1ms( );   
 }
@@ -543,17 +543,13 @@ static void c6dofimu5_i2c_read ( c6dofimu5_t *ctx, uint8_t *reg_buff, uint8_t *d
 
 static void c6dofimu5_spi_write ( c6dofimu5_t *ctx, uint8_t reg, uint8_t *data_buf, uint16_t len )
 {
-    uint8_t tx_buf[ 265 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg & C6DOFIMU5_WRITE_BIT_MASK;
-    for ( cnt = 1; cnt <= len; cnt++ )
-    {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
-    }
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    spi_master_write( &ctx->spi, tx_buf, 1 );
+    spi_master_write( &ctx->spi, data_buf, len );
     spi_master_deselect_device( ctx->chip_select );        
 }
 
@@ -446,9 +446,9 @@ static void c9dof3_i2c_write ( c9dof3_t *ctx, uint8_t reg, uint8_t *data_buf, ui
 
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ ) 
+    for ( cnt = 0; cnt < len; cnt++ ) 
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ];
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ];
     }
     dev_set_slave_addr( ctx );
 
@@ -465,17 +465,13 @@ static void c9dof3_i2c_read ( c9dof3_t *ctx, uint8_t reg, uint8_t *data_buf, uin
 
 static void c9dof3_spi_write ( c9dof3_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
-    uint8_t tx_buf[ 257 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg & C9DOF3_BIT_MASK_SPI_CMD_WRITE;
-    for ( cnt = 1; cnt <= len; cnt++ )
-    {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
-    }
 
     dev_start_chip_select( ctx );
-    spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    spi_master_write( &ctx->spi, tx_buf, 1 );
+    spi_master_write( &ctx->spi, data_buf, len );
     dev_stop_chip_select( ctx );    
 }
 
@@ -373,9 +373,9 @@ static err_t accel22_i2c_write ( accel22_t *ctx, uint8_t reg, uint8_t *data_in,
 {
     uint8_t tx_buf[ 257 ] = { 0 };
     tx_buf[ 0 ] = reg;
-    for ( uint8_t cnt = 1; cnt <= len; cnt++ ) 
+    for ( uint8_t cnt = 0; cnt < len; cnt++ ) 
     {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
+        tx_buf[ cnt + 1 ] = data_in[ cnt ];
     }
     return i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
 }
@@ -387,15 +387,12 @@ static err_t accel22_i2c_read ( accel22_t *ctx, uint8_t reg, uint8_t *data_out,
 
 static err_t accel22_spi_write ( accel22_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len )
 {
-    uint8_t tx_buf[ 258 ] = { 0 };
+    uint8_t tx_buf[ 2 ] = { 0 };
     tx_buf[ 0 ] = ACCEL22_SPI_WRITE_REG;
     tx_buf[ 1 ] = reg;
-    for ( uint8_t cnt = 0; cnt < len; cnt++ ) 
-    {
-        tx_buf[ cnt + 2 ] = data_in[ cnt ];
-    }
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 2 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 2 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
     return error_flag;
 }
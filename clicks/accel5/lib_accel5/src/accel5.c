@@ -82,9 +82,9 @@ err_t accel5_generic_write ( accel5_t *ctx, uint8_t reg, uint8_t *data_buf, uint
 
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ];
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ];
     }
 
     return i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
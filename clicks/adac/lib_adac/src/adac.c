@@ -78,9 +78,9 @@ void adac_generic_write ( adac_t *ctx, uint8_t cmd, uint8_t *data_buf, uint8_t l
     
     tx_buf[ 0 ] = cmd;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );    
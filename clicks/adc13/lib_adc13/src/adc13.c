@@ -213,7 +213,7 @@ err_t adc13_read_registers ( adc13_t *ctx, uint8_t reg, uint8_t *data_out, uint8
 
 err_t adc13_write_registers ( adc13_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t count )
 {
-    uint8_t tx_buf[ ADC13_REG_GPIODAT + 3 ] = { 0 };
+    uint8_t tx_buf[ 2 ] = { 0 };
     
     reg &= ADC13_REG_COUNT_MASK;
     count &= ADC13_REG_COUNT_MASK;
@@ -225,13 +225,9 @@ err_t adc13_write_registers ( adc13_t *ctx, uint8_t reg, uint8_t *data_in, uint8
     tx_buf[ 0 ] = reg | ADC13_CMD_WREG;
     tx_buf[ 1 ] = count - 1;
     
-    for ( uint8_t cnt = 0; cnt < count; cnt++ )
-    {
-        tx_buf[ cnt + 2 ] = data_in[ cnt ];
-    }
-    
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, count + 2 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 2 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, count );
     spi_master_deselect_device( ctx->chip_select );
     
     return error_flag;
@@ -431,9 +431,9 @@ static err_t airflow_i2c_write ( airflow_t *ctx, uint8_t reg, uint8_t *data_in,
 
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ ) 
+    for ( cnt = 0; cnt < len; cnt++ ) 
     {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
+        tx_buf[ cnt + 1 ] = data_in[ cnt ];
     }
 
     return i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
@@ -447,14 +447,6 @@ static err_t airflow_i2c_read ( airflow_t *ctx, uint8_t reg, uint8_t *data_out,
 static err_t airflow_spi_write ( airflow_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
     err_t error_flag = AIRFLOW_OK;
-    uint8_t tx_buf[ 257 ];
-    uint8_t cnt;
-
-    tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ ) 
-    {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
     Delay_10us( );
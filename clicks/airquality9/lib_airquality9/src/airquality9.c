@@ -339,16 +339,13 @@ static err_t airquality9_i2c_read ( airquality9_t *ctx, uint8_t reg, uint8_t *da
 
 static err_t airquality9_spi_write ( airquality9_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len )
 {
-    uint8_t tx_buf[ 257 ] = { 0 };
+    uint8_t tx_buf[ 1 ] = { 0 };
 
     tx_buf[ 0 ] = ( reg << 1 ) & ~SPI_READ_MASK;
-    for ( uint8_t cnt = 0; cnt < len; cnt++ ) 
-    {
-        tx_buf[ cnt + 1 ] = data_in[ cnt ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
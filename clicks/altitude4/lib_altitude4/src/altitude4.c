@@ -82,9 +82,9 @@ void altitude4_generic_write ( altitude4_t *ctx, uint8_t reg, uint8_t *w_buf, ui
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = w_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = w_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );  
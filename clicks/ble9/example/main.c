@@ -4,7 +4,7 @@
  *
  * # Description
  * This example demonstrates the use of BLE 9 Click board by processing
- * the incoming data and displaying them on the USB UART.
+ * the incoming BGAPI events and displaying them on the USB UART.
  *
  * The demo application is composed of two sections :
  *
@@ -12,11 +12,10 @@
  * Initializes the driver and performs the Click default configuration.
  *
  * ## Application Task
- * Reads and processes all incoming data and displays them on the USB UART.
+ * Processes all incoming BGAPI frames and displays the received events on the USB UART.
  *
  * ## Additional Function
- * - static void ble9_clear_app_buf ( void )
- * - static err_t ble9_process ( ble9_t *ctx )
+ * - static void ble9_event_handler ( uint8_t msg_class, uint8_t msg_id, uint8_t *payload, uint16_t len )
  * 
  * <pre>
  * For more information on the chip itself and the firmware on it,
@@ -36,32 +35,19 @@
 #include "ble9.h"
 #include "log.h"
 
-#define PROCESS_BUFFER_SIZE 200
-
 static ble9_t ble9;
 static log_t logger;
 
-static uint8_t app_buf[ PROCESS_BUFFER_SIZE ] = { 0 };
-static int32_t app_buf_len = 0;
-
-/**
- * @brief BLE 9 clearing application buffer.
- * @details This function clears memory of application buffer and reset its length.
- * @note None.
- */
-static void ble9_clear_app_buf ( void );
-
 /**
- * @brief BLE 9 data reading function.
- * @details This function reads data from device and concatenates data to application buffer. 
- * @param[in] ctx : Click context object.
- * See #ble9_t object definition for detailed explanation.
- * @return @li @c  0 - Read some data.
- *         @li @c -1 - Nothing is read.
- * See #err_t definition for detailed explanation.
+ * @brief BLE 9 event handler.
+ * @details This function logs the class, message ID and payload of every received BGAPI event.
+ * @param[in] msg_class : Event class.
+ * @param[in] msg_id : Event message ID.
+ * @param[in] payload : Event payload.
+ * @param[in] len : Payload length.
  * @note None.
  */
-static err_t ble9_process ( ble9_t *ctx );
+static void ble9_event_handler ( uint8_t msg_class, uint8_t msg_id, uint8_t *payload, uint16_t len );
 
 // ------------------------------------------------------ APPLICATION FUNCTIONS
 
@@ -88,11 +74,11 @@ void application_init ( void )
     ble9_cfg_setup( &cfg );
     BLE9_MAP_MIKROBUS( cfg, MIKROBUS_1 );
     ble9_init( &ble9, &cfg );
+    ble9_bgapi_register_handler( &ble9, BLE9_BGAPI_ANY, BLE9_BGAPI_ANY, ble9_event_handler );
     Delay_ms ( 1000 );
     
-    // Clear app buffer
-    ble9_process ( &ble9 );
-    ble9_clear_app_buf( );
+    // Process the boot event
+    ble9_bgapi_process ( &ble9 );
     Delay_ms ( 100 );
     
     if ( BLE9_OK == ble9_sys_get_version ( &ble9 ) )
@@ -122,15 +108,7 @@ void application_init ( void )
 
 void application_task ( void )
 {
-    ble9_process ( &ble9 );
-    if ( app_buf_len > 0 ) 
-    {
-        for ( uint16_t cnt = 0; cnt < app_buf_len; cnt++ )
-        {
-            log_printf( &logger, "%.2X ", ( uint16_t ) app_buf[ cnt ] );
-        }
-        ble9_clear_app_buf( );
-    }
+    ble9_bgapi_process ( &ble9 );
 }
 
 int main ( void ) 
@@ -150,39 +128,14 @@ int main ( void )
     return 0;
 }
 
-static void ble9_clear_app_buf ( void ) 
-{
-    memset( app_buf, 0, app_buf_len );
-    app_buf_len = 0;
-}
-
-static err_t ble9_process ( ble9_t *ctx ) 
+static void ble9_event_handler ( uint8_t msg_class, uint8_t msg_id, uint8_t *payload, uint16_t len )
 {
-    uint8_t rx_buf[ PROCESS_BUFFER_SIZE ] = { 0 };
-    int32_t rx_size = 0;
-    rx_size = ble9_generic_read( ctx, rx_buf, PROCESS_BUFFER_SIZE );
-    if ( rx_size > 0 ) 
+    log_printf( &logger, "Event 0x%.2X 0x%.2X: ", ( uint16_t ) msg_class, ( uint16_t ) msg_id );
+    for ( uint16_t cnt = 0; cnt < len; cnt++ )
     {
-        int32_t buf_cnt = app_buf_len;
-        if ( ( ( app_buf_len + rx_size ) > PROCESS_BUFFER_SIZE ) && ( app_buf_len > 0 ) ) 
-        {
-            buf_cnt = PROCESS_BUFFER_SIZE - ( ( app_buf_len + rx_size ) - PROCESS_BUFFER_SIZE );
-            memmove ( app_buf, &app_buf[ PROCESS_BUFFER_SIZE - buf_cnt ], buf_cnt );
-        }
-        for ( int32_t rx_cnt = 0; rx_cnt < rx_size; rx_cnt++ ) 
-        {
-            if ( rx_buf[ rx_cnt ] ) 
-            {
-                app_buf[ buf_cnt++ ] = rx_buf[ rx_cnt ];
-                if ( app_buf_len < PROCESS_BUFFER_SIZE )
-                {
-                    app_buf_len++;
-                }
-            }
-        }
-        return BLE9_OK;
+        log_printf( &logger, "%.2X ", ( uint16_t ) payload[ cnt ] );
     }
-    return BLE9_ERROR;
+    log_printf( &logger, "\r\n" );
 }
 
 // ------------------------------------------------------------------------ END
@@ -92,7 +92,7 @@ extern "C"{
 #define BLE9_CMD_SYSTEM_HELLO_ID                                0x00010020ul
 #define BLE9_CMD_SYSTEM_DATA_BUFFER_CLEAR_ID                    0x14010020ul
 #define BLE9_CMD_SYSTEM_RESET_ID                                0x01010020ul
-#define BLE9_CMD_SYSTEM_HALT_ID                                 0x2001010Cul
+#define BLE9_CMD_SYSTEM_HALT_ID                                 0x0C010020ul
 #define BLE9_CMD_SYSTEM_SET_TX_POWER_ID                         0x17010020ul
 #define BLE9_CMD_SYSTEM_GET_VERSION_ID                          0x1B010020ul
 #define BLE9_CMD_SYSTEM_SET_SOFT_TIMER_ID                       0x19010020ul
@@ -127,11 +127,35 @@ extern "C"{
 #define BLE9_SYSTEM_RESUME                                      0
 #define BLE9_SYSTEM_HALT                                        1
 
+/**
+ * \defgroup bgapi BGAPI frame layer
+ * \{
+ */
+
+/*!< @brief Frame header: [ type | len_hi ][ len_lo ][ class ][ message id ]. */
+#define BLE9_BGAPI_HEADER_SIZE                                  4
+#define BLE9_BGAPI_TYPE_MASK                                    0x78
+#define BLE9_BGAPI_TYPE_BLUETOOTH                               0x20
+#define BLE9_BGAPI_EVENT_BIT                                    0x80
+#define BLE9_BGAPI_LEN_HI_MASK                                  0x07
+
+/*!< @brief Frames longer than this are delivered truncated. */
+#define BLE9_BGAPI_MAX_PAYLOAD                                  128
+
+/*!< @brief Commands that may be in flight at once and event handler slots. */
+#define BLE9_BGAPI_MAX_PENDING                                  4
+#define BLE9_BGAPI_MAX_HANDLERS                                 4
+
+/*!< @brief Response wait timeout and wildcard class/message ID for handlers. */
+#define BLE9_BGAPI_TIMEOUT_MS                                   1000
+#define BLE9_BGAPI_ANY                                          0xFF
+/** \} */
+
 /**
  * \defgroup driver Driver define
  * \{
  */
-#define DRV_RX_BUFFER_SIZE                                      100
+#define DRV_RX_BUFFER_SIZE                                      256
 #define DRV_TX_BUFFER_SIZE                                      100
 /** \} */
 
@@ -273,6 +297,55 @@ typedef struct
     
 } ble9_timer_t;
 
+/**
+ * @brief BGAPI event handler.
+ * @details Called from #ble9_bgapi_process with the event class, message ID
+ * and payload. The payload is only valid for the duration of the call.
+ */
+typedef void ( *ble9_evt_handler_t ) ( uint8_t msg_class, uint8_t msg_id, uint8_t *payload, uint16_t len );
+
+typedef struct
+{
+    /*!< @brief Class and message ID, #BLE9_BGAPI_ANY matches all. */
+    uint8_t msg_class;
+    uint8_t msg_id;
+    /*!< @brief Handler to call. */
+    ble9_evt_handler_t handler;
+    
+} ble9_bgapi_handler_t;
+
+typedef struct
+{
+    /*!< @brief Slot state: in use, response received and timed out awaiting a late response. */
+    uint8_t used;
+    uint8_t done;
+    uint8_t stale;
+    /*!< @brief Send order, the oldest matching command gets the response. */
+    uint8_t seq;
+    /*!< @brief Class and message ID of the command awaiting a response. */
+    uint8_t msg_class;
+    uint8_t msg_id;
+    /*!< @brief Result code from the response. */
+    uint16_t result;
+    /*!< @brief Caller buffer for the response payload. */
+    uint8_t *rsp_buf;
+    uint16_t rsp_max;
+    uint16_t rsp_len;
+    
+} ble9_bgapi_pending_t;
+
+typedef struct
+{
+    /*!< @brief Header being received and number of frame bytes received so far. */
+    uint8_t hdr[ BLE9_BGAPI_HEADER_SIZE ];
+    uint16_t idx;
+    /*!< @brief Payload length announced in the header. */
+    uint16_t len;
+    /*!< @brief Payload, truncated to #BLE9_BGAPI_MAX_PAYLOAD. */
+    uint8_t payload[ BLE9_BGAPI_MAX_PAYLOAD ];
+    
+} ble9_bgapi_rx_t;
+
 /**
  * @brief Click ctx object definition.
  */
@@ -280,6 +353,12 @@ typedef struct
 {
     uint8_t ble9_adv_handle;
     ble9_version_t ble9_version;
+
+    // BGAPI frame layer
+    ble9_bgapi_rx_t bgapi_rx;
+    ble9_bgapi_pending_t bgapi_pending[ BLE9_BGAPI_MAX_PENDING ];
+    ble9_bgapi_handler_t bgapi_handlers[ BLE9_BGAPI_MAX_HANDLERS ];
+    uint8_t bgapi_seq;
     // Modules
     uart_t uart;
 
@@ -394,7 +473,8 @@ void ble9_sys_set_id_addr ( ble9_t *ctx, uint8_t *address, uint8_t type );
  * which can be a public or random static device address.
  *
  * @param ctx Click object.
- * @param data_buf Array address for storing return values.
+ * @param data_buf Array address for storing return values,
+ * the 6 byte address followed by the address type.
  * @param type Address type.
  *             @b 1 Static device address
  *             @b 0 Public device address
@@ -845,6 +925,83 @@ int32_t ble9_generic_read ( ble9_t *ctx, uint8_t *data_buf, uint16_t max_len );
  */
 void ble9_send_command ( ble9_t *ctx, uint32_t command );
 
+/**
+ * @brief Register a BGAPI event handler.
+ *
+ * @param ctx Click object.
+ * @param msg_class Event class, or #BLE9_BGAPI_ANY.
+ * @param msg_id Event message ID, or #BLE9_BGAPI_ANY.
+ * @param handler Handler to call, NULL removes a previous registration.
+ *
+ * @return err_t
+ *
+ * @description Events are routed to the first matching handler, so register specific
+ * handlers before wildcard ones.
+ */
+err_t ble9_bgapi_register_handler ( ble9_t *ctx, uint8_t msg_class, uint8_t msg_id, ble9_evt_handler_t handler );
+
+/**
+ * @brief Send a BGAPI command without waiting for its response.
+ *
+ * @param ctx Click object.
+ * @param command Command ID, one of the BLE9_CMD_* constants.
+ * @param payload Command parameters.
+ * @param len Number of parameter bytes.
+ * @param rsp_buf Buffer for the response payload ( including the result code ), may be NULL.
+ * @param rsp_max Size of @b rsp_buf.
+ * @param ticket Pending command slot to pass to #ble9_bgapi_wait.
+ *
+ * @return err_t
+ *
+ * @description Several commands may be sent back to back, up to #BLE9_BGAPI_MAX_PENDING.
+ * A response completes the oldest pending command with the same class and message ID.
+ */
+err_t ble9_bgapi_send ( ble9_t *ctx, uint32_t command, uint8_t *payload, uint16_t len,
+                        uint8_t *rsp_buf, uint16_t rsp_max, uint8_t *ticket );
+
+/**
+ * @brief Wait for the response of a pending BGAPI command.
+ *
+ * @param ctx Click object.
+ * @param ticket Slot returned by #ble9_bgapi_send.
+ * @param rsp_len Number of response payload bytes, may be NULL.
+ *
+ * @return @b BLE9_OK if the response arrived with a zero result code, @b BLE9_ERROR otherwise.
+ *
+ * @description Processes incoming frames until the response arrives or
+ * #BLE9_BGAPI_TIMEOUT_MS expires. Events received meanwhile are dispatched.
+ * On timeout the slot stays reserved until the late response is drained, or
+ * until it is reclaimed by #ble9_bgapi_send when no free slot is left.
+ */
+err_t ble9_bgapi_wait ( ble9_t *ctx, uint8_t ticket, uint16_t *rsp_len );
+
+/**
+ * @brief Send a BGAPI command and wait for its response.
+ *
+ * @param ctx Click object.
+ * @param command Command ID, one of the BLE9_CMD_* constants.
+ * @param payload Command parameters.
+ * @param len Number of parameter bytes.
+ * @param rsp_buf Buffer for the response payload ( including the result code ), may be NULL.
+ * @param rsp_max Size of @b rsp_buf.
+ *
+ * @return err_t
+ */
+err_t ble9_bgapi_command ( ble9_t *ctx, uint32_t command, uint8_t *payload, uint16_t len,
+                           uint8_t *rsp_buf, uint16_t rsp_max );
+
+/**
+ * @brief Process received BGAPI frames.
+ *
+ * @param ctx Click object.
+ *
+ * @return @b BLE9_OK if any byte was received, @b BLE9_ERROR otherwise.
+ *
+ * @description Drains the UART RX ring, reassembles frames, completes pending commands
+ * and dispatches events to the registered handlers. Call it regularly from the application loop.
+ */
+err_t ble9_bgapi_process ( ble9_t *ctx );
+
 #ifdef __cplusplus
 }
 #endif
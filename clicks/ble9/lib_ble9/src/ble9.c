@@ -28,27 +28,69 @@
  */
 
 #include "ble9.h"
+#include <string.h>
 
 // ------------------------------------------------ PRIVATE FUNCTION DECLARATIONS
 
 /**
- * @brief Generic BLE9 Click error check function.
- * Reads @b read_n_elements number of elements, places them in
- * @b ret_val_check array if any value is needed( handle for example ),
- * and checks @b check_var_num element for return value.
+ * @brief BGAPI frame write function.
+ * Writes the frame header for @b command with the length of both parameter
+ * parts, followed by the fixed parameters and the variable length data.
  *
  * @param ctx BLE9 Click object.
- * @param read_n_elements Number of elements to read.
- * @param check_char_num Ordinal number of element to check.
- * @param ret_val_check Array address.
- * @return true
- * @return false
+ * @param command Command ID.
+ * @param params Fixed parameters.
+ * @param params_len Number of fixed parameter bytes.
+ * @param data Variable length data, may be NULL.
+ * @param data_len Number of data bytes.
+ */
+static void ble9_bgapi_write_frame ( ble9_t *ctx, uint32_t command, uint8_t *params, uint16_t params_len,
+                                     uint8_t *data, uint16_t data_len );
+
+/**
+ * @brief BGAPI command queue function.
+ * Takes a free pending command slot and writes the frame, see #ble9_bgapi_send.
  *
- * @warning Take into consideration that different functionalities
- * have different return values and different number of bytes.
+ * @param ctx BLE9 Click object.
+ * @param command Command ID.
+ * @param params Fixed parameters.
+ * @param params_len Number of fixed parameter bytes.
+ * @param data Variable length data, may be NULL.
+ * @param data_len Number of data bytes.
+ * @param rsp_buf Buffer for the response payload, may be NULL.
+ * @param rsp_max Size of @b rsp_buf.
+ * @param ticket Pending command slot.
+ * @return err_t
  */
-static uint8_t ble9_generic_err_check ( ble9_t *ctx, uint8_t read_n_elements,
-                                        uint8_t check_char_num, uint8_t *ret_val_check );
+static err_t ble9_bgapi_queue ( ble9_t *ctx, uint32_t command, uint8_t *params, uint16_t params_len,
+                                uint8_t *data, uint16_t data_len, uint8_t *rsp_buf, uint16_t rsp_max, 
+                                uint8_t *ticket );
+
+/**
+ * @brief BGAPI command function with variable length data.
+ * Sends the command and waits for its response, see #ble9_bgapi_command.
+ *
+ * @param ctx BLE9 Click object.
+ * @param command Command ID.
+ * @param params Fixed parameters.
+ * @param params_len Number of fixed parameter bytes.
+ * @param data Variable length data, may be NULL.
+ * @param data_len Number of data bytes.
+ * @param rsp_buf Buffer for the response payload, may be NULL.
+ * @param rsp_max Size of @b rsp_buf.
+ * @return err_t
+ */
+static err_t ble9_bgapi_command_data ( ble9_t *ctx, uint32_t command, uint8_t *params, uint16_t params_len,
+                                       uint8_t *data, uint16_t data_len, uint8_t *rsp_buf, uint16_t rsp_max );
+
+/**
+ * @brief BGAPI frame dispatch function.
+ * Completes the oldest pending command matching a response,
+ * or passes an event to the first matching handler.
+ *
+ * @param ctx BLE9 Click object.
+ */
+static void ble9_bgapi_dispatch ( ble9_t *ctx );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -90,38 +132,36 @@ err_t ble9_init ( ble9_t *ctx, ble9_cfg_t *cfg )
 
     uart_set_blocking( &ctx->uart, cfg->uart_blocking );
 
+    memset( &ctx->bgapi_rx, 0, sizeof ( ctx->bgapi_rx ) );
+    memset( ctx->bgapi_pending, 0, sizeof ( ctx->bgapi_pending ) );
+    memset( ctx->bgapi_handlers, 0, sizeof ( ctx->bgapi_handlers ) );
+    ctx->bgapi_seq = 0;
+
     return BLE9_OK;
 }
 
 err_t ble9_sys_hello ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_HELLO_ID );
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_HELLO_ID, NULL, 0, NULL, 0 );
 }
 
 err_t ble9_sys_get_version ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 22 ] = { 0 };
+    uint8_t rsp[ 18 ] = { 0 };
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_GET_VERSION_ID );
-    Delay_10ms ( );
-    if ( 22 == uart_read ( &ctx->uart, tmp_array, 22 ) ) 
-    {
-        ctx->ble9_version.version_major = ( ( uint16_t ) tmp_array[ 5 ] << 8 ) | tmp_array[ 6 ];
-        ctx->ble9_version.version_minor = ( ( uint16_t ) tmp_array[ 7 ] << 8 ) | tmp_array[ 8 ];
-        ctx->ble9_version.version_patch = ( ( uint16_t ) tmp_array[ 9 ] << 8 ) | tmp_array[ 10 ];
-        ctx->ble9_version.version_build = ( ( uint16_t ) tmp_array[ 11 ] << 8 ) | tmp_array[ 12 ];
-        ctx->ble9_version.version_bootloader = ( ( uint32_t ) tmp_array[ 14 ] << 24 ) | ( ( uint32_t ) tmp_array[ 15 ] << 16 ) | 
-                                               ( ( uint16_t ) tmp_array[ 16 ] << 8 ) | tmp_array[ 17 ];
-        ctx->ble9_version.version_hash = ( ( uint32_t ) tmp_array[ 18 ] << 24 ) | ( ( uint32_t ) tmp_array[ 19 ] << 16 ) | 
-                                         ( ( uint16_t ) tmp_array[ 20 ] << 8 ) | tmp_array[ 21 ];;
-        return BLE9_OK;
-    } 
-    else 
+    if ( BLE9_OK != ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_GET_VERSION_ID, NULL, 0, rsp, sizeof ( rsp ) ) )
     {
         return BLE9_ERROR;
     }
+    ctx->ble9_version.version_major = ( ( uint16_t ) rsp[ 3 ] << 8 ) | rsp[ 2 ];
+    ctx->ble9_version.version_minor = ( ( uint16_t ) rsp[ 5 ] << 8 ) | rsp[ 4 ];
+    ctx->ble9_version.version_patch = ( ( uint16_t ) rsp[ 7 ] << 8 ) | rsp[ 6 ];
+    ctx->ble9_version.version_build = ( ( uint16_t ) rsp[ 9 ] << 8 ) | rsp[ 8 ];
+    ctx->ble9_version.version_bootloader = ( ( uint32_t ) rsp[ 13 ] << 24 ) | ( ( uint32_t ) rsp[ 12 ] << 16 ) | 
+                                           ( ( uint16_t ) rsp[ 11 ] << 8 ) | rsp[ 10 ];
+    ctx->ble9_version.version_hash = ( ( uint32_t ) rsp[ 17 ] << 24 ) | ( ( uint32_t ) rsp[ 16 ] << 16 ) | 
+                                     ( ( uint16_t ) rsp[ 15 ] << 8 ) | rsp[ 14 ];
+    return BLE9_OK;
 }
 
 void ble9_sys_set_id_addr ( ble9_t *ctx, uint8_t *address, uint8_t type ) 
@@ -134,45 +174,37 @@ void ble9_sys_set_id_addr ( ble9_t *ctx, uint8_t *address, uint8_t type )
     }
     ble9_settings[ counter ] = type;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_SET_IDENTITY_ADDRESS_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
+    ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_SET_IDENTITY_ADDRESS_ID, 
+                         ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_sys_get_id_address ( ble9_t *ctx, uint8_t *data_buf, uint8_t type ) 
 {
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_GET_IDENTITY_ADDRESS_ID );
-    ble9_generic_write ( ctx, &type, 1 );
-    Delay_1ms ( );
-    if ( 13 == uart_read ( &ctx->uart, data_buf, 13 ) ) 
-    {
-        return BLE9_OK;
-    } 
-    else 
+    uint8_t rsp[ 9 ] = { 0 };
+
+    if ( BLE9_OK != ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_GET_IDENTITY_ADDRESS_ID, &type, 1, rsp, sizeof ( rsp ) ) )
     {
         return BLE9_ERROR;
     }
+    memcpy ( data_buf, &rsp[ 2 ], 7 );
+    return BLE9_OK;
 }
 
 void ble9_sys_reset ( ble9_t *ctx, ble9_dfu_reset_mode_t reset_mode ) 
 {
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_RESET_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ( uint8_t * ) &reset_mode, 1 );
+    uint8_t mode = ( uint8_t ) reset_mode;
+
+    // No response, the module reports the reboot with a boot event.
+    ble9_bgapi_write_frame ( ctx, BLE9_CMD_SYSTEM_RESET_ID, &mode, 1, NULL, 0 );
 }
 
 err_t ble9_sys_halt ( ble9_t *ctx, uint8_t halt ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
     if ( halt > BLE9_SYSTEM_HALT )
     {
         return BLE9_ERROR;
     }
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_HALT_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, &halt, 1 );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_HALT_ID, &halt, 1, NULL, 0 );
 }
 
 void ble9_sys_set_tx_power ( ble9_t *ctx, int16_t min_power, int16_t max_power ) 
@@ -183,45 +215,33 @@ void ble9_sys_set_tx_power ( ble9_t *ctx, int16_t min_power, int16_t max_power )
     data_buf[ 1 ] = ( uint8_t ) ( ( min_power >> 8 ) & 0xFF );
     data_buf[ 2 ] = ( uint8_t ) ( max_power & 0xFF );
     data_buf[ 3 ] = ( uint8_t ) ( ( max_power >> 8 ) & 0xFF );
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_SET_TX_POWER_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, data_buf, 4 );
+    ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_SET_TX_POWER_ID, data_buf, 4, NULL, 0 );
 }
 
 err_t ble9_sys_data_buf_write ( ble9_t *ctx, uint16_t data_len, uint8_t *wr_data ) 
 {
-    uint8_t tmp_dat = ( uint8_t ) ( ( ( 1 + data_len ) & 0xFF ) << 8 ) + ( ( ( 1 + data_len ) & 0x700 ) >> 8 );
-    uint8_t ble9_settings[ 5 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
+    uint8_t array_len = 0;
 
-    ble9_settings[ 0 ] = tmp_dat;
-    for ( uint8_t counter = 1; counter <= tmp_dat; counter++ ) 
+    // uint8array parameter, one length byte followed by the data.
+    if ( data_len > 0xFF )
     {
-        ble9_settings[ counter ] = ( uint8_t ) ( ( data_len & ( 0xFF << ( ( counter - 1 ) * 8 ) ) ) >> 
-                                                 ( ( counter - 1 ) * 8 ) );
+        return BLE9_ERROR;
     }
+    array_len = ( uint8_t ) data_len;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_WRITE_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, tmp_dat + 1 );
-
-    ble9_generic_write( ctx, wr_data, data_len );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command_data ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_WRITE_ID, 
+                                     &array_len, 1, wr_data, data_len, NULL, 0 );
 }
 
 err_t ble9_sys_data_buf_clear ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_CLEAR_ID );
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_DATA_BUFFER_CLEAR_ID, NULL, 0, NULL, 0 );
 }
 
 err_t ble9_sys_set_soft_timer ( ble9_t  *ctx, ble9_timer_t *ble9_timer ) 
 {
     uint8_t ble9_settings[ 6 ] = { 0 };
     uint8_t counter = 0;
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     for ( counter = 0; counter < 3; counter++ ) 
     {
@@ -233,18 +253,14 @@ err_t ble9_sys_set_soft_timer ( ble9_t  *ctx, ble9_timer_t *ble9_timer )
     ble9_settings[ counter++ ] = ble9_timer->ble9_timer_handle;
     ble9_settings[ counter ]   = ble9_timer->ble9_timer_single_shot;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_SET_SOFT_TIMER_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_SET_SOFT_TIMER_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_sys_set_lazy_soft_timer ( ble9_t *ctx, ble9_timer_t *ble9_timer ) 
 {
     uint8_t ble9_settings[ 10 ] = { 0 };
     uint8_t counter = 0;
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     for ( counter = 0; counter < 4; counter++ ) 
     {
@@ -258,66 +274,47 @@ err_t ble9_sys_set_lazy_soft_timer ( ble9_t *ctx, ble9_timer_t *ble9_timer )
     ble9_settings[ 8 ] = ble9_timer->ble9_timer_handle;
     ble9_settings[ 9 ] = ble9_timer->ble9_timer_single_shot;
 
-    ble9_send_command ( ctx, BLE9_CMD_SYSTEM_SET_LAZY_SOFT_TIMER_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_SYSTEM_SET_LAZY_SOFT_TIMER_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_gap_set_privacy_mode ( ble9_t *ctx, uint8_t privacy, uint8_t interval_in_minutes ) 
 {
     uint8_t ble9_settings[ 2 ] = { privacy, interval_in_minutes };
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_GAP_SET_PRIVACY_MODE_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
 
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_GAP_SET_PRIVACY_MODE_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_gap_en_wlist ( ble9_t *ctx, uint8_t enable ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_GAP_ENABLE_WHITELISTING_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ( uint8_t * ) &enable, 1 );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_GAP_ENABLE_WHITELISTING_ID, &enable, 1, NULL, 0 );
 }
 
 err_t ble9_adv_create_id ( ble9_t *ctx ) 
 {
-    uint8_t status = BLE9_OK;
-    uint8_t tmp_array[ 7 ] = { 0 };
+    uint8_t rsp[ 3 ] = { 0 };
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_CREATE_ID );
-    status = ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 6, tmp_array );
+    if ( BLE9_OK != ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_CREATE_ID, NULL, 0, rsp, sizeof ( rsp ) ) )
+    {
+        return BLE9_ERROR;
+    }
 
     /* Map new handle. */
-    ctx->ble9_adv_handle = tmp_array[ 5 ];
+    ctx->ble9_adv_handle = rsp[ 2 ];
 
-    return status;
+    return BLE9_OK;
 }
 
 err_t ble9_adv_delete_id ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_DELETE_SET_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, &ctx->ble9_adv_handle, 1 );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_DELETE_SET_ID, &ctx->ble9_adv_handle, 1, NULL, 0 );
 }
 
 err_t ble9_adv_set_timing ( ble9_t *ctx, uint16_t interval_min, uint16_t interval_max, 
                             uint16_t duration, uint8_t maxevents ) 
 {
     uint8_t ble9_settings[ 12 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ]  = ctx->ble9_adv_handle;
     ble9_settings[ 1 ]  = interval_min & 0xFF;
@@ -328,209 +325,151 @@ err_t ble9_adv_set_timing ( ble9_t *ctx, uint16_t interval_min, uint16_t interva
     ble9_settings[ 10 ] = ( duration & 0xFF00 ) >> 8;
     ble9_settings[ 11 ] = maxevents;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_TIMING_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_TIMING_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_set_phy ( ble9_t *ctx, ble9_phy_type_t primary_phy, ble9_phy_type_t secondary_phy ) 
 {
     uint8_t ble9_settings[ 3 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = primary_phy;
     ble9_settings[ 2 ] = secondary_phy;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_PHY_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_PHY_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_set_channel_map ( ble9_t *ctx, ble9_channel_t channel_map ) 
 {
     uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = channel_map;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_CHANNEL_MAP_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_CHANNEL_MAP_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_set_tx_power ( ble9_t *ctx, int16_t power, int16_t *set_power ) 
 {
     uint8_t ble9_settings[ 3 ] = { 0 };
-    uint8_t status = BLE9_OK;
-    uint8_t tmp_array[ 8 ] = { 0 };
+    uint8_t rsp[ 4 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = power & 0xFF;
     ble9_settings[ 2 ] = ( power & 0xFF00 ) >> 8;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_TX_POWER_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    status = ble9_generic_err_check( ctx, sizeof ( tmp_array ), 5, tmp_array );
-    *set_power = tmp_array[ 6 ];
+    if ( BLE9_OK != ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_TX_POWER_ID, 
+                                         ble9_settings, sizeof ( ble9_settings ), rsp, sizeof ( rsp ) ) )
+    {
+        return BLE9_ERROR;
+    }
+    *set_power = ( int16_t ) ( ( ( uint16_t ) rsp[ 3 ] << 8 ) | rsp[ 2 ] );
 
-    return status;
+    return BLE9_OK;
 }
 
 err_t ble9_adv_set_report_scan_req ( ble9_t *ctx, uint8_t report_scan_req ) 
 {
     uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = report_scan_req;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_REPORT_SCAN_REQUEST_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_REPORT_SCAN_REQUEST_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_set_configuration ( ble9_t *ctx, uint8_t configurations ) 
 {
     uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = configurations;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_CONFIGURATION_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_CONFIGURATION_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_clear_configuration ( ble9_t *ctx, uint8_t configurations ) 
 {
     uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = configurations;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_CLEAR_CONFIGURATION_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_CLEAR_CONFIGURATION_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_set_data ( ble9_t *ctx, ble9_package_type_t packet_type, 
                           uint16_t adv_data_len, uint8_t *adv_data ) 
 {
-    uint8_t ble9_settings[ 7 ] = { 0 };
-    uint8_t dat_num = 0;
-    uint8_t tmp_array[ 6 ] = { 0 };
+    uint8_t ble9_settings[ 3 ] = { 0 };
 
-    ble9_settings[ 0 ] = ctx->ble9_adv_handle;
-    ble9_settings[ 1 ] = packet_type;
-    for ( uint8_t counter = 5; counter > 1; counter-- ) 
+    // uint8array parameter, one length byte followed by the data.
+    if ( adv_data_len > 0xFF )
     {
-        if ( adv_data_len & ( 0xFF << ( counter - 1) ) ) 
-        {
-            ble9_settings[ counter + 1 ] = ( packet_type & ( 0xFF << ( counter - 1 ) ) ) >> ( counter - 1 );
-            dat_num++;
-        }
+        return BLE9_ERROR;
     }
-    ble9_settings[ 2 ] = dat_num;
-
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_DATA_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, 3 + dat_num );
-    Delay_1ms ( );
-
-    ble9_generic_write ( ctx, adv_data, adv_data_len );
+    ble9_settings[ 0 ] = ctx->ble9_adv_handle;
+    ble9_settings[ 1 ] = packet_type;
+    ble9_settings[ 2 ] = ( uint8_t ) adv_data_len;
 
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command_data ( ctx, BLE9_CMD_ADVERTISER_SET_DATA_ID, ble9_settings, 
+                                     sizeof ( ble9_settings ), adv_data, adv_data_len, NULL, 0 );
 }
 
 err_t ble9_adv_set_long_data ( ble9_t *ctx, ble9_package_type_t packet_type ) 
 {
     uint8_t ble9_settings[ 2 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = packet_type;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_SET_LONG_DATA_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_SET_LONG_DATA_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_start ( ble9_t *ctx, ble9_adv_mode_discoverable_t discover, 
                        ble9_adv_mode_connectable_t connect ) 
 {
     uint8_t ble9_settings[ 3 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
     ble9_settings[ 1 ] = discover;
     ble9_settings[ 2 ] = connect;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_START_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_START_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_stop ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_STOP_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, &ctx->ble9_adv_handle, 1 );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_STOP_ID, &ctx->ble9_adv_handle, 1, NULL, 0 );
 }
 
 err_t ble9_adv_start_per_adv ( ble9_t *ctx, uint16_t interval_min, uint16_t interval_max, uint8_t flags ) 
 {
     uint8_t ble9_settings[ 6 ] = { 0 };
-    uint8_t tmp_array[ 6 ] = { 0 };
 
     ble9_settings[ 0 ] = ctx->ble9_adv_handle;
-    ble9_settings[ 1 ] = ( interval_min & 0xFF00 ) >> 8;
-    ble9_settings[ 2 ] = ( interval_min & 0x00FF );
-    ble9_settings[ 3 ] = ( interval_max & 0xFF00 ) >> 8;
-    ble9_settings[ 4 ] = ( interval_max & 0x00FF );
+    ble9_settings[ 1 ] = interval_min & 0xFF;
+    ble9_settings[ 2 ] = ( interval_min & 0xFF00 ) >> 8;
+    ble9_settings[ 3 ] = interval_max & 0xFF;
+    ble9_settings[ 4 ] = ( interval_max & 0xFF00 ) >> 8;
     ble9_settings[ 5 ] = flags;
 
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_START_PERIODIC_ADVERTISING_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, ble9_settings, sizeof ( ble9_settings ) );
-
-    return ble9_generic_err_check ( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_START_PERIODIC_ADVERTISING_ID, 
+                                ble9_settings, sizeof ( ble9_settings ), NULL, 0 );
 }
 
 err_t ble9_adv_stop_per_adv ( ble9_t *ctx ) 
 {
-    uint8_t tmp_array[ 6 ] = { 0 };
-
-    ble9_send_command ( ctx, BLE9_CMD_ADVERTISER_STOP_PERIODIC_ADVERTISING_ID );
-    Delay_1ms ( );
-    ble9_generic_write ( ctx, &ctx->ble9_adv_handle, 1 );
-
-    return ble9_generic_err_check( ctx, sizeof ( tmp_array ), 4, tmp_array );
+    return ble9_bgapi_command ( ctx, BLE9_CMD_ADVERTISER_STOP_PERIODIC_ADVERTISING_ID, 
+                                &ctx->ble9_adv_handle, 1, NULL, 0 );
 }
 
 // -----------------------------------------------------------------------------
@@ -558,24 +497,274 @@ void ble9_send_command ( ble9_t *ctx, uint32_t command )
 }
 
 // -----------------------------------------------------------------------------
-// STATIC FUNCTIONS
+// BGAPI FRAME LAYER
 // -----------------------------------------------------------------------------
 
-static uint8_t ble9_generic_err_check ( ble9_t *ctx, uint8_t read_n_elements,
-                                        uint8_t check_char_num, uint8_t *ret_val_check ) 
+err_t ble9_bgapi_register_handler ( ble9_t *ctx, uint8_t msg_class, uint8_t msg_id, ble9_evt_handler_t handler )
 {
-    uint8_t temp_array[ 22 ] = { 0 };
-    uart_read ( &ctx->uart, temp_array, read_n_elements );
+    uint8_t free_slot = BLE9_BGAPI_MAX_HANDLERS;
 
-    if ( BLE9_OK == temp_array[ check_char_num ] ) 
+    for ( uint8_t cnt = 0; cnt < BLE9_BGAPI_MAX_HANDLERS; cnt++ )
+    {
+        ble9_bgapi_handler_t *entry = &ctx->bgapi_handlers[ cnt ];
+        if ( ( NULL != entry->handler ) && ( entry->msg_class == msg_class ) && ( entry->msg_id == msg_id ) )
+        {
+            entry->handler = handler;
+            return BLE9_OK;
+        }
+        if ( ( NULL == entry->handler ) && ( BLE9_BGAPI_MAX_HANDLERS == free_slot ) )
+        {
+            free_slot = cnt;
+        }
+    }
+    if ( NULL == handler )
     {
-        memcpy ( ret_val_check, temp_array, read_n_elements );
         return BLE9_OK;
-    } 
-    else 
+    }
+    if ( BLE9_BGAPI_MAX_HANDLERS == free_slot )
     {
         return BLE9_ERROR;
     }
+    ctx->bgapi_handlers[ free_slot ].msg_class = msg_class;
+    ctx->bgapi_handlers[ free_slot ].msg_id = msg_id;
+    ctx->bgapi_handlers[ free_slot ].handler = handler;
+    return BLE9_OK;
+}
+
+err_t ble9_bgapi_send ( ble9_t *ctx, uint32_t command, uint8_t *payload, uint16_t len,
+                        uint8_t *rsp_buf, uint16_t rsp_max, uint8_t *ticket )
+{
+    return ble9_bgapi_queue ( ctx, command, payload, len, NULL, 0, rsp_buf, rsp_max, ticket );
+}
+
+err_t ble9_bgapi_wait ( ble9_t *ctx, uint8_t ticket, uint16_t *rsp_len )
+{
+    ble9_bgapi_pending_t *slot = NULL;
+    uint16_t timeout_cnt = 0;
+    err_t error_flag = BLE9_ERROR;
+
+    if ( ( ticket >= BLE9_BGAPI_MAX_PENDING ) || !ctx->bgapi_pending[ ticket ].used || 
+         ctx->bgapi_pending[ ticket ].stale )
+    {
+        return BLE9_ERROR;
+    }
+    slot = &ctx->bgapi_pending[ ticket ];
+    for ( ; ; )
+    {
+        ble9_bgapi_process ( ctx );
+        if ( slot->done || ( ++timeout_cnt > BLE9_BGAPI_TIMEOUT_MS ) )
+        {
+            break;
+        }
+        Delay_1ms ( );
+    }
+    if ( slot->done )
+    {
+        if ( NULL != rsp_len )
+        {
+            *rsp_len = slot->rsp_len;
+        }
+        if ( 0 == slot->result )
+        {
+            error_flag = BLE9_OK;
+        }
+        slot->used = 0;
+    }
+    else
+    {
+        // Keep the slot until the late response is drained so it cannot complete a newer command.
+        slot->stale = 1;
+        slot->rsp_buf = NULL;
+    }
+    return error_flag;
+}
+
+err_t ble9_bgapi_command ( ble9_t *ctx, uint32_t command, uint8_t *payload, uint16_t len,
+                           uint8_t *rsp_buf, uint16_t rsp_max )
+{
+    return ble9_bgapi_command_data ( ctx, command, payload, len, NULL, 0, rsp_buf, rsp_max );
+}
+
+err_t ble9_bgapi_process ( ble9_t *ctx )
+{
+    ble9_bgapi_rx_t *rx = &ctx->bgapi_rx;
+    uint8_t rx_buf[ 32 ] = { 0 };
+    int32_t rx_size = 0;
+    err_t error_flag = BLE9_ERROR;
+
+    while ( ( rx_size = uart_read ( &ctx->uart, rx_buf, sizeof ( rx_buf ) ) ) > 0 )
+    {
+        error_flag = BLE9_OK;
+        for ( int32_t cnt = 0; cnt < rx_size; cnt++ )
+        {
+            uint8_t rx_byte = rx_buf[ cnt ];
+            if ( rx->idx < BLE9_BGAPI_HEADER_SIZE )
+            {
+                // Resynchronize on the first byte that looks like a Bluetooth frame type.
+                if ( ( 0 == rx->idx ) && ( BLE9_BGAPI_TYPE_BLUETOOTH != ( rx_byte & BLE9_BGAPI_TYPE_MASK ) ) )
+                {
+                    continue;
+                }
+                rx->hdr[ rx->idx++ ] = rx_byte;
+                if ( BLE9_BGAPI_HEADER_SIZE == rx->idx )
+                {
+                    rx->len = ( ( uint16_t ) ( rx->hdr[ 0 ] & BLE9_BGAPI_LEN_HI_MASK ) << 8 ) | rx->hdr[ 1 ];
+                }
+            }
+            else
+            {
+                uint16_t pl_idx = rx->idx - BLE9_BGAPI_HEADER_SIZE;
+                if ( pl_idx < BLE9_BGAPI_MAX_PAYLOAD )
+                {
+                    rx->payload[ pl_idx ] = rx_byte;
+                }
+                rx->idx++;
+            }
+            if ( ( rx->idx >= BLE9_BGAPI_HEADER_SIZE ) && ( ( rx->idx - BLE9_BGAPI_HEADER_SIZE ) == rx->len ) )
+            {
+                ble9_bgapi_dispatch ( ctx );
+                rx->idx = 0;
+            }
+        }
+    }
+    return error_flag;
+}
+
+// -----------------------------------------------------------------------------
+// STATIC FUNCTIONS
+// -----------------------------------------------------------------------------
+
+static void ble9_bgapi_write_frame ( ble9_t *ctx, uint32_t command, uint8_t *params, uint16_t params_len,
+                                     uint8_t *data, uint16_t data_len )
+{
+    uint8_t header[ BLE9_BGAPI_HEADER_SIZE ] = { 0 };
+    uint16_t len = params_len + data_len;
+
+    // Command IDs carry the class and message ID, the length is filled in here.
+    header[ 0 ] = ( uint8_t ) ( command & ~BLE9_BGAPI_LEN_HI_MASK & 0xFF ) | ( ( len >> 8 ) & BLE9_BGAPI_LEN_HI_MASK );
+    header[ 1 ] = ( uint8_t ) ( len & 0xFF );
+    header[ 2 ] = ( uint8_t ) ( ( command >> 16 ) & 0xFF );
+    header[ 3 ] = ( uint8_t ) ( ( command >> 24 ) & 0xFF );
+
+    ble9_generic_write ( ctx, header, BLE9_BGAPI_HEADER_SIZE );
+    if ( ( NULL != params ) && ( params_len > 0 ) )
+    {
+        ble9_generic_write ( ctx, params, params_len );
+    }
+    if ( ( NULL != data ) && ( data_len > 0 ) )
+    {
+        ble9_generic_write ( ctx, data, data_len );
+    }
+}
+
+static err_t ble9_bgapi_queue ( ble9_t *ctx, uint32_t command, uint8_t *params, uint16_t params_len,
+                                uint8_t *data, uint16_t data_len, uint8_t *rsp_buf, uint16_t rsp_max, 
+                                uint8_t *ticket )
+{
+    ble9_bgapi_pending_t *slot = NULL;
+
+    for ( uint8_t cnt = 0; cnt < BLE9_BGAPI_MAX_PENDING; cnt++ )
+    {
+        ble9_bgapi_pending_t *entry = &ctx->bgapi_pending[ cnt ];
+        if ( !entry->used )
+        {
+            slot = entry;
+            break;
+        }
+        // With no free slot left, reclaim the oldest timed out one whose response never came.
+        if ( entry->stale && ( ( NULL == slot ) || ( ( int8_t ) ( entry->seq - slot->seq ) < 0 ) ) )
+        {
+            slot = entry;
+        }
+    }
+    if ( NULL == slot )
+    {
+        return BLE9_ERROR;
+    }
+    slot->used = 1;
+    slot->done = 0;
+    slot->stale = 0;
+    slot->seq = ctx->bgapi_seq++;
+    slot->msg_class = ( uint8_t ) ( ( command >> 16 ) & 0xFF );
+    slot->msg_id = ( uint8_t ) ( ( command >> 24 ) & 0xFF );
+    slot->result = 0;
+    slot->rsp_buf = rsp_buf;
+    slot->rsp_max = rsp_max;
+    slot->rsp_len = 0;
+    *ticket = ( uint8_t ) ( slot - ctx->bgapi_pending );
+    ble9_bgapi_write_frame ( ctx, command, params, params_len, data, data_len );
+    return BLE9_OK;
+}
+
+static err_t ble9_bgapi_command_data ( ble9_t *ctx, uint32_t command, uint8_t *params, uint16_t params_len,
+                                       uint8_t *data, uint16_t data_len, uint8_t *rsp_buf, uint16_t rsp_max )
+{
+    uint8_t ticket = 0;
+
+    if ( BLE9_OK != ble9_bgapi_queue ( ctx, command, params, params_len, data, data_len, 
+                                       rsp_buf, rsp_max, &ticket ) )
+    {
+        return BLE9_ERROR;
+    }
+    return ble9_bgapi_wait ( ctx, ticket, NULL );
+}
+
+static void ble9_bgapi_dispatch ( ble9_t *ctx )
+{
+    ble9_bgapi_rx_t *rx = &ctx->bgapi_rx;
+    uint8_t msg_class = rx->hdr[ 2 ];
+    uint8_t msg_id = rx->hdr[ 3 ];
+    uint16_t len = rx->len;
+    ble9_bgapi_pending_t *slot = NULL;
+
+    if ( len > BLE9_BGAPI_MAX_PAYLOAD )
+    {
+        len = BLE9_BGAPI_MAX_PAYLOAD;
+    }
+    if ( rx->hdr[ 0 ] & BLE9_BGAPI_EVENT_BIT )
+    {
+        for ( uint8_t cnt = 0; cnt < BLE9_BGAPI_MAX_HANDLERS; cnt++ )
+        {
+            ble9_bgapi_handler_t *entry = &ctx->bgapi_handlers[ cnt ];
+            if ( ( NULL != entry->handler ) && 
+                 ( ( BLE9_BGAPI_ANY == entry->msg_class ) || ( msg_class == entry->msg_class ) ) && 
+                 ( ( BLE9_BGAPI_ANY == entry->msg_id ) || ( msg_id == entry->msg_id ) ) )
+            {
+                entry->handler ( msg_class, msg_id, rx->payload, len );
+                return;
+            }
+        }
+        return;
+    }
+    // Responses arrive in command order, complete the oldest matching pending command.
+    for ( uint8_t cnt = 0; cnt < BLE9_BGAPI_MAX_PENDING; cnt++ )
+    {
+        ble9_bgapi_pending_t *entry = &ctx->bgapi_pending[ cnt ];
+        if ( entry->used && !entry->done && ( entry->msg_class == msg_class ) && ( entry->msg_id == msg_id ) && 
+             ( ( NULL == slot ) || ( ( int8_t ) ( entry->seq - slot->seq ) < 0 ) ) )
+        {
+            slot = entry;
+        }
+    }
+    if ( ( NULL != slot ) && slot->stale )
+    {
+        slot->stale = 0;
+        slot->used = 0;
+    }
+    else if ( NULL != slot )
+    {
+        slot->result = 0;
+        if ( len >= 2 )
+        {
+            slot->result = ( ( uint16_t ) rx->payload[ 1 ] << 8 ) | rx->payload[ 0 ];
+        }
+        slot->rsp_len = ( len < slot->rsp_max ) ? len : slot->rsp_max;
+        if ( ( NULL != slot->rsp_buf ) && ( slot->rsp_len > 0 ) )
+        {
+            memcpy ( slot->rsp_buf, rx->payload, slot->rsp_len );
+        }
+        slot->done = 1;
+    }
 }
 
 // ------------------------------------------------------------------------- END
@@ -189,8 +189,6 @@ void captouch2_write_reg ( captouch2_t *ctx, uint8_t reg_addr, uint8_t tx_data )
 void captouch2_read_reg( captouch2_t *ctx, uint8_t reg_addr, uint8_t *rx_data, uint8_t n_bytes )
 {
     uint8_t data_buf[ 5 ];
-    uint8_t rsp_data[ 256 ];
-    uint8_t cnt;
 
     data_buf[ 0 ] = 0x7A;
     data_buf[ 1 ] = 0x7A;
@@ -200,14 +198,9 @@ void captouch2_read_reg( captouch2_t *ctx, uint8_t reg_addr, uint8_t *rx_data, u
 
     spi_master_select_device( ctx->chip_select );
     Delay_1ms();
-    spi_master_write_then_read( &ctx->spi, data_buf, 5, rsp_data, n_bytes );
+    spi_master_write_then_read( &ctx->spi, data_buf, 5, rx_data, n_bytes );
     spi_master_deselect_device( ctx->chip_select );  
 
-    for ( cnt = 0; cnt < n_bytes; cnt++ )
-    {
-        rx_data[ cnt ] = rsp_data[ cnt ];
-    }
-
     Delay_1ms();
 }
 
@@ -120,8 +120,8 @@ err_t charger11_i2c_write ( charger11_t *ctx, uint8_t reg, uint8_t *data_in, uin
 
     tx_buf[ 0 ] = reg;
 
-    for ( uint8_t cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
+    for ( uint8_t cnt = 0; cnt < len; cnt++ ) {
+        tx_buf[ cnt + 1 ] = data_in[ cnt ];
     }
 
     return i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
@@ -132,15 +132,13 @@ err_t charger11_i2c_read ( charger11_t *ctx, uint8_t reg, uint8_t *data_out, uin
 }
 
 err_t charger11_spi_write ( charger11_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) {
-    uint8_t tx_buf[ 257 ] = { 0 };
+    uint8_t tx_buf[ 1 ] = { 0 };
 
     tx_buf[ 0 ] = reg;
-    for ( uint8_t cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
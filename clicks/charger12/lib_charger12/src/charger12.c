@@ -95,19 +95,11 @@ CHARGER12_RETVAL charger12_init ( charger12_t *ctx, charger12_cfg_t *cfg )
 
 void charger12_generic_transfer ( charger12_t *ctx, uint8_t *data_in, uint8_t *data_out, uint8_t tx_len, uint8_t rx_len )
 {        
-    uint8_t r_buf[ 256 ]; 
-    uint8_t i;
-
     Delay_10ms( );
     spi_master_select_device( ctx->chip_select );
     Delay_1us( );
-    spi_master_write_then_read( &ctx->spi, data_in, tx_len, r_buf, rx_len );
+    spi_master_write_then_read( &ctx->spi, data_in, tx_len, data_out, rx_len );
     spi_master_deselect_device( ctx->chip_select );  
-
-    for ( i = 0; i < rx_len; i++ )
-    {
-      data_out[ i ] = r_buf[ i ];
-    }
 }
 
 uint8_t charger12_int_get ( charger12_t *ctx )
@@ -91,6 +91,8 @@
 #define COMPASS2_RETVAL  uint8_t
 
 #define COMPASS2_OK           0x00
+#define COMPASS2_NO_DATA      0x01
+#define COMPASS2_OVERFLOW     0x02
 #define COMPASS2_INIT_ERROR   0xFF
 /** \} */
 
@@ -135,6 +137,21 @@
 #define COMPASS2_X_AXIS                0x00
 #define COMPASS2_Y_AXIS                0x01
 #define COMPASS2_Z_AXIS                0x02
+
+#define COMPASS2_ST1_DRDY              0x01
+#define COMPASS2_ST1_DOR               0x02
+#define COMPASS2_ST2_HOFL              0x08
+/** \} */
+
+/**
+ * \defgroup field Field conversion and calibration
+ * \{
+ */
+#define COMPASS2_LSB_NT_14BIT          600
+#define COMPASS2_LSB_NT_16BIT          150
+#define COMPASS2_CALIB_SCALE_SHIFT     12
+#define COMPASS2_CALIB_SCALE_MIN       2048
+#define COMPASS2_CALIB_SCALE_MAX       8192
 /** \} */
 
 /** \} */ // End group macro 
@@ -183,6 +200,11 @@ typedef struct compass2_s
 
    uint16_t output_resolution;
 
+   // Continuous measurement state 
+
+   uint8_t asa[ 3 ];
+   uint8_t drdy_gate;
+
 } compass2_t;
 
 /**
@@ -217,6 +239,34 @@ typedef struct
 
 } compass2_cfg_t;
 
+/**
+ * @brief Magnetic field sample, sensitivity adjusted, in nT.
+ */
+typedef struct
+{
+    int32_t x;
+    int32_t y;
+    int32_t z;
+    uint8_t overrun;
+
+} compass2_field_t;
+
+/**
+ * @brief Hard and soft iron calibration.
+ *
+ * @description Running extremes of every axis give the hard iron offset and an 
+ * axis aligned ellipsoid, scaled back to a sphere with Q12 factors.
+ */
+typedef struct
+{
+    int32_t min[ 3 ];
+    int32_t max[ 3 ];
+    int32_t offset[ 3 ];
+    int32_t scale[ 3 ];
+    uint32_t samples;
+
+} compass2_calib_t;
+
 /** \} */ // End variable group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 /**
@@ -419,6 +469,77 @@ int16_t compass2_get_axis_data ( compass2_t *ctx, uint8_t axis );
  */
 void compass2_new_measurement ( compass2_t *ctx ); 
 
+/**
+ * @brief Continuous measurement start function.
+ *
+ * @param ctx       Click object.
+ * @param res       Output resolution, COMPASS2_SET_RESOLUTION_14bit or COMPASS2_SET_RESOLUTION_16bit.
+ *
+ * @description This function caches the sensitivity adjustment from fuse ROM once 
+ * and starts continuous measurement mode 2 ( 100 Hz ).
+ */
+void compass2_stream_start ( compass2_t *ctx, uint8_t res );
+
+/**
+ * @brief Read field function.
+ *
+ * @param ctx       Click object.
+ * @param field     Output field in nT.
+ *
+ * @return COMPASS2_OK, COMPASS2_NO_DATA when no new sample is ready, 
+ * COMPASS2_OVERFLOW when the sensor saturated.
+ *
+ * @description This function reads ST1 through ST2 in one burst, reading ST2 
+ * releases the data latch for the next sample. With the INT pin connected the 
+ * bus is only touched once DRDY is high.
+ */
+COMPASS2_RETVAL compass2_read_field ( compass2_t *ctx, compass2_field_t *field );
+
+/**
+ * @brief Calibration reset function.
+ *
+ * @param calib     Calibration object.
+ *
+ * @description This function clears collected extremes, the calibration then passes data through.
+ */
+void compass2_calib_reset ( compass2_calib_t *calib );
+
+/**
+ * @brief Calibration update function.
+ *
+ * @param calib     Calibration object.
+ * @param field     Raw field sample.
+ *
+ * @description This function adds a sample to the calibration, rotate the device 
+ * through all orientations while feeding it.
+ */
+void compass2_calib_update ( compass2_calib_t *calib, compass2_field_t *field );
+
+/**
+ * @brief Calibration apply function.
+ *
+ * @param calib     Calibration object.
+ * @param field     Field sample, corrected in place.
+ */
+void compass2_calib_apply ( compass2_calib_t *calib, compass2_field_t *field );
+
+/**
+ * @brief Tilt compensated heading function.
+ *
+ * @param field     Calibrated field sample.
+ * @param acc_x     Accelerometer X axis, any scale.
+ * @param acc_y     Accelerometer Y axis, any scale.
+ * @param acc_z     Accelerometer Z axis, any scale.
+ *
+ * @return Heading of the X axis from magnetic north in hundredths of a degree, 0 to 35999.
+ *
+ * @description This function projects the field on the horizontal plane given by 
+ * gravity using cross products, one square root and a polynomial arctangent.
+ * @note Accelerometer axes must be aligned with the magnetometer axes and read 
+ * positive on the axis pointing up.
+ */
+uint16_t compass2_get_heading ( compass2_field_t *field, int16_t acc_x, int16_t acc_y, int16_t acc_z );
+
 #ifdef __cplusplus
 }
 #endif
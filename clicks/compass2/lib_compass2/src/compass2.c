@@ -28,11 +28,14 @@
  */
 
 #include "compass2.h"
+#include "math.h"
 
 // ------------------------------------------------------------- PRIVATE MACROS 
 
 #define COMPASS2_DUMMY 0
 
+#define COMPASS2_PI    3.14159265
+
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
 static void compass2_i2c_write ( compass2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len );
@@ -43,6 +46,10 @@ static void compass2_spi_write ( compass2_t *ctx, uint8_t reg, uint8_t *data_buf
 
 static void compass2_spi_read ( compass2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len );
 
+static int32_t compass2_adjust ( int16_t raw, uint8_t asa, int32_t lsb_nt );
+
+static float compass2_atan2 ( float y, float x );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void compass2_cfg_setup ( compass2_cfg_t *cfg )
@@ -136,6 +143,12 @@ COMPASS2_RETVAL compass2_init ( compass2_t *ctx, compass2_cfg_t *cfg )
     // Input pins
 
     digital_in_init( &ctx->int_pin, cfg->int_pin );
+    ctx->drdy_gate = ( cfg->int_pin != HAL_PIN_NC );
+
+    // Neutral adjustment until the fuse ROM is read.
+    ctx->asa[ 0 ] = 128;
+    ctx->asa[ 1 ] = 128;
+    ctx->asa[ 2 ] = 128;
 
     return COMPASS2_OK;
 }
@@ -270,30 +283,14 @@ void compass2_set_mode ( compass2_t *ctx, uint8_t mode )
 
 void compass2_get_all_data ( compass2_t *ctx, int16_t *x, int16_t *y, int16_t *z ) 
 {
-    uint8_t lsb  = 0;
-    uint8_t msb  = 0;
-    int16_t axis_data;
+    uint8_t rx_buf[ 7 ];
 
-    lsb = compass2_read_byte( ctx, COMPASS2_REG_AXIS_X_LOW );
-    msb = compass2_read_byte( ctx, COMPASS2_REG_AXIS_X_HIGH );
-    axis_data = msb;
-    axis_data <<= 8;
-    axis_data |= lsb;
-    *x = axis_data;
-    
-    lsb = compass2_read_byte( ctx, COMPASS2_REG_AXIS_Y_LOW );
-    msb = compass2_read_byte( ctx, COMPASS2_REG_AXIS_Y_HIGH );
-    axis_data = msb;
-    axis_data <<= 8;
-    axis_data |= lsb;
-    *y = axis_data;
+    // ST2 is read along to release the data latch.
+    compass2_generic_read( ctx, COMPASS2_REG_AXIS_X_LOW, rx_buf, 7 );
 
-    lsb = compass2_read_byte( ctx, COMPASS2_REG_AXIS_Z_LOW );
-    msb = compass2_read_byte( ctx, COMPASS2_REG_AXIS_Z_HIGH );
-    axis_data = msb;
-    axis_data <<= 8;
-    axis_data |= lsb;
-    *z = axis_data;
+    *x = ( int16_t ) ( ( ( uint16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ] );
+    *y = ( int16_t ) ( ( ( uint16_t ) rx_buf[ 3 ] << 8 ) | rx_buf[ 2 ] );
+    *z = ( int16_t ) ( ( ( uint16_t ) rx_buf[ 5 ] << 8 ) | rx_buf[ 4 ] );
 }
 
 int16_t compass2_get_axis_data ( compass2_t *ctx, uint8_t axis ) 
@@ -340,8 +337,236 @@ void compass2_new_measurement ( compass2_t *ctx )
     compass2_set_mode( ctx, COMPASS2_MODE_CONT_MEAS_2 );
 }
 
+void compass2_stream_start ( compass2_t *ctx, uint8_t res )
+{
+    compass2_write_byte( ctx, COMPASS2_REG_CNTRL1, COMPASS2_MODE_POWER_DOWN );
+    Delay_1ms( );
+    compass2_write_byte( ctx, COMPASS2_REG_CNTRL1, COMPASS2_MODE_FUSE_ROM );
+    Delay_1ms( );
+    compass2_generic_read( ctx, COMPASS2_REG_X_AXIS_SENS, ctx->asa, 3 );
+    compass2_write_byte( ctx, COMPASS2_REG_CNTRL1, COMPASS2_MODE_POWER_DOWN );
+    Delay_1ms( );
+
+    ctx->output_resolution = ( res & COMPASS2_SET_RESOLUTION_16bit ) | COMPASS2_MODE_CONT_MEAS_2;
+    compass2_write_byte( ctx, COMPASS2_REG_CNTRL1, ctx->output_resolution );
+}
+
+COMPASS2_RETVAL compass2_read_field ( compass2_t *ctx, compass2_field_t *field )
+{
+    uint8_t rx_buf[ 8 ];
+    int32_t lsb_nt;
+
+    if ( ctx->drdy_gate && ( 0 == digital_in_read( &ctx->int_pin ) ) )
+    {
+        return COMPASS2_NO_DATA;
+    }
+
+    // ST1, HXL..HZH and ST2 in one transfer.
+    compass2_generic_read( ctx, COMPASS2_REG_STATUS_1, rx_buf, 8 );
+    if ( 0 == ( rx_buf[ 0 ] & COMPASS2_ST1_DRDY ) )
+    {
+        return COMPASS2_NO_DATA;
+    }
+    if ( rx_buf[ 7 ] & COMPASS2_ST2_HOFL )
+    {
+        return COMPASS2_OVERFLOW;
+    }
+
+    if ( ctx->output_resolution & COMPASS2_SET_RESOLUTION_16bit )
+    {
+        lsb_nt = COMPASS2_LSB_NT_16BIT;
+    }
+    else
+    {
+        lsb_nt = COMPASS2_LSB_NT_14BIT;
+    }
+    field->x = compass2_adjust( ( int16_t ) ( ( ( uint16_t ) rx_buf[ 2 ] << 8 ) | rx_buf[ 1 ] ), ctx->asa[ 0 ], lsb_nt );
+    field->y = compass2_adjust( ( int16_t ) ( ( ( uint16_t ) rx_buf[ 4 ] << 8 ) | rx_buf[ 3 ] ), ctx->asa[ 1 ], lsb_nt );
+    field->z = compass2_adjust( ( int16_t ) ( ( ( uint16_t ) rx_buf[ 6 ] << 8 ) | rx_buf[ 5 ] ), ctx->asa[ 2 ], lsb_nt );
+    field->overrun = ( rx_buf[ 0 ] & COMPASS2_ST1_DOR ) != 0;
+
+    return COMPASS2_OK;
+}
+
+void compass2_calib_reset ( compass2_calib_t *calib )
+{
+    uint8_t axis;
+
+    for ( axis = 0; axis < 3; axis++ )
+    {
+        calib->min[ axis ] = 0x7FFFFFFF;
+        calib->max[ axis ] = -0x7FFFFFFF;
+        calib->offset[ axis ] = 0;
+        calib->scale[ axis ] = 1l << COMPASS2_CALIB_SCALE_SHIFT;
+    }
+    calib->samples = 0;
+}
+
+void compass2_calib_update ( compass2_calib_t *calib, compass2_field_t *field )
+{
+    int32_t sample[ 3 ];
+    int32_t radius[ 3 ];
+    int32_t avg_radius;
+    int32_t num;
+    int32_t den;
+    int32_t scale;
+    uint8_t axis;
+
+    sample[ 0 ] = field->x;
+    sample[ 1 ] = field->y;
+    sample[ 2 ] = field->z;
+
+    for ( axis = 0; axis < 3; axis++ )
+    {
+        if ( sample[ axis ] < calib->min[ axis ] )
+        {
+            calib->min[ axis ] = sample[ axis ];
+        }
+        if ( sample[ axis ] > calib->max[ axis ] )
+        {
+            calib->max[ axis ] = sample[ axis ];
+        }
+        calib->offset[ axis ] = calib->min[ axis ] / 2 + calib->max[ axis ] / 2;
+        radius[ axis ] = calib->max[ axis ] / 2 - calib->min[ axis ] / 2;
+    }
+    calib->samples++;
+
+    // Stretch every semi axis to the mean radius, limited to 0.5 - 2 until the extremes settle.
+    avg_radius = ( radius[ 0 ] + radius[ 1 ] + radius[ 2 ] ) / 3;
+    for ( axis = 0; axis < 3; axis++ )
+    {
+        if ( radius[ axis ] <= 0 )
+        {
+            continue;
+        }
+        // Drop precision only for fields far above the geomagnetic range to stay within 32 bits.
+        num = avg_radius;
+        den = radius[ axis ];
+        while ( ( num >= ( 1l << 19 ) ) || ( den >= ( 1l << 19 ) ) )
+        {
+            num >>= 1;
+            den >>= 1;
+        }
+        if ( den <= 0 )
+        {
+            continue;
+        }
+        scale = ( num << COMPASS2_CALIB_SCALE_SHIFT ) / den;
+        if ( scale < COMPASS2_CALIB_SCALE_MIN )
+        {
+            scale = COMPASS2_CALIB_SCALE_MIN;
+        }
+        else if ( scale > COMPASS2_CALIB_SCALE_MAX )
+        {
+            scale = COMPASS2_CALIB_SCALE_MAX;
+        }
+        calib->scale[ axis ] = scale;
+    }
+}
+
+void compass2_calib_apply ( compass2_calib_t *calib, compass2_field_t *field )
+{
+    int32_t *sample[ 3 ];
+    int32_t value;
+    uint8_t axis;
+
+    sample[ 0 ] = &field->x;
+    sample[ 1 ] = &field->y;
+    sample[ 2 ] = &field->z;
+
+    for ( axis = 0; axis < 3; axis++ )
+    {
+        value = *sample[ axis ] - calib->offset[ axis ];
+        // Split multiply keeps the full sensor range within 32 bits.
+        *sample[ axis ] = ( value >> COMPASS2_CALIB_SCALE_SHIFT ) * calib->scale[ axis ] + 
+                          ( ( value & ( ( 1l << COMPASS2_CALIB_SCALE_SHIFT ) - 1 ) ) * calib->scale[ axis ] >> 
+                            COMPASS2_CALIB_SCALE_SHIFT );
+    }
+}
+
+uint16_t compass2_get_heading ( compass2_field_t *field, int16_t acc_x, int16_t acc_y, int16_t acc_z )
+{
+    float mx = field->x;
+    float my = field->y;
+    float mz = field->z;
+    float dx = -acc_x;
+    float dy = -acc_y;
+    float dz = -acc_z;
+    float ey;
+    float ez;
+    float east_x;
+    float north_x;
+    float heading;
+
+    // East = Down x Field, North = East x Down, heading is the X axis in that frame.
+    // North carries an extra |Down| factor, East is scaled to match.
+    east_x = dy * mz - dz * my;
+    ey = dz * mx - dx * mz;
+    ez = dx * my - dy * mx;
+    north_x = ey * dz - ez * dy;
+    east_x *= sqrt( dx * dx + dy * dy + dz * dz );
+
+    heading = compass2_atan2( east_x, north_x ) * ( 18000.0 / COMPASS2_PI );
+    if ( heading < 0 )
+    {
+        heading += 36000.0;
+    }
+    if ( heading >= 35999.5 )
+    {
+        return 0;
+    }
+    return ( uint16_t ) ( heading + 0.5 );
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
+static int32_t compass2_adjust ( int16_t raw, uint8_t asa, int32_t lsb_nt )
+{
+    // Hadj = H * ( ASA + 128 ) / 256, rounded toward zero before scaling to nT.
+    return ( ( ( int32_t ) raw * ( asa + 128 ) ) / 256 ) * lsb_nt;
+}
+
+static float compass2_atan2 ( float y, float x )
+{
+    float abs_x = ( x < 0 ) ? -x : x;
+    float abs_y = ( y < 0 ) ? -y : y;
+    float ratio;
+    float ratio_sq;
+    float angle;
+
+    if ( ( 0 == abs_x ) && ( 0 == abs_y ) )
+    {
+        return 0;
+    }
+
+    // Minimax polynomial on [ 0, 1 ], error below 1e-5 rad.
+    if ( abs_x >= abs_y )
+    {
+        ratio = abs_y / abs_x;
+    }
+    else
+    {
+        ratio = abs_x / abs_y;
+    }
+    ratio_sq = ratio * ratio;
+    angle = ratio * ( 0.9998660 + ratio_sq * ( -0.3302995 + ratio_sq * ( 0.1801410 + 
+            ratio_sq * ( -0.0851330 + ratio_sq * 0.0208351 ) ) ) );
+
+    if ( abs_y > abs_x )
+    {
+        angle = ( COMPASS2_PI / 2 ) - angle;
+    }
+    if ( x < 0 )
+    {
+        angle = COMPASS2_PI - angle;
+    }
+    if ( y < 0 )
+    {
+        angle = -angle;
+    }
+    return angle;
+}
+
 static void compass2_i2c_write ( compass2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
     uint8_t tx_buf[ 256 ];
@@ -349,9 +574,9 @@ static void compass2_i2c_write ( compass2_t *ctx, uint8_t reg, uint8_t *data_buf
     
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
 
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );    
@@ -364,36 +589,25 @@ static void compass2_i2c_read ( compass2_t *ctx, uint8_t reg, uint8_t *data_buf,
 
 static void compass2_spi_write ( compass2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
-    uint8_t tx_buf[ 265 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ )
-    {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
-    }
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    spi_master_write( &ctx->spi, tx_buf, 1 );
+    spi_master_write( &ctx->spi, data_buf, len );
     spi_master_deselect_device( ctx->chip_select );    
 }
 
 static void compass2_spi_read ( compass2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
     uint8_t tx_buf[ 1 ];
-    uint8_t rx_buf[ 265 ];
-    uint8_t cnt;
 
     tx_buf[ 0 ] = reg | 0x80;
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write_then_read( &ctx->spi, tx_buf, 1, rx_buf, len );
+    spi_master_write_then_read( &ctx->spi, tx_buf, 1, data_buf, len );
     spi_master_deselect_device( ctx->chip_select );  
-
-    for ( cnt = 0; cnt < len; cnt++ )
-    {
-        data_buf[ cnt ] = rx_buf [ cnt ];
-    }
 }
 
 // ------------------------------------------------------------------------- END
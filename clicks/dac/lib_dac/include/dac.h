@@ -78,6 +78,7 @@
 
 #define DAC_OK           0x00
 #define DAC_INIT_ERROR   0xFF
+#define DAC_WAVE_ERROR   0xFE
 /** \} */
 
 /**
@@ -97,6 +98,16 @@
 #define DAC_STEP_VALUE      1000
 /** \} */
 
+/**
+ * \defgroup wave Waveform
+ * \{
+ */
+#define DAC_WAVE_MIN_BITS   4
+#define DAC_WAVE_MAX_BITS   10
+#define DAC_WAVE_MAX_CODE   4095
+#define DAC_WAVE_TABLE_SIZE( table_bits )  ( 2u << ( table_bits ) )
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -138,6 +149,22 @@ typedef struct
 
 } dac_cfg_t;
 
+/**
+ * @brief Waveform object definition.
+ *
+ * @description Samples are stored as ready to send SPI frames, two bytes per sample, 
+ * so streaming does no arithmetic besides the phase accumulator step.
+ */
+typedef struct
+{
+    uint8_t *table;
+    uint8_t table_bits;
+    uint32_t sample_rate;
+    uint32_t phase;
+    uint32_t step;
+
+} dac_wave_t;
+
 /** \} */ // End types group
 // ------------------------------------------------------------------ CONSTANTS
 /**
@@ -208,6 +235,94 @@ void dac_set_voltage ( dac_t *ctx, uint16_t v_out );
 
 void dac_set_voltage_pct ( dac_t *ctx, uint8_t v_out_pct );
 
+/**
+ * @brief Waveform setup function
+ *
+ * @param wave          Waveform object.
+ * @param table         Table buffer of DAC_WAVE_TABLE_SIZE( table_bits ) bytes.
+ * @param table_bits    Table length as a power of two, DAC_WAVE_MIN_BITS to DAC_WAVE_MAX_BITS.
+ * @param sample_rate   Rate in Hz at which #dac_wave_tick is called.
+ *
+ * @return DAC_OK or DAC_WAVE_ERROR if table_bits is out of range.
+ *
+ * @description This function binds the table and resets the phase, the table 
+ * holds mid scale and the frequency is 0 until set.
+ */
+DAC_RETVAL dac_wave_setup ( dac_wave_t *wave, uint8_t *table, uint8_t table_bits, uint32_t sample_rate );
+
+/**
+ * @brief Waveform sine table function
+ *
+ * @param wave          Waveform object.
+ * @param amplitude     Peak amplitude in DAC codes.
+ * @param offset        Center value in DAC codes.
+ *
+ * @description This function fills the table with one sine period, 
+ * samples are clipped to the DAC range.
+ */
+void dac_wave_sine ( dac_wave_t *wave, uint16_t amplitude, uint16_t offset );
+
+/**
+ * @brief Waveform triangle table function
+ *
+ * @param wave          Waveform object.
+ * @param amplitude     Peak amplitude in DAC codes.
+ * @param offset        Center value in DAC codes.
+ *
+ * @description This function fills the table with one triangle period, 
+ * samples are clipped to the DAC range.
+ */
+void dac_wave_triangle ( dac_wave_t *wave, uint16_t amplitude, uint16_t offset );
+
+/**
+ * @brief Waveform arbitrary table function
+ *
+ * @param wave          Waveform object.
+ * @param samples       One period of full scale signed samples, table length entries.
+ * @param amplitude     Amplitude in DAC codes of a full scale sample.
+ * @param offset        Center value in DAC codes.
+ *
+ * @description This function fills the table with a user defined period, 
+ * samples are clipped to the DAC range.
+ */
+void dac_wave_arbitrary ( dac_wave_t *wave, const int16_t *samples, uint16_t amplitude, uint16_t offset );
+
+/**
+ * @brief Waveform frequency function
+ *
+ * @param wave          Waveform object.
+ * @param freq          Output frequency in Hz.
+ *
+ * @description This function sets the phase accumulator step, the resolution 
+ * is sample_rate / 2^32 Hz. The phase is kept so the change is glitch free.
+ */
+void dac_wave_set_frequency ( dac_wave_t *wave, float freq );
+
+/**
+ * @brief Waveform tick function
+ *
+ * @param ctx           Click object.
+ * @param wave          Waveform object.
+ *
+ * @description This function outputs the next sample, call it from a timer 
+ * interrupt running at the sample rate.
+ */
+void dac_wave_tick ( dac_t *ctx, dac_wave_t *wave );
+
+/**
+ * @brief Waveform burst function
+ *
+ * @param ctx           Click object.
+ * @param wave          Waveform object.
+ * @param n_samples     Number of samples to output.
+ *
+ * @description This function outputs samples back to back, the sample rate is 
+ * then set by the SPI clock and the wave sample rate should match the measured rate.
+ * 
+ * @note The DAC latches on chip select release, so every sample is its own frame.
+ */
+void dac_wave_burst ( dac_t *ctx, dac_wave_t *wave, uint32_t n_samples );
+
 #ifdef __cplusplus
 }
 #endif
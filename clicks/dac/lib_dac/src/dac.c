@@ -27,11 +27,14 @@
  */
 
 #include "dac.h"
+#include "math.h"
 
 // ------------------------------------------------------------- PRIVATE MACROS 
 
 #define DAC_DUMMY 0
 
+#define DAC_WAVE_PI 3.14159265
+
 // -------------------------------------------------------------- PRIVATE TYPES
 
 
@@ -52,6 +55,8 @@ static void dac_generic_transfer
     uint16_t rd_len 
 );
 
+static void dac_wave_store ( dac_wave_t *wave, uint16_t idx, int32_t code );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void dac_cfg_setup ( dac_cfg_t *cfg )
@@ -129,8 +134,143 @@ void dac_set_voltage_pct ( dac_t *ctx, uint8_t v_out_pct )
     dac_set_voltage( ctx, v_out );
 }
 
+DAC_RETVAL dac_wave_setup ( dac_wave_t *wave, uint8_t *table, uint8_t table_bits, uint32_t sample_rate )
+{
+    uint16_t cnt;
+
+    if ( ( table_bits < DAC_WAVE_MIN_BITS ) || ( table_bits > DAC_WAVE_MAX_BITS ) )
+    {
+        return DAC_WAVE_ERROR;
+    }
+
+    wave->table = table;
+    wave->table_bits = table_bits;
+    wave->sample_rate = sample_rate;
+    wave->phase = 0;
+    wave->step = 0;
+
+    for ( cnt = 0; cnt < ( 1u << table_bits ); cnt++ )
+    {
+        dac_wave_store( wave, cnt, ( DAC_WAVE_MAX_CODE + 1 ) / 2 );
+    }
+
+    return DAC_OK;
+}
+
+void dac_wave_sine ( dac_wave_t *wave, uint16_t amplitude, uint16_t offset )
+{
+    uint16_t len = 1u << wave->table_bits;
+    uint16_t cnt;
+    float angle;
+
+    for ( cnt = 0; cnt < len; cnt++ )
+    {
+        angle = ( 2.0 * DAC_WAVE_PI * cnt ) / len;
+        dac_wave_store( wave, cnt, offset + ( int32_t ) floor( amplitude * sin( angle ) + 0.5 ) );
+    }
+}
+
+void dac_wave_triangle ( dac_wave_t *wave, uint16_t amplitude, uint16_t offset )
+{
+    uint16_t len = 1u << wave->table_bits;
+    uint16_t quarter = len / 4;
+    int32_t ramp;
+    uint16_t cnt;
+
+    // Starts at the offset rising, like the sine table.
+    for ( cnt = 0; cnt < len; cnt++ )
+    {
+        if ( cnt < quarter )
+        {
+            ramp = cnt;
+        }
+        else if ( cnt < ( 3 * quarter ) )
+        {
+            ramp = ( int32_t ) ( 2 * quarter ) - cnt;
+        }
+        else
+        {
+            ramp = ( int32_t ) cnt - len;
+        }
+        dac_wave_store( wave, cnt, offset + ( ramp * amplitude ) / ( int32_t ) quarter );
+    }
+}
+
+void dac_wave_arbitrary ( dac_wave_t *wave, const int16_t *samples, uint16_t amplitude, uint16_t offset )
+{
+    uint16_t len = 1u << wave->table_bits;
+    uint16_t cnt;
+
+    for ( cnt = 0; cnt < len; cnt++ )
+    {
+        dac_wave_store( wave, cnt, offset + ( ( ( int32_t ) samples[ cnt ] * amplitude ) >> 15 ) );
+    }
+}
+
+void dac_wave_set_frequency ( dac_wave_t *wave, float freq )
+{
+    float step;
+
+    if ( ( freq <= 0 ) || ( 0 == wave->sample_rate ) )
+    {
+        wave->step = 0;
+        return;
+    }
+
+    // Nyquist limit, the step must stay below half of the phase range.
+    step = ( freq / wave->sample_rate ) * 4294967296.0;
+    if ( step >= 2147483648.0 )
+    {
+        step = 2147483647.0;
+    }
+    wave->step = ( uint32_t ) step;
+}
+
+void dac_wave_tick ( dac_t *ctx, dac_wave_t *wave )
+{
+    uint8_t *frame = &wave->table[ ( wave->phase >> ( 32 - wave->table_bits ) ) << 1 ];
+
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write( &ctx->spi, frame, 2 );
+    spi_master_deselect_device( ctx->chip_select );
+
+    wave->phase += wave->step;
+}
+
+void dac_wave_burst ( dac_t *ctx, dac_wave_t *wave, uint32_t n_samples )
+{
+    uint8_t shift = 32 - wave->table_bits;
+    uint32_t phase = wave->phase;
+    uint32_t step = wave->step;
+
+    while ( n_samples-- )
+    {
+        spi_master_select_device( ctx->chip_select );
+        spi_master_write( &ctx->spi, &wave->table[ ( phase >> shift ) << 1 ], 2 );
+        spi_master_deselect_device( ctx->chip_select );
+        phase += step;
+    }
+    wave->phase = phase;
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
+static void dac_wave_store ( dac_wave_t *wave, uint16_t idx, int32_t code )
+{
+    if ( code < 0 )
+    {
+        code = 0;
+    }
+    else if ( code > DAC_WAVE_MAX_CODE )
+    {
+        code = DAC_WAVE_MAX_CODE;
+    }
+
+    // Same frame layout as dac_set_voltage.
+    wave->table[ idx * 2 ] = ( ( code >> 8 ) & DAC_4_BIT_DATA ) | DAC_APPLY_SETTINGS;
+    wave->table[ idx * 2 + 1 ] = code & DAC_8_BIT_DATA;
+}
+
 static void dac_generic_transfer 
 ( 
     dac_t *ctx, 
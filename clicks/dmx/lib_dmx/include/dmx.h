@@ -126,6 +126,18 @@
 #define DMX_DRV_TX_BUFFER_SIZE  100
 /** \} */
 
+/**
+ * \defgroup dmx_universe DMX universe
+ * \{
+ */
+#define DMX_UNIVERSE_SIZE           512
+#define DMX_UNIVERSE_FRAME_MS       23
+#define DMX_UNIVERSE_REFRESH_MS     1000
+#define DMX_UNIVERSE_RX_GAP_MS      5
+#define DMX_UNIVERSE_CMD_TIMEOUT_MS 200
+#define DMX_UNIVERSE_TX_TIMEOUT_MS  200
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -177,6 +189,40 @@ typedef struct
 
 } dmx_cfg_t;
 
+/**
+ * @brief DMX universe object definition.
+ *
+ * @details Slots are numbered from 1, @b slot[ 0 ] holds slot 1. The Click 
+ * exchanges the window of @b win_len slots starting at @b win_start with the
+ * host, in master mode it keeps retransmitting the last written window on its own.
+ */
+typedef struct
+{
+    uint8_t  slot[ DMX_UNIVERSE_SIZE ];
+    uint8_t  changed[ DMX_UNIVERSE_SIZE / 8 ];    // Slots changed by the last received frame.
+
+    // Transmit change tracking, clean when dirty_first > dirty_last.
+    uint16_t dirty_first;
+    uint16_t dirty_last;
+
+    // Click window and frame length.
+    uint16_t win_start;
+    uint16_t win_len;
+    uint16_t frame_len;
+
+    // Scheduler
+    uint16_t frame_ms;
+    uint16_t refresh_ms;
+    uint16_t frame_elapsed;
+    uint16_t refresh_elapsed;
+
+    // Receive decoder
+    uint16_t rx_pos;
+    uint16_t rx_idle;
+    uint8_t  rx_frame[ DMX_UNIVERSE_SIZE ];
+
+} dmx_universe_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -277,6 +323,115 @@ void dmx_set_reset ( dmx_t *ctx, uint8_t state );
  */
 void dmx_set_auto_baud_rate ( dmx_t *ctx, uint8_t state );
 
+/**
+ * @brief Universe Initialization function.
+ * @param uni Universe object.
+ *
+ * @details This function clears all slots and sets the default frame period 
+ * of @b DMX_UNIVERSE_FRAME_MS and refresh period of @b DMX_UNIVERSE_REFRESH_MS.
+ * The Click window is empty until the first transmit or listen call.
+ */
+void dmx_universe_init ( dmx_universe_t *uni );
+
+/**
+ * @brief Universe Slot Setting function.
+ * @param uni Universe object.
+ * @param slot Slot number, 1 to 512.
+ * @param value Slot value.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Slot out of range.
+ *
+ * @details This function sets a slot and marks it for transmission, 
+ * writing an unchanged value does not cause any traffic.
+ */
+err_t dmx_universe_set_slot ( dmx_universe_t *uni, uint16_t slot, uint8_t value );
+
+/**
+ * @brief Universe Slots Setting function.
+ * @param uni Universe object.
+ * @param slot First slot number, 1 to 512.
+ * @param values Slot values.
+ * @param len Number of slots.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Slots out of range.
+ */
+err_t dmx_universe_set_slots ( dmx_universe_t *uni, uint16_t slot, uint8_t *values, uint16_t len );
+
+/**
+ * @brief Universe Slot Reading function.
+ * @param uni Universe object.
+ * @param slot Slot number, 1 to 512.
+ * @return Slot value, 0 for slots out of range.
+ */
+uint8_t dmx_universe_get_slot ( dmx_universe_t *uni, uint16_t slot );
+
+/**
+ * @brief Universe Flush function.
+ * @param ctx Click object.
+ * @param uni Universe object.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error,
+ *         @li @c -2 - Timeout error.
+ *
+ * @details This function writes the changed slots to the Click right away. 
+ * The window grows to cover them when needed, which takes a short trip to
+ * config mode, otherwise only the window data is written.
+ * @note The Click must be reset in master mode.
+ */
+err_t dmx_universe_flush ( dmx_t *ctx, dmx_universe_t *uni );
+
+/**
+ * @brief Universe Transmit Scheduler function.
+ * @param ctx Click object.
+ * @param uni Universe object.
+ * @param elapsed_ms Milliseconds since the previous call.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error,
+ *         @li @c -2 - Timeout error.
+ *
+ * @details This function is called periodically from the application loop. 
+ * Changes are coalesced and written at most once per frame period, 
+ * an unchanged window is rewritten every refresh period.
+ */
+err_t dmx_universe_process ( dmx_t *ctx, dmx_universe_t *uni, uint16_t elapsed_ms );
+
+/**
+ * @brief Universe Listen function.
+ * @param ctx Click object.
+ * @param uni Universe object.
+ * @param slot First slot to receive, 1 to 512.
+ * @param len Number of slots to receive.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error,
+ *         @li @c -2 - Timeout error.
+ *
+ * @details This function sets the Click window for receiving and leaves it in run mode.
+ * @note The Click must be reset in slave mode.
+ */
+err_t dmx_universe_listen ( dmx_t *ctx, dmx_universe_t *uni, uint16_t slot, uint16_t len );
+
+/**
+ * @brief Universe Receive function.
+ * @param ctx Click object.
+ * @param uni Universe object.
+ * @param elapsed_ms Milliseconds since the previous call.
+ * @return @li @c  0 - New frame decoded,
+ *         @li @c -1 - No complete frame yet.
+ *
+ * @details This function decodes the window data the Click outputs for every 
+ * received frame. A partial frame followed by a line gap of @b DMX_UNIVERSE_RX_GAP_MS
+ * is dropped so the decoder realigns on the next frame.
+ */
+err_t dmx_universe_receive ( dmx_t *ctx, dmx_universe_t *uni, uint16_t elapsed_ms );
+
+/**
+ * @brief Universe Slot Change Check function.
+ * @param uni Universe object.
+ * @param slot Slot number, 1 to 512.
+ * @return 1 - slot changed by the last received frame, 0 - unchanged.
+ */
+uint8_t dmx_universe_slot_changed ( dmx_universe_t *uni, uint16_t slot );
+
 #ifdef __cplusplus
 }
 #endif
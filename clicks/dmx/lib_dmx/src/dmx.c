@@ -30,6 +30,18 @@
 #include "dmx.h"
 #include "string.h"
 
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static err_t dmx_write_all ( dmx_t *ctx, uint8_t *data_buf, uint16_t len );
+
+static err_t dmx_universe_cmd ( dmx_t *ctx, char *name, uint16_t value );
+
+static err_t dmx_universe_window ( dmx_t *ctx, dmx_universe_t *uni, uint16_t start, uint16_t len );
+
+static err_t dmx_universe_write_window ( dmx_t *ctx, dmx_universe_t *uni );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
 void dmx_cfg_setup ( dmx_cfg_t *cfg )
 {
     // Communication gpio pins 
@@ -141,5 +153,336 @@ void dmx_set_auto_baud_rate ( dmx_t *ctx, uint8_t state )
     digital_out_write( &ctx->abr, state );
 }
 
+void dmx_universe_init ( dmx_universe_t *uni )
+{
+    memset( uni, 0, sizeof( dmx_universe_t ) );
+    uni->dirty_first = DMX_UNIVERSE_SIZE;
+    uni->frame_ms = DMX_UNIVERSE_FRAME_MS;
+    uni->refresh_ms = DMX_UNIVERSE_REFRESH_MS;
+}
+
+err_t dmx_universe_set_slot ( dmx_universe_t *uni, uint16_t slot, uint8_t value )
+{
+    return dmx_universe_set_slots( uni, slot, &value, 1 );
+}
+
+err_t dmx_universe_set_slots ( dmx_universe_t *uni, uint16_t slot, uint8_t *values, uint16_t len )
+{
+    uint16_t idx;
+
+    if ( ( slot < 1 ) || ( len > DMX_UNIVERSE_SIZE ) || ( ( slot - 1 + len ) > DMX_UNIVERSE_SIZE ) )
+    {
+        return DMX_ERROR;
+    }
+
+    for ( idx = slot - 1; len > 0; idx++, len-- )
+    {
+        if ( uni->slot[ idx ] != *values )
+        {
+            uni->slot[ idx ] = *values;
+            if ( idx < uni->dirty_first )
+            {
+                uni->dirty_first = idx;
+            }
+            if ( idx > uni->dirty_last )
+            {
+                uni->dirty_last = idx;
+            }
+        }
+        values++;
+    }
+    return DMX_OK;
+}
+
+uint8_t dmx_universe_get_slot ( dmx_universe_t *uni, uint16_t slot )
+{
+    if ( ( slot < 1 ) || ( slot > DMX_UNIVERSE_SIZE ) )
+    {
+        return 0;
+    }
+    return uni->slot[ slot - 1 ];
+}
+
+err_t dmx_universe_flush ( dmx_t *ctx, dmx_universe_t *uni )
+{
+    uint16_t start = uni->dirty_first;
+    uint16_t end = uni->dirty_last + 1;
+    err_t error_flag = DMX_OK;
+
+    if ( uni->dirty_first > uni->dirty_last )
+    {
+        return DMX_OK;
+    }
+
+    // The Click takes whole windows only, so the window grows to cover every slot in use.
+    if ( uni->win_len > 0 )
+    {
+        if ( uni->win_start < start )
+        {
+            start = uni->win_start;
+        }
+        if ( ( uni->win_start + uni->win_len ) > end )
+        {
+            end = uni->win_start + uni->win_len;
+        }
+    }
+    if ( ( start != uni->win_start ) || ( ( end - start ) != uni->win_len ) )
+    {
+        error_flag = dmx_universe_window( ctx, uni, start, end - start );
+        if ( DMX_OK != error_flag )
+        {
+            return error_flag;
+        }
+    }
+
+    error_flag = dmx_universe_write_window( ctx, uni );
+    if ( DMX_OK != error_flag )
+    {
+        return error_flag;
+    }
+    uni->dirty_first = DMX_UNIVERSE_SIZE;
+    uni->dirty_last = 0;
+    return DMX_OK;
+}
+
+err_t dmx_universe_process ( dmx_t *ctx, dmx_universe_t *uni, uint16_t elapsed_ms )
+{
+    uni->frame_elapsed += elapsed_ms;
+    if ( uni->refresh_elapsed < ( 0xFFFF - elapsed_ms ) )
+    {
+        uni->refresh_elapsed += elapsed_ms;
+    }
+    if ( uni->frame_elapsed < uni->frame_ms )
+    {
+        return DMX_OK;
+    }
+    uni->frame_elapsed = 0;
+
+    if ( uni->dirty_first <= uni->dirty_last )
+    {
+        return dmx_universe_flush( ctx, uni );
+    }
+    if ( ( uni->refresh_ms > 0 ) && ( uni->win_len > 0 ) && ( uni->refresh_elapsed >= uni->refresh_ms ) )
+    {
+        return dmx_universe_write_window( ctx, uni );
+    }
+    return DMX_OK;
+}
+
+err_t dmx_universe_listen ( dmx_t *ctx, dmx_universe_t *uni, uint16_t slot, uint16_t len )
+{
+    if ( ( slot < 1 ) || ( len < 1 ) || ( len > DMX_UNIVERSE_SIZE ) || ( ( slot - 1 + len ) > DMX_UNIVERSE_SIZE ) )
+    {
+        return DMX_ERROR;
+    }
+    uni->rx_pos = 0;
+    uni->rx_idle = 0;
+    return dmx_universe_window( ctx, uni, slot - 1, len );
+}
+
+err_t dmx_universe_receive ( dmx_t *ctx, dmx_universe_t *uni, uint16_t elapsed_ms )
+{
+    err_t rx_size = 0;
+    uint16_t idx;
+    uint8_t *slot;
+
+    if ( 0 == uni->win_len )
+    {
+        return DMX_ERROR;
+    }
+
+    rx_size = uart_read( &ctx->uart, &uni->rx_frame[ uni->rx_pos ], uni->win_len - uni->rx_pos );
+    if ( rx_size <= 0 )
+    {
+        // A gap inside a frame means bytes were lost, realign on the next frame.
+        if ( uni->rx_pos > 0 )
+        {
+            uni->rx_idle += elapsed_ms;
+            if ( uni->rx_idle >= DMX_UNIVERSE_RX_GAP_MS )
+            {
+                uni->rx_pos = 0;
+                uni->rx_idle = 0;
+            }
+        }
+        return DMX_ERROR;
+    }
+    uni->rx_idle = 0;
+    uni->rx_pos += rx_size;
+    if ( uni->rx_pos < uni->win_len )
+    {
+        return DMX_ERROR;
+    }
+
+    memset( uni->changed, 0, sizeof( uni->changed ) );
+    slot = &uni->slot[ uni->win_start ];
+    for ( idx = 0; idx < uni->win_len; idx++ )
+    {
+        if ( slot[ idx ] != uni->rx_frame[ idx ] )
+        {
+            slot[ idx ] = uni->rx_frame[ idx ];
+            uni->changed[ ( uni->win_start + idx ) >> 3 ] |= 1 << ( ( uni->win_start + idx ) & 7 );
+        }
+    }
+    uni->rx_pos = 0;
+    return DMX_OK;
+}
+
+uint8_t dmx_universe_slot_changed ( dmx_universe_t *uni, uint16_t slot )
+{
+    if ( ( slot < 1 ) || ( slot > DMX_UNIVERSE_SIZE ) )
+    {
+        return 0;
+    }
+    slot--;
+    return ( uni->changed[ slot >> 3 ] >> ( slot & 7 ) ) & 1;
+}
+
+// --------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static err_t dmx_write_all ( dmx_t *ctx, uint8_t *data_buf, uint16_t len )
+{
+    err_t tx_size = 0;
+    uint16_t timeout_cnt = 0;
+
+    // Non-blocking UART takes what fits in the ring buffer, keep feeding it.
+    while ( len > 0 )
+    {
+        tx_size = uart_write( &ctx->uart, data_buf, len );
+        if ( tx_size > 0 )
+        {
+            data_buf += tx_size;
+            len -= tx_size;
+            timeout_cnt = 0;
+        }
+        else if ( ++timeout_cnt > DMX_UNIVERSE_TX_TIMEOUT_MS )
+        {
+            return DMX_ERROR_TIMEOUT;
+        }
+        else
+        {
+            Delay_1ms( );
+        }
+    }
+    return DMX_OK;
+}
+
+static err_t dmx_universe_cmd ( dmx_t *ctx, char *name, uint16_t value )
+{
+    uint8_t cmd_buf[ 10 ] = { 0 };
+    uint8_t rsp_buf[ 16 ] = { 0 };
+    uint8_t rsp_len = 0;
+    err_t rx_size = 0;
+    uint16_t timeout_cnt = 0;
+
+    // Command format is @NAME,ddd as in DMX_CMD_SADR.
+    memcpy( cmd_buf, name, 5 );
+    cmd_buf[ 5 ] = ',';
+    cmd_buf[ 6 ] = '0' + ( value / 100 ) % 10;
+    cmd_buf[ 7 ] = '0' + ( value / 10 ) % 10;
+    cmd_buf[ 8 ] = '0' + value % 10;
+
+    while ( uart_read( &ctx->uart, rsp_buf, sizeof( rsp_buf ) ) > 0 );
+    memset( rsp_buf, 0, sizeof( rsp_buf ) );
+    if ( DMX_OK != dmx_write_all( ctx, cmd_buf, 9 ) )
+    {
+        return DMX_ERROR_TIMEOUT;
+    }
+
+    for ( ; ; )
+    {
+        rx_size = uart_read( &ctx->uart, &rsp_buf[ rsp_len ], sizeof( rsp_buf ) - 1 - rsp_len );
+        if ( rx_size > 0 )
+        {
+            rsp_len += rx_size;
+            if ( strstr( ( char * ) rsp_buf, DMX_RSP_OK ) )
+            {
+                return DMX_OK;
+            }
+            if ( strstr( ( char * ) rsp_buf, DMX_RSP_ERROR ) )
+            {
+                return DMX_ERROR;
+            }
+            if ( rsp_len >= ( sizeof( rsp_buf ) - 1 ) )
+            {
+                // Keep the tail in case a response straddles the buffer end.
+                memmove( rsp_buf, &rsp_buf[ rsp_len - 2 ], 2 );
+                memset( &rsp_buf[ 2 ], 0, sizeof( rsp_buf ) - 2 );
+                rsp_len = 2;
+            }
+        }
+        else if ( ++timeout_cnt > DMX_UNIVERSE_CMD_TIMEOUT_MS )
+        {
+            return DMX_ERROR_TIMEOUT;
+        }
+        else
+        {
+            Delay_1ms( );
+        }
+    }
+}
+
+static err_t dmx_universe_window ( dmx_t *ctx, dmx_universe_t *uni, uint16_t start, uint16_t len )
+{
+    err_t error_flag = DMX_OK;
+
+    dmx_run( ctx, DMX_CONFIG_MODE );
+    Delay_10ms( );
+    error_flag = dmx_universe_cmd( ctx, "@SADR", start + 1 );
+    if ( DMX_OK == error_flag )
+    {
+        error_flag = dmx_universe_cmd( ctx, "@BLEN", len );
+    }
+    if ( ( DMX_OK == error_flag ) && ( uni->frame_len < ( start + len ) ) )
+    {
+        error_flag = dmx_universe_cmd( ctx, "@FLEN", start + len );
+        if ( DMX_OK == error_flag )
+        {
+            uni->frame_len = start + len;
+        }
+    }
+    dmx_run( ctx, DMX_RUN_MODE );
+    Delay_10ms( );
+
+    if ( DMX_OK != error_flag )
+    {
+        // The Click state is unknown, redo the whole window on the next attempt.
+        uni->win_len = 0;
+        uni->frame_len = 0;
+        if ( start < uni->dirty_first )
+        {
+            uni->dirty_first = start;
+        }
+        if ( ( start + len - 1 ) > uni->dirty_last )
+        {
+            uni->dirty_last = start + len - 1;
+        }
+        return error_flag;
+    }
+    uni->win_start = start;
+    uni->win_len = len;
+    return DMX_OK;
+}
+
+static err_t dmx_universe_write_window ( dmx_t *ctx, dmx_universe_t *uni )
+{
+    err_t error_flag = dmx_write_all( ctx, &uni->slot[ uni->win_start ], uni->win_len );
+    if ( DMX_OK != error_flag )
+    {
+        // A partial block leaves the Click out of step, redo the whole window on the next attempt.
+        if ( uni->win_start < uni->dirty_first )
+        {
+            uni->dirty_first = uni->win_start;
+        }
+        if ( ( uni->win_start + uni->win_len - 1 ) > uni->dirty_last )
+        {
+            uni->dirty_last = uni->win_start + uni->win_len - 1;
+        }
+        uni->win_len = 0;
+        return error_flag;
+    }
+    uni->refresh_elapsed = 0;
+    return DMX_OK;
+}
+
 // ------------------------------------------------------------------------- END
 
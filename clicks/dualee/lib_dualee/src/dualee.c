@@ -75,9 +75,9 @@ void dualee_generic_write ( dualee_t *ctx, uint8_t *reg, uint8_t *data_buf, uint
     tx_buf[ 0 ] = reg[ 0 ];
     tx_buf[ 1 ] = reg[ 1 ];
     
-    for ( cnt = 2; cnt <= len + 1; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 2 ]; 
+        tx_buf[ cnt + 2 ] = data_buf[ cnt ]; 
     }
 
     i2c_master_write( &ctx->i2c, tx_buf, len + 2 );      
@@ -309,6 +309,35 @@ extern "C"{
 #define ECG2_CHANNEL_DISABLE                                        0x00
 
 #define ECG2_DATA_READY                                             0x01
+
+/**
+ * @brief ECG 2 data frame settings.
+ * @details Specified data frame settings of ECG 2 Click driver, a frame holds the 24-bit
+ * status word followed by 16-bit samples of all channels.
+ */
+#define ECG2_FRAME_CHANNELS                                         8
+#define ECG2_FRAME_STATUS_LEN                                       3
+#define ECG2_FRAME_LEN                                              ( ECG2_FRAME_STATUS_LEN + ECG2_FRAME_CHANNELS * 2 )
+#define ECG2_FRAME_STATUS_HEADER                                    0xC0
+#define ECG2_FRAME_STATUS_HEADER_MASK                               0xF0
+#define ECG2_STREAM_BUF_SIZE                                        16  /**< Must be a power of two not above 128. */
+
+/**
+ * @brief ECG 2 QRS detector settings.
+ * @details Specified QRS detector settings of ECG 2 Click driver.
+ */
+#define ECG2_QRS_HP_SHIFT                                           7
+#define ECG2_QRS_NOTCH_Q                                            12
+#define ECG2_QRS_NOTCH_POLE_RADIUS                                  0.95
+#define ECG2_QRS_MWI_MS                                             150
+#define ECG2_QRS_MWI_MAX_LEN                                        80
+#define ECG2_QRS_REFRACTORY_MS                                      200
+#define ECG2_QRS_LEARN_MS                                           2000
+#define ECG2_QRS_RR_AVG_SHIFT                                       3
+#define ECG2_QRS_NO_BEAT                                            0
+#define ECG2_QRS_BEAT                                               1
+#define ECG2_MAINS_FREQ_50HZ                                        50
+#define ECG2_MAINS_FREQ_60HZ                                        60
 /**
  * @brief Data sample selection.
  * @details This macro sets data samples for SPI modules.
@@ -410,6 +439,73 @@ typedef enum
 
 } ecg2_return_value_t;
 
+/**
+ * @brief ECG 2 Click data frame object.
+ * @details Data frame object definition of ECG 2 Click driver.
+ */
+typedef struct
+{
+    uint32_t status;                                /**< 24-bit status word with lead-off bits. */
+    int16_t  channel[ ECG2_FRAME_CHANNELS ];        /**< Channel samples. */
+
+} ecg2_frame_t;
+
+/**
+ * @brief ECG 2 Click frame stream object.
+ * @details Frame ring buffer object definition of ECG 2 Click driver.
+ */
+typedef struct
+{
+    ecg2_frame_t frames[ ECG2_STREAM_BUF_SIZE ];    /**< Frame ring buffer. */
+    volatile uint8_t head;                          /**< Read index, written by get only. */
+    volatile uint8_t tail;                          /**< Write index, written by poll only. */
+    uint16_t     overruns;                          /**< Frames dropped on full buffer, written by poll only. */
+
+} ecg2_stream_t;
+
+/**
+ * @brief ECG 2 Click QRS detector object.
+ * @details Integer QRS detector object definition of ECG 2 Click driver. The filter chain
+ * is a baseline wander high-pass, a mains notch and a Pan-Tompkins style detector.
+ */
+typedef struct
+{
+    // Baseline wander high-pass
+    int32_t  hp_x1;                                 /**< Previous input sample. */
+    int32_t  hp_y1;                                 /**< Previous output, Q8. */
+
+    // Mains notch
+    int32_t  notch_b0;                              /**< Numerator coefficient b0 = b2. */
+    int32_t  notch_b1;                              /**< Numerator coefficient b1. */
+    int32_t  notch_a1;                              /**< Denominator coefficient a1. */
+    int32_t  notch_a2;                              /**< Denominator coefficient a2. */
+    int16_t  notch_x[ 2 ];                          /**< Previous notch inputs. */
+    int16_t  notch_y[ 2 ];                          /**< Previous notch outputs. */
+
+    // Derivative and moving window integration
+    int16_t  deriv_x[ 4 ];                          /**< Previous derivative inputs. */
+    uint16_t mwi_buf[ ECG2_QRS_MWI_MAX_LEN ];       /**< Squared derivative window. */
+    uint8_t  mwi_len;                               /**< Window length in samples. */
+    uint8_t  mwi_idx;                               /**< Window write index. */
+    uint32_t mwi_sum;                               /**< Window sum. */
+    uint32_t mwi_prev[ 2 ];                         /**< Previous integrator outputs. */
+
+    // Adaptive thresholds
+    uint32_t spki;                                  /**< Signal peak level. */
+    uint32_t npki;                                  /**< Noise peak level. */
+    uint32_t threshold;                             /**< Detection threshold. */
+    uint32_t sample_cnt;                            /**< Processed samples. */
+    uint32_t last_beat;                             /**< Sample index of the last beat. */
+    uint16_t learn_len;                             /**< Threshold learning period in samples. */
+    uint16_t refractory;                            /**< Refractory period in samples. */
+
+    // Heart rate
+    uint16_t sample_rate;                           /**< Sample rate in SPS. */
+    uint32_t rr_sum;                                /**< Averaged RR interval, scaled by 2^ECG2_QRS_RR_AVG_SHIFT. */
+    uint16_t heart_rate;                            /**< Heart rate in BPM, 0 until two beats are detected. */
+
+} ecg2_qrs_t;
+
 /*!
  * @addtogroup ecg2 ECG 2 Click Driver
  * @brief API for configuring and manipulating ECG 2 Click driver.
@@ -728,6 +824,86 @@ err_t ecg2_read_data ( ecg2_t *ctx, uint8_t *data_out, uint8_t len );
  */
 err_t ecg2_read_channel_data ( ecg2_t *ctx, uint8_t channel, uint16_t *data_out );
 
+/**
+ * @brief ECG 2 read frame function.
+ * @details This function reads one data frame with a single SPI transfer and unpacks the
+ * status word and all channel samples. It does not wait for the DRD pin.
+ * @param[in] ctx : Click context object.
+ * See #ecg2_t object definition for detailed explanation.
+ * @param[out] frame : Data frame.
+ * See #ecg2_frame_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, no data ready or frame out of sync.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note The device should be in read data continuous mode.
+ */
+err_t ecg2_read_frame ( ecg2_t *ctx, ecg2_frame_t *frame );
+
+/**
+ * @brief ECG 2 stream init function.
+ * @details This function clears the frame ring buffer.
+ * @param[out] stream : Frame stream object.
+ * See #ecg2_stream_t object definition for detailed explanation.
+ * @return Nothing.
+ */
+void ecg2_stream_init ( ecg2_stream_t *stream );
+
+/**
+ * @brief ECG 2 stream poll function.
+ * @details This function reads a data frame into the ring buffer if the DRD pin reports
+ * new data. When the buffer is full the new frame is dropped and counted as an overrun.
+ * @param[in] ctx : Click context object.
+ * See #ecg2_t object definition for detailed explanation.
+ * @param[in,out] stream : Frame stream object.
+ * See #ecg2_stream_t object definition for detailed explanation.
+ * @return @li @c  0 - Frame captured,
+ *         @li @c -1 - No frame captured.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note Call this function from the DRD interrupt or at least once per sample period.
+ * Poll and #ecg2_stream_get each own one ring index, so get needs no interrupt masking.
+ */
+err_t ecg2_stream_poll ( ecg2_t *ctx, ecg2_stream_t *stream );
+
+/**
+ * @brief ECG 2 stream get function.
+ * @details This function takes the oldest frame from the ring buffer.
+ * @param[in,out] stream : Frame stream object.
+ * See #ecg2_stream_t object definition for detailed explanation.
+ * @param[out] frame : Data frame.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Buffer empty.
+ *
+ * See #err_t definition for detailed explanation.
+ */
+err_t ecg2_stream_get ( ecg2_stream_t *stream, ecg2_frame_t *frame );
+
+/**
+ * @brief ECG 2 QRS detector init function.
+ * @details This function initializes the filter chain and detector for the selected
+ * sample rate and mains frequency.
+ * @param[out] qrs : QRS detector object.
+ * See #ecg2_qrs_t object definition for detailed explanation.
+ * @param[in] sample_rate : Sample rate in SPS.
+ * @param[in] mains_freq : Mains frequency to be rejected, 50 or 60 Hz.
+ * @return Nothing.
+ */
+void ecg2_qrs_init ( ecg2_qrs_t *qrs, uint16_t sample_rate, uint8_t mains_freq );
+
+/**
+ * @brief ECG 2 QRS detector process function.
+ * @details This function runs one lead sample through the integer filter chain and the
+ * QRS detector, and updates the heart rate on each detected beat.
+ * @param[in,out] qrs : QRS detector object.
+ * See #ecg2_qrs_t object definition for detailed explanation.
+ * @param[in] sample : Raw lead sample.
+ * @param[out] filtered : Baseline and mains filtered sample, can be NULL.
+ * @return @li @c 0 - No beat,
+ *         @li @c 1 - Beat detected, reported one integration window after the R peak.
+ */
+uint8_t ecg2_qrs_process ( ecg2_qrs_t *qrs, int16_t sample, int16_t *filtered );
+
 #ifdef __cplusplus
 }
 #endif
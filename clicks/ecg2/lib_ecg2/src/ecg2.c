@@ -26,6 +26,8 @@
  */
 
 #include "ecg2.h"
+#include "math.h"
+#include "string.h"
 
 /**
  * @brief Dummy data.
@@ -45,6 +47,36 @@ void dev_hw_reset_delay ( void );
  */
 void dev_read_delay ( void );
 
+/**
+ * @brief Saturate value to 16-bit signed range.
+ */
+static int16_t dev_saturate_int16 ( int32_t value );
+
+/**
+ * @brief Baseline wander high-pass filter.
+ */
+static int16_t dev_qrs_high_pass ( ecg2_qrs_t *qrs, int16_t sample );
+
+/**
+ * @brief Mains notch filter.
+ */
+static int16_t dev_qrs_notch ( ecg2_qrs_t *qrs, int16_t sample );
+
+/**
+ * @brief Derivative, squaring and moving window integration.
+ */
+static uint32_t dev_qrs_integrate ( ecg2_qrs_t *qrs, int16_t sample );
+
+/**
+ * @brief Adaptive threshold update.
+ */
+static void dev_qrs_update_threshold ( ecg2_qrs_t *qrs );
+
+/**
+ * @brief Adaptive threshold peak classification.
+ */
+static uint8_t dev_qrs_detect ( ecg2_qrs_t *qrs, uint32_t peak );
+
 // --------------------------------------------------------- PUBLIC FUNCTIONS 
 
 void ecg2_cfg_setup ( ecg2_cfg_t *cfg ) 
@@ -174,16 +206,13 @@ err_t ecg2_default_cfg ( ecg2_t *ctx )
 
 err_t ecg2_generic_write ( ecg2_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
-    uint8_t tx_buf[ 257 ] = { 0 };
+    uint8_t tx_buf[ 1 ] = { 0 };
 
     tx_buf[ 0 ] = reg;
-    for ( uint8_t cnt = 1; cnt <= len; cnt++ )
-    {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
@@ -237,17 +266,14 @@ err_t ecg2_read_register ( ecg2_t *ctx, uint8_t reg, uint8_t *data_out ) {
 } 
 
 err_t ecg2_multi_write ( ecg2_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) {
-    uint8_t tx_buf[ 256 ];
+    uint8_t tx_buf[ 2 ];
     tx_buf[ 0 ] = reg;
     tx_buf[ 0 ] |= ECG2_SPI_CMD_WRITE;
     tx_buf[ 1 ] = len - 1;
-
-    for ( uint8_t cnt = 0; cnt <= len; cnt++) {
-        tx_buf[ cnt + 2 ] = data_in[ cnt ]; 
-    }
     
     spi_master_select_device( ctx->chip_select );
     err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 2 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
     
     return error_flag;
@@ -512,6 +538,147 @@ err_t ecg2_read_channel_data ( ecg2_t *ctx, uint8_t channel, uint16_t *data_out
     return error_flag;
 }
 
+err_t ecg2_read_frame ( ecg2_t *ctx, ecg2_frame_t *frame ) 
+{
+    uint8_t rx_data[ ECG2_FRAME_LEN ];
+    uint8_t ch_cnt;
+    
+    // DRD is active low.
+    if ( ecg2_data_ready( ctx ) ) 
+    {
+        return ECG2_ERROR;
+    }
+    
+    spi_master_select_device( ctx->chip_select );
+    err_t error_flag = spi_master_read( &ctx->spi, rx_data, ECG2_FRAME_LEN );
+    spi_master_deselect_device( ctx->chip_select );
+    
+    if ( ( ECG2_OK != error_flag ) || 
+         ( ECG2_FRAME_STATUS_HEADER != ( rx_data[ 0 ] & ECG2_FRAME_STATUS_HEADER_MASK ) ) ) 
+    {
+        return ECG2_ERROR;
+    }
+    
+    frame->status = ( ( uint32_t ) rx_data[ 0 ] << 16 ) | ( ( uint32_t ) rx_data[ 1 ] << 8 ) | rx_data[ 2 ];
+    for ( ch_cnt = 0; ch_cnt < ECG2_FRAME_CHANNELS; ch_cnt++ ) 
+    {
+        frame->channel[ ch_cnt ] = ( int16_t ) ( ( ( uint16_t ) rx_data[ ECG2_FRAME_STATUS_LEN + ch_cnt * 2 ] << 8 ) | 
+                                                 rx_data[ ECG2_FRAME_STATUS_LEN + ch_cnt * 2 + 1 ] );
+    }
+    return ECG2_OK;
+}
+
+void ecg2_stream_init ( ecg2_stream_t *stream ) 
+{
+    stream->head = 0;
+    stream->tail = 0;
+    stream->overruns = 0;
+}
+
+err_t ecg2_stream_poll ( ecg2_t *ctx, ecg2_stream_t *stream ) 
+{
+    ecg2_frame_t frame;
+    uint8_t tail = stream->tail;
+    
+    if ( ECG2_OK != ecg2_read_frame( ctx, &frame ) ) 
+    {
+        return ECG2_ERROR;
+    }
+    // Only get moves head, so a full buffer drops the new frame.
+    if ( ( uint8_t ) ( tail - stream->head ) >= ECG2_STREAM_BUF_SIZE ) 
+    {
+        stream->overruns++;
+        return ECG2_OK;
+    }
+    stream->frames[ tail % ECG2_STREAM_BUF_SIZE ] = frame;
+    stream->tail = tail + 1;
+    return ECG2_OK;
+}
+
+err_t ecg2_stream_get ( ecg2_stream_t *stream, ecg2_frame_t *frame ) 
+{
+    uint8_t head = stream->head;
+    
+    if ( head == stream->tail ) 
+    {
+        return ECG2_ERROR;
+    }
+    *frame = stream->frames[ head % ECG2_STREAM_BUF_SIZE ];
+    stream->head = head + 1;
+    return ECG2_OK;
+}
+
+void ecg2_qrs_init ( ecg2_qrs_t *qrs, uint16_t sample_rate, uint8_t mains_freq ) 
+{
+    float cos_w0;
+    float gain;
+    float radius = ECG2_QRS_NOTCH_POLE_RADIUS;
+    
+    memset( qrs, 0, sizeof( ecg2_qrs_t ) );
+    qrs->sample_rate = sample_rate;
+    
+    // Unity gain notch, only the coefficients are computed in floating point.
+    if ( ( mains_freq * 2 ) < sample_rate ) 
+    {
+        cos_w0 = cos( 2.0 * 3.14159265 * mains_freq / sample_rate );
+        gain = ( 1.0 - 2.0 * radius * cos_w0 + radius * radius ) / ( 2.0 - 2.0 * cos_w0 );
+        qrs->notch_b0 = ( int32_t ) ( gain * ( 1ul << ECG2_QRS_NOTCH_Q ) + 0.5 );
+        qrs->notch_b1 = ( int32_t ) ( -2.0 * gain * cos_w0 * ( 1ul << ECG2_QRS_NOTCH_Q ) - 0.5 );
+        qrs->notch_a1 = ( int32_t ) ( -2.0 * radius * cos_w0 * ( 1ul << ECG2_QRS_NOTCH_Q ) - 0.5 );
+        qrs->notch_a2 = ( int32_t ) ( radius * radius * ( 1ul << ECG2_QRS_NOTCH_Q ) + 0.5 );
+    }
+    else 
+    {
+        qrs->notch_b0 = ( 1ul << ECG2_QRS_NOTCH_Q );
+    }
+    
+    qrs->mwi_len = ( uint8_t ) ( ( ( uint32_t ) sample_rate * ECG2_QRS_MWI_MS ) / 1000 );
+    if ( qrs->mwi_len > ECG2_QRS_MWI_MAX_LEN ) 
+    {
+        qrs->mwi_len = ECG2_QRS_MWI_MAX_LEN;
+    }
+    if ( 0 == qrs->mwi_len ) 
+    {
+        qrs->mwi_len = 1;
+    }
+    qrs->refractory = ( uint16_t ) ( ( ( uint32_t ) sample_rate * ECG2_QRS_REFRACTORY_MS ) / 1000 );
+    qrs->learn_len = ( uint16_t ) ( ( ( uint32_t ) sample_rate * ECG2_QRS_LEARN_MS ) / 1000 );
+}
+
+uint8_t ecg2_qrs_process ( ecg2_qrs_t *qrs, int16_t sample, int16_t *filtered ) 
+{
+    uint32_t mwi;
+    uint8_t beat = ECG2_QRS_NO_BEAT;
+    
+    if ( 0 == qrs->sample_cnt ) 
+    {
+        // Start the high-pass from the first sample to avoid a DC step transient.
+        qrs->hp_x1 = sample;
+    }
+    sample = dev_qrs_notch( qrs, dev_qrs_high_pass( qrs, sample ) );
+    if ( NULL != filtered ) 
+    {
+        *filtered = sample;
+    }
+    
+    mwi = dev_qrs_integrate( qrs, sample );
+    // Local maximum of the integrator output one sample back.
+    if ( ( qrs->mwi_prev[ 0 ] > qrs->mwi_prev[ 1 ] ) && ( qrs->mwi_prev[ 0 ] >= mwi ) ) 
+    {
+        beat = dev_qrs_detect( qrs, qrs->mwi_prev[ 0 ] );
+    }
+    qrs->mwi_prev[ 1 ] = qrs->mwi_prev[ 0 ];
+    qrs->mwi_prev[ 0 ] = mwi;
+    if ( ++qrs->sample_cnt == qrs->learn_len ) 
+    {
+        // End of learning, start from half of the largest peak seen.
+        qrs->npki = qrs->spki / 8;
+        qrs->spki /= 2;
+        dev_qrs_update_threshold( qrs );
+    }
+    return beat;
+}
+
 // --------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 void dev_hw_reset_delay ( void ) {
@@ -522,4 +689,117 @@ void dev_read_delay ( void ) {
     Delay_1us( );
 }
 
+static int16_t dev_saturate_int16 ( int32_t value ) 
+{
+    if ( value > INT16_MAX ) 
+    {
+        return INT16_MAX;
+    }
+    if ( value < INT16_MIN ) 
+    {
+        return INT16_MIN;
+    }
+    return ( int16_t ) value;
+}
+
+static int16_t dev_qrs_high_pass ( ecg2_qrs_t *qrs, int16_t sample ) 
+{
+    // DC blocker y = x - x1 + ( 1 - 2^-k ) * y1, corner at about fs / ( 2 * pi * 2^k ).
+    qrs->hp_y1 += ( ( int32_t ) sample - qrs->hp_x1 ) * 256 - ( qrs->hp_y1 >> ECG2_QRS_HP_SHIFT );
+    qrs->hp_x1 = sample;
+    return dev_saturate_int16( qrs->hp_y1 / 256 );
+}
+
+static int16_t dev_qrs_notch ( ecg2_qrs_t *qrs, int16_t sample ) 
+{
+    int32_t acc = qrs->notch_b0 * ( sample + ( int32_t ) qrs->notch_x[ 1 ] ) + 
+                  qrs->notch_b1 * qrs->notch_x[ 0 ] - 
+                  qrs->notch_a1 * qrs->notch_y[ 0 ] - 
+                  qrs->notch_a2 * qrs->notch_y[ 1 ];
+    int16_t out = dev_saturate_int16( ( acc + ( 1l << ( ECG2_QRS_NOTCH_Q - 1 ) ) ) >> ECG2_QRS_NOTCH_Q );
+    qrs->notch_x[ 1 ] = qrs->notch_x[ 0 ];
+    qrs->notch_x[ 0 ] = sample;
+    qrs->notch_y[ 1 ] = qrs->notch_y[ 0 ];
+    qrs->notch_y[ 0 ] = out;
+    return out;
+}
+
+static uint32_t dev_qrs_integrate ( ecg2_qrs_t *qrs, int16_t sample ) 
+{
+    // Five point derivative ( 2x[n] + x[n-1] - x[n-3] - 2x[n-4] ) / 8.
+    int32_t deriv = ( 2l * sample + qrs->deriv_x[ 0 ] - qrs->deriv_x[ 2 ] - 2l * qrs->deriv_x[ 3 ] ) / 8;
+    uint32_t square = ( uint32_t ) ( deriv * deriv );
+    qrs->deriv_x[ 3 ] = qrs->deriv_x[ 2 ];
+    qrs->deriv_x[ 2 ] = qrs->deriv_x[ 1 ];
+    qrs->deriv_x[ 1 ] = qrs->deriv_x[ 0 ];
+    qrs->deriv_x[ 0 ] = sample;
+    if ( square > UINT16_MAX ) 
+    {
+        square = UINT16_MAX;
+    }
+    qrs->mwi_sum -= qrs->mwi_buf[ qrs->mwi_idx ];
+    qrs->mwi_buf[ qrs->mwi_idx ] = ( uint16_t ) square;
+    qrs->mwi_sum += square;
+    if ( ++qrs->mwi_idx >= qrs->mwi_len ) 
+    {
+        qrs->mwi_idx = 0;
+    }
+    return qrs->mwi_sum / qrs->mwi_len;
+}
+
+static void dev_qrs_update_threshold ( ecg2_qrs_t *qrs ) 
+{
+    if ( qrs->spki > qrs->npki ) 
+    {
+        qrs->threshold = qrs->npki + ( qrs->spki - qrs->npki ) / 4;
+    }
+    else 
+    {
+        qrs->threshold = qrs->npki;
+    }
+}
+
+static uint8_t dev_qrs_detect ( ecg2_qrs_t *qrs, uint32_t peak ) 
+{
+    uint32_t rr;
+    
+    if ( qrs->sample_cnt < qrs->learn_len ) 
+    {
+        // Learning phase, SPKI tracks the largest peak.
+        if ( peak > qrs->spki ) 
+        {
+            qrs->spki = peak;
+        }
+        return ECG2_QRS_NO_BEAT;
+    }
+    
+    if ( ( peak > qrs->threshold ) && 
+         ( ( 0 == qrs->last_beat ) || ( ( qrs->sample_cnt - qrs->last_beat ) > qrs->refractory ) ) ) 
+    {
+        qrs->spki = ( peak + 7 * qrs->spki ) / 8;
+        if ( qrs->last_beat ) 
+        {
+            rr = qrs->sample_cnt - qrs->last_beat;
+            if ( 0 == qrs->rr_sum ) 
+            {
+                qrs->rr_sum = rr << ECG2_QRS_RR_AVG_SHIFT;
+            }
+            else 
+            {
+                qrs->rr_sum = qrs->rr_sum + rr - ( qrs->rr_sum >> ECG2_QRS_RR_AVG_SHIFT );
+            }
+            qrs->heart_rate = ( uint16_t ) ( ( ( 60ul * qrs->sample_rate ) << ECG2_QRS_RR_AVG_SHIFT ) / qrs->rr_sum );
+        }
+        qrs->last_beat = qrs->sample_cnt;
+        dev_qrs_update_threshold( qrs );
+        return ECG2_QRS_BEAT;
+    }
+    if ( peak <= qrs->threshold ) 
+    {
+        qrs->npki = ( peak + 7 * qrs->npki ) / 8;
+        dev_qrs_update_threshold( qrs );
+    }
+    return ECG2_QRS_NO_BEAT;
+}
+
 // ------------------------------------------------------------------------- END
@@ -256,9 +256,7 @@ uint8_t eeram2_read_byte ( eeram2_t *ctx, uint32_t reg )
 
 uint8_t eeram2_write_continuous ( eeram2_t *ctx, uint32_t reg, uint8_t *p_tx_data, uint8_t n_bytes )
 {
-    uint8_t tx_buf[ 256 ];
-    uint8_t n_cnt;
-
+    uint8_t tx_buf[ 4 ];
     uint8_t status;
 
     status = EERAM2_SUCCESS;
@@ -273,14 +271,10 @@ uint8_t eeram2_write_continuous ( eeram2_t *ctx, uint32_t reg, uint8_t *p_tx_dat
     tx_buf[ 2 ] = ( uint8_t ) ( reg >> 8 );
     tx_buf[ 3 ] = ( uint8_t ) reg;
 
-    for ( n_cnt = 0; n_cnt < n_bytes; n_cnt++ )
-    {
-        tx_buf[ n_cnt + 4 ] = p_tx_data[ n_cnt ];
-    }
-
     spi_master_select_device( ctx->chip_select );
 
-    spi_master_write( &ctx->spi, tx_buf, n_bytes );
+    spi_master_write( &ctx->spi, tx_buf, 4 );
+    spi_master_write( &ctx->spi, p_tx_data, n_bytes );
 
     spi_master_deselect_device( ctx->chip_select ); 
 
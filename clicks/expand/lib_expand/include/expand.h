@@ -175,6 +175,7 @@
  * \defgroup expand_iocon Expand IOCON
  * \{
  */
+#define EXPAND_IOCON_MIRROR                                       0x40
 #define EXPAND_IOCON_BYTE_MODE                                    0x20
 #define EXPAND_IOCON_HAEN                                         0x08
 
@@ -201,6 +202,23 @@
 #define EXPAND_INT_ERR                                            0xFF
 /** \} */
 
+/**
+ * \defgroup cache Register Cache
+ * \{
+ */
+#define EXPAND_PORT_A                                             0x00
+#define EXPAND_PORT_B                                             0x01
+
+#define EXPAND_CACHE_DIRTY_IODIRA                                 0x01
+#define EXPAND_CACHE_DIRTY_IODIRB                                 0x02
+#define EXPAND_CACHE_DIRTY_GPPUA                                  0x04
+#define EXPAND_CACHE_DIRTY_GPPUB                                  0x08
+#define EXPAND_CACHE_DIRTY_OLATA                                  0x10
+#define EXPAND_CACHE_DIRTY_OLATB                                  0x20
+
+#define EXPAND_CACHE_REG_BLOCK_SIZE                               22
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -254,6 +272,28 @@ typedef struct
 
 } expand_cfg_t;
 
+/**
+ * @brief Per-device register cache definition.
+ *
+ * Shadow of the output latch, direction and pull-up registers of one MCP23S17
+ * and the last read input state. Bit operations on the cache are local, and
+ * only the registers flagged in @b dirty are written by @b expand_cache_commit.
+ */
+typedef struct
+{
+    uint8_t mod_cmd;
+
+    uint8_t iodir[ 2 ];
+    uint8_t gppu[ 2 ];
+    uint8_t olat[ 2 ];
+    uint8_t gpio[ 2 ];
+
+    uint8_t dirty;
+    uint8_t gpio_valid;
+    uint8_t int_enabled;
+
+} expand_cache_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -621,6 +661,141 @@ void expand_reset ( expand_t *ctx );
  */
 uint8_t expand_get_interrupt( expand_t *ctx );
 
+/**
+ * @brief Register cache initialization function.
+ *
+ * @param ctx          Click object.
+ * @param cache        Register cache object.
+ * @param mod_cmd      module address
+ *
+ * @description Function binds the cache to one MCP23S17 chip, clears IOCON.SEQOP if set
+ * and fills the cache with a single sequential read of the whole BANK 0 register block.
+ * @note BANK 0 addressing is required, which is the power-on state of the chip.
+ */
+void expand_cache_init ( expand_t *ctx, expand_cache_t *cache, uint8_t mod_cmd );
+
+/**
+ * @brief Cached write port function.
+ *
+ * @param cache        Register cache object.
+ * @param port         EXPAND_PORT_A or EXPAND_PORT_B
+ * @param write_data   output latch value
+ *
+ * @description Function updates the cached output latch of the selected port.
+ * @note The change is sent to the chip by @b expand_cache_commit.
+ */
+void expand_cache_write_port ( expand_cache_t *cache, uint8_t port, uint8_t write_data );
+
+/**
+ * @brief Cached set bits function.
+ *
+ * @param cache        Register cache object.
+ * @param port         EXPAND_PORT_A or EXPAND_PORT_B
+ * @param bit_mask     bits mask
+ *
+ * @description Function sets bits of the cached output latch of the selected port.
+ * @note The change is sent to the chip by @b expand_cache_commit.
+ */
+void expand_cache_set_bits ( expand_cache_t *cache, uint8_t port, uint8_t bit_mask );
+
+/**
+ * @brief Cached clear bits function.
+ *
+ * @param cache        Register cache object.
+ * @param port         EXPAND_PORT_A or EXPAND_PORT_B
+ * @param bit_mask     bits mask
+ *
+ * @description Function clears bits of the cached output latch of the selected port.
+ * @note The change is sent to the chip by @b expand_cache_commit.
+ */
+void expand_cache_clear_bits ( expand_cache_t *cache, uint8_t port, uint8_t bit_mask );
+
+/**
+ * @brief Cached toggle bits function.
+ *
+ * @param cache        Register cache object.
+ * @param port         EXPAND_PORT_A or EXPAND_PORT_B
+ * @param bit_mask     bits mask
+ *
+ * @description Function toggles bits of the cached output latch of the selected port.
+ * @note The change is sent to the chip by @b expand_cache_commit.
+ */
+void expand_cache_toggle_bits ( expand_cache_t *cache, uint8_t port, uint8_t bit_mask );
+
+/**
+ * @brief Cached set direction function.
+ *
+ * @param cache        Register cache object.
+ * @param port         EXPAND_PORT_A or EXPAND_PORT_B
+ * @param write_data   direction value ( 1 - input, 0 - output )
+ *
+ * @description Function updates the cached direction register of the selected port.
+ * @note The change is sent to the chip by @b expand_cache_commit.
+ */
+void expand_cache_set_direction ( expand_cache_t *cache, uint8_t port, uint8_t write_data );
+
+/**
+ * @brief Cached set pull-ups function.
+ *
+ * @param cache        Register cache object.
+ * @param port         EXPAND_PORT_A or EXPAND_PORT_B
+ * @param write_data   pull up value
+ *
+ * @description Function updates the cached pull-up register of the selected port.
+ * @note The change is sent to the chip by @b expand_cache_commit.
+ */
+void expand_cache_set_pull_ups ( expand_cache_t *cache, uint8_t port, uint8_t write_data );
+
+/**
+ * @brief Register cache commit function.
+ *
+ * @param ctx          Click object.
+ * @param cache        Register cache object.
+ *
+ * @description Function writes only the changed cached registers to the chip.
+ * PORTA and PORTB registers of the same kind are written in one sequential burst.
+ * A direction change also updates GPINTEN when the interrupt is enabled and
+ * invalidates the cached inputs.
+ */
+void expand_cache_commit ( expand_t *ctx, expand_cache_t *cache );
+
+/**
+ * @brief Enable input change interrupt function.
+ *
+ * @param ctx          Click object.
+ * @param cache        Register cache object.
+ *
+ * @description Function enables interrupt-on-change for all pins configured as inputs
+ * in the cache, with INTA and INTB mirrored to the INT pin. From then on
+ * @b expand_cache_read_inputs reads the chip only when the INT pin is asserted.
+ * @note Pending direction changes should be committed before calling this function.
+ */
+void expand_cache_enable_interrupt ( expand_t *ctx, expand_cache_t *cache );
+
+/**
+ * @brief Cached read inputs function.
+ *
+ * @param ctx          Click object.
+ * @param cache        Register cache object.
+ *
+ * @return result      input state ( PORTA & PORTB )
+ *
+ * @description Function returns the 16-bit input state of both ports. Both GPIO
+ * registers are read in one burst when the cache is invalid, when the interrupt
+ * is not enabled or when the INT pin signals a change, otherwise the cached
+ * state is returned.
+ */
+uint16_t expand_cache_read_inputs ( expand_t *ctx, expand_cache_t *cache );
+
+/**
+ * @brief Invalidate cached inputs function.
+ *
+ * @param cache        Register cache object.
+ *
+ * @description Function forces the next @b expand_cache_read_inputs to read the chip.
+ */
+void expand_cache_invalidate_inputs ( expand_cache_t *cache );
+
 #ifdef __cplusplus
 }
 #endif
@@ -33,6 +33,15 @@
 
 #define EXPAND_DUMMY 0
 
+#define EXPAND_INT_ASSERTED    0
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static void dev_read_block ( expand_t *ctx, uint8_t mod_cmd, uint8_t reg_addr, uint8_t *data_buf, uint8_t len );
+
+static void dev_cache_write_pair ( expand_t *ctx, expand_cache_t *cache, uint8_t reg_a, 
+                                   uint8_t *data_buf, uint8_t dirty_a, uint8_t dirty_b );
+
 
 void expand_cfg_setup ( expand_cfg_t *cfg )
 {
@@ -300,5 +309,191 @@ uint8_t expand_get_interrupt ( expand_t *ctx )
 {
     return digital_in_read( &ctx->int_pin );
 }
+
+void expand_cache_init ( expand_t *ctx, expand_cache_t *cache, uint8_t mod_cmd )
+{
+    uint8_t regs[ EXPAND_CACHE_REG_BLOCK_SIZE ];
+    uint8_t iocon;
+
+    cache->mod_cmd = mod_cmd;
+    cache->dirty = 0;
+    cache->int_enabled = 0;
+
+    iocon = expand_read_byte( ctx, mod_cmd, EXPAND_IOCON_BANK0 );
+    if ( iocon & EXPAND_IOCON_BYTE_MODE )
+    {
+        expand_write_byte( ctx, mod_cmd, EXPAND_IOCON_BANK0, iocon & ~EXPAND_IOCON_BYTE_MODE );
+    }
+
+    dev_read_block( ctx, mod_cmd, EXPAND_IODIRA_BANK0, regs, EXPAND_CACHE_REG_BLOCK_SIZE );
+
+    cache->iodir[ EXPAND_PORT_A ] = regs[ EXPAND_IODIRA_BANK0 ];
+    cache->iodir[ EXPAND_PORT_B ] = regs[ EXPAND_IODIRB_BANK0 ];
+    cache->gppu[ EXPAND_PORT_A ] = regs[ EXPAND_GPPUA_BANK0 ];
+    cache->gppu[ EXPAND_PORT_B ] = regs[ EXPAND_GPPUB_BANK0 ];
+    cache->olat[ EXPAND_PORT_A ] = regs[ EXPAND_OLATA_BANK0 ];
+    cache->olat[ EXPAND_PORT_B ] = regs[ EXPAND_OLATB_BANK0 ];
+    cache->gpio[ EXPAND_PORT_A ] = regs[ EXPAND_GPIOA_BANK0 ];
+    cache->gpio[ EXPAND_PORT_B ] = regs[ EXPAND_GPIOB_BANK0 ];
+    cache->gpio_valid = 1;
+}
+
+void expand_cache_write_port ( expand_cache_t *cache, uint8_t port, uint8_t write_data )
+{
+    port &= EXPAND_PORT_B;
+    cache->olat[ port ] = write_data;
+    cache->dirty |= ( EXPAND_CACHE_DIRTY_OLATA << port );
+}
+
+void expand_cache_set_bits ( expand_cache_t *cache, uint8_t port, uint8_t bit_mask )
+{
+    port &= EXPAND_PORT_B;
+    expand_cache_write_port( cache, port, cache->olat[ port ] | bit_mask );
+}
+
+void expand_cache_clear_bits ( expand_cache_t *cache, uint8_t port, uint8_t bit_mask )
+{
+    port &= EXPAND_PORT_B;
+    expand_cache_write_port( cache, port, cache->olat[ port ] & ~bit_mask );
+}
+
+void expand_cache_toggle_bits ( expand_cache_t *cache, uint8_t port, uint8_t bit_mask )
+{
+    port &= EXPAND_PORT_B;
+    expand_cache_write_port( cache, port, cache->olat[ port ] ^ bit_mask );
+}
+
+void expand_cache_set_direction ( expand_cache_t *cache, uint8_t port, uint8_t write_data )
+{
+    port &= EXPAND_PORT_B;
+    cache->iodir[ port ] = write_data;
+    cache->dirty |= ( EXPAND_CACHE_DIRTY_IODIRA << port );
+}
+
+void expand_cache_set_pull_ups ( expand_cache_t *cache, uint8_t port, uint8_t write_data )
+{
+    port &= EXPAND_PORT_B;
+    cache->gppu[ port ] = write_data;
+    cache->dirty |= ( EXPAND_CACHE_DIRTY_GPPUA << port );
+}
+
+void expand_cache_commit ( expand_t *ctx, expand_cache_t *cache )
+{
+    if ( 0 == cache->dirty )
+    {
+        return;
+    }
+
+    // Direction first, so that new latch values appear on pins switched to outputs at once.
+    if ( cache->dirty & ( EXPAND_CACHE_DIRTY_IODIRA | EXPAND_CACHE_DIRTY_IODIRB ) )
+    {
+        dev_cache_write_pair( ctx, cache, EXPAND_IODIRA_BANK0, cache->iodir, 
+                              EXPAND_CACHE_DIRTY_IODIRA, EXPAND_CACHE_DIRTY_IODIRB );
+
+        // Interrupt-on-change follows the direction, and new inputs have no cached level yet.
+        if ( cache->int_enabled )
+        {
+            expand_write_byte( ctx, cache->mod_cmd, EXPAND_GPINTENA_BANK0, cache->iodir[ EXPAND_PORT_A ] );
+            expand_write_byte( ctx, cache->mod_cmd, EXPAND_GPINTENB_BANK0, cache->iodir[ EXPAND_PORT_B ] );
+        }
+        cache->gpio_valid = 0;
+    }
+    dev_cache_write_pair( ctx, cache, EXPAND_GPPUA_BANK0, cache->gppu, 
+                          EXPAND_CACHE_DIRTY_GPPUA, EXPAND_CACHE_DIRTY_GPPUB );
+    dev_cache_write_pair( ctx, cache, EXPAND_OLATA_BANK0, cache->olat, 
+                          EXPAND_CACHE_DIRTY_OLATA, EXPAND_CACHE_DIRTY_OLATB );
+}
+
+void expand_cache_enable_interrupt ( expand_t *ctx, expand_cache_t *cache )
+{
+    uint8_t iocon;
+
+    iocon = expand_read_byte( ctx, cache->mod_cmd, EXPAND_IOCON_BANK0 );
+    expand_write_byte( ctx, cache->mod_cmd, EXPAND_IOCON_BANK0, iocon | EXPAND_IOCON_MIRROR );
+
+    // Compare against the previous value ( INTCON = 0 ) on every input pin.
+    expand_write_byte( ctx, cache->mod_cmd, EXPAND_INTCONA_BANK0, 0x00 );
+    expand_write_byte( ctx, cache->mod_cmd, EXPAND_INTCONB_BANK0, 0x00 );
+    expand_write_byte( ctx, cache->mod_cmd, EXPAND_GPINTENA_BANK0, cache->iodir[ EXPAND_PORT_A ] );
+    expand_write_byte( ctx, cache->mod_cmd, EXPAND_GPINTENB_BANK0, cache->iodir[ EXPAND_PORT_B ] );
+
+    cache->int_enabled = 1;
+    cache->gpio_valid = 0;
+}
+
+uint16_t expand_cache_read_inputs ( expand_t *ctx, expand_cache_t *cache )
+{
+    uint16_t result;
+
+    if ( ( 0 == cache->gpio_valid ) || ( 0 == cache->int_enabled ) || 
+         ( EXPAND_INT_ASSERTED == digital_in_read( &ctx->int_pin ) ) )
+    {
+        // Reading GPIO also clears the pending interrupt.
+        dev_read_block( ctx, cache->mod_cmd, EXPAND_GPIOA_BANK0, cache->gpio, 2 );
+        cache->gpio_valid = 1;
+    }
+
+    result = cache->gpio[ EXPAND_PORT_A ];
+    result <<= 8;
+    result |= cache->gpio[ EXPAND_PORT_B ];
+
+    return result;
+}
+
+void expand_cache_invalidate_inputs ( expand_cache_t *cache )
+{
+    cache->gpio_valid = 0;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void dev_read_block ( expand_t *ctx, uint8_t mod_cmd, uint8_t reg_addr, uint8_t *data_buf, uint8_t len )
+{
+    uint8_t buffer_write[ 2 ];
+
+    mod_cmd <<= 1;
+    buffer_write[ 0 ] = EXPAND_SPI_DEVICE_OPCODE | mod_cmd | EXPAND_OPCODE_READ;
+    buffer_write[ 1 ] = reg_addr;
+
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write( &ctx->spi, buffer_write, 2 );
+    spi_master_read( &ctx->spi, data_buf, len );
+    spi_master_deselect_device( ctx->chip_select );
+}
+
+static void dev_cache_write_pair ( expand_t *ctx, expand_cache_t *cache, uint8_t reg_a, 
+                                   uint8_t *data_buf, uint8_t dirty_a, uint8_t dirty_b )
+{
+    uint8_t buffer_write[ 4 ];
+    uint8_t len = 0;
+
+    buffer_write[ 0 ] = ( EXPAND_SPI_DEVICE_OPCODE | ( cache->mod_cmd << 1 ) ) & EXPAND_OPCODE_WRITE;
+
+    if ( cache->dirty & dirty_a )
+    {
+        buffer_write[ 1 ] = reg_a;
+        buffer_write[ 2 ] = data_buf[ EXPAND_PORT_A ];
+        len = 3;
+        if ( cache->dirty & dirty_b )
+        {
+            buffer_write[ 3 ] = data_buf[ EXPAND_PORT_B ];
+            len = 4;
+        }
+    }
+    else if ( cache->dirty & dirty_b )
+    {
+        buffer_write[ 1 ] = reg_a + 1;
+        buffer_write[ 2 ] = data_buf[ EXPAND_PORT_B ];
+        len = 3;
+    }
+
+    if ( len )
+    {
+        spi_master_select_device( ctx->chip_select );
+        spi_master_write( &ctx->spi, buffer_write, len );
+        spi_master_deselect_device( ctx->chip_select );
+        cache->dirty &= ~( dirty_a | dirty_b );
+    }
+}
 // ------------------------------------------------------------------------- END
 
@@ -78,6 +78,7 @@
 #define EXPAND2_RETVAL  uint8_t
 
 #define EXPAND2_OK           0x00
+#define EXPAND2_ERROR        0x01
 #define EXPAND2_INIT_ERROR   0xFF
 /** \} */
 
@@ -179,6 +180,35 @@
 
 #define EXPAND2_INT_ERR                                             0xFF
 /** \} */
+
+/**
+ * \defgroup iocon_bits IOCON Bits
+ * \{
+ */
+#define EXPAND2_IOCON_BANK                                          0x80
+#define EXPAND2_IOCON_MIRROR                                        0x40
+#define EXPAND2_IOCON_SEQOP                                         0x20
+#define EXPAND2_IOCON_DISSLW                                        0x10
+#define EXPAND2_IOCON_ODR                                           0x04
+#define EXPAND2_IOCON_INTPOL                                        0x02
+/** \} */
+
+/**
+ * \defgroup cache Register Cache
+ * \{
+ */
+#define EXPAND2_PORT_A                                              0x00
+#define EXPAND2_PORT_B                                              0x01
+
+#define EXPAND2_CACHE_DIRTY_IODIRA                                  0x01
+#define EXPAND2_CACHE_DIRTY_IODIRB                                  0x02
+#define EXPAND2_CACHE_DIRTY_GPPUA                                   0x04
+#define EXPAND2_CACHE_DIRTY_GPPUB                                   0x08
+#define EXPAND2_CACHE_DIRTY_OLATA                                   0x10
+#define EXPAND2_CACHE_DIRTY_OLATB                                   0x20
+
+#define EXPAND2_CACHE_REG_BLOCK_SIZE                                22
+/** \} */
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -231,6 +261,28 @@ typedef struct
 
 } expand2_cfg_t;
 
+/**
+ * @brief Per-device register cache definition.
+ *
+ * Shadow of the output latch, direction and pull-up registers of one MCP23017
+ * and the last read input state. Bit operations on the cache are local, and
+ * only the registers flagged in @b dirty are written by @b expand2_cache_commit.
+ */
+typedef struct
+{
+    uint8_t module_address;
+
+    uint8_t iodir[ 2 ];
+    uint8_t gppu[ 2 ];
+    uint8_t olat[ 2 ];
+    uint8_t gpio[ 2 ];
+
+    uint8_t dirty;
+    uint8_t gpio_valid;
+    uint8_t int_enabled;
+
+} expand2_cache_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -591,6 +643,143 @@ void expand2_reset( expand2_t *ctx );
  */
 uint8_t expand2_getInterrupt( expand2_t *ctx );
 
+/**
+ * @brief Register cache initialization function.
+ *
+ * @param ctx                                Click object.
+ * @param cache                              Register cache object.
+ * @param module_address                     module address
+ * @return EXPAND2_OK on success, EXPAND2_ERROR on I2C error.
+ *
+ * @description Function binds the cache to one MCP23017 chip, clears IOCON.SEQOP if set
+ * and fills the cache with a single sequential read of the whole BANK 0 register block.
+ * @note BANK 0 addressing is required, which is the power-on state of the chip.
+ */
+EXPAND2_RETVAL expand2_cache_init ( expand2_t *ctx, expand2_cache_t *cache, uint8_t module_address );
+
+/**
+ * @brief Cached write port function.
+ *
+ * @param cache                              Register cache object.
+ * @param port                               EXPAND2_PORT_A or EXPAND2_PORT_B
+ * @param write_data                         output latch value
+ *
+ * @description Function updates the cached output latch of the selected port.
+ * @note The change is sent to the chip by @b expand2_cache_commit.
+ */
+void expand2_cache_write_port ( expand2_cache_t *cache, uint8_t port, uint8_t write_data );
+
+/**
+ * @brief Cached set bits function.
+ *
+ * @param cache                              Register cache object.
+ * @param port                               EXPAND2_PORT_A or EXPAND2_PORT_B
+ * @param bit_mask                           bits mask
+ *
+ * @description Function sets bits of the cached output latch of the selected port.
+ * @note The change is sent to the chip by @b expand2_cache_commit.
+ */
+void expand2_cache_set_bits ( expand2_cache_t *cache, uint8_t port, uint8_t bit_mask );
+
+/**
+ * @brief Cached clear bits function.
+ *
+ * @param cache                              Register cache object.
+ * @param port                               EXPAND2_PORT_A or EXPAND2_PORT_B
+ * @param bit_mask                           bits mask
+ *
+ * @description Function clears bits of the cached output latch of the selected port.
+ * @note The change is sent to the chip by @b expand2_cache_commit.
+ */
+void expand2_cache_clear_bits ( expand2_cache_t *cache, uint8_t port, uint8_t bit_mask );
+
+/**
+ * @brief Cached toggle bits function.
+ *
+ * @param cache                              Register cache object.
+ * @param port                               EXPAND2_PORT_A or EXPAND2_PORT_B
+ * @param bit_mask                           bits mask
+ *
+ * @description Function toggles bits of the cached output latch of the selected port.
+ * @note The change is sent to the chip by @b expand2_cache_commit.
+ */
+void expand2_cache_toggle_bits ( expand2_cache_t *cache, uint8_t port, uint8_t bit_mask );
+
+/**
+ * @brief Cached set direction function.
+ *
+ * @param cache                              Register cache object.
+ * @param port                               EXPAND2_PORT_A or EXPAND2_PORT_B
+ * @param write_data                         direction value ( 1 - input, 0 - output )
+ *
+ * @description Function updates the cached direction register of the selected port.
+ * @note The change is sent to the chip by @b expand2_cache_commit.
+ */
+void expand2_cache_set_direction ( expand2_cache_t *cache, uint8_t port, uint8_t write_data );
+
+/**
+ * @brief Cached set pull-ups function.
+ *
+ * @param cache                              Register cache object.
+ * @param port                               EXPAND2_PORT_A or EXPAND2_PORT_B
+ * @param write_data                         pull up value
+ *
+ * @description Function updates the cached pull-up register of the selected port.
+ * @note The change is sent to the chip by @b expand2_cache_commit.
+ */
+void expand2_cache_set_pull_ups ( expand2_cache_t *cache, uint8_t port, uint8_t write_data );
+
+/**
+ * @brief Register cache commit function.
+ *
+ * @param ctx                                Click object.
+ * @param cache                              Register cache object.
+ * @return EXPAND2_OK on success, EXPAND2_ERROR on I2C error.
+ *
+ * @description Function writes only the changed cached registers to the chip.
+ * PORTA and PORTB registers of the same kind are written in one sequential burst.
+ * A direction change also updates GPINTEN when the interrupt is enabled and
+ * invalidates the cached inputs.
+ */
+EXPAND2_RETVAL expand2_cache_commit ( expand2_t *ctx, expand2_cache_t *cache );
+
+/**
+ * @brief Enable input change interrupt function.
+ *
+ * @param ctx                                Click object.
+ * @param cache                              Register cache object.
+ * @return EXPAND2_OK on success, EXPAND2_ERROR on I2C error.
+ *
+ * @description Function enables interrupt-on-change for all pins configured as inputs
+ * in the cache, with INTA and INTB mirrored to the INT pin. From then on
+ * @b expand2_cache_read_inputs reads the chip only when the INT pin is asserted.
+ * @note Pending direction changes should be committed before calling this function.
+ */
+EXPAND2_RETVAL expand2_cache_enable_interrupt ( expand2_t *ctx, expand2_cache_t *cache );
+
+/**
+ * @brief Cached read inputs function.
+ *
+ * @param ctx                                Click object.
+ * @param cache                              Register cache object.
+ * @return result                            input state ( PORTA & PORTB )
+ *
+ * @description Function returns the 16-bit input state of both ports in the same
+ * format as @b expand2_read_both_ports. Both GPIO registers are read in one burst
+ * when the cache is invalid, when the interrupt is not enabled or when the INT pin
+ * signals a change, otherwise the cached state is returned.
+ */
+uint16_t expand2_cache_read_inputs ( expand2_t *ctx, expand2_cache_t *cache );
+
+/**
+ * @brief Invalidate cached inputs function.
+ *
+ * @param cache                              Register cache object.
+ *
+ * @description Function forces the next @b expand2_cache_read_inputs to read the chip.
+ */
+void expand2_cache_invalidate_inputs ( expand2_cache_t *cache );
+
 #ifdef __cplusplus
 }
 #endif
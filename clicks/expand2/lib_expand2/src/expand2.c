@@ -29,6 +29,15 @@
 
 #include "expand2.h"
 
+// ------------------------------------------------------------- PRIVATE MACROS 
+
+#define EXPAND2_INT_ASSERTED    0
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static err_t dev_cache_write_pair ( expand2_t *ctx, expand2_cache_t *cache, uint8_t reg_a, 
+                                    uint8_t *data_buf, uint8_t dirty_a, uint8_t dirty_b );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void expand2_cfg_setup ( expand2_cfg_t *cfg )
@@ -95,9 +104,9 @@ void expand2_generic_write ( expand2_t *ctx, uint8_t reg, uint8_t *data_buf, uin
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );    
@@ -322,5 +331,232 @@ uint8_t expand2_getInterrupt( expand2_t *ctx )
     return state;
 }
 
+EXPAND2_RETVAL expand2_cache_init ( expand2_t *ctx, expand2_cache_t *cache, uint8_t module_address )
+{
+    uint8_t reg = EXPAND2_IOCON_BANK0;
+    uint8_t regs[ EXPAND2_CACHE_REG_BLOCK_SIZE ];
+    uint8_t tx_buf[ 2 ];
+    uint8_t iocon;
+
+    cache->module_address = module_address;
+    cache->dirty = 0;
+    cache->gpio_valid = 0;
+    cache->int_enabled = 0;
+
+    ctx->slave_address = module_address;
+    i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
+
+    // The burst accesses below need the address pointer to auto-increment.
+    if ( i2c_master_write_then_read( &ctx->i2c, &reg, 1, &iocon, 1 ) )
+    {
+        return EXPAND2_ERROR;
+    }
+    if ( iocon & EXPAND2_IOCON_SEQOP )
+    {
+        tx_buf[ 0 ] = EXPAND2_IOCON_BANK0;
+        tx_buf[ 1 ] = iocon & ~EXPAND2_IOCON_SEQOP;
+        if ( i2c_master_write( &ctx->i2c, tx_buf, 2 ) )
+        {
+            return EXPAND2_ERROR;
+        }
+    }
+
+    reg = EXPAND2_IODIRA_BANK0;
+    if ( i2c_master_write_then_read( &ctx->i2c, &reg, 1, regs, EXPAND2_CACHE_REG_BLOCK_SIZE ) )
+    {
+        return EXPAND2_ERROR;
+    }
+
+    cache->iodir[ EXPAND2_PORT_A ] = regs[ EXPAND2_IODIRA_BANK0 ];
+    cache->iodir[ EXPAND2_PORT_B ] = regs[ EXPAND2_IODIRB_BANK0 ];
+    cache->gppu[ EXPAND2_PORT_A ] = regs[ EXPAND2_GPPUA_BANK0 ];
+    cache->gppu[ EXPAND2_PORT_B ] = regs[ EXPAND2_GPPUB_BANK0 ];
+    cache->olat[ EXPAND2_PORT_A ] = regs[ EXPAND2_OLATA_BANK0 ];
+    cache->olat[ EXPAND2_PORT_B ] = regs[ EXPAND2_OLATB_BANK0 ];
+    cache->gpio[ EXPAND2_PORT_A ] = regs[ EXPAND2_GPIOA_BANK0 ];
+    cache->gpio[ EXPAND2_PORT_B ] = regs[ EXPAND2_GPIOB_BANK0 ];
+    cache->gpio_valid = 1;
+
+    return EXPAND2_OK;
+}
+
+void expand2_cache_write_port ( expand2_cache_t *cache, uint8_t port, uint8_t write_data )
+{
+    port &= EXPAND2_PORT_B;
+    cache->olat[ port ] = write_data;
+    cache->dirty |= ( EXPAND2_CACHE_DIRTY_OLATA << port );
+}
+
+void expand2_cache_set_bits ( expand2_cache_t *cache, uint8_t port, uint8_t bit_mask )
+{
+    port &= EXPAND2_PORT_B;
+    expand2_cache_write_port( cache, port, cache->olat[ port ] | bit_mask );
+}
+
+void expand2_cache_clear_bits ( expand2_cache_t *cache, uint8_t port, uint8_t bit_mask )
+{
+    port &= EXPAND2_PORT_B;
+    expand2_cache_write_port( cache, port, cache->olat[ port ] & ~bit_mask );
+}
+
+void expand2_cache_toggle_bits ( expand2_cache_t *cache, uint8_t port, uint8_t bit_mask )
+{
+    port &= EXPAND2_PORT_B;
+    expand2_cache_write_port( cache, port, cache->olat[ port ] ^ bit_mask );
+}
+
+void expand2_cache_set_direction ( expand2_cache_t *cache, uint8_t port, uint8_t write_data )
+{
+    port &= EXPAND2_PORT_B;
+    cache->iodir[ port ] = write_data;
+    cache->dirty |= ( EXPAND2_CACHE_DIRTY_IODIRA << port );
+}
+
+void expand2_cache_set_pull_ups ( expand2_cache_t *cache, uint8_t port, uint8_t write_data )
+{
+    port &= EXPAND2_PORT_B;
+    cache->gppu[ port ] = write_data;
+    cache->dirty |= ( EXPAND2_CACHE_DIRTY_GPPUA << port );
+}
+
+EXPAND2_RETVAL expand2_cache_commit ( expand2_t *ctx, expand2_cache_t *cache )
+{
+    err_t error_flag = I2C_MASTER_SUCCESS;
+    uint8_t tx_buf[ 3 ];
+
+    if ( 0 == cache->dirty )
+    {
+        return EXPAND2_OK;
+    }
+
+    ctx->slave_address = cache->module_address;
+    i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
+
+    // Direction first, so that new latch values appear on pins switched to outputs at once.
+    if ( cache->dirty & ( EXPAND2_CACHE_DIRTY_IODIRA | EXPAND2_CACHE_DIRTY_IODIRB ) )
+    {
+        error_flag |= dev_cache_write_pair( ctx, cache, EXPAND2_IODIRA_BANK0, cache->iodir, 
+                                            EXPAND2_CACHE_DIRTY_IODIRA, EXPAND2_CACHE_DIRTY_IODIRB );
+
+        // Interrupt-on-change follows the direction, and new inputs have no cached level yet.
+        if ( cache->int_enabled )
+        {
+            tx_buf[ 0 ] = EXPAND2_GPINTENA_BANK0;
+            tx_buf[ 1 ] = cache->iodir[ EXPAND2_PORT_A ];
+            tx_buf[ 2 ] = cache->iodir[ EXPAND2_PORT_B ];
+            error_flag |= i2c_master_write( &ctx->i2c, tx_buf, 3 );
+        }
+        cache->gpio_valid = 0;
+    }
+    error_flag |= dev_cache_write_pair( ctx, cache, EXPAND2_GPPUA_BANK0, cache->gppu, 
+                                        EXPAND2_CACHE_DIRTY_GPPUA, EXPAND2_CACHE_DIRTY_GPPUB );
+    error_flag |= dev_cache_write_pair( ctx, cache, EXPAND2_OLATA_BANK0, cache->olat, 
+                                        EXPAND2_CACHE_DIRTY_OLATA, EXPAND2_CACHE_DIRTY_OLATB );
+
+    return ( I2C_MASTER_SUCCESS == error_flag ) ? EXPAND2_OK : EXPAND2_ERROR;
+}
+
+EXPAND2_RETVAL expand2_cache_enable_interrupt ( expand2_t *ctx, expand2_cache_t *cache )
+{
+    err_t error_flag = I2C_MASTER_SUCCESS;
+    uint8_t tx_buf[ 3 ];
+
+    ctx->slave_address = cache->module_address;
+    i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
+
+    tx_buf[ 0 ] = EXPAND2_IOCON_BANK0;
+    if ( i2c_master_write_then_read( &ctx->i2c, tx_buf, 1, &tx_buf[ 1 ], 1 ) )
+    {
+        return EXPAND2_ERROR;
+    }
+    tx_buf[ 1 ] |= EXPAND2_IOCON_MIRROR;
+    error_flag |= i2c_master_write( &ctx->i2c, tx_buf, 2 );
+
+    // Compare against the previous value ( INTCON = 0 ) on every input pin.
+    tx_buf[ 0 ] = EXPAND2_INTCONA_BANK0;
+    tx_buf[ 1 ] = 0x00;
+    tx_buf[ 2 ] = 0x00;
+    error_flag |= i2c_master_write( &ctx->i2c, tx_buf, 3 );
+
+    tx_buf[ 0 ] = EXPAND2_GPINTENA_BANK0;
+    tx_buf[ 1 ] = cache->iodir[ EXPAND2_PORT_A ];
+    tx_buf[ 2 ] = cache->iodir[ EXPAND2_PORT_B ];
+    error_flag |= i2c_master_write( &ctx->i2c, tx_buf, 3 );
+
+    cache->int_enabled = ( I2C_MASTER_SUCCESS == error_flag );
+    cache->gpio_valid = 0;
+
+    return ( I2C_MASTER_SUCCESS == error_flag ) ? EXPAND2_OK : EXPAND2_ERROR;
+}
+
+uint16_t expand2_cache_read_inputs ( expand2_t *ctx, expand2_cache_t *cache )
+{
+    uint8_t reg = EXPAND2_GPIOA_BANK0;
+    uint16_t result;
+
+    if ( ( 0 == cache->gpio_valid ) || ( 0 == cache->int_enabled ) || 
+         ( EXPAND2_INT_ASSERTED == digital_in_read( &ctx->int_pin ) ) )
+    {
+        ctx->slave_address = cache->module_address;
+        i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
+
+        // Reading GPIO also clears the pending interrupt.
+        if ( I2C_MASTER_SUCCESS == i2c_master_write_then_read( &ctx->i2c, &reg, 1, cache->gpio, 2 ) )
+        {
+            cache->gpio_valid = 1;
+        }
+    }
+
+    result = cache->gpio[ EXPAND2_PORT_A ];
+    result <<= 8;
+    result |= cache->gpio[ EXPAND2_PORT_B ];
+
+    return result;
+}
+
+void expand2_cache_invalidate_inputs ( expand2_cache_t *cache )
+{
+    cache->gpio_valid = 0;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static err_t dev_cache_write_pair ( expand2_t *ctx, expand2_cache_t *cache, uint8_t reg_a, 
+                                    uint8_t *data_buf, uint8_t dirty_a, uint8_t dirty_b )
+{
+    err_t error_flag = I2C_MASTER_SUCCESS;
+    uint8_t tx_buf[ 3 ];
+    uint8_t len = 0;
+
+    if ( cache->dirty & dirty_a )
+    {
+        tx_buf[ 0 ] = reg_a;
+        tx_buf[ 1 ] = data_buf[ EXPAND2_PORT_A ];
+        len = 2;
+        if ( cache->dirty & dirty_b )
+        {
+            tx_buf[ 2 ] = data_buf[ EXPAND2_PORT_B ];
+            len = 3;
+        }
+    }
+    else if ( cache->dirty & dirty_b )
+    {
+        tx_buf[ 0 ] = reg_a + 1;
+        tx_buf[ 1 ] = data_buf[ EXPAND2_PORT_B ];
+        len = 2;
+    }
+
+    if ( len )
+    {
+        error_flag = i2c_master_write( &ctx->i2c, tx_buf, len );
+        if ( I2C_MASTER_SUCCESS == error_flag )
+        {
+            cache->dirty &= ~( dirty_a | dirty_b );
+        }
+    }
+
+    return error_flag;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -106,10 +106,9 @@ fan_generic_write ( fan_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len )
 
     tx_buf[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = *data_in;
-        data_in++;
+        tx_buf[ cnt + 1 ] = data_in[ cnt ];
     }
 
     return i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
@@ -242,6 +242,25 @@
 #define FAN2_LUT_NBYTES  48
 /** \} */
 
+/**
+ * \defgroup lut_temp LUT Temperature Index
+ * \{
+ */
+#define FAN2_LUT_BASE_TEMP_CELS  16
+#define FAN2_LUT_STEP_CELS       2
+/** \} */
+
+/**
+ * \defgroup rpm_ctrl RPM Controller
+ * \{
+ */
+#define FAN2_CTRL_STALL_PERIODS   3
+#define FAN2_CTRL_KICK_PERIODS    2
+#define FAN2_CTRL_RESTART_MAX     3
+#define FAN2_CURVE_NPOINTS        11
+#define FAN2_AUTOTUNE_SETTLE_MS   3000
+/** \} */
+
 /** \} */ //  End limits group
 
 /**
@@ -275,7 +294,8 @@ typedef enum
     FAN2_ERR_REG_ADDR,
     FAN2_ERR_NDATA,
     FAN2_ERR_TEMP_RANGE,
-    FAN2_ERR_PWM_DUTY_RANGE
+    FAN2_ERR_PWM_DUTY_RANGE,
+    FAN2_ERR_FAN_STALL = 0xF9
 
 } fan2_err_t;
 
@@ -335,6 +355,51 @@ typedef struct
 
 } fan2_cfg_t;
 
+/**
+ * @brief Click monitor data definition.
+ */
+typedef struct
+{
+    uint16_t  tach1_rpm;
+    uint16_t  tach2_rpm;
+    float     remote_temp;
+    float     local_temp;
+
+} fan2_monitor_t;
+
+/**
+ * @brief Click duty to rpm curve definition.
+ */
+typedef struct
+{
+    //  Measured rpm at duty = idx * 100 / ( FAN2_CURVE_NPOINTS - 1 ) percents.
+    uint16_t  rpm[ FAN2_CURVE_NPOINTS ];
+
+} fan2_curve_t;
+
+/**
+ * @brief Click rpm controller definition.
+ */
+typedef struct
+{
+    //  Controller gains [percents per rpm, percents per rpm per second].
+    float  kp;
+    float  ki;
+    float  period_s;
+
+    //  Optional feed-forward curve.
+    const fan2_curve_t  *curve;
+
+    //  Controller state.
+    uint16_t  setpoint_rpm;
+    float     integral;
+    float     duty_per;
+    uint8_t   stall_cnt;
+    uint8_t   kick_cnt;
+    uint8_t   restart_cnt;
+
+} fan2_ctrl_t;
+
 /** \} */ //  End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 /**
@@ -549,6 +614,102 @@ uint8_t fan2_status( fan2_t *ctx, uint8_t flag_mask );
 fan2_err_t fan2_write_lut( fan2_t *ctx, uint8_t lut_addr, uint8_t *lut_data,
                 uint8_t n_data );
 
+/**
+ * @brief Monitor Read function.
+ *
+ * @param ctx  Click object.
+ * @param monitor  Memory where tachometer and temperature data be stored.
+ *
+ * @description This function reads both tachometers and both temperatures
+ * in a single I2C transaction.
+ * @note Stopped or disabled tachometer reads as 0 rpm.
+ */
+void fan2_read_monitor( fan2_t *ctx, fan2_monitor_t *monitor );
+
+/**
+ * @brief RPM Controller Initialization function.
+ *
+ * @param ctrl  Controller object.
+ * @param kp  Proportional gain [percents per rpm].
+ * @param ki  Integral gain [percents per rpm per second].
+ * @param period_ms  Control period in milliseconds.
+ * @param curve  Duty to rpm curve used as feed-forward, or NULL.
+ *
+ * @description This function initializes the PI rpm controller.
+ */
+void fan2_ctrl_init( fan2_ctrl_t *ctrl, float kp, float ki, uint16_t period_ms,
+                     const fan2_curve_t *curve );
+
+/**
+ * @brief RPM Controller Setpoint function.
+ *
+ * @param ctrl  Controller object.
+ * @param rpm  Desired fan speed in rpm.
+ *
+ * @description This function sets the rpm setpoint. If a curve is attached,
+ * the integrator is preloaded with the duty expected to hold the setpoint.
+ */
+void fan2_ctrl_set_rpm( fan2_ctrl_t *ctrl, uint16_t rpm );
+
+/**
+ * @brief RPM Controller Update function.
+ *
+ * @param ctx  Click object.
+ * @param ctrl  Controller object.
+ * @param monitor  Memory where monitor data of this period be stored, or NULL.
+ *
+ * @returns 0x0 - Ok,
+ *          0xF9 - Fan did not restart after FAN2_CTRL_RESTART_MAX attempts.
+ *
+ * @description This function executes one control period: reads the monitor
+ * registers, runs the PI loop with anti-windup on TACH1 and writes the new
+ * duty cycle. A stalled fan is kicked at full speed for FAN2_CTRL_KICK_PERIODS
+ * periods before the loop resumes.
+ * @note Must be called once every control period with direct fan control enabled.
+ */
+fan2_err_t fan2_ctrl_update( fan2_t *ctx, fan2_ctrl_t *ctrl, fan2_monitor_t *monitor );
+
+/**
+ * @brief Autotune function.
+ *
+ * @param ctx  Click object.
+ * @param curve  Memory where measured duty to rpm curve be stored.
+ *
+ * @description This function sweeps the duty cycle in FAN2_CURVE_NPOINTS steps
+ * and measures the settled TACH1 speed at each step.
+ * @note Blocks for FAN2_CURVE_NPOINTS * FAN2_AUTOTUNE_SETTLE_MS milliseconds.
+ */
+void fan2_autotune( fan2_t *ctx, fan2_curve_t *curve );
+
+/**
+ * @brief Curve Duty function.
+ *
+ * @param curve  Duty to rpm curve.
+ * @param rpm  Desired fan speed in rpm.
+ *
+ * @returns Duty cycle in percents needed to reach the desired speed.
+ *
+ * @description This function interpolates the duty cycle from the measured curve.
+ */
+float fan2_curve_duty( const fan2_curve_t *curve, uint16_t rpm );
+
+/**
+ * @brief Lookup Table Generate function.
+ *
+ * @param curve  Duty to rpm curve.
+ * @param temp_low  Temperature below which the fan runs at rpm_low.
+ * @param temp_high  Temperature above which the fan runs at rpm_high.
+ * @param rpm_low  Fan speed at temp_low.
+ * @param rpm_high  Fan speed at temp_high.
+ * @param lut_data  Memory where FAN2_LUT_NBYTES of LUT data be stored.
+ *
+ * @description This function generates a LUT which ramps the fan speed
+ * linearly in rpm between two temperatures. The result can be written by
+ * the fan2_write_lut function.
+ */
+void fan2_generate_lut( const fan2_curve_t *curve, int8_t temp_low, int8_t temp_high,
+                        uint16_t rpm_low, uint16_t rpm_high, uint8_t *lut_data );
+
 /**
  * @brief Software Reset function.
  *
@@ -36,6 +36,13 @@
 #define FAN2_RESOL_TEMP_CELS  0.125
 #define FAN2_RESOL_SPEED_PER  0.392156862745098
 
+//  Tachometer count to rpm conversion numerator.
+#define FAN2_TACHO_RPM_FACTOR  1500000ul
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static uint16_t fan2_tacho_to_rpm( uint16_t tacho );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void fan2_cfg_setup( fan2_cfg_t *cfg )
@@ -224,7 +231,6 @@ fan2_err_t fan2_write_temp( fan2_t *ctx, uint8_t temp_addr, float temp_cels )
 fan2_err_t fan2_read_tacho( fan2_t *ctx, uint8_t tacho_addr, uint16_t *tacho_rpm )
 {
     uint16_t tacho;
-    double res;
 
     if ( ( tacho_addr != 0x0E ) && ( tacho_addr != 0x52 ) &&
          ( tacho_addr != 0x54 ) )
@@ -234,12 +240,7 @@ fan2_err_t fan2_read_tacho( fan2_t *ctx, uint8_t tacho_addr, uint16_t *tacho_rpm
 
     fan2_generic_read_word( ctx, tacho_addr, &tacho );
 
-    res = 100000;
-    res /= tacho;
-    res /= 4;
-    res *= 60;
-
-    *tacho_rpm = (uint16_t)res;
+    *tacho_rpm = fan2_tacho_to_rpm( tacho );
 
     return FAN2_OK;
 }
@@ -320,6 +321,229 @@ fan2_err_t fan2_write_lut( fan2_t *ctx, uint8_t lut_addr, uint8_t *lut_data,
     return FAN2_OK;
 }
 
+void fan2_read_monitor( fan2_t *ctx, fan2_monitor_t *monitor )
+{
+    uint8_t reg_addr = FAN2_REG_TACH1_CNT;
+    uint8_t tmp_data[ 8 ];
+    int16_t temp;
+
+    //  TACH1, TACH2, remote and local temperature are consecutive registers.
+    i2c_master_write_then_read( &ctx->i2c, &reg_addr, 1, tmp_data, 8 );
+
+    monitor->tach1_rpm = fan2_tacho_to_rpm( ( ( uint16_t )tmp_data[ 0 ] << 8 ) | tmp_data[ 1 ] );
+    monitor->tach2_rpm = fan2_tacho_to_rpm( ( ( uint16_t )tmp_data[ 2 ] << 8 ) | tmp_data[ 3 ] );
+
+    temp = ( int16_t )( ( ( uint16_t )tmp_data[ 4 ] << 8 ) | tmp_data[ 5 ] );
+    monitor->remote_temp = ( float )( temp >> FAN2_TEMP_DATA_OFFSET ) * FAN2_RESOL_TEMP_CELS;
+
+    temp = ( int16_t )( ( ( uint16_t )tmp_data[ 6 ] << 8 ) | tmp_data[ 7 ] );
+    monitor->local_temp = ( float )( temp >> FAN2_TEMP_DATA_OFFSET ) * FAN2_RESOL_TEMP_CELS;
+}
+
+void fan2_ctrl_init( fan2_ctrl_t *ctrl, float kp, float ki, uint16_t period_ms,
+                     const fan2_curve_t *curve )
+{
+    ctrl->kp = kp;
+    ctrl->ki = ki;
+    ctrl->period_s = ( float )period_ms / 1000;
+    ctrl->curve = curve;
+
+    ctrl->setpoint_rpm = 0;
+    ctrl->integral = 0;
+    ctrl->duty_per = 0;
+    ctrl->stall_cnt = 0;
+    ctrl->kick_cnt = 0;
+    ctrl->restart_cnt = 0;
+}
+
+void fan2_ctrl_set_rpm( fan2_ctrl_t *ctrl, uint16_t rpm )
+{
+    ctrl->setpoint_rpm = rpm;
+    ctrl->stall_cnt = 0;
+    ctrl->restart_cnt = 0;
+
+    if ( ctrl->curve != NULL )
+    {
+        ctrl->integral = fan2_curve_duty( ctrl->curve, rpm );
+    }
+}
+
+fan2_err_t fan2_ctrl_update( fan2_t *ctx, fan2_ctrl_t *ctrl, fan2_monitor_t *monitor )
+{
+    fan2_monitor_t tmp_monitor;
+    float error;
+    float duty;
+
+    if ( monitor == NULL )
+    {
+        monitor = &tmp_monitor;
+    }
+
+    fan2_read_monitor( ctx, monitor );
+
+    if ( ctrl->setpoint_rpm == 0 )
+    {
+        ctrl->integral = 0;
+        ctrl->duty_per = FAN2_MIN_SPEED_PER;
+        ctrl->stall_cnt = 0;
+        ctrl->kick_cnt = 0;
+        return fan2_direct_speed_control( ctx, ctrl->duty_per );
+    }
+
+    //  Kick a stalled fan at full speed, then hand it back to the loop.
+    if ( ctrl->kick_cnt )
+    {
+        if ( --ctrl->kick_cnt == 0 )
+        {
+            ctrl->duty_per = ctrl->integral;
+            return fan2_direct_speed_control( ctx, ctrl->duty_per );
+        }
+
+        return FAN2_OK;
+    }
+
+    if ( ( monitor->tach1_rpm == 0 ) && ( ctrl->duty_per > FAN2_MIN_SPEED_PER ) )
+    {
+        if ( ++ctrl->stall_cnt >= FAN2_CTRL_STALL_PERIODS )
+        {
+            ctrl->stall_cnt = 0;
+
+            if ( ctrl->restart_cnt >= FAN2_CTRL_RESTART_MAX )
+            {
+                ctrl->duty_per = FAN2_MIN_SPEED_PER;
+                fan2_direct_speed_control( ctx, ctrl->duty_per );
+                return FAN2_ERR_FAN_STALL;
+            }
+
+            ctrl->restart_cnt++;
+            ctrl->kick_cnt = FAN2_CTRL_KICK_PERIODS;
+            ctrl->duty_per = FAN2_MAX_SPEED_PER;
+            return fan2_direct_speed_control( ctx, ctrl->duty_per );
+        }
+    }
+    else if ( monitor->tach1_rpm != 0 )
+    {
+        ctrl->stall_cnt = 0;
+        ctrl->restart_cnt = 0;
+    }
+
+    error = ( float )ctrl->setpoint_rpm - monitor->tach1_rpm;
+    duty = ctrl->integral + ctrl->kp * error;
+
+    //  Conditional integration: freeze the integrator while the output is
+    //  saturated in the direction of the error.
+    if ( !( ( duty >= FAN2_MAX_SPEED_PER ) && ( error > 0 ) ) &&
+         !( ( duty <= FAN2_MIN_SPEED_PER ) && ( error < 0 ) ) )
+    {
+        ctrl->integral += ctrl->ki * error * ctrl->period_s;
+
+        if ( ctrl->integral > FAN2_MAX_SPEED_PER )
+        {
+            ctrl->integral = FAN2_MAX_SPEED_PER;
+        }
+        else if ( ctrl->integral < FAN2_MIN_SPEED_PER )
+        {
+            ctrl->integral = FAN2_MIN_SPEED_PER;
+        }
+
+        duty = ctrl->integral + ctrl->kp * error;
+    }
+
+    if ( duty > FAN2_MAX_SPEED_PER )
+    {
+        duty = FAN2_MAX_SPEED_PER;
+    }
+    else if ( duty < FAN2_MIN_SPEED_PER )
+    {
+        duty = FAN2_MIN_SPEED_PER;
+    }
+
+    ctrl->duty_per = duty;
+
+    return fan2_direct_speed_control( ctx, ctrl->duty_per );
+}
+
+void fan2_autotune( fan2_t *ctx, fan2_curve_t *curve )
+{
+    fan2_monitor_t monitor;
+    uint8_t cnt;
+    uint16_t settle;
+
+    for ( cnt = 0; cnt < FAN2_CURVE_NPOINTS; cnt++ )
+    {
+        fan2_direct_speed_control( ctx, ( float )cnt * FAN2_MAX_SPEED_PER /
+                                        ( FAN2_CURVE_NPOINTS - 1 ) );
+
+        for ( settle = 0; settle < FAN2_AUTOTUNE_SETTLE_MS; settle++ )
+        {
+            Delay_1ms( );
+        }
+
+        fan2_read_monitor( ctx, &monitor );
+
+        //  Keep the curve monotonic so it can be inverted.
+        curve->rpm[ cnt ] = monitor.tach1_rpm;
+
+        if ( ( cnt > 0 ) && ( curve->rpm[ cnt ] < curve->rpm[ cnt - 1 ] ) )
+        {
+            curve->rpm[ cnt ] = curve->rpm[ cnt - 1 ];
+        }
+    }
+
+    fan2_direct_speed_control( ctx, FAN2_MIN_SPEED_PER );
+}
+
+float fan2_curve_duty( const fan2_curve_t *curve, uint16_t rpm )
+{
+    float step = ( float )FAN2_MAX_SPEED_PER / ( FAN2_CURVE_NPOINTS - 1 );
+    uint8_t cnt;
+
+    if ( rpm <= curve->rpm[ 0 ] )
+    {
+        return FAN2_MIN_SPEED_PER;
+    }
+
+    for ( cnt = 1; cnt < FAN2_CURVE_NPOINTS; cnt++ )
+    {
+        if ( rpm <= curve->rpm[ cnt ] )
+        {
+            return step * ( cnt - 1 ) + step * ( rpm - curve->rpm[ cnt - 1 ] ) /
+                   ( curve->rpm[ cnt ] - curve->rpm[ cnt - 1 ] );
+        }
+    }
+
+    return FAN2_MAX_SPEED_PER;
+}
+
+void fan2_generate_lut( const fan2_curve_t *curve, int8_t temp_low, int8_t temp_high,
+                        uint16_t rpm_low, uint16_t rpm_high, uint8_t *lut_data )
+{
+    int16_t temp;
+    uint16_t rpm;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < FAN2_LUT_NBYTES; cnt++ )
+    {
+        temp = FAN2_LUT_BASE_TEMP_CELS + cnt * FAN2_LUT_STEP_CELS;
+
+        if ( temp <= temp_low )
+        {
+            rpm = rpm_low;
+        }
+        else if ( temp >= temp_high )
+        {
+            rpm = rpm_high;
+        }
+        else
+        {
+            rpm = rpm_low + ( int32_t )( rpm_high - rpm_low ) * ( temp - temp_low ) /
+                  ( temp_high - temp_low );
+        }
+
+        lut_data[ cnt ] = fan2_curve_duty( curve, rpm ) / FAN2_RESOL_SPEED_PER;
+    }
+}
+
 void fan2_sw_reset( fan2_t *ctx )
 {
     uint8_t por_state;
@@ -355,4 +579,17 @@ uint8_t fan2_get_int_pin( fan2_t *ctx )
     return digital_in_read( &ctx->int_pin );
 }
 
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint16_t fan2_tacho_to_rpm( uint16_t tacho )
+{
+    //  Zero or full count means the fan is stopped or the tachometer is off.
+    if ( ( tacho == 0 ) || ( tacho == 0xFFFF ) )
+    {
+        return 0;
+    }
+
+    return FAN2_TACHO_RPM_FACTOR / tacho;
+}
+
 // ------------------------------------------------------------------------ END
@@ -271,21 +271,17 @@ void flash4_fast_read_flash_4 ( flash4_t *ctx, uint8_t *out_data, uint8_t addr,
 
 void flash4_page_program_4 ( flash4_t *ctx, uint8_t *in_data, uint32_t addr, uint8_t n_data )
 {  
-    uint8_t write_reg[ 256 ];
+    uint8_t write_reg[ 5 ];
     
     write_reg[ 0 ] = FLASH4_CMD_PAGE_4PROGRAM;
     write_reg[ 1 ] = ( uint8_t )( ( addr >> 24 ) & 0xFF );
     write_reg[ 2 ] = ( uint8_t )( ( addr >> 16 ) & 0xFF );
     write_reg[ 3 ] = ( uint8_t )( ( addr >> 8 )& 0xFF );
     write_reg[ 4 ] = ( uint8_t )( addr & 0xFF );
-    
-    for ( uint8_t cnt = 0; cnt < n_data; cnt++ )
-    {
-         write_reg[ cnt + 5 ] = in_data[ cnt ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, write_reg, n_data + 5 );
+    spi_master_write( &ctx->spi, write_reg, 5 );
+    spi_master_write( &ctx->spi, in_data, n_data );
     spi_master_deselect_device( ctx->chip_select ); 
 }
 
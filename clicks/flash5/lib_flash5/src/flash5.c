@@ -116,19 +116,9 @@ void flash5_read_data ( flash5_t *ctx, uint8_t reg_addr, uint8_t *data_buf, uint
 
 void flash5_write_data ( flash5_t *ctx, uint8_t reg_addr, uint8_t *data_buf, uint16_t n_buf_size )
 {
-    uint8_t write_buf[ 100 ];
-    uint16_t n_cnt;
-
-    write_buf[ 0 ] = reg_addr;
-
-    for ( n_cnt = 1; n_cnt < ( n_buf_size + 1 ); n_cnt++ )
-    {
-        write_buf[ n_cnt ] = *data_buf;
-        data_buf++;
-    }
-
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, write_buf, n_buf_size + 1 );
+    spi_master_write( &ctx->spi, &reg_addr, 1 );
+    spi_master_write( &ctx->spi, data_buf, n_buf_size );
     spi_master_deselect_device( ctx->chip_select );  
 }
 
@@ -239,20 +229,15 @@ void flash5_continous_read_memory ( flash5_t *ctx, uint8_t *data_buf, uint16_t b
 
 void flash5_page_load_memory ( flash5_t *ctx, uint16_t column_addr, uint8_t *data_buf, uint16_t buf_size )
 {
-    uint8_t write_buf[ 2048 ];
-    uint16_t n_cnt;
+    uint8_t write_buf[ 3 ];
 
     write_buf[ 0 ] = 0x02;
     write_buf[ 1 ] = ( uint8_t ) ( ( column_addr >> 8 ) & 0x00FF );
     write_buf[ 2 ] = ( uint8_t ) ( column_addr & 0x00FF );
 
-    for ( n_cnt = 3; n_cnt < ( buf_size + 3 ); n_cnt++ )
-    {
-        write_buf[n_cnt] = data_buf[ n_cnt - 3 ];
-    }
-
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, write_buf, buf_size + 3 );
+    spi_master_write( &ctx->spi, write_buf, 3 );
+    spi_master_write( &ctx->spi, data_buf, buf_size );
     spi_master_deselect_device( ctx->chip_select );
 }
 
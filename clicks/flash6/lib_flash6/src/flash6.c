@@ -106,19 +106,9 @@ void flash6_read_data ( flash6_t *ctx, uint8_t reg_addr, uint8_t *data_buf, uint
 
 void flash6_write_data ( flash6_t *ctx, uint8_t reg_addr, uint8_t *data_buf, uint8_t len )
 {
-    uint8_t write_buf[ 100 ];
-    uint16_t n_cnt;
-
-    write_buf[ 0 ] = reg_addr;
-
-    for ( n_cnt = 1; n_cnt < ( len + 1 ); n_cnt++ )
-    {
-        write_buf[ n_cnt ] = *data_buf;
-        data_buf++;
-    }
-
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, write_buf, len + 1 );
+    spi_master_write( &ctx->spi, &reg_addr, 1 );
+    spi_master_write( &ctx->spi, data_buf, len );
     spi_master_deselect_device( ctx->chip_select );   
 }
 
@@ -181,23 +171,18 @@ void flash6_write_status_reg ( flash6_t *ctx, uint8_t status_cmd, uint8_t status
 
 void flash6_write_memory_data ( flash6_t *ctx, uint32_t addr, uint8_t *data_buf, uint16_t buf_size )
 {
-    uint8_t write_buf[ 256 ];
-    uint16_t n_cnt;
+    uint8_t write_buf[ 4 ];
 
     write_buf[ 0 ] = FLASH6_CMD_PAGE_PROGRAM;
     write_buf[ 1 ] = ( uint8_t )( addr >> 16 );
     write_buf[ 2 ] = ( uint8_t )( addr >> 8 );
     write_buf[ 3 ] = ( uint8_t )( addr );
 
-    for ( n_cnt = 4; n_cnt < ( buf_size + 4 ); n_cnt++ )
-    {
-        write_buf[ n_cnt ] = data_buf[ n_cnt - 4 ];
-    }
-
     flash6_send_cmd( ctx, FLASH6_CMD_WRITE_ENABLE );
 
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi,  write_buf , buf_size + 4 );
+    spi_master_write( &ctx->spi, write_buf, 4 );
+    spi_master_write( &ctx->spi, data_buf, buf_size );
     spi_master_deselect_device( ctx->chip_select ); 
 }
 
@@ -83,16 +83,13 @@ err_t flash7_default_cfg ( flash7_t *ctx ) {
 }
 
 err_t flash7_generic_write ( flash7_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) {
-    uint8_t tx_buf[ 257 ] = { 0 };
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ] = { 0 };
 
     tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
@@ -181,27 +178,23 @@ void flash7_write_status_register ( flash7_t *ctx, uint16_t status_data ) {
 }
 
 uint8_t flash7_page_program ( flash7_t *ctx, uint32_t mem_addr, uint8_t *p_tx_data, uint16_t n_bytes ) {
-    uint8_t tx_buf[ 256 ];
-    uint16_t n_cnt;
+    uint8_t tx_buf[ 4 ];
     uint8_t status;
 
     status = FLASH7_OK;
 
-    if ( n_bytes < 256 ) {
+    if ( n_bytes <= 256 ) {
         tx_buf[ 0 ] = FLASH7_CMD_WRITE;
         tx_buf[ 1 ] = ( uint8_t )( mem_addr >> 16 );
         tx_buf[ 2 ] = ( uint8_t )( mem_addr >> 8 );
         tx_buf[ 3 ] = ( uint8_t ) mem_addr;
 
-        for ( n_cnt = 0; n_cnt < n_bytes; n_cnt++ ) {
-            tx_buf[ n_cnt + 4 ] = p_tx_data[ n_cnt ];
-        }
-
         flash7_write_enable( ctx );
         Delay_1ms( );
 
         spi_master_select_device( ctx->chip_select );
-        spi_master_write( &ctx->spi, tx_buf, n_bytes + 4 );
+        spi_master_write( &ctx->spi, tx_buf, 4 );
+        spi_master_write( &ctx->spi, p_tx_data, n_bytes );
         spi_master_deselect_device( ctx->chip_select );
     } else {
         status = FLASH7_ERROR;
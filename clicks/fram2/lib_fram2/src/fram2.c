@@ -169,24 +169,18 @@ void fram2_read( fram2_t *ctx, uint32_t address, uint8_t *buffer, uint8_t count
 
 void fram2_write ( fram2_t *ctx, uint32_t address, uint8_t *buffer, uint8_t counter ) 
 {
-    uint8_t temp[ 260 ];
-    uint8_t i;
+    uint8_t temp[ 4 ];
 
     temp[ 0 ] = FRAM_WRITE;
     temp[ 1 ] = ( uint8_t )( address >> 16 );
     temp[ 2 ] = ( uint8_t )( address >> 8 );
     temp[ 3 ] = ( uint8_t )( address & 0x000000FF );
-                           
-    for ( i = 4; i < counter + 4; i++ )
-    {
-        temp[ i ] = *buffer;
-        buffer++;
-    }
 
     fram2_write_enable(ctx);
 
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, temp, counter + 4 );
+    spi_master_write( &ctx->spi, temp, 4 );
+    spi_master_write( &ctx->spi, buffer, counter );
     spi_master_deselect_device( ctx->chip_select ); 
 }
 
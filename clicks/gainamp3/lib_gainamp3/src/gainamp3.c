@@ -147,33 +147,27 @@ err_t gainamp3_default_cfg ( gainamp3_t *ctx )
 
 err_t gainamp3_continuous_write ( gainamp3_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
-    uint8_t tx_buf[ 50 ] = { 0 }; 
+    uint8_t tx_buf[ 2 ] = { 0 }; 
     uint8_t crc_buf[ 2 ] = { 0 };
     reg &= ~GAINAMP3_SPI_READ_BIT;
     
-    tx_buf[ 0 ] = reg;
-    
-    for ( uint8_t cnt = 1; cnt <= len; cnt++ )
+    spi_master_select_device( ctx->chip_select );
+    err_t error_flag = spi_master_write( &ctx->spi, &reg, 1 );
+    if ( GAINAMP3_SPI_CRC_ENABLE == ctx->spi_crc_enable )
     {
-        if ( GAINAMP3_SPI_CRC_ENABLE == ctx->spi_crc_enable )
-        {
-            tx_buf[ cnt * 2 - 1 ] = data_in[ cnt - 1 ];
-            crc_buf[ 0 ] = reg + cnt - 1;
-            crc_buf[ 1 ] = data_in[ cnt - 1 ];
-            tx_buf[ cnt * 2 ] = gainamp3_calculate_crc ( crc_buf, 2 );
-        }
-        else
+        for ( uint8_t cnt = 0; cnt < len; cnt++ )
         {
-            tx_buf[ cnt ] = data_in[ cnt - 1 ];
+            tx_buf[ 0 ] = data_in[ cnt ];
+            crc_buf[ 0 ] = reg + cnt;
+            crc_buf[ 1 ] = data_in[ cnt ];
+            tx_buf[ 1 ] = gainamp3_calculate_crc ( crc_buf, 2 );
+            error_flag |= spi_master_write( &ctx->spi, tx_buf, 2 );
         }
     }
-    
-    if ( GAINAMP3_SPI_CRC_ENABLE == ctx->spi_crc_enable )
+    else
     {
-        len *= 2;
+        error_flag |= spi_master_write( &ctx->spi, data_in, len );
     }
-    spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
@@ -104,6 +104,21 @@
 #define I2CMUX_CMD_SET_CH_3                                           0x08
 /** \} */
 
+/**
+ * \defgroup channel_cache Channel cache
+ * \{
+ */
+#define I2CMUX_CH_UNKNOWN                                             0xFF
+/** \} */
+
+/**
+ * \defgroup xfer_dir Transfer direction
+ * \{
+ */
+#define I2CMUX_XFER_WRITE                                             0x00
+#define I2CMUX_XFER_READ                                              0x01
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -127,6 +142,8 @@ typedef struct
     // ctx variable 
 
     uint8_t slave_address;
+    uint8_t ch_slave_address;
+    uint8_t channel;
 
 } i2cmux_t;
 
@@ -151,6 +168,31 @@ typedef struct
 
 } i2cmux_cfg_t;
 
+/**
+ * @brief Downstream channel handle definition.
+ */
+typedef struct
+{
+    i2cmux_t *mux;
+    uint8_t channel;
+    uint8_t slave_address;
+
+} i2cmux_channel_t;
+
+/**
+ * @brief Queued channel transfer definition.
+ */
+typedef struct
+{
+    i2cmux_channel_t *ch;
+    uint8_t dir;
+    uint8_t reg;
+    uint8_t *data_buf;
+    uint8_t len;
+    uint8_t done;
+
+} i2cmux_xfer_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -251,6 +293,69 @@ uint8_t i2cmux_read_cmd ( i2cmux_t *ctx );
  */
 void i2cmux_set_channel ( i2cmux_t *ctx, uint8_t channel, uint8_t ch_slave_address );
 
+/**
+ * @brief Channel handle initialization function.
+ *
+ * @param ctx               Click object.
+ * @param ch                Channel handle.
+ * @param channel           Channel selection command.
+ * @param ch_slave_address  Slave address of the device on the channel.
+ *
+ * @description This function binds a channel handle to the mux, so the device
+ * behind it can be accessed as a separate sub-bus.
+ */
+void i2cmux_channel_init ( i2cmux_t *ctx, i2cmux_channel_t *ch, uint8_t channel, uint8_t ch_slave_address );
+
+/**
+ * @brief Channel select function.
+ *
+ * @param ch                Channel handle.
+ *
+ * @description This function selects the channel of the handle and its slave
+ * address. The control register is only written when the mux has
+ * a different channel selected.
+ */
+void i2cmux_channel_select ( i2cmux_channel_t *ch );
+
+/**
+ * @brief Channel write function.
+ *
+ * @param ch           Channel handle.
+ * @param reg          Register address.
+ * @param data_buf     Data buf to be written.
+ * @param len          Number of the bytes in data buf.
+ *
+ * @description This function writes data to the desired register of the
+ * device behind the channel.
+ */
+void i2cmux_channel_write ( i2cmux_channel_t *ch, uint8_t reg, uint8_t *data_buf, uint8_t len );
+
+/**
+ * @brief Channel read function.
+ *
+ * @param ch           Channel handle.
+ * @param reg          Register address.
+ * @param data_buf     Output data buf.
+ * @param len          Number of the bytes to be read.
+ *
+ * @description This function reads data from the desired register of the
+ * device behind the channel.
+ */
+void i2cmux_channel_read ( i2cmux_channel_t *ch, uint8_t reg, uint8_t *data_buf, uint8_t len );
+
+/**
+ * @brief Run queued transfers function.
+ *
+ * @param ctx          Click object.
+ * @param xfer         Array of queued transfers.
+ * @param n_xfer       Number of queued transfers.
+ *
+ * @description This function executes queued transfers grouped by channel,
+ * starting with the currently selected one, so each channel is selected
+ * at most once. Transfers on the same channel keep their queued order.
+ */
+void i2cmux_run_xfers ( i2cmux_t *ctx, i2cmux_xfer_t *xfer, uint8_t n_xfer );
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,10 +29,6 @@
 
 #include "i2cmux.h"
 
-// ---------------------------------------------- PRIVATE VARIABLES 
-
-static uint8_t slv_address; 
-
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
 void dev_reset_delay ( void );
@@ -66,6 +62,8 @@ I2CMUX_RETVAL i2cmux_init ( i2cmux_t *ctx, i2cmux_cfg_t *cfg )
     i2c_cfg.sda    = cfg->sda;
 
     ctx->slave_address = cfg->i2c_address;
+    ctx->ch_slave_address = cfg->i2c_address;
+    ctx->channel = I2CMUX_CH_UNKNOWN;
 
     if ( i2c_master_open( &ctx->i2c, &i2c_cfg ) == I2C_MASTER_ERROR )
     {
@@ -90,18 +88,18 @@ void i2cmux_generic_write ( i2cmux_t *ctx, uint8_t reg, uint8_t *data_buf, uint8
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
-    i2c_master_set_slave_address( &ctx->i2c, slv_address );
+    i2c_master_set_slave_address( &ctx->i2c, ctx->ch_slave_address );
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
 }
 
 void i2cmux_generic_read ( i2cmux_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
-    i2c_master_set_slave_address( &ctx->i2c, slv_address );
+    i2c_master_set_slave_address( &ctx->i2c, ctx->ch_slave_address );
     i2c_master_write_then_read( &ctx->i2c, &reg, 1, data_buf, len );
 }
 
@@ -111,6 +109,8 @@ void i2cmux_hw_reset ( i2cmux_t *ctx )
     dev_reset_delay( );
     digital_out_high( &ctx->rst );
     dev_reset_delay( );
+
+    ctx->channel = I2CMUX_CMD_NO_CH;
 }
 
 void i2cmux_write_cmd ( i2cmux_t *ctx, uint8_t tx_data )
@@ -120,7 +120,14 @@ void i2cmux_write_cmd ( i2cmux_t *ctx, uint8_t tx_data )
     tx_buf[ 0 ] = tx_data;
     i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
     
-    i2c_master_write( &ctx->i2c, tx_buf, 1 );
+    if ( i2c_master_write( &ctx->i2c, tx_buf, 1 ) == I2C_MASTER_SUCCESS )
+    {
+        ctx->channel = tx_data;
+    }
+    else
+    {
+        ctx->channel = I2CMUX_CH_UNKNOWN;
+    }
 }
 
 uint8_t i2cmux_read_cmd ( i2cmux_t *ctx )
@@ -135,9 +142,85 @@ uint8_t i2cmux_read_cmd ( i2cmux_t *ctx )
 
 void i2cmux_set_channel ( i2cmux_t *ctx, uint8_t channel, uint8_t ch_slave_address )
 {
-    slv_address = ch_slave_address;
+    ctx->ch_slave_address = ch_slave_address;
+
+    if ( channel != ctx->channel )
+    {
+        i2cmux_write_cmd( ctx, channel );
+    }
+}
+
+void i2cmux_channel_init ( i2cmux_t *ctx, i2cmux_channel_t *ch, uint8_t channel, uint8_t ch_slave_address )
+{
+    ch->mux = ctx;
+    ch->channel = channel;
+    ch->slave_address = ch_slave_address;
+}
+
+void i2cmux_channel_select ( i2cmux_channel_t *ch )
+{
+    i2cmux_set_channel( ch->mux, ch->channel, ch->slave_address );
+}
+
+void i2cmux_channel_write ( i2cmux_channel_t *ch, uint8_t reg, uint8_t *data_buf, uint8_t len )
+{
+    i2cmux_channel_select( ch );
+    i2cmux_generic_write( ch->mux, reg, data_buf, len );
+}
+
+void i2cmux_channel_read ( i2cmux_channel_t *ch, uint8_t reg, uint8_t *data_buf, uint8_t len )
+{
+    i2cmux_channel_select( ch );
+    i2cmux_generic_read( ch->mux, reg, data_buf, len );
+}
+
+void i2cmux_run_xfers ( i2cmux_t *ctx, i2cmux_xfer_t *xfer, uint8_t n_xfer )
+{
+    uint8_t cnt;
+    uint8_t n_left;
+    uint8_t channel;
+
+    for ( cnt = 0; cnt < n_xfer; cnt++ )
+    {
+        xfer[ cnt ].done = 0;
+    }
+
+    n_left = n_xfer;
+    channel = ctx->channel;
 
-    i2cmux_write_cmd( ctx, channel );
+    while ( n_left )
+    {
+        // Keep the current channel while any transfer still needs it.
+        for ( cnt = 0; cnt < n_xfer; cnt++ )
+        {
+            if ( ( 0 == xfer[ cnt ].done ) && ( xfer[ cnt ].ch->channel == channel ) )
+            {
+                break;
+            }
+        }
+        if ( cnt == n_xfer )
+        {
+            for ( cnt = 0; xfer[ cnt ].done; cnt++ );
+            channel = xfer[ cnt ].ch->channel;
+        }
+
+        for ( ; cnt < n_xfer; cnt++ )
+        {
+            if ( ( 0 == xfer[ cnt ].done ) && ( xfer[ cnt ].ch->channel == channel ) )
+            {
+                if ( I2CMUX_XFER_READ == xfer[ cnt ].dir )
+                {
+                    i2cmux_channel_read( xfer[ cnt ].ch, xfer[ cnt ].reg, xfer[ cnt ].data_buf, xfer[ cnt ].len );
+                }
+                else
+                {
+                    i2cmux_channel_write( xfer[ cnt ].ch, xfer[ cnt ].reg, xfer[ cnt ].data_buf, xfer[ cnt ].len );
+                }
+                xfer[ cnt ].done = 1;
+                n_left--;
+            }
+        }
+    }
 }
 
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
@@ -29,10 +29,6 @@
 
 #include "i2cmux2.h"
 
-// ------------------------------------------------------------------ VARIABLES
-
-static uint8_t ch_slave_addr;
-
 // ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
 
 void dev_reset_delay ( void );
@@ -63,6 +59,8 @@ err_t i2cmux2_init ( i2cmux2_t *ctx, i2cmux2_cfg_t *cfg )
     i2c_cfg.sda    = cfg->sda;
 
     ctx->slave_address = cfg->i2c_address;
+    ctx->ch_slave_address = cfg->i2c_address;
+    ctx->channel = I2CMUX2_CH_UNKNOWN;
 
     if ( I2C_MASTER_ERROR == i2c_master_open( &ctx->i2c, &i2c_cfg ) )
     {
@@ -95,14 +93,14 @@ void i2cmux2_generic_write ( i2cmux2_t *ctx, uint8_t reg, uint8_t *data_buf, uin
         tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
-    i2c_master_set_slave_address( &ctx->i2c, ch_slave_addr );
+    i2c_master_set_slave_address( &ctx->i2c, ctx->ch_slave_address );
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );   
 }
 
 void i2cmux2_generic_read ( i2cmux2_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len )
 {
-    i2c_master_set_slave_address( &ctx->i2c, ch_slave_addr );
+    i2c_master_set_slave_address( &ctx->i2c, ctx->ch_slave_address );
     
     i2c_master_write_then_read( &ctx->i2c, &reg, 1, data_buf, len );
 }
@@ -113,13 +111,22 @@ void i2cmux2_hw_reset ( i2cmux2_t *ctx )
     dev_reset_delay( );
     digital_out_high( &ctx->rst );
     dev_reset_delay( );
+
+    ctx->channel = I2CMUX2_CMD_NO_CH;
 }
 
 void i2cmux2_write_cmd ( i2cmux2_t *ctx, uint8_t tx_data )
 {
     i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
 
-    i2c_master_write( &ctx->i2c, &tx_data, 1 );  
+    if ( i2c_master_write( &ctx->i2c, &tx_data, 1 ) == I2C_MASTER_SUCCESS )
+    {
+        ctx->channel = tx_data;
+    }
+    else
+    {
+        ctx->channel = I2CMUX2_CH_UNKNOWN;
+    }
 }
 
 uint8_t i2cmux2_read_cmd ( i2cmux2_t *ctx )
@@ -135,9 +142,12 @@ uint8_t i2cmux2_read_cmd ( i2cmux2_t *ctx )
 
 void i2cmux2_set_channel ( i2cmux2_t *ctx, uint8_t channel, uint8_t ch_slave_address )
 {
-    ch_slave_addr = ch_slave_address;
+    ctx->ch_slave_address = ch_slave_address;
     
-    i2cmux2_write_cmd( ctx, channel );
+    if ( channel != ctx->channel )
+    {
+        i2cmux2_write_cmd( ctx, channel );
+    }
 }
 
 uint8_t i2cmux2_read_interrupt ( i2cmux2_t *ctx )
@@ -158,6 +168,79 @@ uint8_t i2cmux2_check_int ( i2cmux2_t *ctx )
     return digital_in_read( &ctx->int_pin );
 }
 
+void i2cmux2_channel_init ( i2cmux2_t *ctx, i2cmux2_channel_t *ch, uint8_t channel, uint8_t ch_slave_address )
+{
+    ch->mux = ctx;
+    ch->channel = channel;
+    ch->slave_address = ch_slave_address;
+}
+
+void i2cmux2_channel_select ( i2cmux2_channel_t *ch )
+{
+    i2cmux2_set_channel( ch->mux, ch->channel, ch->slave_address );
+}
+
+void i2cmux2_channel_write ( i2cmux2_channel_t *ch, uint8_t reg, uint8_t *data_buf, uint8_t len )
+{
+    i2cmux2_channel_select( ch );
+    i2cmux2_generic_write( ch->mux, reg, data_buf, len );
+}
+
+void i2cmux2_channel_read ( i2cmux2_channel_t *ch, uint8_t reg, uint8_t *data_buf, uint8_t len )
+{
+    i2cmux2_channel_select( ch );
+    i2cmux2_generic_read( ch->mux, reg, data_buf, len );
+}
+
+void i2cmux2_run_xfers ( i2cmux2_t *ctx, i2cmux2_xfer_t *xfer, uint8_t n_xfer )
+{
+    uint8_t cnt;
+    uint8_t n_left;
+    uint8_t channel;
+
+    for ( cnt = 0; cnt < n_xfer; cnt++ )
+    {
+        xfer[ cnt ].done = 0;
+    }
+
+    n_left = n_xfer;
+    channel = ctx->channel;
+
+    while ( n_left )
+    {
+        // Keep the current channel while any transfer still needs it.
+        for ( cnt = 0; cnt < n_xfer; cnt++ )
+        {
+            if ( ( 0 == xfer[ cnt ].done ) && ( xfer[ cnt ].ch->channel == channel ) )
+            {
+                break;
+            }
+        }
+        if ( cnt == n_xfer )
+        {
+            for ( cnt = 0; xfer[ cnt ].done; cnt++ );
+            channel = xfer[ cnt ].ch->channel;
+        }
+
+        for ( ; cnt < n_xfer; cnt++ )
+        {
+            if ( ( 0 == xfer[ cnt ].done ) && ( xfer[ cnt ].ch->channel == channel ) )
+            {
+                if ( I2CMUX2_XFER_READ == xfer[ cnt ].dir )
+                {
+                    i2cmux2_channel_read( xfer[ cnt ].ch, xfer[ cnt ].reg, xfer[ cnt ].data_buf, xfer[ cnt ].len );
+                }
+                else
+                {
+                    i2cmux2_channel_write( xfer[ cnt ].ch, xfer[ cnt ].reg, xfer[ cnt ].data_buf, xfer[ cnt ].len );
+                }
+                xfer[ cnt ].done = 1;
+                n_left--;
+            }
+        }
+    }
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 void dev_reset_delay ( void )
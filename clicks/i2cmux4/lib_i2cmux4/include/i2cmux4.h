@@ -105,6 +105,7 @@
 #define I2CMUX4_SEL_CH_ALL_DISABLE                0x00
 #define I2CMUX4_SEL_CH_0                          0x01
 #define I2CMUX4_SEL_CH_1                          0x02
+#define I2CMUX4_SEL_CH_UNKNOWN                    0xFF
 /** \} */
  
 /**
@@ -144,6 +145,7 @@ typedef struct
 
     uint8_t slave_address;
     uint8_t rmt_slave_addr;
+    uint8_t channel;
 
 } i2cmux4_t;
 
@@ -293,6 +295,7 @@ uint8_t i2cmux4_read_cmd ( i2cmux4_t *ctx );
  * @description The function sets channel and slave address of the 
  * device connected to the selected channel 
  * of the I2C MUX 4 Click board.
+ * The command is skipped when the channel is already selected.
 **/
 void i2cmux4_set_channel ( i2cmux4_t *ctx, uint8_t sel_ch, uint8_t ch_slave_addr );
 
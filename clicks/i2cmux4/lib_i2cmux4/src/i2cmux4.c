@@ -79,6 +79,8 @@ I2CMUX4_RETVAL i2cmux4_init ( i2cmux4_t *ctx, i2cmux4_cfg_t *cfg )
 
     digital_in_init( &ctx->int_pin, cfg->int_pin );
 
+    ctx->channel = I2CMUX4_SEL_CH_UNKNOWN;
+
     return I2CMUX4_OK;
 }
 
@@ -89,9 +91,9 @@ void i2cmux4_generic_write ( i2cmux4_t *ctx, uint8_t reg, uint8_t *data_buf, uin
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );   
@@ -112,6 +114,8 @@ void i2cmux4_power_on ( i2cmux4_t *ctx, uint8_t enable )
     {
         digital_out_low( &ctx->rst );
     }
+
+    ctx->channel = I2CMUX4_SEL_CH_UNKNOWN;
 }
 
 void i2cmux4_hw_reset ( i2cmux4_t *ctx )
@@ -120,12 +124,22 @@ void i2cmux4_hw_reset ( i2cmux4_t *ctx )
     dev_reset_delay( );
     digital_out_high( &ctx->rst );
     dev_reset_delay( );
+
+    ctx->channel = I2CMUX4_SEL_CH_UNKNOWN;
 }
 
 void i2cmux4_write_cmd ( i2cmux4_t *ctx, uint8_t cmd_data )
 {
     i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
-    i2c_master_write( &ctx->i2c, &cmd_data, 1 );  
+
+    if ( i2c_master_write( &ctx->i2c, &cmd_data, 1 ) == I2C_MASTER_SUCCESS )
+    {
+        ctx->channel = cmd_data;
+    }
+    else
+    {
+        ctx->channel = I2CMUX4_SEL_CH_UNKNOWN;
+    }
 }
 
 uint8_t i2cmux4_read_cmd ( i2cmux4_t *ctx )
@@ -140,29 +154,31 @@ uint8_t i2cmux4_read_cmd ( i2cmux4_t *ctx )
 
 void i2cmux4_set_channel ( i2cmux4_t *ctx, uint8_t sel_ch, uint8_t ch_slave_addr )
 {
+    uint8_t cmd_data;
+
     switch ( sel_ch )
     {
-        case 0:
-        {
-            i2cmux4_write_cmd( ctx, I2CMUX4_SEL_CH_ALL_DISABLE );
-            break;
-        }
         case 1:
         {
-            i2cmux4_write_cmd( ctx, I2CMUX4_SEL_CH_0 );
+            cmd_data = I2CMUX4_SEL_CH_0;
             break;
         }
         case 2:
         {
-            i2cmux4_write_cmd( ctx, I2CMUX4_SEL_CH_1 );
+            cmd_data = I2CMUX4_SEL_CH_1;
             break;
         }
         default:
         {
-            i2cmux4_write_cmd( ctx, I2CMUX4_SEL_CH_ALL_DISABLE );
+            cmd_data = I2CMUX4_SEL_CH_ALL_DISABLE;
             break;
         }
     }
+
+    if ( cmd_data != ctx->channel )
+    {
+        i2cmux4_write_cmd( ctx, cmd_data );
+    }
     
     ctx->rmt_slave_addr = ch_slave_addr;
 }
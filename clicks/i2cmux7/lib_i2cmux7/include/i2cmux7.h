@@ -80,6 +80,7 @@ extern "C"{
 #define I2CMUX7_CHANNEL_6                   0x0E
 #define I2CMUX7_CHANNEL_7                   0x0F
 #define I2CMUX7_CHANNEL_NUM_MASK            0x07
+#define I2CMUX7_CHANNEL_UNKNOWN             0xFF
 
 /**
  * @brief I2C MUX 7 device address setting.
@@ -134,6 +135,7 @@ typedef struct
     // I2C slave address
     uint8_t slave_address;      /**< Device slave address (used for I2C driver). */
     uint8_t ch_slave_address;   /**< Channel device slave address (used for I2C driver). */
+    uint8_t channel;            /**< Currently selected channel. */
 
 } i2cmux7_t;
 
@@ -200,6 +202,7 @@ err_t i2cmux7_init ( i2cmux7_t *ctx, i2cmux7_cfg_t *cfg );
 /**
  * @brief I2C MUX 7 set channel function.
  * @details This function sets the desired channel active and configures its slave address.
+ * The control register is only written when a different channel is currently selected.
  * @param[in] ctx : Click context object.
  * See #i2cmux7_t object definition for detailed explanation.
  * @param[in] ch_sel : Channel selection bit mask.
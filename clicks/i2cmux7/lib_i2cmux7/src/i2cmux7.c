@@ -50,6 +50,7 @@ err_t i2cmux7_init ( i2cmux7_t *ctx, i2cmux7_cfg_t *cfg )
     i2c_cfg.sda = cfg->sda;
 
     ctx->slave_address = cfg->i2c_address;
+    ctx->channel = I2CMUX7_CHANNEL_UNKNOWN;
 
     if ( I2C_MASTER_ERROR == i2c_master_open( &ctx->i2c, &i2c_cfg ) ) 
     {
@@ -77,8 +78,17 @@ err_t i2cmux7_set_channel ( i2cmux7_t *ctx, uint8_t ch_sel, uint8_t ch_slave_add
     {
         return I2CMUX7_ERROR;
     }
-    err_t error_flag = i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
-    error_flag |= i2c_master_write( &ctx->i2c, &ch_sel, 1 );
+    err_t error_flag = I2CMUX7_OK;
+    if ( ch_sel != ctx->channel )
+    {
+        error_flag |= i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
+        error_flag |= i2c_master_write( &ctx->i2c, &ch_sel, 1 );
+        ctx->channel = I2CMUX7_CHANNEL_UNKNOWN;
+        if ( I2CMUX7_OK == error_flag )
+        {
+            ctx->channel = ch_sel;
+        }
+    }
     ctx->ch_slave_address = ch_slave_addr;
     error_flag |= i2c_master_set_slave_address( &ctx->i2c, ctx->ch_slave_address );
     return error_flag;
@@ -98,6 +108,7 @@ void i2cmux7_reset_device ( i2cmux7_t *ctx )
     Delay_100ms ( );
     digital_out_high ( &ctx->rst );
     Delay_100ms ( );
+    ctx->channel = I2CMUX7_CHANNEL_DISABLE;
 }
 
 err_t i2cmux7_generic_write ( i2cmux7_t *ctx, uint8_t reg, uint8_t *tx_buf, uint8_t tx_len ) 
@@ -77,6 +77,12 @@ extern "C"{
 #define I2CMUX8_CHANNEL_4                       0x08
 #define I2CMUX8_CHANNEL_MASK                    0x0F
 
+/**
+ * @brief I2C MUX 8 channel cache setting.
+ * @details Cached channel value of I2C MUX 8 Click driver when the mux state is not known.
+ */
+#define I2CMUX8_CHANNEL_UNKNOWN                 0xFF
+
 /**
  * @brief I2C MUX 8 device address setting.
  * @details Specified setting for device slave address selection of
@@ -131,6 +137,8 @@ typedef struct
     uint8_t slave_address;          /**< Device slave address (used for I2C driver). */
     uint8_t ch_slave_address;       /**< Channel device slave address (used for I2C driver). */
 
+    uint8_t channel;                /**< Last channel selection written to the mux. */
+
 } i2cmux8_t;
 
 /**
@@ -201,7 +209,8 @@ err_t i2cmux8_init ( i2cmux8_t *ctx, i2cmux8_cfg_t *cfg );
  * @param[in] ch_slave_addr : Slave address of the selected channel.
  * @return @li @c  0 - Success,
  *         @li @c -1 - Error.
- * @note None.
+ * @note The control register is written only when @b ch_sel differs from the last
+ * successfully written selection.
  */
 err_t i2cmux8_set_channel ( i2cmux8_t *ctx, uint8_t ch_sel, uint8_t ch_slave_addr );
 
@@ -68,13 +68,20 @@ err_t i2cmux8_init ( i2cmux8_t *ctx, i2cmux8_cfg_t *cfg )
 
     digital_out_init( &ctx->rst, cfg->rst );
 
+    ctx->channel = I2CMUX8_CHANNEL_UNKNOWN;
+
     return I2C_MASTER_SUCCESS;
 }
 
 err_t i2cmux8_set_channel ( i2cmux8_t *ctx, uint8_t ch_sel, uint8_t ch_slave_addr )
 {
-    err_t error_flag = i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
-    error_flag |= i2c_master_write( &ctx->i2c, &ch_sel, 1 );
+    err_t error_flag = I2CMUX8_OK;
+    if ( ch_sel != ctx->channel )
+    {
+        error_flag |= i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address );
+        error_flag |= i2c_master_write( &ctx->i2c, &ch_sel, 1 );
+        ctx->channel = ( I2CMUX8_OK == error_flag ) ? ch_sel : I2CMUX8_CHANNEL_UNKNOWN;
+    }
     ctx->ch_slave_address = ch_slave_addr;
     error_flag |= i2c_master_set_slave_address( &ctx->i2c, ctx->ch_slave_address );
     return error_flag;
@@ -108,6 +115,7 @@ err_t i2cmux8_read_channel ( i2cmux8_t *ctx, uint8_t *ch_sel )
 void i2cmux8_set_rst_pin ( i2cmux8_t *ctx, uint8_t state )
 {
     digital_out_write ( &ctx->rst, state );
+    ctx->channel = I2CMUX8_CHANNEL_UNKNOWN;
 }
 
 void i2cmux8_reset_device ( i2cmux8_t *ctx )
@@ -116,6 +124,7 @@ void i2cmux8_reset_device ( i2cmux8_t *ctx )
     Delay_100ms ( );
     digital_out_high ( &ctx->rst );
     Delay_100ms ( );
+    ctx->channel = I2CMUX8_CHANNEL_UNKNOWN;
 }
 
 err_t i2cmux8_i2c_write ( i2cmux8_t *ctx, uint8_t *data_in, uint16_t len ) 
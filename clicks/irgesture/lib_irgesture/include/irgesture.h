@@ -200,6 +200,20 @@
 #define IRGESTURE_DOWN             0x04
 #define IRGESTURE_NEAR             0x05
 /** \} */
+
+/**
+ * \defgroup gesture_decoder Gesture decoder
+ * \{
+ */
+#define IRGESTURE_GFIFO_SIZE           32
+#define IRGESTURE_GMODE                0b00000001
+#define IRGESTURE_GESTURE_MIN_LEVEL    10
+#define IRGESTURE_GESTURE_MIN_SAMPLES  4
+#define IRGESTURE_GESTURE_SENSITIVITY  50
+#define IRGESTURE_GESTURE_NEAR_DELTA   20
+#define IRGESTURE_GESTURE_NEAR_LEVEL   200
+#define IRGESTURE_GESTURE_TIMEOUT_MS   1000
+/** \} */
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -296,6 +310,21 @@ typedef struct
 
 } gesture_data_t;
 
+/**
+ * @brief Incremental gesture decoder state.
+ */
+typedef struct
+{
+    int16_t ud_ratio_first;
+    int16_t lr_ratio_first;
+    int16_t ud_ratio_last;
+    int16_t lr_ratio_last;
+    uint16_t samples;
+    uint8_t peak;
+    uint8_t active;
+
+} irgesture_decoder_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -384,9 +413,65 @@ uint8_t irgesture_get_interrupt ( irgesture_t *ctx );
 
  * @description Function processes a gesture event and returns best guessed gesture
  * engine on the APDS-9960 IC on IR Gesture Click.
+ * @note Blocks for up to IRGESTURE_GESTURE_TIMEOUT_MS while the gesture is in progress.
  */
 gesture_dir_t irgesture_gesture_read_gesture ( irgesture_t *ctx );
 
+/**
+ * @brief Gesture decoder initialization function
+ * 
+ * @param dec          Gesture decoder state.
+ *
+ * @description Function resets the incremental gesture decoder.
+ */
+void irgesture_decoder_init ( irgesture_decoder_t *dec );
+
+/**
+ * @brief Gesture decoder push function
+ * 
+ * @param dec          Gesture decoder state.
+ * @param u_data       Up photodiode sample.
+ * @param d_data       Down photodiode sample.
+ * @param l_data       Left photodiode sample.
+ * @param r_data       Right photodiode sample.
+ *
+ * @returns gesture_dir_t - detected gesture or DIR_NONE while the gesture is in progress.
+ *
+ * @description Function feeds a single UDLR dataset to the decoder. The first and last
+ * up/down and left/right ratios are tracked as the samples arrive, and the gesture is
+ * reported on the first dataset that falls below the exit level.
+ */
+gesture_dir_t irgesture_decoder_push ( irgesture_decoder_t *dec, uint8_t u_data, uint8_t d_data, 
+                                       uint8_t l_data, uint8_t r_data );
+
+/**
+ * @brief Gesture decoder flush function
+ * 
+ * @param dec          Gesture decoder state.
+ *
+ * @returns gesture_dir_t - detected gesture or DIR_NONE.
+ *
+ * @description Function ends the gesture in progress, returns its direction and resets the decoder.
+ */
+gesture_dir_t irgesture_decoder_flush ( irgesture_decoder_t *dec );
+
+/**
+ * @brief Gesture FIFO drain function
+ * 
+ * @param ctx          Click object.
+ * @param dec          Gesture decoder state.
+ * @param motion       Detected gesture or DIR_NONE.
+ *
+ * @returns err_t - I2C_MASTER_SUCCESS, or the I2C error of the FIFO read ( the
+ * decoder is left untouched and @b motion is DIR_NONE ).
+ *
+ * @description Function reads all GFLVL datasets from the gesture FIFO in a single
+ * I2C transfer and feeds them to the decoder. If the FIFO is empty and the gesture
+ * engine has exited, the gesture in progress is flushed.
+ * @note Call this function when the INT pin is asserted ( low ).
+ */
+err_t irgesture_gesture_drain ( irgesture_t *ctx, irgesture_decoder_t *dec, gesture_dir_t *motion );
+
 /**
  * @brief Sets the gesture mode function
  * 
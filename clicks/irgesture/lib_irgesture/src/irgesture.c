@@ -35,8 +35,7 @@
 static uint8_t compare_data ( uint8_t value0, uint8_t value1, uint8_t value2, uint8_t value3 );
 static uint8_t get_mode ( irgesture_t *ctx );
 static void set_mode ( irgesture_t *ctx, uint8_t mode, uint8_t enable );
-static uint8_t process_gesture_data ( gesture_data_t *gesture_data );
-static uint8_t decode_gesture ( gesture_data_t *gesture_data );
+static int16_t gesture_ratio ( uint8_t value0, uint8_t value1 );
 
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
@@ -212,64 +211,170 @@ uint8_t irgesture_get_interrupt ( irgesture_t *ctx )
 
 gesture_dir_t irgesture_gesture_read_gesture ( irgesture_t *ctx )
 {
-    gesture_data_t gesture_data;
-    uint8_t fifo_count;
-    uint8_t fifo_data[ 132 ];
-    uint8_t fifo_addr[ 1 ];
-    uint16_t i;
-    uint8_t len;
-    
-    fifo_count = 0;
-    fifo_addr[ 0 ] = IRGESTURE_GFIFO_U;
+    irgesture_decoder_t decoder;
+    gesture_dir_t motion;
+    uint16_t timeout_cnt;
 
     if ( !irgesture_available( ctx ) || !( get_mode( ctx ) & 0x41 ) )
     {
         return DIR_NONE;
     }
 
-    while ( 1 )
+    irgesture_decoder_init( &decoder );
+
+    for ( timeout_cnt = 0; timeout_cnt < IRGESTURE_GESTURE_TIMEOUT_MS; timeout_cnt++ )
     {
-        Delay_100ms();
+        if ( irgesture_gesture_drain( ctx, &decoder, &motion ) != I2C_MASTER_SUCCESS )
+        {
+            return DIR_NONE;
+        }
+        if ( motion != DIR_NONE )
+        {
+            return motion;
+        }
+        if ( !( irgesture_read_data( ctx, IRGESTURE_GCONF4 ) & IRGESTURE_GMODE ) )
+        {
+            // The engine exits at GEXTH, above the decoder exit level, so close the gesture here.
+            return irgesture_decoder_flush( &decoder );
+        }
+
+        Delay_1ms();
+    }
+
+    return irgesture_decoder_flush( &decoder );
+}
+
+void irgesture_decoder_init ( irgesture_decoder_t *dec )
+{
+    dec->ud_ratio_first = 0;
+    dec->lr_ratio_first = 0;
+    dec->ud_ratio_last = 0;
+    dec->lr_ratio_last = 0;
+    dec->samples = 0;
+    dec->peak = 0;
+    dec->active = 0;
+}
 
-        if ( irgesture_available( ctx ) )
+gesture_dir_t irgesture_decoder_push ( irgesture_decoder_t *dec, uint8_t u_data, uint8_t d_data, 
+                                       uint8_t l_data, uint8_t r_data )
+{
+    if ( ( u_data <= IRGESTURE_GESTURE_MIN_LEVEL ) || ( d_data <= IRGESTURE_GESTURE_MIN_LEVEL ) || 
+         ( l_data <= IRGESTURE_GESTURE_MIN_LEVEL ) || ( r_data <= IRGESTURE_GESTURE_MIN_LEVEL ) )
+    {
+        if ( dec->active )
         {
-            fifo_count = irgesture_read_data( ctx, IRGESTURE_GFLVL );
+            return irgesture_decoder_flush( dec );
+        }
 
-            if ( fifo_count > 0 )
-            {
-                i2c_master_write_then_read( &ctx->i2c, &fifo_addr, 1, fifo_data, fifo_count * 4 );
+        return DIR_NONE;
+    }
+
+    dec->ud_ratio_last = gesture_ratio( u_data, d_data );
+    dec->lr_ratio_last = gesture_ratio( l_data, r_data );
+
+    if ( !dec->active )
+    {
+        dec->ud_ratio_first = dec->ud_ratio_last;
+        dec->lr_ratio_first = dec->lr_ratio_last;
+        dec->active = 1;
+    }
+
+    dec->samples++;
 
+    if ( u_data > dec->peak ) dec->peak = u_data;
+    if ( d_data > dec->peak ) dec->peak = d_data;
+    if ( l_data > dec->peak ) dec->peak = l_data;
+    if ( r_data > dec->peak ) dec->peak = r_data;
 
-                for ( i = 0; i < fifo_count; i += 4 )
-                {
-                    gesture_data.u_data[ gesture_data.index ] = fifo_data[ i ];
-                    gesture_data.d_data[ gesture_data.index ] = fifo_data[ i + 1 ];
-                    gesture_data.l_data[ gesture_data.index ] = fifo_data[ i + 2 ];
-                    gesture_data.r_data[ gesture_data.index ] = fifo_data[ i + 3 ];
-                    gesture_data.index++;
-                    gesture_data.total_gestures++;
-                }
+    return DIR_NONE;
+}
+
+gesture_dir_t irgesture_decoder_flush ( irgesture_decoder_t *dec )
+{
+    gesture_dir_t motion;
+    int16_t ud_delta;
+    int16_t lr_delta;
+    int16_t ud_abs;
+    int16_t lr_abs;
 
-                if ( !process_gesture_data( &gesture_data ) )
-                {
-                    if ( !decode_gesture( &gesture_data ) )
-                    {
+    motion = DIR_NONE;
 
-                    }
-                }
+    if ( dec->active && ( dec->samples >= IRGESTURE_GESTURE_MIN_SAMPLES ) )
+    {
+        ud_delta = dec->ud_ratio_last - dec->ud_ratio_first;
+        lr_delta = dec->lr_ratio_last - dec->lr_ratio_first;
+        ud_abs = ( ud_delta < 0 ) ? -ud_delta : ud_delta;
+        lr_abs = ( lr_delta < 0 ) ? -lr_delta : lr_delta;
 
-                gesture_data.index = 0;
-                gesture_data.total_gestures = 0;
+        if ( ( ud_abs >= IRGESTURE_GESTURE_SENSITIVITY ) || ( lr_abs >= IRGESTURE_GESTURE_SENSITIVITY ) )
+        {
+            if ( ud_abs > lr_abs )
+            {
+                motion = ( ud_delta < 0 ) ? DIR_UP : DIR_DOWN;
+            }
+            else
+            {
+                motion = ( lr_delta < 0 ) ? DIR_LEFT : DIR_RIGHT;
             }
-        } 
-        else 
+        }
+        else if ( ( ud_abs < IRGESTURE_GESTURE_NEAR_DELTA ) && ( lr_abs < IRGESTURE_GESTURE_NEAR_DELTA ) )
+        {
+            motion = ( dec->peak >= IRGESTURE_GESTURE_NEAR_LEVEL ) ? DIR_NEAR : DIR_FAR;
+        }
+    }
+
+    irgesture_decoder_init( dec );
+
+    return motion;
+}
+
+err_t irgesture_gesture_drain ( irgesture_t *ctx, irgesture_decoder_t *dec, gesture_dir_t *motion )
+{
+    uint8_t fifo_data[ IRGESTURE_GFIFO_SIZE * 4 ];
+    uint8_t fifo_addr;
+    uint8_t fifo_count;
+    uint8_t i;
+    gesture_dir_t result;
+    err_t error_flag;
+
+    *motion = DIR_NONE;
+    fifo_addr = IRGESTURE_GFIFO_U;
+    fifo_count = irgesture_read_data( ctx, IRGESTURE_GFLVL );
+
+    if ( fifo_count == 0 )
+    {
+        if ( !( irgesture_read_data( ctx, IRGESTURE_GCONF4 ) & IRGESTURE_GMODE ) )
         {
-            Delay_100ms();
-            decode_gesture( &gesture_data );
+            *motion = irgesture_decoder_flush( dec );
+        }
+
+        return I2C_MASTER_SUCCESS;
+    }
+
+    if ( fifo_count > IRGESTURE_GFIFO_SIZE )
+    {
+        fifo_count = IRGESTURE_GFIFO_SIZE;
+    }
+
+    error_flag = i2c_master_write_then_read( &ctx->i2c, &fifo_addr, 1, fifo_data, fifo_count * 4 );
+
+    if ( error_flag != I2C_MASTER_SUCCESS )
+    {
+        return error_flag;
+    }
+
+    for ( i = 0; i < fifo_count * 4; i += 4 )
+    {
+        result = irgesture_decoder_push( dec, fifo_data[ i ], fifo_data[ i + 1 ], 
+                                         fifo_data[ i + 2 ], fifo_data[ i + 3 ] );
 
-            return gesture_data.motion;
+        if ( result != DIR_NONE )
+        {
+            *motion = result;
         }
     }
+
+    return I2C_MASTER_SUCCESS;
 }
 
 void irgesture_set_gesture_mode ( irgesture_t *ctx )
@@ -686,229 +791,9 @@ static void set_mode ( irgesture_t *ctx, uint8_t mode, uint8_t enable )
     irgesture_write_data( ctx, IRGESTURE_ENABLE, reg_val );
 }
 
-static uint8_t process_gesture_data ( gesture_data_t *gesture_data )
-{
-    uint8_t u_first = 0;
-    uint8_t d_first = 0;
-    uint8_t l_first = 0;
-    uint8_t r_first = 0;
-    uint8_t u_last = 0;
-    uint8_t d_last = 0;
-    uint8_t l_last = 0;
-    uint8_t r_last = 0;
-    uint16_t ud_ratio_first;
-    uint16_t lr_ratio_first;
-    uint16_t ud_ratio_last;
-    uint16_t lr_ratio_last;
-    uint16_t ud_delta;
-    uint16_t lr_delta;
-    uint16_t i;
-
-    if ( gesture_data->total_gestures <= 4 )
-    {
-        return -1;
-    }
-
-    if ( ( gesture_data->total_gestures <= 32 ) && ( gesture_data->total_gestures > 0 ) )
-    {
-        for ( i = 0; i < gesture_data->total_gestures; i++ )
-        {
-            if ( ( gesture_data->u_data[ i ] > 10 ) && ( gesture_data->d_data[i] > 10 ) && ( gesture_data->l_data[ i ] > 10 ) && ( gesture_data->r_data[ i ] > 10 ) )
-            {
-                u_first = gesture_data->u_data[ i ];
-                d_first = gesture_data->d_data[ i ];
-                l_first = gesture_data->l_data[ i ];
-                r_first = gesture_data->r_data[ i ];
-                break;
-            }
-        }
-
-        if ( ( u_first == 0 ) || 
-             ( d_first == 0 ) ||
-             ( l_first == 0 ) || 
-             ( r_first == 0 ) )
-        {
-            return -1;
-        } 
-
-        for ( i = gesture_data->total_gestures - 1; i >= 0; i-- )
-        {
-            if( ( gesture_data->u_data[ i ] > 10 ) && ( gesture_data->d_data[ i ] > 10 ) && ( gesture_data->l_data[ i ] > 10 ) && ( gesture_data->r_data[ i ] > 10 ) )
-            {
-                u_last = gesture_data->u_data[ i ];
-                d_last = gesture_data->d_data[ i ];
-                l_last = gesture_data->l_data[ i ];
-                r_last = gesture_data->r_data[ i ];
-                break;
-            }
-        }
-    }
-
-    ud_ratio_first = ( ( u_first - d_first ) * 100 ) / ( u_first + d_first );
-    lr_ratio_first = ( ( l_first - r_first ) * 100 ) / ( l_first + r_first );
-    ud_ratio_last = ( ( u_last - d_last ) * 100 ) / ( u_last + d_last );
-    lr_ratio_last = ( ( l_last - r_last ) * 100 ) / ( l_last + r_last );
-
-    ud_delta = ud_ratio_last - ud_ratio_first;
-    lr_delta = lr_ratio_last - lr_ratio_first;
-
-    gesture_data->ud_delta += ud_delta;
-    gesture_data->lr_delta += lr_delta;
-
-    if ( gesture_data->ud_delta >= 50 )
-    {
-        gesture_data->ud_count = 1;
-    }
-    else if ( gesture_data->ud_delta <= -50 )
-    {
-        gesture_data->ud_count = -1;
-    }
-    else
-    {
-        gesture_data->ud_count = 0;
-    }
-
-    if ( gesture_data->lr_delta >= 50 )
-    {
-        gesture_data->lr_count = 1;
-    }
-    else if ( gesture_data->lr_delta <= -50 )
-    {
-        gesture_data->lr_count = -1;
-    }
-    else
-    {
-        gesture_data->lr_count = 0;
-    }
-
-    if ( ( gesture_data->ud_count == 0 ) && ( gesture_data->lr_count == 0 ) )
-    {
-        if ( ( ud_delta  < 20 ) && ( lr_delta < 20 ) )
-        {
-            if ( ( ud_delta == 0 ) && ( lr_delta == 0 ) )
-            {
-                gesture_data->near_count++;
-            }
-            else if ( ( ud_delta != 0 ) || ( lr_delta != 0 ) )
-            {
-                gesture_data->far_count++;
-            }
-
-            if ( ( gesture_data->near_count >= 10 ) && ( gesture_data->far_count >= 2 ) )
-            {
-                if ( ( ud_delta == 0 ) && ( lr_delta == 0 ) )
-                {
-                    gesture_data->state = NEAR_STATE;
-                }
-                else if ( ( ud_delta != 0 ) && ( lr_delta != 0 ) )
-                {
-                    gesture_data->state = FAR_STATE;
-                }
-                
-                return 0;
-            }
-        }
-    } 
-    else 
-    {
-        if ( (  ud_delta < 20 ) && ( lr_delta < 20 ) )
-        {
-            if ( ( ud_delta == 0 ) && ( lr_delta == 0 ) )
-            {
-                gesture_data->near_count++;
-            }
-            if ( gesture_data->near_count >= 10 )
-            {
-                gesture_data->ud_count = 0;
-                gesture_data->lr_count = 0;
-                gesture_data->ud_delta = 0;
-                gesture_data->lr_delta = 0;
-            }
-        }
-    }
-    return -1;
-}
-
-
-static uint8_t decode_gesture ( gesture_data_t *gesture_data )
+static int16_t gesture_ratio ( uint8_t value0, uint8_t value1 )
 {
-    if ( gesture_data->state == NEAR_STATE )
-    {
-        gesture_data->motion = DIR_NEAR;
-        return 0;
-    } 
-    else if ( gesture_data->state == FAR_STATE )
-    {
-         gesture_data->motion = DIR_FAR;
-         return 0;
-    }
-
-    if ( ( gesture_data->ud_count == -1 ) && ( gesture_data->lr_count == 0 ) )
-    {
-        gesture_data->motion = DIR_UP;
-    }
-    else if ( ( gesture_data->ud_count == 1 ) && ( gesture_data->lr_count == 0) )
-    {
-        gesture_data->motion = DIR_DOWN;
-    }
-    else if ( ( gesture_data->ud_count == 0 ) && ( gesture_data->lr_count == 1) )
-    {
-        gesture_data->motion = DIR_RIGHT;
-    }
-    else if ( ( gesture_data->ud_count == 0 ) && ( gesture_data->lr_count == -1) )
-    {
-        gesture_data->motion = DIR_LEFT;
-    }
-    else if ( ( gesture_data->ud_count == -1 ) && ( gesture_data->lr_count == 1) )
-    {
-        if ( gesture_data->ud_delta > gesture_data->lr_delta )
-        {
-            gesture_data->motion = DIR_UP;
-        }
-        else
-        {
-            gesture_data->motion = DIR_RIGHT;
-        }
-    }
-    else if ( ( gesture_data->ud_count == 1 ) && ( gesture_data->lr_count == -1) )
-    {
-        if ( gesture_data->ud_delta > gesture_data->lr_delta )
-        {
-            gesture_data->motion = DIR_DOWN;
-        }
-        else
-        {
-            gesture_data->motion = DIR_LEFT;
-        }
-    }
-    else if ( ( gesture_data->ud_count == -1 ) && ( gesture_data->lr_count == -1) )
-    {
-        if ( gesture_data->ud_delta > gesture_data->lr_delta )
-        {
-             gesture_data->motion = DIR_UP;
-        }
-        else
-        {
-            gesture_data->motion = DIR_LEFT;
-        }
-    }
-    else if ( ( gesture_data->ud_count == 1 ) && ( gesture_data->lr_count == 1) )
-    {
-        if ( gesture_data->ud_delta > gesture_data->lr_delta )
-        {
-            gesture_data->motion = DIR_DOWN;
-        }
-        else
-        {
-            gesture_data->motion = DIR_RIGHT;
-        }
-    }
-    else
-    {
-        return -1;
-    }
-
-    return 0;
+    return ( ( ( int16_t ) value0 - value1 ) * 100 ) / ( ( int16_t ) value0 + value1 );
 }
 
 // ------------------------------------------------------------------------- END
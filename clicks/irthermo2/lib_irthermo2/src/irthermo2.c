@@ -89,9 +89,9 @@ void irthermo2_generic_write ( irthermo2_t *ctx, uint8_t reg, uint8_t *data_in,
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_in[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );      
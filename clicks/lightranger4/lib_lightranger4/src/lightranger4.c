@@ -207,9 +207,9 @@ void lightranger4_generic_write ( lightranger4_t *ctx, uint16_t reg, uint8_t *da
     tx_buf[ 0 ] = reg  >> 8;
     tx_buf[ 1 ] = reg & 0x00FF;
 
-    for ( cnt = 2; cnt <= len + 1; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 2 ];
+        tx_buf[ cnt + 2 ] = data_buf[ cnt ];
     }
 
     i2c_master_write( &ctx->i2c, tx_buf, len + 2 ); 
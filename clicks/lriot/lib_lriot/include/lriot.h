@@ -118,6 +118,22 @@ extern "C"{
 #define LRIOT_LORA_PKT_PAYLOAD_LEN              64
 #define LRIOT_LORA_DEFAULT_FREQ                 868100000ul
 
+/**
+ * @brief LR IoT asynchronous engine macros.
+ * @details Queue sizes, states and request types of the LR IoT Click asynchronous engine.
+ * @note The asynchronous engine is supported in transceiver firmware only.
+ */
+#define LRIOT_ENGINE_REQ_QUEUE_SIZE             4
+#define LRIOT_ENGINE_PKT_QUEUE_SIZE             4
+#define LRIOT_ENGINE_RX_CONTINUOUS              0xFFFFFFul
+#define LRIOT_ENGINE_CFG_UNKNOWN                0xFF
+#define LRIOT_ENGINE_STATE_IDLE                 0
+#define LRIOT_ENGINE_STATE_RX                   1
+#define LRIOT_ENGINE_STATE_BUSY                 2
+#define LRIOT_REQ_WIFI_SCAN                     0
+#define LRIOT_REQ_GNSS_SCAN                     1
+#define LRIOT_REQ_LORA_TX                       2
+
 /**
  * @brief LR IoT update firmware macros.
  * @details Specified macro for updating the module firmware of LR IoT Click driver.
@@ -286,6 +302,8 @@ typedef struct
     pin_name_t     chip_select;     /**< Chip select pin descriptor (used for SPI driver). */
     
     lriot_wifi_settings_t wifi_settings; /**< WiFi settings object. */
+    
+    uint8_t        radio_cfg_seq;   /**< Changed by every blocking call that reprograms the radio. */
 
 } lriot_t;
 
@@ -313,6 +331,65 @@ typedef struct
 
 } lriot_cfg_t;
 
+#if ( LRIOT_FIRMWARE_SELECTOR == LRIOT_TRANSCEIVE_FIRMWARE )
+/**
+ * @brief LR IoT request completion callback.
+ * @details Callback called by the asynchronous engine when a queued request completes.
+ * The request data is the results object or message buffer passed on submission.
+ */
+typedef void ( *lriot_req_cb_t ) ( uint8_t req_type, void *req_data, err_t status );
+
+/**
+ * @brief LR IoT queued request object.
+ * @details Queued request object definition of LR IoT Click asynchronous engine.
+ */
+typedef struct
+{
+    uint8_t         req_type;       /**< Request type. */
+    void           *req_data;       /**< Results object or LoRa message buffer. */
+    lriot_req_cb_t  callback;       /**< Completion callback, can be NULL. */
+
+} lriot_request_t;
+
+/**
+ * @brief LR IoT received LoRa packet object.
+ * @details Received LoRa packet object definition of LR IoT Click asynchronous engine.
+ */
+typedef struct
+{
+    uint8_t                     payload[ LRIOT_LORA_PKT_PAYLOAD_LEN ];  /**< Packet payload. */
+    uint8_t                     len;                                    /**< Payload length. */
+    lriot_lora_packet_status_t  status;                                 /**< Packet RSSI and SNR. */
+
+} lriot_lora_packet_t;
+
+/**
+ * @brief LR IoT asynchronous engine object.
+ * @details Asynchronous engine object definition of LR IoT Click driver.
+ */
+typedef struct
+{
+    uint8_t              state;                                         /**< Engine state. */
+    uint8_t              rx_enabled;                                    /**< Continuous LoRa RX enabled. */
+
+    lriot_request_t      req_queue[ LRIOT_ENGINE_REQ_QUEUE_SIZE ];      /**< Queued requests. */
+    uint8_t              req_head;                                      /**< Oldest queued request index. */
+    uint8_t              req_count;                                     /**< Number of queued requests. */
+    lriot_request_t      active_req;                                    /**< Request in progress. */
+
+    lriot_lora_packet_t  pkt_queue[ LRIOT_ENGINE_PKT_QUEUE_SIZE ];      /**< Received packets. */
+    uint8_t              pkt_head;                                      /**< Oldest received packet index. */
+    uint8_t              pkt_count;                                     /**< Number of received packets. */
+    uint16_t             pkt_dropped;                                   /**< Packets dropped on full queue. */
+
+    uint8_t              pkt_type;                                      /**< Programmed packet type. */
+    uint32_t             rf_freq;                                       /**< Programmed RF frequency. */
+    uint32_t             irq_mask;                                      /**< Programmed DIO IRQ mask. */
+    uint8_t              radio_cfg_seq;                                 /**< Context radio_cfg_seq of the cached values. */
+
+} lriot_engine_t;
+#endif
+
 /**
  * @brief LR IoT Click return value data.
  * @details Predefined enum values for driver return values.
@@ -456,6 +533,82 @@ err_t lriot_send_lora_message ( lriot_t *ctx, uint8_t *message );
  * @note This function is supported in transceiver firmware only.
  */
 err_t lriot_read_lora_message ( lriot_t *ctx, lriot_lora_packet_status_t *pkt_status, uint8_t *message );
+
+/**
+ * @brief LR IoT engine init function.
+ * @details This function clears the asynchronous engine queues and marks the cached
+ * radio configuration as unknown.
+ * @param[out] engine : Asynchronous engine object.
+ * See #lriot_engine_t object definition for detailed explanation.
+ * @return Nothing.
+ * @note This function is supported in transceiver firmware only.
+ */
+void lriot_engine_init ( lriot_engine_t *engine );
+
+/**
+ * @brief LR IoT engine set rx function.
+ * @details This function enables or disables continuous LoRa reception. While enabled, the
+ * radio is kept in RX between queued requests and received packets are queued by the engine.
+ * @param[in] ctx : Click context object.
+ * See #lriot_t object definition for detailed explanation.
+ * @param[in] engine : Asynchronous engine object.
+ * See #lriot_engine_t object definition for detailed explanation.
+ * @param[in] enable : Continuous RX enable.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note This function is supported in transceiver firmware only.
+ */
+err_t lriot_engine_set_rx ( lriot_t *ctx, lriot_engine_t *engine, uint8_t enable );
+
+/**
+ * @brief LR IoT engine submit function.
+ * @details This function queues a Wi-Fi scan, GNSS scan or LoRa TX request. The request is
+ * started by @b lriot_engine_process and completed through its callback.
+ * @param[in] engine : Asynchronous engine object.
+ * See #lriot_engine_t object definition for detailed explanation.
+ * @param[in] req_type : Request type (LRIOT_REQ_WIFI_SCAN, LRIOT_REQ_GNSS_SCAN or LRIOT_REQ_LORA_TX).
+ * @param[in] req_data : Results object for scans, or a message buffer of
+ * @b LRIOT_LORA_PKT_PAYLOAD_LEN bytes for LoRa TX. Must stay valid until completion.
+ * @param[in] callback : Completion callback, can be NULL.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error, queue is full or request type is invalid.
+ * See #err_t definition for detailed explanation.
+ * @note This function is supported in transceiver firmware only.
+ */
+err_t lriot_engine_submit ( lriot_engine_t *engine, uint8_t req_type, void *req_data, lriot_req_cb_t callback );
+
+/**
+ * @brief LR IoT engine process function.
+ * @details This function services the IRQ line, completes the request in progress, starts the
+ * next queued request and re-enters continuous RX when idle. It never waits for the radio.
+ * @param[in] ctx : Click context object.
+ * See #lriot_t object definition for detailed explanation.
+ * @param[in] engine : Asynchronous engine object.
+ * See #lriot_engine_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note This function should be called from the main loop or when the IRQ pin goes high.
+ * Blocking radio functions may be mixed with the engine only while no request is in progress,
+ * the engine reprograms the radio and re-enters RX after them.
+ * It is supported in transceiver firmware only.
+ */
+err_t lriot_engine_process ( lriot_t *ctx, lriot_engine_t *engine );
+
+/**
+ * @brief LR IoT engine read packet function.
+ * @details This function takes the oldest received LoRa packet from the engine queue.
+ * @param[in] engine : Asynchronous engine object.
+ * See #lriot_engine_t object definition for detailed explanation.
+ * @param[out] pkt : Received packet with its RSSI and SNR.
+ * See #lriot_lora_packet_t object definition for detailed explanation.
+ * @return @li @c  0 - Packet read,
+ *         @li @c -1 - Queue is empty.
+ * See #err_t definition for detailed explanation.
+ * @note This function is supported in transceiver firmware only.
+ */
+err_t lriot_engine_read_packet ( lriot_engine_t *engine, lriot_lora_packet_t *pkt );
 #endif
 
 /**
@@ -45,6 +45,90 @@
  */
 #define DUMMY  0x00
 
+#if ( LRIOT_FIRMWARE_SELECTOR == LRIOT_TRANSCEIVE_FIRMWARE )
+/**
+ * @brief LR IoT read wifi results function.
+ * @details This function reads the results of a finished WiFi scan.
+ * @param[in] ctx : Click context object.
+ * See #lriot_t object definition for detailed explanation.
+ * @param[out] results : WiFi scan results object.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t lriot_read_wifi_results ( lriot_t *ctx, lriot_wifi_scan_results_t *results );
+
+/**
+ * @brief LR IoT read gnss results function.
+ * @details This function reads the results of a finished GNSS scan.
+ * @param[in] ctx : Click context object.
+ * See #lriot_t object definition for detailed explanation.
+ * @param[out] results : GNSS scan results object.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t lriot_read_gnss_results ( lriot_t *ctx, lriot_gnss_scan_results_t *results );
+
+/**
+ * @brief LR IoT engine set irq function.
+ * @details This function programs the DIO IRQ mask only when it differs from the cached one.
+ * @param[in] ctx : Click context object.
+ * See #lriot_t object definition for detailed explanation.
+ * @param[in] engine : Asynchronous engine object.
+ * @param[in] irq_mask : DIO1 IRQ mask.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t lriot_engine_set_irq ( lriot_t *ctx, lriot_engine_t *engine, lr1110_system_irq_mask_t irq_mask );
+
+/**
+ * @brief LR IoT engine set lora function.
+ * @details This function programs the LoRa packet type and RF frequency only when they differ
+ * from the cached ones.
+ * @param[in] ctx : Click context object.
+ * See #lriot_t object definition for detailed explanation.
+ * @param[in] engine : Asynchronous engine object.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t lriot_engine_set_lora ( lriot_t *ctx, lriot_engine_t *engine );
+
+/**
+ * @brief LR IoT engine invalidate config function.
+ * @details This function marks the cached packet type, RF frequency and DIO IRQ mask as unknown.
+ * @param[in] engine : Asynchronous engine object.
+ * @return Nothing.
+ */
+static void lriot_engine_invalidate_cfg ( lriot_engine_t *engine );
+
+/**
+ * @brief LR IoT engine start request function.
+ * @details This function starts the active request of the engine without waiting for it.
+ * @param[in] ctx : Click context object.
+ * See #lriot_t object definition for detailed explanation.
+ * @param[in] engine : Asynchronous engine object.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t lriot_engine_start_req ( lriot_t *ctx, lriot_engine_t *engine );
+
+/**
+ * @brief LR IoT engine handle irq function.
+ * @details This function handles the raised IRQ status for the current engine state.
+ * @param[in] ctx : Click context object.
+ * See #lriot_t object definition for detailed explanation.
+ * @param[in] engine : Asynchronous engine object.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t lriot_engine_handle_irq ( lriot_t *ctx, lriot_engine_t *engine );
+#endif
+
 void lriot_cfg_setup ( lriot_cfg_t *cfg ) 
 {
     cfg->sck  = HAL_PIN_NC;
@@ -101,6 +185,7 @@ err_t lriot_init ( lriot_t *ctx, lriot_cfg_t *cfg )
     digital_in_init( &ctx->int_pin, cfg->int_pin );
     
     ctx->bsy_pin_name = cfg->bsy;
+    ctx->radio_cfg_seq = 0;
 
     return SPI_MASTER_SUCCESS;
 }
@@ -108,6 +193,7 @@ err_t lriot_init ( lriot_t *ctx, lriot_cfg_t *cfg )
 err_t lriot_default_cfg ( lriot_t *ctx ) 
 {
     err_t error_flag = LRIOT_OK;
+    ctx->radio_cfg_seq++;
     lriot_set_rst_pin ( ctx, 1 );
     Delay_1sec ( );
 
@@ -226,6 +312,7 @@ err_t lriot_default_cfg ( lriot_t *ctx )
 
 void lriot_set_rst_pin ( lriot_t *ctx, uint8_t state )
 {
+    ctx->radio_cfg_seq++;
     digital_out_write ( &ctx->rst, state );
 }
 
@@ -261,6 +348,7 @@ err_t lriot_get_wifi_scan_results ( lriot_t *ctx, lriot_wifi_scan_results_t *res
 {
     err_t error_flag = LRIOT_OK;
 #if ( LRIOT_FIRMWARE_SELECTOR == LRIOT_TRANSCEIVE_FIRMWARE )
+    ctx->radio_cfg_seq++;
     /* Prepare event interrupt line */
     error_flag |= lr1110_system_set_dio_irq_params( ctx, LR1110_SYSTEM_IRQ_WIFI_SCAN_DONE, 0 );
     
@@ -280,17 +368,7 @@ err_t lriot_get_wifi_scan_results ( lriot_t *ctx, lriot_wifi_scan_results_t *res
     /* Blocking wait */
     while ( !lriot_get_int_pin( ctx ) );
 
-    /* Read scanning time */
-    lr1110_wifi_read_cumulative_timing( ctx, &results->timings );
-    
-    /* Clear event interrupt line */
-    error_flag |= lr1110_system_clear_irq_status( ctx, LR1110_SYSTEM_IRQ_WIFI_SCAN_DONE );
-
-    /* Get number of wifi scan results */
-    error_flag |= lr1110_wifi_get_nb_results( ctx, &results->num_wifi_results );
-    
-    error_flag |= lr1110_wifi_read_extended_full_results( ctx, LRIOT_WIFI_SCAN_DISPLAY_ALL, 
-                                                          results->num_wifi_results, results->scan_results );
+    error_flag |= lriot_read_wifi_results( ctx, results );
 #else
     uint8_t wifi_max_results = ctx->wifi_settings.max_results;
     error_flag |= lr1110_modem_wifi_reset_cumulative_timing( ctx );
@@ -338,6 +416,7 @@ err_t lriot_get_gnss_scan_results ( lriot_t *ctx, lriot_gnss_scan_results_t *res
 {
     err_t error_flag = LRIOT_OK;
 #if ( LRIOT_FIRMWARE_SELECTOR == LRIOT_TRANSCEIVE_FIRMWARE )
+    ctx->radio_cfg_seq++;
     /* Prepare event interrupt line */
     error_flag |= lr1110_system_set_dio_irq_params( ctx, LR1110_SYSTEM_IRQ_GNSS_SCAN_DONE, 0 );
 
@@ -353,21 +432,7 @@ err_t lriot_get_gnss_scan_results ( lriot_t *ctx, lriot_gnss_scan_results_t *res
     /* Blocking wait */
     while ( !lriot_get_int_pin( ctx ) );
 
-    /* Clear event interrupt line */
-    error_flag |= lr1110_system_clear_irq_status( ctx, LR1110_SYSTEM_IRQ_GNSS_SCAN_DONE );
-
-    /* Get number of GNSS scan results */
-    error_flag |= lr1110_gnss_get_nb_detected_satellites( ctx, &results->num_satellites );
-    
-    if ( ( results->num_satellites > 0 ) && ( LRIOT_OK == error_flag ) )
-    {
-        error_flag |= lr1110_gnss_get_detected_satellites( ctx, results->num_satellites, results->satellite_id_cnr_doppler );
-        error_flag |= lr1110_gnss_get_result_size( ctx, &results->scan_results_len );
-        error_flag |= lr1110_gnss_read_results( ctx, results->scan_results, results->scan_results_len );
-        error_flag |= lr1110_gnss_get_result_destination( results->scan_results, 
-                                                          results->scan_results_len, 
-                                                          &results->destination_id );
-    }
+    error_flag |= lriot_read_gnss_results( ctx, results );
 #else
     if ( LRIOT_ERROR == lr1110_modem_gnss_scan_autonomous( ctx, LR1110_MODEM_GNSS_OPTION_BEST_EFFORT, 
                                                            LR1110_MODEM_GNSS_PSEUDO_RANGE_MASK, LRIOT_GNSS_SCAN_MAX_SATELLITES ) )
@@ -394,6 +459,7 @@ err_t lriot_get_gnss_scan_results ( lriot_t *ctx, lriot_gnss_scan_results_t *res
 
 err_t lriot_update_firmware ( lriot_t *ctx )
 {
+    ctx->radio_cfg_seq++;
 #if LRIOT_UPDATE_FIRMWARE
     return lr1110_update_firmware ( ctx, LR1110_FIRMWARE_VERSION, lr1110_firmware_image, LR1110_FIRMWARE_IMAGE_SIZE );
 #endif
@@ -415,6 +481,7 @@ err_t lriot_send_lora_message ( lriot_t *ctx, uint8_t *message )
 {
     err_t error_flag = LRIOT_OK;
     lr1110_system_irq_mask_t irq_status;
+    ctx->radio_cfg_seq++;
     error_flag |= lr1110_radio_set_pkt_type ( ctx, LR1110_RADIO_PKT_TYPE_LORA );
     error_flag |= lr1110_radio_set_rf_freq( ctx, LRIOT_LORA_DEFAULT_FREQ );
     error_flag |= lr1110_system_set_dio_irq_params( ctx, LR1110_SYSTEM_IRQ_TX_DONE | 
@@ -438,6 +505,7 @@ err_t lriot_read_lora_message ( lriot_t *ctx, lriot_lora_packet_status_t *pkt_st
 {
     err_t error_flag = LRIOT_OK;
     lr1110_system_irq_mask_t irq_regs;
+    ctx->radio_cfg_seq++;
     error_flag |= lr1110_radio_set_pkt_type ( ctx, LR1110_RADIO_PKT_TYPE_LORA );
     error_flag |= lr1110_radio_set_rf_freq( ctx, LRIOT_LORA_DEFAULT_FREQ );
     error_flag |= lr1110_system_set_dio_irq_params( ctx, LR1110_SYSTEM_IRQ_RX_DONE | 
@@ -480,6 +548,308 @@ err_t lriot_read_lora_message ( lriot_t *ctx, lriot_lora_packet_status_t *pkt_st
     }
     return LRIOT_ERROR;
 }
+
+void lriot_engine_init ( lriot_engine_t *engine )
+{
+    engine->state = LRIOT_ENGINE_STATE_IDLE;
+    engine->rx_enabled = 0;
+    engine->req_head = 0;
+    engine->req_count = 0;
+    engine->pkt_head = 0;
+    engine->pkt_count = 0;
+    engine->pkt_dropped = 0;
+    engine->radio_cfg_seq = 0;
+    lriot_engine_invalidate_cfg( engine );
+}
+
+err_t lriot_engine_set_rx ( lriot_t *ctx, lriot_engine_t *engine, uint8_t enable )
+{
+    err_t error_flag = LRIOT_OK;
+    engine->rx_enabled = enable;
+    if ( ( !enable ) && ( LRIOT_ENGINE_STATE_RX == engine->state ) )
+    {
+        error_flag |= lr1110_system_set_standby( ctx, LR1110_SYSTEM_STANDBY_CFG_RC );
+        engine->state = LRIOT_ENGINE_STATE_IDLE;
+    }
+    return error_flag;
+}
+
+err_t lriot_engine_submit ( lriot_engine_t *engine, uint8_t req_type, void *req_data, lriot_req_cb_t callback )
+{
+    uint8_t req_idx;
+    if ( ( req_type > LRIOT_REQ_LORA_TX ) || ( engine->req_count >= LRIOT_ENGINE_REQ_QUEUE_SIZE ) )
+    {
+        return LRIOT_ERROR;
+    }
+    req_idx = ( engine->req_head + engine->req_count ) % LRIOT_ENGINE_REQ_QUEUE_SIZE;
+    engine->req_queue[ req_idx ].req_type = req_type;
+    engine->req_queue[ req_idx ].req_data = req_data;
+    engine->req_queue[ req_idx ].callback = callback;
+    engine->req_count++;
+    return LRIOT_OK;
+}
+
+err_t lriot_engine_process ( lriot_t *ctx, lriot_engine_t *engine )
+{
+    err_t error_flag = LRIOT_OK;
+
+    if ( engine->radio_cfg_seq != ctx->radio_cfg_seq )
+    {
+        // A blocking call reprogrammed the radio and took it out of RX.
+        lriot_engine_invalidate_cfg( engine );
+        engine->radio_cfg_seq = ctx->radio_cfg_seq;
+        if ( LRIOT_ENGINE_STATE_RX == engine->state )
+        {
+            engine->state = LRIOT_ENGINE_STATE_IDLE;
+        }
+    }
+
+    if ( ( LRIOT_ENGINE_STATE_IDLE != engine->state ) && lriot_get_int_pin( ctx ) )
+    {
+        error_flag |= lriot_engine_handle_irq( ctx, engine );
+    }
+
+    if ( ( LRIOT_ENGINE_STATE_BUSY != engine->state ) && engine->req_count )
+    {
+        if ( LRIOT_ENGINE_STATE_RX == engine->state )
+        {
+            error_flag |= lr1110_system_set_standby( ctx, LR1110_SYSTEM_STANDBY_CFG_RC );
+        }
+        engine->active_req = engine->req_queue[ engine->req_head ];
+        engine->req_head = ( engine->req_head + 1 ) % LRIOT_ENGINE_REQ_QUEUE_SIZE;
+        engine->req_count--;
+        engine->state = LRIOT_ENGINE_STATE_BUSY;
+        if ( LRIOT_OK != lriot_engine_start_req( ctx, engine ) )
+        {
+            engine->state = LRIOT_ENGINE_STATE_IDLE;
+            if ( NULL != engine->active_req.callback )
+            {
+                engine->active_req.callback( engine->active_req.req_type, engine->active_req.req_data, LRIOT_ERROR );
+            }
+            error_flag = LRIOT_ERROR;
+        }
+    }
+
+    if ( ( LRIOT_ENGINE_STATE_IDLE == engine->state ) && engine->rx_enabled )
+    {
+        error_flag |= lriot_engine_set_lora( ctx, engine );
+        error_flag |= lriot_engine_set_irq( ctx, engine, LR1110_SYSTEM_IRQ_RX_DONE | 
+                                                         LR1110_SYSTEM_IRQ_TIMEOUT | 
+                                                         LR1110_SYSTEM_IRQ_CRC_ERROR );
+        error_flag |= lr1110_system_clear_irq_status ( ctx, LR1110_SYSTEM_IRQ_ALL_MASK );
+        error_flag |= lr1110_radio_set_rx_with_timeout_in_rtc_step( ctx, LRIOT_ENGINE_RX_CONTINUOUS );
+        if ( LRIOT_OK == error_flag )
+        {
+            engine->state = LRIOT_ENGINE_STATE_RX;
+        }
+    }
+    return error_flag;
+}
+
+err_t lriot_engine_read_packet ( lriot_engine_t *engine, lriot_lora_packet_t *pkt )
+{
+    if ( 0 == engine->pkt_count )
+    {
+        return LRIOT_ERROR;
+    }
+    *pkt = engine->pkt_queue[ engine->pkt_head ];
+    engine->pkt_head = ( engine->pkt_head + 1 ) % LRIOT_ENGINE_PKT_QUEUE_SIZE;
+    engine->pkt_count--;
+    return LRIOT_OK;
+}
+
+static err_t lriot_read_wifi_results ( lriot_t *ctx, lriot_wifi_scan_results_t *results )
+{
+    err_t error_flag = LRIOT_OK;
+
+    /* Read scanning time */
+    lr1110_wifi_read_cumulative_timing( ctx, &results->timings );
+    
+    /* Clear event interrupt line */
+    error_flag |= lr1110_system_clear_irq_status( ctx, LR1110_SYSTEM_IRQ_WIFI_SCAN_DONE );
+
+    /* Get number of wifi scan results */
+    error_flag |= lr1110_wifi_get_nb_results( ctx, &results->num_wifi_results );
+    
+    error_flag |= lr1110_wifi_read_extended_full_results( ctx, LRIOT_WIFI_SCAN_DISPLAY_ALL, 
+                                                          results->num_wifi_results, results->scan_results );
+    return error_flag;
+}
+
+static err_t lriot_read_gnss_results ( lriot_t *ctx, lriot_gnss_scan_results_t *results )
+{
+    err_t error_flag = LRIOT_OK;
+
+    /* Clear event interrupt line */
+    error_flag |= lr1110_system_clear_irq_status( ctx, LR1110_SYSTEM_IRQ_GNSS_SCAN_DONE );
+
+    /* Get number of GNSS scan results */
+    error_flag |= lr1110_gnss_get_nb_detected_satellites( ctx, &results->num_satellites );
+    
+    if ( ( results->num_satellites > 0 ) && ( LRIOT_OK == error_flag ) )
+    {
+        error_flag |= lr1110_gnss_get_detected_satellites( ctx, results->num_satellites, results->satellite_id_cnr_doppler );
+        error_flag |= lr1110_gnss_get_result_size( ctx, &results->scan_results_len );
+        error_flag |= lr1110_gnss_read_results( ctx, results->scan_results, results->scan_results_len );
+        error_flag |= lr1110_gnss_get_result_destination( results->scan_results, 
+                                                          results->scan_results_len, 
+                                                          &results->destination_id );
+    }
+    return error_flag;
+}
+
+static err_t lriot_engine_set_irq ( lriot_t *ctx, lriot_engine_t *engine, lr1110_system_irq_mask_t irq_mask )
+{
+    err_t error_flag = LRIOT_OK;
+    if ( irq_mask != engine->irq_mask )
+    {
+        error_flag = lr1110_system_set_dio_irq_params( ctx, irq_mask, 0 );
+        engine->irq_mask = 0;
+        if ( LRIOT_OK == error_flag )
+        {
+            engine->irq_mask = irq_mask;
+        }
+    }
+    return error_flag;
+}
+
+static err_t lriot_engine_set_lora ( lriot_t *ctx, lriot_engine_t *engine )
+{
+    err_t error_flag = LRIOT_OK;
+    if ( LR1110_RADIO_PKT_TYPE_LORA != engine->pkt_type )
+    {
+        error_flag |= lr1110_radio_set_pkt_type ( ctx, LR1110_RADIO_PKT_TYPE_LORA );
+        engine->pkt_type = LRIOT_ENGINE_CFG_UNKNOWN;
+        if ( LRIOT_OK == error_flag )
+        {
+            engine->pkt_type = LR1110_RADIO_PKT_TYPE_LORA;
+        }
+    }
+    if ( LRIOT_LORA_DEFAULT_FREQ != engine->rf_freq )
+    {
+        error_flag |= lr1110_radio_set_rf_freq( ctx, LRIOT_LORA_DEFAULT_FREQ );
+        engine->rf_freq = 0;
+        if ( LRIOT_OK == error_flag )
+        {
+            engine->rf_freq = LRIOT_LORA_DEFAULT_FREQ;
+        }
+    }
+    return error_flag;
+}
+
+static void lriot_engine_invalidate_cfg ( lriot_engine_t *engine )
+{
+    engine->pkt_type = LRIOT_ENGINE_CFG_UNKNOWN;
+    engine->rf_freq = 0;
+    engine->irq_mask = 0;
+}
+
+static err_t lriot_engine_start_req ( lriot_t *ctx, lriot_engine_t *engine )
+{
+    err_t error_flag = LRIOT_OK;
+    if ( LRIOT_REQ_WIFI_SCAN == engine->active_req.req_type )
+    {
+        error_flag |= lriot_engine_set_irq( ctx, engine, LR1110_SYSTEM_IRQ_WIFI_SCAN_DONE );
+        error_flag |= lr1110_wifi_reset_cumulative_timing( ctx );
+        error_flag |= lr1110_wifi_scan( ctx, 
+                                        ctx->wifi_settings.signal_type, 
+                                        ctx->wifi_settings.channels, 
+                                        ctx->wifi_settings.scan_mode, 
+                                        ctx->wifi_settings.max_results, 
+                                        ctx->wifi_settings.nb_scan_per_channel, 
+                                        ctx->wifi_settings.timeout_in_ms, 
+                                        ctx->wifi_settings.abort_on_timeout );
+    }
+    else if ( LRIOT_REQ_GNSS_SCAN == engine->active_req.req_type )
+    {
+        error_flag |= lriot_engine_set_irq( ctx, engine, LR1110_SYSTEM_IRQ_GNSS_SCAN_DONE );
+        error_flag |= lr1110_gnss_scan_autonomous( ctx, 
+                                                   0, 
+                                                   LR1110_GNSS_OPTION_DEFAULT, 
+                                                   LR1110_GNSS_RESULTS_LEGACY_PSEUDO_RANGE_MASK | 
+                                                   LR1110_GNSS_RESULTS_LEGACY_DOPPLER_MASK, 
+                                                   LRIOT_GNSS_SCAN_DISPLAY_ALL );
+    }
+    else
+    {
+        error_flag |= lriot_engine_set_lora( ctx, engine );
+        error_flag |= lriot_engine_set_irq( ctx, engine, LR1110_SYSTEM_IRQ_TX_DONE | 
+                                                         LR1110_SYSTEM_IRQ_TIMEOUT );
+        error_flag |= lr1110_system_clear_irq_status ( ctx, LR1110_SYSTEM_IRQ_ALL_MASK );
+        error_flag |= lr1110_regmem_write_buffer8 ( ctx, engine->active_req.req_data, LRIOT_LORA_PKT_PAYLOAD_LEN );
+        error_flag |= lr1110_radio_set_tx ( ctx, 0 );
+    }
+    return error_flag;
+}
+
+static err_t lriot_engine_handle_irq ( lriot_t *ctx, lriot_engine_t *engine )
+{
+    err_t error_flag = LRIOT_OK;
+    err_t req_status = LRIOT_ERROR;
+    lr1110_system_irq_mask_t irq_status = 0;
+
+    if ( LRIOT_ENGINE_STATE_RX == engine->state )
+    {
+        error_flag |= lr1110_system_get_and_clear_irq_status( ctx, &irq_status );
+        if ( ( irq_status & LR1110_SYSTEM_IRQ_RX_DONE ) && !( irq_status & LR1110_SYSTEM_IRQ_CRC_ERROR ) )
+        {
+            lr1110_radio_rx_buffer_status_t rx_buffer_status;
+            lr1110_radio_pkt_status_lora_t lr_pkt_status;
+            lriot_lora_packet_t *pkt;
+
+            if ( engine->pkt_count >= LRIOT_ENGINE_PKT_QUEUE_SIZE )
+            {
+                engine->pkt_dropped++;
+                return error_flag;
+            }
+            pkt = &engine->pkt_queue[ ( engine->pkt_head + engine->pkt_count ) % LRIOT_ENGINE_PKT_QUEUE_SIZE ];
+
+            error_flag |= lr1110_radio_get_rx_buffer_status( ctx, &rx_buffer_status );
+            pkt->len = rx_buffer_status.pld_len_in_bytes;
+            if ( pkt->len > LRIOT_LORA_PKT_PAYLOAD_LEN )
+            {
+                pkt->len = LRIOT_LORA_PKT_PAYLOAD_LEN;
+            }
+            error_flag |= lr1110_regmem_read_buffer8( ctx, pkt->payload, rx_buffer_status.buffer_start_pointer, pkt->len );
+            error_flag |= lr1110_radio_get_lora_pkt_status( ctx, &lr_pkt_status );
+            pkt->status.rssi_pkt_in_dbm = lr_pkt_status.rssi_pkt_in_dbm;
+            pkt->status.signal_rssi_pkt_in_dbm = lr_pkt_status.signal_rssi_pkt_in_dbm;
+            pkt->status.snr_pkt_in_db = lr_pkt_status.snr_pkt_in_db;
+            if ( LRIOT_OK == error_flag )
+            {
+                engine->pkt_count++;
+            }
+        }
+        return error_flag;
+    }
+
+    if ( LRIOT_REQ_WIFI_SCAN == engine->active_req.req_type )
+    {
+        req_status = lriot_read_wifi_results( ctx, engine->active_req.req_data );
+        // Scans reconfigure the radio, so LoRa is programmed again afterwards.
+        lriot_engine_invalidate_cfg( engine );
+    }
+    else if ( LRIOT_REQ_GNSS_SCAN == engine->active_req.req_type )
+    {
+        req_status = lriot_read_gnss_results( ctx, engine->active_req.req_data );
+        lriot_engine_invalidate_cfg( engine );
+    }
+    else
+    {
+        error_flag |= lr1110_system_get_and_clear_irq_status( ctx, &irq_status );
+        if ( ( LRIOT_OK == error_flag ) && ( irq_status & LR1110_SYSTEM_IRQ_TX_DONE ) )
+        {
+            req_status = LRIOT_OK;
+        }
+    }
+
+    engine->state = LRIOT_ENGINE_STATE_IDLE;
+    if ( NULL != engine->active_req.callback )
+    {
+        engine->active_req.callback( engine->active_req.req_type, engine->active_req.req_data, req_status );
+    }
+    return error_flag | req_status;
+}
 #endif
 
 // ------------------------------------------------------------------------- END
@@ -72,7 +72,7 @@ void macaddress_generic_write ( macaddress_t *ctx, uint8_t reg, uint8_t *data_bu
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 0; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
         tx_buf[ cnt + 1 ] = *data_buf; 
         data_buf++;
@@ -116,6 +116,17 @@
 #define MAGNETO_FLAG_ERROR                        1
 /** \} */
 
+/**
+ * \defgroup stream Streaming
+ * \{
+ */
+#define MAGNETO_STREAM_FRAME_ERROR                0x4000
+#define MAGNETO_STREAM_DATA_MASK                  0x3FFF
+#define MAGNETO_STREAM_COUNTS                     16384
+#define MAGNETO_STREAM_VEL_FRAC_BITS              8
+#define MAGNETO_STREAM_VEL_SHIFT_DEFAULT          3
+/** \} */
+
 /** \} */ // End group macro
 
 // --------------------------------------------------------------- PUBLIC TYPES
@@ -165,6 +176,22 @@ typedef struct
 
 } magneto_cfg_t;
 
+/**
+ * @brief Streaming reader object definition.
+ */
+typedef struct
+{
+    uint8_t cmd[ 2 ];           // Command frame sent with every sample, parity included.
+    uint8_t primed;             // The first result is in and the tracker is seeded.
+    uint8_t vel_shift;          // Velocity filter, new sample weight is 1 / 2^vel_shift.
+
+    uint16_t angle;             // Last 14-bit angle.
+    int32_t position;           // Unwrapped position in counts, 16384 per turn.
+    int32_t velocity;           // Counts per sample, MAGNETO_STREAM_VEL_FRAC_BITS fraction bits.
+    uint16_t errors;            // Frames dropped on parity or error flag.
+
+} magneto_stream_t;
+
 /** \} */ // End types group
 
 // ------------------------------------------------------------------ CONSTANTS
@@ -300,6 +327,56 @@ uint8_t magneto_check_state ( magneto_t *ctx );
  */
 float magneto_get_angle ( magneto_t *ctx );
 
+/**
+ * @brief Stream start function.
+ *
+ * @param ctx                     Click object.
+ * @param stream                  Streaming reader object.
+ * @param address_command         14-bit register address, usually MAGNETO_REG_ANGLE.
+ * @param vel_shift               Velocity filter shift, 0 disables filtering.
+ *
+ * @description This function precomputes the read command and sends it once to 
+ * prime the pipeline. The device answers every frame with the result of the 
+ * previous command, so each following sample costs a single 16-bit frame.
+ */
+void magneto_stream_start ( magneto_t *ctx, magneto_stream_t *stream, uint16_t address_command, 
+                            uint8_t vel_shift );
+
+/**
+ * @brief Stream read function.
+ *
+ * @param ctx                     Click object.
+ * @param stream                  Streaming reader object.
+ * 
+ * @return MAGNETO_FLAG_OK on a new sample, MAGNETO_FLAG_ERROR when the frame 
+ * failed the parity check or carried the error flag.
+ *
+ * @description This function clocks one frame and updates angle, unwrapped 
+ * position and filtered velocity. Call it at a fixed rate for a meaningful velocity.
+ * A frame with the error flag set also clears the flag on the device, which costs 
+ * two extra frames.
+ */
+uint8_t magneto_stream_read ( magneto_t *ctx, magneto_stream_t *stream );
+
+/**
+ * @brief Stream stop function.
+ *
+ * @param ctx                     Click object.
+ * @param stream                  Streaming reader object.
+ *
+ * @description This function restores the bus for the register access functions.
+ */
+void magneto_stream_stop ( magneto_t *ctx, magneto_stream_t *stream );
+
+/**
+ * @brief Integer angle function.
+ *
+ * @param raw_angle               14-bit angle.
+ * 
+ * @return Angle in hundredths of a degree, 0 to 35997.
+ */
+uint16_t magneto_angle_cdeg ( uint16_t raw_angle );
+
 #ifdef __cplusplus
 }
 #endif
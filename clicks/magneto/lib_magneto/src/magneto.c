@@ -46,6 +46,9 @@
 
 // ------------------------------------------------------------------ CONSTANTS
 
+// Parity of every nibble value, bit n is the parity of n.
+#define MAGNETO_NIBBLE_PARITY_LUT           0x6996
+
 
 // ------------------------------------------------------------------ VARIABLES
 
@@ -56,6 +59,10 @@ static uint8_t calc_parity ( magneto_t *ctx, uint16_t parity );
 
 static void dev_comm_delay ( void );
 
+static uint16_t stream_frame ( magneto_t *ctx, uint8_t *cmd );
+
+static void stream_clear_error ( magneto_t *ctx, magneto_stream_t *stream );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void magneto_cfg_setup ( magneto_cfg_t *cfg )
@@ -208,22 +215,136 @@ float magneto_get_angle ( magneto_t *ctx )
     return angle;
 }
 
+void magneto_stream_start ( magneto_t *ctx, magneto_stream_t *stream, uint16_t address_command, 
+                            uint8_t vel_shift )
+{
+    address_command &= MAGNETO_REG_ANGLE;
+    address_command |= MAGNETO_CMD_READ_COMMAND_BIT;
+    address_command |= ( calc_parity( ctx, address_command ) << MAGNETO_CMD_PARITY_VALUE );
+
+    stream->cmd[ 0 ] = ( uint8_t ) ( address_command >> 8 );
+    stream->cmd[ 1 ] = ( uint8_t ) ( address_command );
+    stream->primed = 0;
+    stream->vel_shift = vel_shift;
+    stream->angle = 0;
+    stream->position = 0;
+    stream->velocity = 0;
+    stream->errors = 0;
+
+    // A command with equal bytes, like the angle read, is left as the default write data.
+    spi_master_set_default_write_data( &ctx->spi, stream->cmd[ 0 ] );
+
+    // The answer to this frame belongs to whatever was sent before, drop it.
+    stream_frame( ctx, stream->cmd );
+}
+
+uint8_t magneto_stream_read ( magneto_t *ctx, magneto_stream_t *stream )
+{
+    uint16_t frame;
+    uint16_t angle;
+    int16_t delta;
+
+    frame = stream_frame( ctx, stream->cmd );
+    if ( calc_parity( ctx, frame ) )
+    {
+        stream->errors++;
+        return MAGNETO_FLAG_ERROR;
+    }
+    if ( frame & MAGNETO_STREAM_FRAME_ERROR )
+    {
+        // The flag sticks until the error register is read.
+        stream_clear_error( ctx, stream );
+        stream->errors++;
+        return MAGNETO_FLAG_ERROR;
+    }
+    angle = frame & MAGNETO_STREAM_DATA_MASK;
+
+    if ( !stream->primed )
+    {
+        stream->angle = angle;
+        stream->position = angle;
+        stream->primed = 1;
+        return MAGNETO_FLAG_OK;
+    }
+
+    // Shortest way around the circle, valid while the shaft turns less than half a turn per sample.
+    delta = ( int16_t ) ( angle - stream->angle );
+    if ( delta >= ( MAGNETO_STREAM_COUNTS / 2 ) )
+    {
+        delta -= MAGNETO_STREAM_COUNTS;
+    }
+    else if ( delta < -( MAGNETO_STREAM_COUNTS / 2 ) )
+    {
+        delta += MAGNETO_STREAM_COUNTS;
+    }
+    stream->angle = angle;
+    stream->position += delta;
+    stream->velocity += ( ( ( int32_t ) delta << MAGNETO_STREAM_VEL_FRAC_BITS ) - stream->velocity ) >> 
+                        stream->vel_shift;
+
+    return MAGNETO_FLAG_OK;
+}
+
+void magneto_stream_stop ( magneto_t *ctx, magneto_stream_t *stream )
+{
+    spi_master_set_default_write_data( &ctx->spi, MAGNETO_DUMMY );
+    stream->primed = 0;
+}
+
+uint16_t magneto_angle_cdeg ( uint16_t raw_angle )
+{
+    return ( uint16_t ) ( ( ( uint32_t ) ( raw_angle & MAGNETO_STREAM_DATA_MASK ) * 36000 ) >> 14 );
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static uint8_t calc_parity ( magneto_t *ctx, uint16_t parity )
 {
-	uint8_t cnt = 0;
-	uint8_t i;
-
-	for ( i = 0; i < 16; i++ )
-	{
-		if ( parity & 0x1 )
-		{
-			cnt++;
-		}
-		parity >>= 1;
-	}
-	return cnt & 0x1;
+    parity ^= parity >> 8;
+    parity ^= parity >> 4;
+    return ( MAGNETO_NIBBLE_PARITY_LUT >> ( parity & 0x0F ) ) & 0x1;
+}
+
+static uint16_t stream_frame ( magneto_t *ctx, uint8_t *cmd )
+{
+    uint8_t rx_buf[ 2 ];
+    uint16_t result;
+
+    // Full duplex frame, the command goes out as the read dummy bytes.
+    spi_master_select_device( ctx->chip_select );
+    if ( cmd[ 0 ] == cmd[ 1 ] )
+    {
+        spi_master_read( &ctx->spi, rx_buf, 2 );
+    }
+    else
+    {
+        spi_master_set_default_write_data( &ctx->spi, cmd[ 0 ] );
+        spi_master_read( &ctx->spi, &rx_buf[ 0 ], 1 );
+        spi_master_set_default_write_data( &ctx->spi, cmd[ 1 ] );
+        spi_master_read( &ctx->spi, &rx_buf[ 1 ], 1 );
+    }
+    spi_master_deselect_device( ctx->chip_select );
+
+    result = rx_buf[ 0 ];
+    result <<= 8;
+    result |= rx_buf[ 1 ];
+
+    return result;
+}
+
+static void stream_clear_error ( magneto_t *ctx, magneto_stream_t *stream )
+{
+    uint8_t clear_cmd[ 2 ];
+    uint16_t command = MAGNETO_REG_CLEAR_ERROR_FLAG | MAGNETO_CMD_READ_COMMAND_BIT;
+
+    command |= ( calc_parity( ctx, command ) << MAGNETO_CMD_PARITY_VALUE );
+    clear_cmd[ 0 ] = ( uint8_t ) ( command >> 8 );
+    clear_cmd[ 1 ] = ( uint8_t ) ( command );
+
+    // Queue the clear read, then clock its answer out with the stream command to re-prime.
+    stream_frame( ctx, clear_cmd );
+    spi_master_set_default_write_data( &ctx->spi, stream->cmd[ 0 ] );
+    stream_frame( ctx, stream->cmd );
 }
 
 static void dev_comm_delay ( void )
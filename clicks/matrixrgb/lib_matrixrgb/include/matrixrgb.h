@@ -116,6 +116,14 @@
 #define MATRIXRGB_PATTERN_4S_MAP_6MM              0x0F
 /** \} */
 
+/**
+ * \defgroup frame_buffer Frame Buffer 
+ * \{
+ */
+#define MATRIXRGB_MAX_WIDTH                       128
+#define MATRIXRGB_MAX_HEIGHT                      128
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -174,6 +182,11 @@ typedef struct
     uint16_t device_pattern_delay;
     pin_name_t chip_select;
 
+    // Frame buffer 
+
+    uint16_t *frame_buf;
+    uint8_t  dirty_rows[ MATRIXRGB_MAX_HEIGHT / 8 ];
+
 } matrixrgb_t;
 
 /**
@@ -317,6 +330,7 @@ void matrixrgb_set_brightness ( matrixrgb_t *ctx, uint8_t brightness );
  * 
  * @note 
  * Error may appear in case of wrong X or Y positions.
+ * An attached frame buffer is updated as well.
  */
 uint8_t matrixrgb_write_pixel ( matrixrgb_t *ctx, uint16_t x, uint16_t y, uint16_t color );
 
@@ -326,6 +340,8 @@ uint8_t matrixrgb_write_pixel ( matrixrgb_t *ctx, uint16_t x, uint16_t y, uint16
  * @param ctx           Click object.
  * @param color         color screen color
  *
+ * @description The frame is streamed in row bursts, paced by the RDY pin.
+ * An attached frame buffer is filled as well and left clean.
  */
 void matrixrgb_fill_screen ( matrixrgb_t *ctx, uint16_t color );
 
@@ -335,8 +351,11 @@ void matrixrgb_fill_screen ( matrixrgb_t *ctx, uint16_t color );
  * @param ctx                Click object.
  * @param device_img         Pointer to image array
  *
+ * @description The image is streamed in row bursts, paced by the RDY pin.
+ *
  * @note
  * Image must be in RGB565 format LSB first.
+ * An attached frame buffer receives a copy of the image and is left clean.
  */
 void matrixrgb_draw_image ( matrixrgb_t *ctx, const uint8_t *device_img );
 
@@ -362,13 +381,64 @@ void matrixrgb_set_font ( matrixrgb_t *ctx, matrixrgb_font_t *font_cfg );
  * @return 
  * 0 OK / 1 Error
  *
- * @description Writing starts at provided offset
+ * @description Writing starts at provided offset. With an attached frame buffer 
+ * the text is rendered into it and uploaded with a single flush.
  *
  * @note 
  * Error may appear in case of wrong X or Y positions.
  */
 uint8_t matrixrgb_write_text ( matrixrgb_t *ctx, char *text, uint16_t x, uint16_t y );
 
+/**
+ * @brief Attach Frame Buffer
+ *
+ * @param ctx           Click object.
+ * @param frame_buf     Frame buffer of ram_size RGB565 pixels, NULL to detach
+ *
+ * @description Drawing functions prefixed with fb and text writing render into 
+ * the frame buffer, changes reach the panel on #matrixrgb_fb_flush.
+ * 
+ * @note 
+ * Call after #matrixrgb_device_settings, the whole frame is marked dirty.
+ */
+void matrixrgb_fb_attach ( matrixrgb_t *ctx, uint16_t *frame_buf );
+
+/**
+ * @brief Frame Buffer Set Pixel
+ *
+ * @param ctx           Click object.
+ * @param x             horizontal position
+ * @param y             vertical position
+ * @param color         pixel color
+ *
+ * @return 
+ * 0 OK / 1 Error
+ * 
+ * @note 
+ * Error may appear in case of wrong X or Y positions or no attached frame buffer.
+ */
+uint8_t matrixrgb_fb_set_pixel ( matrixrgb_t *ctx, uint16_t x, uint16_t y, uint16_t color );
+
+/**
+ * @brief Frame Buffer Fill
+ *
+ * @param ctx           Click object.
+ * @param color         screen color
+ *
+ */
+void matrixrgb_fb_fill ( matrixrgb_t *ctx, uint16_t color );
+
+/**
+ * @brief Frame Buffer Flush
+ *
+ * @param ctx           Click object.
+ *
+ * @description Uploads the rows changed since the last flush. Few dirty rows are 
+ * written pixel by pixel, otherwise the whole frame is streamed in row bursts,
+ * whichever moves fewer bytes.
+ */
+void matrixrgb_fb_flush ( matrixrgb_t *ctx );
+
 
 #ifdef __cplusplus
 }
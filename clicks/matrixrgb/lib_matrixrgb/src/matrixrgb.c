@@ -27,6 +27,7 @@
  *
  */
 
+#include <string.h>
 #include "matrixrgb.h"
 
 // ------------------------------------------------------------- PRIVATE MACROS 
@@ -45,6 +46,10 @@
 
 static void send_command ( matrixrgb_t *ctx,  uint8_t cmd, uint8_t arg );
 static void write_char ( matrixrgb_t *ctx, uint16_t ch );
+static void plot_pixel ( matrixrgb_t *ctx, uint16_t x, uint16_t y, uint16_t color );
+static void load_pixel ( matrixrgb_t *ctx, uint16_t pos, uint16_t color );
+static void load_img_start ( matrixrgb_t *ctx );
+static void load_img_row ( matrixrgb_t *ctx, uint8_t *row_buf );
 static void wait_int_pin ( matrixrgb_t *ctx );
 static void pattern_delay ( uint16_t delay_us );
 
@@ -103,6 +108,9 @@ MATRIXRGB_RETVAL matrixrgb_init ( matrixrgb_t *ctx, matrixrgb_cfg_t *cfg )
 
     digital_in_init( &ctx->rdy, cfg->rdy );
 
+    ctx->frame_buf = NULL;
+    memset( ctx->dirty_rows, 0, sizeof( ctx->dirty_rows ) );
+
     return MATRIXRGB_OK;
 }
 
@@ -224,80 +232,72 @@ void matrixrgb_set_brightness ( matrixrgb_t *ctx, uint8_t brightness )
 
 uint8_t matrixrgb_write_pixel ( matrixrgb_t *ctx, uint16_t x, uint16_t y, uint16_t color )
 { 
-    uint8_t cmd;
-    uint16_t pos;
-    uint8_t tmp[ 4 ];
-
     if ( ( x >= ctx->device_pixel.pixel_width ) || ( y >= ctx->device_pixel.pixel_height ) )
     {
         return 1;
     }
 
-    cmd = MATRIXRGB_CMD_LOAD_PIX;
-    pos = ( ( y * ctx->device_pixel.pixel_width ) + x );
-    
-    tmp[0] = color;
-    tmp[1] = color >> 8;
-    tmp[2] = pos;
-    tmp[3] = pos >> 8;
-        
-    wait_int_pin( ctx );
-    
-    spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, &cmd, 1 );
-    spi_master_write( &ctx->spi, tmp, 4 );
-    spi_master_deselect_device( ctx->chip_select );
-    Delay_1ms();
+    // Keep the frame buffer in step so the next flush does not undo the write.
+    if ( ctx->frame_buf != NULL )
+    {
+        ctx->frame_buf[ ( y * ctx->device_pixel.pixel_width ) + x ] = color;
+    }
+
+    load_pixel( ctx, ( y * ctx->device_pixel.pixel_width ) + x, color );
 
     return 0;
 }
 
 void matrixrgb_fill_screen ( matrixrgb_t *ctx, uint16_t color )
 {
-    uint8_t cmd;
-    uint16_t pos;
-    uint8_t tmp[ 2 ];
+    uint8_t row_buf[ MATRIXRGB_MAX_WIDTH * 2 ];
+    uint16_t cnt;
     
-    cmd = MATRIXRGB_CMD_LOAD_IMG;
-    tmp[ 0 ] = color;
-    tmp[ 1 ] = color >> 8;
+    for ( cnt = 0; cnt < ctx->device_pixel.pixel_width; cnt++ )
+    {
+        row_buf[ cnt * 2 ] = color;
+        row_buf[ cnt * 2 + 1 ] = color >> 8;
+    }
 
-    wait_int_pin( ctx );
-    
-    spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, &cmd, 1 );
-    
-    for ( pos = 0; pos < ctx->device_pixel.ram_size; pos++ )
+    if ( ctx->frame_buf != NULL )
     {
-        spi_master_write( &ctx->spi, tmp, 2 );
-        Delay_1ms();
+        for ( cnt = 0; cnt < ctx->device_pixel.ram_size; cnt++ )
+        {
+            ctx->frame_buf[ cnt ] = color;
+        }
+        memset( ctx->dirty_rows, 0, sizeof( ctx->dirty_rows ) );
     }
 
+    load_img_start( ctx );
+    for ( cnt = 0; cnt < ctx->device_pixel.pixel_height; cnt++ )
+    {
+        load_img_row( ctx, row_buf );
+    }
     spi_master_deselect_device( ctx->chip_select );  
-    Delay_1ms();
 }
 
 void matrixrgb_draw_image ( matrixrgb_t *ctx, const 
 uint8_t *device_img )
 {
-    uint16_t pos;
-    uint8_t tmp_buf[ 2 ];
-    uint8_t tmp;
+    uint16_t row_size = ctx->device_pixel.pixel_width * 2;
+    uint16_t cnt;
 
-    wait_int_pin( ctx );
-    spi_master_select_device( ctx->chip_select );
-    tmp = MATRIXRGB_CMD_LOAD_IMG;
-    spi_master_write( &ctx->spi, &tmp, 1 );
+    if ( ctx->frame_buf != NULL )
+    {
+        for ( cnt = 0; cnt < ctx->device_pixel.ram_size; cnt++ )
+        {
+            ctx->frame_buf[ cnt ] = device_img[ cnt * 2 ] | ( ( uint16_t ) device_img[ cnt * 2 + 1 ] << 8 );
+        }
+        memset( ctx->dirty_rows, 0, sizeof( ctx->dirty_rows ) );
+    }
 
-    for ( pos = 0; pos < ctx->device_pixel.ram_size; pos++ )
+    // Rows go out straight from the image, RGB565 LSB first is the panel format.
+    load_img_start( ctx );
+    for ( cnt = 0; cnt < ctx->device_pixel.pixel_height; cnt++ )
     {
-        tmp_buf[0] = device_img[ pos * 2 ];
-        tmp_buf[1] = device_img[ pos * 2 + 1 ];
-        spi_master_write( &ctx->spi, tmp_buf, 2 );
-        Delay_1ms();
+        load_img_row( ctx, ( uint8_t * ) &device_img[ cnt * row_size ] );
     }
     spi_master_deselect_device( ctx->chip_select );  
-    Delay_1ms();
 }
 
 void matrixrgb_set_font ( matrixrgb_t *ctx, matrixrgb_font_t *font_cfg )
@@ -330,8 +330,115 @@ uint8_t matrixrgb_write_text ( matrixrgb_t *ctx, char *text, uint16_t x, uint16_
         i++;
     }
 
+    if ( ctx->frame_buf != NULL )
+    {
+        matrixrgb_fb_flush( ctx );
+    }
+
+    return 0;
+}
+
+void matrixrgb_fb_attach ( matrixrgb_t *ctx, uint16_t *frame_buf )
+{
+    ctx->frame_buf = frame_buf;
+    memset( ctx->dirty_rows, 0xFF, sizeof( ctx->dirty_rows ) );
+}
+
+uint8_t matrixrgb_fb_set_pixel ( matrixrgb_t *ctx, uint16_t x, uint16_t y, uint16_t color )
+{
+    uint16_t pos;
+
+    if ( ( ctx->frame_buf == NULL ) || 
+         ( x >= ctx->device_pixel.pixel_width ) || ( y >= ctx->device_pixel.pixel_height ) )
+    {
+        return 1;
+    }
+
+    pos = ( y * ctx->device_pixel.pixel_width ) + x;
+    if ( ctx->frame_buf[ pos ] != color )
+    {
+        ctx->frame_buf[ pos ] = color;
+        ctx->dirty_rows[ y >> 3 ] |= 1 << ( y & 7 );
+    }
+
     return 0;
 }
+
+void matrixrgb_fb_fill ( matrixrgb_t *ctx, uint16_t color )
+{
+    uint16_t pos;
+
+    if ( ctx->frame_buf == NULL )
+    {
+        return;
+    }
+
+    for ( pos = 0; pos < ctx->device_pixel.ram_size; pos++ )
+    {
+        ctx->frame_buf[ pos ] = color;
+    }
+    memset( ctx->dirty_rows, 0xFF, sizeof( ctx->dirty_rows ) );
+}
+
+void matrixrgb_fb_flush ( matrixrgb_t *ctx )
+{
+    uint8_t row_buf[ MATRIXRGB_MAX_WIDTH * 2 ];
+    uint16_t width = ctx->device_pixel.pixel_width;
+    uint16_t *row;
+    uint16_t n_dirty = 0;
+    uint16_t x;
+    uint16_t y;
+
+    if ( ctx->frame_buf == NULL )
+    {
+        return;
+    }
+
+    for ( y = 0; y < ctx->device_pixel.pixel_height; y++ )
+    {
+        if ( ctx->dirty_rows[ y >> 3 ] & ( 1 << ( y & 7 ) ) )
+        {
+            n_dirty++;
+        }
+    }
+    if ( n_dirty == 0 )
+    {
+        return;
+    }
+
+    // A pixel write moves 5 bytes, a frame upload 2 bytes per pixel of the whole panel.
+    if ( ( uint32_t ) n_dirty * width * 5 < ( uint32_t ) ctx->device_pixel.ram_size * 2 )
+    {
+        for ( y = 0; y < ctx->device_pixel.pixel_height; y++ )
+        {
+            if ( ctx->dirty_rows[ y >> 3 ] & ( 1 << ( y & 7 ) ) )
+            {
+                row = &ctx->frame_buf[ y * width ];
+                for ( x = 0; x < width; x++ )
+                {
+                    load_pixel( ctx, ( y * width ) + x, row[ x ] );
+                }
+            }
+        }
+    }
+    else
+    {
+        load_img_start( ctx );
+        for ( y = 0; y < ctx->device_pixel.pixel_height; y++ )
+        {
+            row = &ctx->frame_buf[ y * width ];
+            for ( x = 0; x < width; x++ )
+            {
+                row_buf[ x * 2 ] = row[ x ];
+                row_buf[ x * 2 + 1 ] = row[ x ] >> 8;
+            }
+            load_img_row( ctx, row_buf );
+        }
+        spi_master_deselect_device( ctx->chip_select );  
+    }
+
+    memset( ctx->dirty_rows, 0, sizeof( ctx->dirty_rows ) );
+}
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static void send_command ( matrixrgb_t *ctx, uint8_t cmd, uint8_t arg )
@@ -399,8 +506,7 @@ static void write_char ( matrixrgb_t *ctx, uint16_t ch )
                 
                 if ( temp & mask )
                 {
-                    matrixrgb_write_pixel( ctx, x, y, ctx->device_font.color );
-                    Delay_80us();
+                    plot_pixel( ctx, x, y, ctx->device_font.color );
                 }
 
                 x++;
@@ -437,7 +543,7 @@ static void write_char ( matrixrgb_t *ctx, uint16_t ch )
 
                 if ( temp & mask )
                 {
-                    matrixrgb_write_pixel( ctx, x, y, ctx->device_font.color );
+                    plot_pixel( ctx, x, y, ctx->device_font.color );
                 }
 
                 x--;
@@ -449,6 +555,51 @@ static void write_char ( matrixrgb_t *ctx, uint16_t ch )
     }
 }
 
+static void plot_pixel ( matrixrgb_t *ctx, uint16_t x, uint16_t y, uint16_t color )
+{
+    if ( ctx->frame_buf != NULL )
+    {
+        matrixrgb_fb_set_pixel( ctx, x, y, color );
+    }
+    else
+    {
+        matrixrgb_write_pixel( ctx, x, y, color );
+    }
+}
+
+static void load_pixel ( matrixrgb_t *ctx, uint16_t pos, uint16_t color )
+{
+    uint8_t tx_buf[ 5 ];
+
+    tx_buf[ 0 ] = MATRIXRGB_CMD_LOAD_PIX;
+    tx_buf[ 1 ] = color;
+    tx_buf[ 2 ] = color >> 8;
+    tx_buf[ 3 ] = pos;
+    tx_buf[ 4 ] = pos >> 8;
+
+    // RDY paces the transfers, the panel drops it while it is busy.
+    wait_int_pin( ctx );
+    
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write( &ctx->spi, tx_buf, 5 );
+    spi_master_deselect_device( ctx->chip_select );
+}
+
+static void load_img_start ( matrixrgb_t *ctx )
+{
+    uint8_t cmd = MATRIXRGB_CMD_LOAD_IMG;
+
+    wait_int_pin( ctx );
+    spi_master_select_device( ctx->chip_select );
+    spi_master_write( &ctx->spi, &cmd, 1 );
+}
+
+static void load_img_row ( matrixrgb_t *ctx, uint8_t *row_buf )
+{
+    wait_int_pin( ctx );
+    spi_master_write( &ctx->spi, row_buf, ctx->device_pixel.pixel_width * 2 );
+}
+
 static void wait_int_pin ( matrixrgb_t *ctx )
 {
     uint8_t temp;
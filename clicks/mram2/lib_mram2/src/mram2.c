@@ -163,8 +163,6 @@ void mram2_wrsr ( mram2_t *ctx, uint8_t stat_reg )
 void mram2_read ( mram2_t *ctx, uint32_t mem_adr, uint8_t *rd_data, uint8_t n_bytes )
 {
     uint8_t tx_buf[ 4 ];
-    uint8_t rx_buf[ 256 ];
-    uint32_t cnt;
 
     tx_buf[ 0 ] = MRAM2_CMD_READ;
     tx_buf[ 1 ] = (uint8_t)( ( mem_adr >> 16 ) & 0x000000FF );
@@ -173,21 +171,14 @@ void mram2_read ( mram2_t *ctx, uint32_t mem_adr, uint8_t *rd_data, uint8_t n_by
 
     spi_master_select_device( ctx->chip_select );
     spi_master_write( &ctx->spi, tx_buf, 4 );
-    spi_master_read( &ctx->spi, rx_buf, n_bytes );
+    spi_master_read( &ctx->spi, rd_data, n_bytes );
     spi_master_deselect_device( ctx->chip_select ); 
-
-    for ( cnt = 0; cnt < n_bytes; cnt++ )
-    {
-        rd_data[ cnt ] = rx_buf [ cnt ];
-    }
 }
 
 // Fast Read Data Bytes (FREAD)
 void mram2_fread ( mram2_t *ctx, uint32_t mem_adr, uint8_t mode, uint8_t *rd_data, uint8_t n_bytes )
 {
     uint8_t tx_buf[ 5 ];
-    uint8_t rx_buf[ 256 ];
-    uint32_t cnt;
 
     tx_buf[ 0 ] = MRAM2_CMD_FREAD;
     tx_buf[ 1 ] = (uint8_t)( ( mem_adr >> 16 ) & 0x000000FF );
@@ -197,33 +188,23 @@ void mram2_fread ( mram2_t *ctx, uint32_t mem_adr, uint8_t mode, uint8_t *rd_dat
 
     spi_master_select_device( ctx->chip_select );
     spi_master_write( &ctx->spi, tx_buf, 5 );
-    spi_master_read( &ctx->spi, rx_buf, n_bytes );
+    spi_master_read( &ctx->spi, rd_data, n_bytes );
     spi_master_deselect_device( ctx->chip_select ); 
-
-    for ( cnt = 0; cnt < n_bytes; cnt++ )
-    {
-        rd_data[ cnt ] = rx_buf [ cnt ];
-    }
 }
 
 // Write Data Bytes (WRITE)
 void mram2_write ( mram2_t *ctx, uint32_t mem_adr, uint8_t *wr_data, uint8_t n_bytes )
 {
-    uint8_t tx_buf[ 256 ];
-    uint32_t cnt;
+    uint8_t tx_buf[ 4 ];
 
     tx_buf[ 0 ] = MRAM2_CMD_WRITE;
     tx_buf[ 1 ] = (uint8_t)( ( mem_adr >> 16 ) & 0x000000FF );
     tx_buf[ 2 ] = (uint8_t)( ( mem_adr >> 8 ) & 0x000000FF );
     tx_buf[ 3 ] = (uint8_t)( mem_adr & 0x000000FF );
 
-    for ( cnt = 0; cnt < n_bytes; cnt++ )
-    {
-        tx_buf[ cnt + 4 ] = wr_data[ cnt ];
-    }
-
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, n_bytes + 4 );
+    spi_master_write( &ctx->spi, tx_buf, 4 );
+    spi_master_write( &ctx->spi, wr_data, n_bytes );
     spi_master_deselect_device( ctx->chip_select ); 
 }
 
@@ -95,17 +95,14 @@ err_t nfc3_init ( nfc3_t *ctx, nfc3_cfg_t *cfg )
 
 err_t nfc3_generic_write ( nfc3_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
-    uint8_t tx_buf[ 257 ];
+    uint8_t tx_buf[ 1 ];
     uint16_t cnt;
     uint16_t timeout = 5000;
     tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ ) 
-    {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
     cnt = 0;
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     while ( !nfc3_get_bsy( ctx ) )
     {
         Delay_10us( );
@@ -190,9 +187,9 @@ err_t nfc3_write_eeprom ( nfc3_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t le
         return error_flag;
     }
     tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ ) 
+    for ( cnt = 0; cnt < len; cnt++ ) 
     {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
+        tx_buf[ cnt + 1 ] = data_in[ cnt ];
     }
     error_flag = nfc3_generic_write( ctx, NFC3_CMD_WRITE_EEPROM, tx_buf, len );
     return error_flag;
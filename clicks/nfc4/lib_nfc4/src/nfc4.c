@@ -3132,7 +3132,7 @@ static err_t nfc4_i2c_read ( nfc4_t *ctx, uint8_t reg, uint8_t *data_out, uint16
 
 static err_t nfc4_spi_write ( nfc4_t *ctx, uint8_t reg, uint8_t *data_in, uint16_t len ) 
 {
-    uint8_t tx_buf[ NFC4_FIFO_DEPTH + 1 ] = { 0 };
+    uint8_t tx_buf[ 2 ] = { 0 };
     err_t error_flag = NFC4_ERROR;
 
     spi_master_select_device( ctx->chip_select );
@@ -3141,11 +3141,8 @@ static err_t nfc4_spi_write ( nfc4_t *ctx, uint8_t reg, uint8_t *data_in, uint16
     {
         tx_buf[ 0 ] = reg;
         
-        for ( uint16_t cnt = 0; cnt < len; cnt++ ) 
-        {
-            tx_buf[ cnt + 1 ] = data_in[ cnt ];
-        }
-        error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+        error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+        error_flag |= spi_master_write( &ctx->spi, data_in, len );
     }
     else if ( NFC4_MODE_DIRECT_COMMAND == ( reg & NFC4_MODE_DIRECT_COMMAND ) )
     {
@@ -3158,21 +3155,15 @@ static err_t nfc4_spi_write ( nfc4_t *ctx, uint8_t reg, uint8_t *data_in, uint16
         tx_buf[ 0 ] = NFC4_CMD_SPACE_B_ACCESS;
         tx_buf[ 1 ] = reg & ~NFC4_REG_SPACE_B_MASK;
         
-        for ( uint16_t cnt = 0; cnt < len; cnt++ ) 
-        {
-            tx_buf[ cnt + 2 ] = data_in[ cnt ];
-        }
-        error_flag = spi_master_write( &ctx->spi, tx_buf, len + 2 );
+        error_flag = spi_master_write( &ctx->spi, tx_buf, 2 );
+        error_flag |= spi_master_write( &ctx->spi, data_in, len );
     }
     else
     {
         tx_buf[ 0 ] = reg;
         
-        for ( uint16_t cnt = 0; cnt < len; cnt++ ) 
-        {
-            tx_buf[ cnt + 1 ] = data_in[ cnt ];
-        }
-        error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+        error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+        error_flag |= spi_master_write( &ctx->spi, data_in, len );
     }
     spi_master_deselect_device( ctx->chip_select );
 
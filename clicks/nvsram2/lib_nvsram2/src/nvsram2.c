@@ -95,16 +95,13 @@ err_t nvsram2_default_cfg ( nvsram2_t *ctx ) {
 }
 
 err_t nvsram2_generic_write ( nvsram2_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) {    
-    uint8_t tx_buf[ 257 ] = { 0 };
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ] = { 0 };
 
     tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
     return error_flag;
 }
@@ -191,11 +188,7 @@ void nvsram2_burst_read ( nvsram2_t *ctx, uint32_t mem_addr, uint8_t *p_rx_data,
 }
 
 void nvsram2_burst_write ( nvsram2_t *ctx, uint32_t mem_addr, uint8_t *p_tx_data, uint8_t n_bytes ) {    
-    uint8_t tx_buf[ 260 ];
-    uint16_t cnt;
-    uint16_t len;
-    
-    len = n_bytes + 4;
+    uint8_t tx_buf[ 4 ];
 
     if ( n_bytes != 0 ) {        
         tx_buf[ 0 ] = NVSRAM2_SRAM_WRITE;
@@ -203,12 +196,9 @@ void nvsram2_burst_write ( nvsram2_t *ctx, uint32_t mem_addr, uint8_t *p_tx_data
         tx_buf[ 2 ] = ( uint8_t )( mem_addr >> 8 );
         tx_buf[ 3 ] = ( uint8_t ) mem_addr;
 
-        for ( cnt = 0; cnt < n_bytes; cnt++ ) {
-            tx_buf[ cnt + 4 ] = p_tx_data[ cnt ];
-        }
-
         spi_master_select_device( ctx->chip_select );
-        spi_master_write( &ctx->spi, &tx_buf, len );
+        spi_master_write( &ctx->spi, tx_buf, 4 );
+        spi_master_write( &ctx->spi, p_tx_data, n_bytes );
         spi_master_deselect_device( ctx->chip_select );
     }
 }
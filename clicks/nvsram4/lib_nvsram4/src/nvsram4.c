@@ -177,16 +177,13 @@ void nvsram4_default_cfg ( nvsram4_t *ctx ) {
 }
 
 err_t nvsram4_generic_write ( nvsram4_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) {
-    uint8_t tx_buf[ 257 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
@@ -255,14 +252,10 @@ err_t nvsram4_burst_read_memory ( nvsram4_t *ctx, uint32_t mem_addr, uint8_t *da
 }
 
 err_t nvsram4_burst_write_memory ( nvsram4_t *ctx, uint32_t mem_addr, uint8_t *data_in, uint8_t n_bytes ) {
-    uint8_t tx_buf[ 260 ];
-    uint16_t cnt;
-    uint16_t len;
+    uint8_t tx_buf[ 4 ];
     err_t status;
     
     status = NVSRAM4_SUCCESS;
-    
-    len = n_bytes + 4;
 
     if ( n_bytes != 0 ) {
         tx_buf[ 0 ] = NVSRAM4_SRAM_WRITE;
@@ -270,13 +263,9 @@ err_t nvsram4_burst_write_memory ( nvsram4_t *ctx, uint32_t mem_addr, uint8_t *d
         tx_buf[ 2 ] = ( uint8_t )( mem_addr >> 8 );
         tx_buf[ 3 ] = ( uint8_t ) mem_addr;
 
-        for ( cnt = 0; cnt < n_bytes; cnt++ )
-        {
-            tx_buf[ cnt + 4 ] = data_in[ cnt ];
-        }
-
         spi_master_select_device( ctx->chip_select );
-        spi_master_write( &ctx->spi, tx_buf, len );
+        spi_master_write( &ctx->spi, tx_buf, 4 );
+        spi_master_write( &ctx->spi, data_in, n_bytes );
         spi_master_deselect_device( ctx->chip_select );
     } else {
         status = NVSRAM4_ERROR;    
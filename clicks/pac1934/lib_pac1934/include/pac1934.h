@@ -180,6 +180,15 @@
  */
 #define PAC1934_CHANNEL_DIS                                   0x1C
 #define PAC1934_CHANNEL_DIS_ALL_CHA                      0xF0
+#define PAC1934_CHANNEL_DIS_NO_SKIP                      0x02
+/** \} */
+
+/**
+ * \defgroup snapshot   Snapshot Settings
+ * \{
+ */
+#define PAC1934_CH_NUM                                        4
+#define PAC1934_SNAPSHOT_BLOCK_SIZE                           75
 /** \} */
 
 /**
@@ -328,6 +337,41 @@ typedef struct
 
 } pac1934_cfg_t;
 
+/**
+ * @brief Snapshot monitor structure definition.
+ *
+ * Software energy integrator state used by the snapshot read.
+ */
+typedef struct
+{
+    uint16_t samp_rate;
+
+    uint8_t  acc_valid;
+    uint32_t acc_count;
+    uint32_t acc_raw_hi[ PAC1934_CH_NUM ];
+    uint32_t acc_raw_lo[ PAC1934_CH_NUM ];
+    uint32_t energy_hi[ PAC1934_CH_NUM ];
+    uint32_t energy_lo[ PAC1934_CH_NUM ];
+
+} pac1934_monitor_t;
+
+/**
+ * @brief Snapshot data structure definition.
+ *
+ * Scaled results of all channels, in the same units as the single value functions.
+ */
+typedef struct
+{
+    float voltage[ PAC1934_CH_NUM ];
+    float current[ PAC1934_CH_NUM ];
+    float voltage_avg[ PAC1934_CH_NUM ];
+    float current_avg[ PAC1934_CH_NUM ];
+    float power[ PAC1934_CH_NUM ];
+    float energy[ PAC1934_CH_NUM ];
+    uint32_t acc_count;
+
+} pac1934_snapshot_t;
+
 /** \} */ // End types group
 
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
@@ -537,6 +581,47 @@ float pac1934_calc_power ( pac1934_t *ctx, float voltage, float amperage );
  */
 float pac1934_measure_energy ( pac1934_t *ctx, uint8_t chann, uint16_t samp_rate );
 
+/**
+ * @brief Snapshot monitor initialization function.
+ *
+ * @param ctx          Click object.
+ * @param monitor      Snapshot monitor object.
+ * @param samp_rate    16-bit data representing sample rate.
+ *
+ * @description This function clears the software energy integrator and disables
+ * skipping of inactive channels in auto-incrementing reads, so the snapshot block
+ * always has the same layout.
+ */
+void pac1934_monitor_init ( pac1934_t *ctx, pac1934_monitor_t *monitor, uint16_t samp_rate );
+
+/**
+ * @brief Get snapshot function.
+ *
+ * @param ctx          Click object.
+ * @param monitor      Snapshot monitor object.
+ * @param snapshot     Scaled results of all channels.
+ *
+ * @description This function issues a single REFRESH_V command and reads the
+ * accumulator count, all power accumulators and all channel results in one
+ * auto-incrementing block read. The accumulator difference since the previous
+ * snapshot is added to the 64-bit software energy integrator.
+ *
+ * @note Accumulator rollover is handled modulo 2^48. A decrease of the accumulator
+ * count is treated as an accumulator reset ( REFRESH or POR ), so the new
+ * accumulator value is integrated from zero.
+ */
+void pac1934_get_snapshot ( pac1934_t *ctx, pac1934_monitor_t *monitor, pac1934_snapshot_t *snapshot );
+
+/**
+ * @brief Reset energy function.
+ *
+ * @param monitor      Snapshot monitor object.
+ *
+ * @description This function clears the software energy integrator of all channels.
+ * The next snapshot only takes the accumulator baseline and adds no energy.
+ */
+void pac1934_monitor_reset_energy ( pac1934_monitor_t *monitor );
+
 /**
  * @brief Enable device function.
  * 
@@ -29,6 +29,28 @@
 
 #include "pac1934.h"
 
+// ------------------------------------------------------------- PRIVATE MACROS 
+
+#define PAC1934_SNAP_VACC_OFFSET          3
+#define PAC1934_SNAP_VACC_SIZE            6
+#define PAC1934_SNAP_VBUS_OFFSET          27
+#define PAC1934_SNAP_VSENSE_OFFSET        35
+#define PAC1934_SNAP_VBUS_AVG_OFFSET      43
+#define PAC1934_SNAP_VSENSE_AVG_OFFSET    51
+#define PAC1934_SNAP_VPOWER_OFFSET        59
+
+#define PAC1934_VOLTAGE_LSB               ( 32.0 / 0xFFFF )
+#define PAC1934_CURRENT_LSB               ( 25000.0 / 0xFFFF )
+#define PAC1934_POWER_LSB                 0.0000029802
+#define PAC1934_ACC_HI_MASK               0x0000FFFFul
+#define PAC1934_TWO_POW_32                4294967296.0
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static uint16_t dev_get_u16 ( uint8_t *data_buf );
+
+static void dev_integrate_acc ( pac1934_monitor_t *monitor, uint8_t ch, uint8_t *acc_buf, uint8_t acc_reset );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void pac1934_cfg_setup ( pac1934_cfg_t *cfg )
@@ -85,9 +107,9 @@ void pac1934_generic_write ( pac1934_t *ctx, uint8_t reg, uint8_t *data_buf, uin
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );   
@@ -296,5 +318,153 @@ uint8_t pac1934_check_interrupt ( pac1934_t *ctx )
     return digital_in_read( &ctx->ale );
 }
 
+void pac1934_monitor_init ( pac1934_t *ctx, pac1934_monitor_t *monitor, uint16_t samp_rate )
+{
+    uint8_t ch_dis;
+
+    monitor->samp_rate = samp_rate;
+    pac1934_monitor_reset_energy( monitor );
+
+    ch_dis = pac1934_read_byte( ctx, PAC1934_CHANNEL_DIS );
+    pac1934_write_byte( ctx, PAC1934_CHANNEL_DIS, ch_dis | PAC1934_CHANNEL_DIS_NO_SKIP );
+}
+
+void pac1934_get_snapshot ( pac1934_t *ctx, pac1934_monitor_t *monitor, pac1934_snapshot_t *snapshot )
+{
+    uint8_t r_buffer[ PAC1934_SNAPSHOT_BLOCK_SIZE ];
+    uint8_t *ptr;
+    uint32_t acc_count;
+    uint32_t pwr_raw;
+    uint8_t acc_reset;
+    uint8_t ch;
+    float energy;
+
+    pac1934_send_command( ctx, PAC1934_REFRESH_V_CMD );
+    Delay_1ms( );
+
+    pac1934_generic_read( ctx, PAC1934_ACC_COUNT, r_buffer, PAC1934_SNAPSHOT_BLOCK_SIZE );
+
+    acc_count = r_buffer[ 0 ];
+    acc_count <<= 8;
+    acc_count |= r_buffer[ 1 ];
+    acc_count <<= 8;
+    acc_count |= r_buffer[ 2 ];
+
+    acc_reset = monitor->acc_valid && ( acc_count < monitor->acc_count );
+    monitor->acc_count = acc_count;
+    snapshot->acc_count = acc_count;
+
+    for ( ch = 0; ch < PAC1934_CH_NUM; ch++ )
+    {
+        snapshot->voltage[ ch ] = dev_get_u16( &r_buffer[ PAC1934_SNAP_VBUS_OFFSET + 2 * ch ] ) * PAC1934_VOLTAGE_LSB;
+        snapshot->current[ ch ] = dev_get_u16( &r_buffer[ PAC1934_SNAP_VSENSE_OFFSET + 2 * ch ] ) * PAC1934_CURRENT_LSB;
+        snapshot->voltage_avg[ ch ] = dev_get_u16( &r_buffer[ PAC1934_SNAP_VBUS_AVG_OFFSET + 2 * ch ] ) * PAC1934_VOLTAGE_LSB;
+        snapshot->current_avg[ ch ] = dev_get_u16( &r_buffer[ PAC1934_SNAP_VSENSE_AVG_OFFSET + 2 * ch ] ) * PAC1934_CURRENT_LSB;
+
+        ptr = &r_buffer[ PAC1934_SNAP_VPOWER_OFFSET + 4 * ch ];
+        pwr_raw = ptr[ 0 ];
+        pwr_raw <<= 8;
+        pwr_raw |= ptr[ 1 ];
+        pwr_raw <<= 8;
+        pwr_raw |= ptr[ 2 ];
+        pwr_raw <<= 4;
+        pwr_raw |= ptr[ 3 ] >> 4;
+        snapshot->power[ ch ] = pwr_raw * PAC1934_POWER_LSB;
+
+        dev_integrate_acc( monitor, ch, &r_buffer[ PAC1934_SNAP_VACC_OFFSET + PAC1934_SNAP_VACC_SIZE * ch ], acc_reset );
+
+        energy = ( float ) monitor->energy_hi[ ch ] * PAC1934_TWO_POW_32 + ( float ) monitor->energy_lo[ ch ];
+        energy *= PAC1934_POWER_LSB;
+        energy /= monitor->samp_rate;
+        snapshot->energy[ ch ] = energy;
+    }
+
+    monitor->acc_valid = 1;
+}
+
+void pac1934_monitor_reset_energy ( pac1934_monitor_t *monitor )
+{
+    uint8_t ch;
+
+    monitor->acc_valid = 0;
+    monitor->acc_count = 0;
+
+    for ( ch = 0; ch < PAC1934_CH_NUM; ch++ )
+    {
+        monitor->acc_raw_hi[ ch ] = 0;
+        monitor->acc_raw_lo[ ch ] = 0;
+        monitor->energy_hi[ ch ] = 0;
+        monitor->energy_lo[ ch ] = 0;
+    }
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint16_t dev_get_u16 ( uint8_t *data_buf )
+{
+    uint16_t result;
+
+    result = data_buf[ 0 ];
+    result <<= 8;
+    result |= data_buf[ 1 ];
+
+    return result;
+}
+
+static void dev_integrate_acc ( pac1934_monitor_t *monitor, uint8_t ch, uint8_t *acc_buf, uint8_t acc_reset )
+{
+    uint32_t acc_hi;
+    uint32_t acc_lo;
+    uint32_t delta_hi;
+    uint32_t delta_lo;
+    uint32_t sum_lo;
+
+    acc_hi = acc_buf[ 0 ];
+    acc_hi <<= 8;
+    acc_hi |= acc_buf[ 1 ];
+    acc_lo = acc_buf[ 2 ];
+    acc_lo <<= 8;
+    acc_lo |= acc_buf[ 3 ];
+    acc_lo <<= 8;
+    acc_lo |= acc_buf[ 4 ];
+    acc_lo <<= 8;
+    acc_lo |= acc_buf[ 5 ];
+
+    if ( !monitor->acc_valid )
+    {
+        // First readout after init or reset only sets the baseline, earlier energy is not ours.
+        monitor->acc_raw_hi[ ch ] = acc_hi;
+        monitor->acc_raw_lo[ ch ] = acc_lo;
+        return;
+    }
+
+    if ( acc_reset )
+    {
+        // The accumulator restarted from zero, so its whole content is new energy.
+        monitor->acc_raw_hi[ ch ] = 0;
+        monitor->acc_raw_lo[ ch ] = 0;
+    }
+
+    // Difference modulo 2^48 covers accumulator rollover.
+    delta_lo = acc_lo - monitor->acc_raw_lo[ ch ];
+    delta_hi = acc_hi - monitor->acc_raw_hi[ ch ];
+    if ( acc_lo < monitor->acc_raw_lo[ ch ] )
+    {
+        delta_hi--;
+    }
+    delta_hi &= PAC1934_ACC_HI_MASK;
+
+    sum_lo = monitor->energy_lo[ ch ] + delta_lo;
+    monitor->energy_hi[ ch ] += delta_hi;
+    if ( sum_lo < delta_lo )
+    {
+        monitor->energy_hi[ ch ]++;
+    }
+    monitor->energy_lo[ ch ] = sum_lo;
+
+    monitor->acc_raw_hi[ ch ] = acc_hi;
+    monitor->acc_raw_lo[ ch ] = acc_lo;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -289,6 +289,16 @@ extern "C"{
 #define PAC1944_SMBUS_AUTO_INC_SKIP_OFF               0x02
 #define PAC1944_SMBUS_I2C_HIGH_SPEED                  0x01
 
+/**
+ * @brief PAC1944 snapshot setting.
+ * @details Specified setting for whole-device snapshot reads of
+ * PAC1944 Click driver.
+ */
+
+#define PAC1944_CH_NUM                                4
+#define PAC1944_SNAPSHOT_BLOCK_SIZE                   80
+#define PAC1944_ACC_SAMPLE_RATE_DEFAULT               1024
+
 /**
  * @brief PAC1944 device address setting.
  * @details Specified setting for device slave address selection of
@@ -402,6 +412,46 @@ typedef struct
     
 } pac1944_setup_t;
 
+/**
+ * @brief PAC1944 Snapshot monitor object.
+ * @details Precomputed conversion factors and software energy integrator state
+ * of PAC1944 Click driver, used by #pac1944_get_snapshot.
+ */
+typedef struct
+{
+    uint8_t  pwr_mode[ PAC1944_CH_NUM ];             /**< Derived power measure mode per channel. */
+    uint8_t  vbus_mode[ PAC1944_CH_NUM ];            /**< Vbus measure mode per channel. */
+    uint8_t  vsense_mode[ PAC1944_CH_NUM ];          /**< Vsense measure mode per channel. */
+    float    vbus_lsb[ PAC1944_CH_NUM ];             /**< Volts per Vbus count. */
+    float    isense_lsb[ PAC1944_CH_NUM ];           /**< Amperes per Vsense count. */
+    float    power_lsb[ PAC1944_CH_NUM ];            /**< Watts per Vpower count. */
+    uint16_t acc_sample_rate;                        /**< Accumulator sample rate in SPS. */
+
+    uint8_t  acc_valid;                              /**< Previous accumulator readout is valid. */
+    uint32_t acc_count;                              /**< Previous accumulator count. */
+    uint32_t acc_raw_hi[ PAC1944_CH_NUM ];           /**< Previous accumulator value [55:32]. */
+    uint32_t acc_raw_lo[ PAC1944_CH_NUM ];           /**< Previous accumulator value [31:0]. */
+    int32_t  energy_hi[ PAC1944_CH_NUM ];            /**< Integrated accumulator [63:32]. */
+    uint32_t energy_lo[ PAC1944_CH_NUM ];            /**< Integrated accumulator [31:0]. */
+
+} pac1944_monitor_t;
+
+/**
+ * @brief PAC1944 Snapshot data object.
+ * @details Scaled results of all channels of PAC1944 Click driver.
+ */
+typedef struct
+{
+    float    vbus[ PAC1944_CH_NUM ];                 /**< Bus voltage [V]. */
+    float    isense[ PAC1944_CH_NUM ];               /**< Sense current [A]. */
+    float    vbus_avg[ PAC1944_CH_NUM ];             /**< Averaged bus voltage [V]. */
+    float    isense_avg[ PAC1944_CH_NUM ];           /**< Averaged sense current [A]. */
+    float    power[ PAC1944_CH_NUM ];                /**< Power [W]. */
+    float    energy[ PAC1944_CH_NUM ];               /**< Integrated energy [J]. */
+    uint32_t acc_count;                              /**< Accumulator count. */
+
+} pac1944_snapshot_t;
+
 /*!
  * @addtogroup pac1944 PAC1944 Click Driver
  * @brief API for configuring and manipulating PAC1944 Click driver.
@@ -711,6 +761,70 @@ uint32_t pac1944_get_measurement ( pac1944_t *ctx, uint8_t meas_sel, uint8_t ch_
  */
 float pac1944_get_calc_measurement ( pac1944_t *ctx, uint8_t meas_sel, uint8_t ch_sel, uint8_t avg_sel, uint8_t meas_mode );
 
+/**
+ * @brief PAC1944 snapshot monitor initialization function.
+ * @details This function precomputes per-channel conversion factors from the
+ * measure modes in @b cfg_data, clears the software energy integrator and
+ * disables skipping of inactive channels in auto-incrementing reads, so the
+ * snapshot block always has the same layout.
+ * @param[in] ctx : Click context object.
+ * See #pac1944_t object definition for detailed explanation.
+ * @param[out] monitor : Snapshot monitor object.
+ * See #pac1944_monitor_t object definition for detailed explanation.
+ * @param[in] cfg_data : Configuration that was applied by #pac1944_setup_config.
+ * @param[in] acc_sample_rate : Accumulator sample rate in SPS, which is 1024
+ * ( PAC1944_ACC_SAMPLE_RATE_DEFAULT ) for all adaptive accumulation modes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note The accumulator must be configured to accumulate VPOWER, which is the
+ * power-on default.
+ *
+ * @endcode
+ */
+err_t pac1944_monitor_init ( pac1944_t *ctx, pac1944_monitor_t *monitor, 
+                             pac1944_setup_t *cfg_data, uint16_t acc_sample_rate );
+
+/**
+ * @brief PAC1944 get snapshot function.
+ * @details This function issues a single REFRESH_V command and reads the
+ * accumulator count, all accumulators and all channel results in one
+ * auto-incrementing block read. Results are scaled with the precomputed
+ * factors and the accumulator difference since the previous snapshot is added
+ * to the software energy integrator.
+ * @param[in] ctx : Click context object.
+ * See #pac1944_t object definition for detailed explanation.
+ * @param[in,out] monitor : Snapshot monitor object.
+ * See #pac1944_monitor_t object definition for detailed explanation.
+ * @param[out] snapshot : Scaled results of all channels.
+ * See #pac1944_snapshot_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note Accumulator rollover is handled modulo 2^56. A decrease of the
+ * accumulator count is treated as an accumulator reset ( REFRESH or POR ),
+ * so the new accumulator value is integrated from zero.
+ *
+ * @endcode
+ */
+err_t pac1944_get_snapshot ( pac1944_t *ctx, pac1944_monitor_t *monitor, pac1944_snapshot_t *snapshot );
+
+/**
+ * @brief PAC1944 reset energy function.
+ * @details This function clears the software energy integrator of all channels.
+ * The next snapshot only takes the accumulator baseline and adds no energy.
+ * @param[out] monitor : Snapshot monitor object.
+ * See #pac1944_monitor_t object definition for detailed explanation.
+ * @return Nothing.
+ *
+ * @note None.
+ *
+ * @endcode
+ */
+void pac1944_monitor_reset_energy ( pac1944_monitor_t *monitor );
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,6 +51,43 @@
 #define PAC1944_TWOS_COMP_PWR_SIGN_NEGATIVE           0x20000000
 #define PAC1944_TWOS_COMP_PWR_SIGN_CONV               0xC0000000
 
+#define PAC1944_SNAP_ACC_COUNT_OFFSET                 0
+#define PAC1944_SNAP_VACC_OFFSET                      4
+#define PAC1944_SNAP_VACC_SIZE                        7
+#define PAC1944_SNAP_VBUS_OFFSET                      32
+#define PAC1944_SNAP_VSENSE_OFFSET                    40
+#define PAC1944_SNAP_VBUS_AVG_OFFSET                  48
+#define PAC1944_SNAP_VSENSE_AVG_OFFSET                56
+#define PAC1944_SNAP_VPOWER_OFFSET                    64
+
+#define PAC1944_ACC_HI_MASK                           0x00FFFFFFul
+#define PAC1944_ACC_HI_SIGN                           0x00800000ul
+#define PAC1944_ACC_HI_SIGN_CONV                      0xFF000000ul
+#define PAC1944_TWO_POW_32                            4294967296.0
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+/**
+ * @brief PAC1944 raw to signed conversion function.
+ * @details This function converts a raw 16-bit result to a signed count
+ * according to the measure mode.
+ */
+static int32_t pac1944_raw16_to_count ( uint8_t *data_buf, uint8_t meas_mode );
+
+/**
+ * @brief PAC1944 lsb calculation function.
+ * @details This function returns the value of one count for the given full
+ * scale range, unipolar denominator and measure mode.
+ */
+static float pac1944_calc_lsb ( float fsr, float denominator, uint8_t meas_mode );
+
+/**
+ * @brief PAC1944 energy integration function.
+ * @details This function adds the accumulator difference since the previous
+ * readout to the 64-bit software integrator of the selected channel.
+ */
+static void pac1944_integrate_acc ( pac1944_monitor_t *monitor, uint8_t ch, uint8_t *acc_buf, uint8_t acc_reset );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void pac1944_cfg_setup ( pac1944_cfg_t *cfg ) {
@@ -427,6 +464,215 @@ float pac1944_get_calc_measurement ( pac1944_t *ctx, uint8_t meas_sel, uint8_t c
     return res;
 }
 
+err_t pac1944_monitor_init ( pac1944_t *ctx, pac1944_monitor_t *monitor, 
+                             pac1944_setup_t *cfg_data, uint16_t acc_sample_rate ) {
+    uint8_t smbus_cfg = DUMMY;
+    uint8_t ch;
+    
+    monitor->vbus_mode[ 0 ] = cfg_data->cfg_vbus1;
+    monitor->vbus_mode[ 1 ] = cfg_data->cfg_vbus2;
+    monitor->vbus_mode[ 2 ] = cfg_data->cfg_vbus3;
+    monitor->vbus_mode[ 3 ] = cfg_data->cfg_vbus4;
+    monitor->vsense_mode[ 0 ] = cfg_data->cfg_vsense1;
+    monitor->vsense_mode[ 1 ] = cfg_data->cfg_vsense2;
+    monitor->vsense_mode[ 2 ] = cfg_data->cfg_vsense3;
+    monitor->vsense_mode[ 3 ] = cfg_data->cfg_vsense4;
+    
+    for ( ch = 0; ch < PAC1944_CH_NUM; ch++ ) {
+        // Power is bipolar if any of its factors is bipolar, and half range if any is half range.
+        if ( ( monitor->vbus_mode[ ch ] == PAC1944_MEAS_MODE_BIPOLAR_HALF_FSR ) || 
+             ( monitor->vsense_mode[ ch ] == PAC1944_MEAS_MODE_BIPOLAR_HALF_FSR ) ) {
+            monitor->pwr_mode[ ch ] = PAC1944_MEAS_MODE_BIPOLAR_HALF_FSR;
+        } else if ( ( monitor->vbus_mode[ ch ] == PAC1944_MEAS_MODE_BIPOLAR_FSR ) || 
+                    ( monitor->vsense_mode[ ch ] == PAC1944_MEAS_MODE_BIPOLAR_FSR ) ) {
+            monitor->pwr_mode[ ch ] = PAC1944_MEAS_MODE_BIPOLAR_FSR;
+        } else {
+            monitor->pwr_mode[ ch ] = PAC1944_MEAS_MODE_UNIPOLAR_FSR;
+        }
+        
+        monitor->vbus_lsb[ ch ] = pac1944_calc_lsb( PAC1944_FSR_VSOURCE_V, PAC1944_CALC_DENOMINATOR_UNIPOLAR, 
+                                                    monitor->vbus_mode[ ch ] );
+        monitor->isense_lsb[ ch ] = pac1944_calc_lsb( PAC1944_FSR_ISENSE_A, PAC1944_CALC_DENOMINATOR_UNIPOLAR, 
+                                                      monitor->vsense_mode[ ch ] );
+        monitor->power_lsb[ ch ] = pac1944_calc_lsb( PAC1944_FSR_PSENSE_W, PAC1944_CALC_PWR_DENOMINATOR_UNIPOLAR, 
+                                                     monitor->pwr_mode[ ch ] );
+    }
+    
+    monitor->acc_sample_rate = acc_sample_rate;
+    pac1944_monitor_reset_energy( monitor );
+    
+    if ( pac1944_generic_read( ctx, PAC1944_REG_SMBUS_CFG, &smbus_cfg, 1 ) ) {
+        return I2C_MASTER_ERROR;
+    }
+    
+    smbus_cfg |= PAC1944_SMBUS_AUTO_INC_SKIP_OFF;
+    
+    return pac1944_generic_write( ctx, PAC1944_REG_SMBUS_CFG, &smbus_cfg, 1 );
+}
+
+err_t pac1944_get_snapshot ( pac1944_t *ctx, pac1944_monitor_t *monitor, pac1944_snapshot_t *snapshot ) {
+    uint8_t data_buf[ PAC1944_SNAPSHOT_BLOCK_SIZE ] = { DUMMY };
+    uint8_t *ptr;
+    uint32_t acc_count;
+    uint32_t pwr_raw;
+    int32_t pwr_count;
+    uint8_t acc_reset;
+    uint8_t ch;
+    float energy;
+    
+    pac1944_volatile_refresh_cmd( ctx );
+    
+    if ( pac1944_generic_read( ctx, PAC1944_REG_ACC_COUNT, data_buf, PAC1944_SNAPSHOT_BLOCK_SIZE ) ) {
+        return I2C_MASTER_ERROR;
+    }
+    
+    acc_count = data_buf[ PAC1944_SNAP_ACC_COUNT_OFFSET ];
+    acc_count <<= 8;
+    acc_count |= data_buf[ PAC1944_SNAP_ACC_COUNT_OFFSET + 1 ];
+    acc_count <<= 8;
+    acc_count |= data_buf[ PAC1944_SNAP_ACC_COUNT_OFFSET + 2 ];
+    acc_count <<= 8;
+    acc_count |= data_buf[ PAC1944_SNAP_ACC_COUNT_OFFSET + 3 ];
+    
+    acc_reset = monitor->acc_valid && ( acc_count < monitor->acc_count );
+    monitor->acc_count = acc_count;
+    snapshot->acc_count = acc_count;
+    
+    for ( ch = 0; ch < PAC1944_CH_NUM; ch++ ) {
+        snapshot->vbus[ ch ] = pac1944_raw16_to_count( &data_buf[ PAC1944_SNAP_VBUS_OFFSET + 2 * ch ], 
+                                                       monitor->vbus_mode[ ch ] ) * monitor->vbus_lsb[ ch ];
+        snapshot->isense[ ch ] = pac1944_raw16_to_count( &data_buf[ PAC1944_SNAP_VSENSE_OFFSET + 2 * ch ], 
+                                                         monitor->vsense_mode[ ch ] ) * monitor->isense_lsb[ ch ];
+        snapshot->vbus_avg[ ch ] = pac1944_raw16_to_count( &data_buf[ PAC1944_SNAP_VBUS_AVG_OFFSET + 2 * ch ], 
+                                                           monitor->vbus_mode[ ch ] ) * monitor->vbus_lsb[ ch ];
+        snapshot->isense_avg[ ch ] = pac1944_raw16_to_count( &data_buf[ PAC1944_SNAP_VSENSE_AVG_OFFSET + 2 * ch ], 
+                                                             monitor->vsense_mode[ ch ] ) * monitor->isense_lsb[ ch ];
+        
+        ptr = &data_buf[ PAC1944_SNAP_VPOWER_OFFSET + 4 * ch ];
+        pwr_raw = ptr[ 0 ];
+        pwr_raw <<= 8;
+        pwr_raw |= ptr[ 1 ];
+        pwr_raw <<= 8;
+        pwr_raw |= ptr[ 2 ];
+        pwr_raw <<= 6;
+        pwr_raw |= ptr[ 3 ] >> 2;
+        
+        if ( ( monitor->pwr_mode[ ch ] != PAC1944_MEAS_MODE_UNIPOLAR_FSR ) && 
+             ( pwr_raw & PAC1944_TWOS_COMP_PWR_SIGN_NEGATIVE ) ) {
+            pwr_raw |= PAC1944_TWOS_COMP_PWR_SIGN_CONV;
+        }
+        
+        pwr_count = ( int32_t ) pwr_raw;
+        snapshot->power[ ch ] = pwr_count * monitor->power_lsb[ ch ];
+        
+        pac1944_integrate_acc( monitor, ch, &data_buf[ PAC1944_SNAP_VACC_OFFSET + PAC1944_SNAP_VACC_SIZE * ch ], 
+                               acc_reset );
+        
+        energy = ( float ) monitor->energy_hi[ ch ] * PAC1944_TWO_POW_32 + ( float ) monitor->energy_lo[ ch ];
+        energy *= monitor->power_lsb[ ch ];
+        energy /= monitor->acc_sample_rate;
+        snapshot->energy[ ch ] = energy;
+    }
+    
+    monitor->acc_valid = 1;
+    
+    return I2C_MASTER_SUCCESS;
+}
+
+void pac1944_monitor_reset_energy ( pac1944_monitor_t *monitor ) {
+    uint8_t ch;
+    
+    monitor->acc_valid = 0;
+    monitor->acc_count = DUMMY;
+    
+    for ( ch = 0; ch < PAC1944_CH_NUM; ch++ ) {
+        monitor->acc_raw_hi[ ch ] = DUMMY;
+        monitor->acc_raw_lo[ ch ] = DUMMY;
+        monitor->energy_hi[ ch ] = DUMMY;
+        monitor->energy_lo[ ch ] = DUMMY;
+    }
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
+static int32_t pac1944_raw16_to_count ( uint8_t *data_buf, uint8_t meas_mode ) {
+    uint16_t raw;
+    
+    raw = data_buf[ 0 ];
+    raw <<= 8;
+    raw |= data_buf[ 1 ];
+    
+    if ( meas_mode == PAC1944_MEAS_MODE_UNIPOLAR_FSR ) {
+        return raw;
+    }
+    
+    return ( int16_t ) raw;
+}
+
+static float pac1944_calc_lsb ( float fsr, float denominator, uint8_t meas_mode ) {
+    float lsb = fsr / denominator;
+    
+    if ( meas_mode == PAC1944_MEAS_MODE_BIPOLAR_FSR ) {
+        lsb *= 2;
+    }
+    
+    return lsb;
+}
+
+static void pac1944_integrate_acc ( pac1944_monitor_t *monitor, uint8_t ch, uint8_t *acc_buf, uint8_t acc_reset ) {
+    uint32_t acc_hi;
+    uint32_t acc_lo;
+    uint32_t delta_hi;
+    uint32_t delta_lo;
+    uint32_t sum_lo;
+    
+    acc_hi = acc_buf[ 0 ];
+    acc_hi <<= 8;
+    acc_hi |= acc_buf[ 1 ];
+    acc_hi <<= 8;
+    acc_hi |= acc_buf[ 2 ];
+    acc_lo = acc_buf[ 3 ];
+    acc_lo <<= 8;
+    acc_lo |= acc_buf[ 4 ];
+    acc_lo <<= 8;
+    acc_lo |= acc_buf[ 5 ];
+    acc_lo <<= 8;
+    acc_lo |= acc_buf[ 6 ];
+    
+    if ( !monitor->acc_valid ) {
+        // First readout after init or reset only sets the baseline, earlier energy is not ours.
+        monitor->acc_raw_hi[ ch ] = acc_hi;
+        monitor->acc_raw_lo[ ch ] = acc_lo;
+        return;
+    }
+    
+    if ( acc_reset ) {
+        // The accumulator restarted from zero, so its whole content is new energy.
+        monitor->acc_raw_hi[ ch ] = DUMMY;
+        monitor->acc_raw_lo[ ch ] = DUMMY;
+    }
+    
+    // Difference modulo 2^56 covers accumulator rollover.
+    delta_lo = acc_lo - monitor->acc_raw_lo[ ch ];
+    delta_hi = acc_hi - monitor->acc_raw_hi[ ch ];
+    if ( acc_lo < monitor->acc_raw_lo[ ch ] ) {
+        delta_hi--;
+    }
+    delta_hi &= PAC1944_ACC_HI_MASK;
+    
+    if ( ( monitor->pwr_mode[ ch ] != PAC1944_MEAS_MODE_UNIPOLAR_FSR ) && ( delta_hi & PAC1944_ACC_HI_SIGN ) ) {
+        delta_hi |= PAC1944_ACC_HI_SIGN_CONV;
+    }
+    
+    sum_lo = monitor->energy_lo[ ch ] + delta_lo;
+    monitor->energy_hi[ ch ] += ( int32_t ) delta_hi;
+    if ( sum_lo < delta_lo ) {
+        monitor->energy_hi[ ch ]++;
+    }
+    monitor->energy_lo[ ch ] = sum_lo;
+    
+    monitor->acc_raw_hi[ ch ] = acc_hi;
+    monitor->acc_raw_lo[ ch ] = acc_lo;
+}
+
 // ------------------------------------------------------------------------- END
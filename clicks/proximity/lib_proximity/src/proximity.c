@@ -104,9 +104,9 @@ void proximity_write_data ( proximity_t *ctx, uint8_t w_addr, uint8_t* wr_data,
     
     tx_buf[ 0 ] = w_addr;
     
-    for ( cnt = 1; cnt <= n_len; cnt++ )
+    for ( cnt = 0; cnt < n_len; cnt++ )
     {
-        tx_buf[ cnt ] = wr_data[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = wr_data[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, n_len + 1 );   
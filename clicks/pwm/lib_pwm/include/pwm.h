@@ -74,6 +74,17 @@
  */
 #define PWM_MAX_RESOLUTION                                     4096
 /** \} */
+
+/**
+ * \defgroup frame Frame
+ * \{
+ */
+#define PWM_CH_NUM                                             16
+#define PWM_FRAME_SIZE                                         64
+#define PWM_FULL_BIT                                           0x10
+#define PWM_STAGGER_OFF                                        0x00
+#define PWM_STAGGER_ON                                         0x01
+/** \} */
  
 /**
  * \defgroup error_code Error Code
@@ -377,6 +388,16 @@ typedef struct
 
 } pwm_cfg_t;
 
+/**
+ * @brief Channel frame structure definition.
+ */
+typedef struct
+{
+    uint16_t raw_dc[ PWM_CH_NUM ];
+    uint8_t stagger;
+
+} pwm_frame_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -550,6 +571,42 @@ void pwm_set_pre_scale ( pwm_t *ctx, uint8_t pre_scale );
  */
 void pwm_set_all_raw ( pwm_t *ctx, uint16_t raw_dc );
 
+/**
+ * @brief Frame initialization function.
+ *
+ * @param frame        Channel frame.
+ * @param stagger      Phase staggering:
+ * - 0x00 ( PWM_STAGGER_OFF ) : All channels turn ON at the start of the period;
+ * - 0x01 ( PWM_STAGGER_ON )  : Channel ON times are spread evenly across the period;
+ *
+ * @description This function clears all channels of the frame to 0% duty cycle.
+ */
+void pwm_frame_init ( pwm_frame_t *frame, uint8_t stagger );
+
+/**
+ * @brief Frame set channel function.
+ *
+ * @param frame        Channel frame.
+ * @param chann_id     Channel ID (0 - 15).
+ * @param raw_dc       Duty cycle in range 0 - 4096, where 4096 is fully ON.
+ *
+ * @description This function stages the duty cycle of one channel in RAM,
+ * without any bus transaction.
+ */
+void pwm_frame_set_channel ( pwm_frame_t *frame, uint8_t chann_id, uint16_t raw_dc );
+
+/**
+ * @brief Frame commit function.
+ *
+ * @param ctx          Click object.
+ * @param frame        Channel frame.
+ *
+ * @description This function writes the ON and OFF registers of all 16 channels
+ * in a single auto-increment I2C transaction, so all outputs change together.
+ * @note Register auto-increment (AI bit of MODE1) must be enabled.
+ */
+void pwm_frame_commit ( pwm_t *ctx, pwm_frame_t *frame );
+
 #ifdef __cplusplus
 }
 #endif
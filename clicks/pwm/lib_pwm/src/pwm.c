@@ -79,9 +79,9 @@ void pwm_generic_write ( pwm_t *ctx, uint8_t reg, uint8_t *data_buf, uint8_t len
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );     
@@ -235,6 +235,66 @@ void pwm_set_pre_scale ( pwm_t *ctx, uint8_t pre_scale )
     pwm_generic_write( ctx, PWM_PRE_SCALE, &pre_scale, 1 );
 }
 
+void pwm_frame_init ( pwm_frame_t *frame, uint8_t stagger )
+{
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < PWM_CH_NUM; cnt++ )
+    {
+        frame->raw_dc[ cnt ] = 0;
+    }
+    frame->stagger = stagger;
+}
+
+void pwm_frame_set_channel ( pwm_frame_t *frame, uint8_t chann_id, uint16_t raw_dc )
+{
+    if ( chann_id >= PWM_CH_NUM )
+    {
+        return;
+    }
+    if ( raw_dc > PWM_MAX_RESOLUTION )
+    {
+        raw_dc = PWM_MAX_RESOLUTION;
+    }
+    frame->raw_dc[ chann_id ] = raw_dc;
+}
+
+void pwm_frame_commit ( pwm_t *ctx, pwm_frame_t *frame )
+{
+    uint8_t w_buffer[ PWM_FRAME_SIZE + 1 ];
+    uint16_t on_time;
+    uint16_t off_time;
+    uint8_t cnt;
+
+    w_buffer[ 0 ] = PWM_CH0_ON_L;
+
+    for ( cnt = 0; cnt < PWM_CH_NUM; cnt++ )
+    {
+        on_time = 0;
+        if ( PWM_STAGGER_ON == frame->stagger )
+        {
+            on_time = cnt * ( PWM_MAX_RESOLUTION / PWM_CH_NUM );
+        }
+        off_time = ( on_time + frame->raw_dc[ cnt ] ) % PWM_MAX_RESOLUTION;
+
+        w_buffer[ cnt * 4 + 1 ] = on_time & 0x00FF;
+        w_buffer[ cnt * 4 + 2 ] = ( on_time & 0x0F00 ) >> 8;
+        w_buffer[ cnt * 4 + 3 ] = off_time & 0x00FF;
+        w_buffer[ cnt * 4 + 4 ] = ( off_time & 0x0F00 ) >> 8;
+
+        if ( 0 == frame->raw_dc[ cnt ] )
+        {
+            w_buffer[ cnt * 4 + 4 ] |= PWM_FULL_BIT;
+        }
+        else if ( PWM_MAX_RESOLUTION == frame->raw_dc[ cnt ] )
+        {
+            w_buffer[ cnt * 4 + 2 ] |= PWM_FULL_BIT;
+        }
+    }
+
+    i2c_master_write( &ctx->i2c, w_buffer, PWM_FRAME_SIZE + 1 );
+}
+
 void pwm_set_output ( pwm_t *ctx, uint8_t en_out )
 {
     if ( en_out == PWM_DISABLE )
@@ -136,17 +136,14 @@ err_t rfid_send_command ( rfid_t *ctx, uint8_t cmd, uint8_t *data_in, uint8_t le
 {
     if ( RFID_SPI == ctx->com_interface )
     {
-        uint8_t tx_buf[ 257 ];
+        uint8_t tx_buf[ 3 ];
         tx_buf[ 0 ] = RFID_SEND_CMD_CRTL;
         tx_buf[ 1 ] = cmd;
         tx_buf[ 2 ] = len;
-        for ( uint8_t cnt = 0; cnt < len; cnt++ ) 
-        {
-            tx_buf[ cnt + 3 ] = data_in[ cnt ];
-        }
 
         spi_master_select_device( ctx->chip_select );
-        err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 3 );
+        err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 3 );
+        error_flag |= spi_master_write( &ctx->spi, data_in, len );
         spi_master_deselect_device( ctx->chip_select );
 
         return error_flag;
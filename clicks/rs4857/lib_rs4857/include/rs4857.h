@@ -70,9 +70,54 @@ extern "C"{
  * @details Specified size of driver ring buffer.
  * @note Increase buffer size if needed.
  */
-#define RS4857_TX_DRV_BUFFER_SIZE    100
+#define RS4857_TX_DRV_BUFFER_SIZE    256
 #define RS4857_RX_DRV_BUFFER_SIZE    300
 
+/**
+ * @brief RS485 7 Modbus RTU settings.
+ * @details Specified Modbus RTU frame limits and timings of RS485 7 Click driver.
+ */
+#define RS4857_MB_ADU_MAX_LEN        256
+#define RS4857_MB_MAX_READ_REGS      125
+#define RS4857_MB_MAX_WRITE_REGS     123
+#define RS4857_MB_MAX_REQUESTS       16
+#define RS4857_MB_CHAR_BITS          11
+#define RS4857_MB_FIXED_TIMING_BAUD  19200
+#define RS4857_MB_FIXED_T35_US       1750
+#define RS4857_MB_RSP_TIMEOUT_US     100000ul
+#define RS4857_MB_BROADCAST_ADDR     0x00
+
+/**
+ * @brief RS485 7 Modbus RTU function codes.
+ * @details Specified Modbus RTU function codes supported by RS485 7 Click driver.
+ */
+#define RS4857_MB_FC_READ_HOLDING    0x03
+#define RS4857_MB_FC_READ_INPUT      0x04
+#define RS4857_MB_FC_WRITE_SINGLE    0x06
+#define RS4857_MB_FC_WRITE_MULTIPLE  0x10
+#define RS4857_MB_FC_EXCEPTION       0x80
+
+/**
+ * @brief RS485 7 Modbus RTU status values.
+ * @details Specified Modbus RTU exception codes and poll status values of RS485 7 Click driver.
+ */
+#define RS4857_MB_STATUS_OK          0x00
+#define RS4857_MB_EX_ILLEGAL_FUNC    0x01
+#define RS4857_MB_EX_ILLEGAL_ADDR    0x02
+#define RS4857_MB_EX_ILLEGAL_VALUE   0x03
+#define RS4857_MB_STATUS_PENDING     0xFD
+#define RS4857_MB_STATUS_BAD_FRAME   0xFE
+#define RS4857_MB_STATUS_TIMEOUT     0xFF
+
+/**
+ * @brief RS485 7 Modbus RTU engine states.
+ * @details Specified Modbus RTU engine states of RS485 7 Click driver.
+ */
+#define RS4857_MB_STATE_IDLE         0
+#define RS4857_MB_STATE_TX           1
+#define RS4857_MB_STATE_WAIT_RSP     2
+#define RS4857_MB_STATE_RSP_READY    3
+
 /*! @} */ // rs4857_cmd
 
 /**
@@ -157,6 +202,84 @@ typedef enum
 
 } rs4857_return_value_t;
 
+/**
+ * @brief RS485 7 Modbus RTU poll object.
+ * @details Register read polled by the Modbus RTU master scheduler. Adjacent polls of the
+ * same slave and function are coalesced into a single request.
+ */
+typedef struct
+{
+    uint8_t   slave;            /**< Slave address. */
+    uint8_t   func;             /**< Read holding or read input registers function code. */
+    uint16_t  reg;              /**< First register address. */
+    uint16_t  count;            /**< Number of registers. */
+    uint16_t *dest;             /**< Destination of the register values. */
+    uint8_t   status;           /**< Status of the last poll. */
+
+} rs4857_mb_poll_t;
+
+/**
+ * @brief RS485 7 Modbus RTU request object.
+ * @details Coalesced read request object definition of RS485 7 Click driver.
+ */
+typedef struct
+{
+    uint8_t   slave;            /**< Slave address. */
+    uint8_t   func;             /**< Function code. */
+    uint16_t  reg;              /**< First register address. */
+    uint16_t  count;            /**< Number of registers. */
+
+} rs4857_mb_req_t;
+
+/**
+ * @brief RS485 7 Modbus RTU register map object.
+ * @details Slave register map object definition of RS485 7 Click driver. The register
+ * arrays are owned by the application and accessed by the engine in place.
+ */
+typedef struct
+{
+    uint16_t *holding;          /**< Holding registers. */
+    uint16_t  holding_start;    /**< Address of the first holding register. */
+    uint16_t  holding_count;    /**< Number of holding registers. */
+    uint16_t *input;            /**< Input registers. */
+    uint16_t  input_start;      /**< Address of the first input register. */
+    uint16_t  input_count;      /**< Number of input registers. */
+
+} rs4857_mb_regmap_t;
+
+/**
+ * @brief RS485 7 Modbus RTU engine object.
+ * @details Modbus RTU master/slave engine object definition of RS485 7 Click driver.
+ */
+typedef struct
+{
+    uint8_t             state;                              /**< Engine state. */
+    uint8_t             slave_addr;                         /**< Own address in slave mode, 0 in master mode. */
+
+    uint32_t            char_us;                            /**< Character time. */
+    uint32_t            t35_us;                             /**< Inter-frame silence. */
+    uint32_t            rsp_timeout_us;                     /**< Master response timeout. */
+
+    uint8_t             adu[ RS4857_MB_ADU_MAX_LEN ];       /**< Frame buffer shared by RX and TX. */
+    uint16_t            adu_len;                            /**< Number of bytes in the frame buffer. */
+    uint16_t            rsp_len;                            /**< Expected response length, 0 if unknown. */
+    uint32_t            bus_time_us;                        /**< Time of the last bus activity. */
+    uint32_t            tx_time_us;                         /**< Transmission time of the frame being sent. */
+
+    rs4857_mb_poll_t   *polls;                              /**< Master poll list. */
+    uint8_t             num_polls;                          /**< Number of polls. */
+    rs4857_mb_req_t     reqs[ RS4857_MB_MAX_REQUESTS ];     /**< Coalesced requests. */
+    uint8_t             num_reqs;                           /**< Number of coalesced requests. */
+    uint8_t             req_idx;                            /**< Request being processed. */
+    uint16_t            cycles;                             /**< Completed poll cycles. */
+
+    rs4857_mb_regmap_t *regmap;                             /**< Slave register map. */
+
+    uint16_t            bad_frames;                         /**< Frames dropped on CRC or format error. */
+    uint16_t            timeouts;                           /**< Master response timeouts. */
+
+} rs4857_mb_t;
+
 /*!
  * @addtogroup rs4857 RS485 7 Click Driver
  * @brief API for configuring and manipulating RS485 7 Click driver.
@@ -313,6 +436,70 @@ void rs4857_termination_ab_enable ( rs4857_t *ctx );
  */
 void rs4857_termination_ab_disable ( rs4857_t *ctx );
 
+/**
+ * @brief RS485 7 Modbus CRC function.
+ * @details This function calculates the Modbus CRC-16 of the selected data.
+ * @param[in] data_in : Data buffer.
+ * @param[in] len : Number of bytes.
+ * @return CRC-16 value, low byte is transmitted first.
+ * @note None.
+ */
+uint16_t rs4857_mb_crc16 ( uint8_t *data_in, uint16_t len );
+
+/**
+ * @brief RS485 7 Modbus master init function.
+ * @details This function initializes the Modbus RTU engine in master mode and coalesces
+ * the poll list into read requests. Polls of the same slave and function whose register
+ * ranges touch or overlap are merged as long as a request stays within 125 registers.
+ * @param[out] mb : Modbus engine object.
+ * See #rs4857_mb_t object definition for detailed explanation.
+ * @param[in] baud_rate : UART baud rate used for frame timing.
+ * @param[in] polls : Poll list, must stay valid while the engine runs.
+ * @param[in] num_polls : Number of polls.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Returns error if a poll is invalid or the polls need more than
+ * RS4857_MB_MAX_REQUESTS requests.
+ */
+err_t rs4857_mb_master_init ( rs4857_mb_t *mb, uint32_t baud_rate, rs4857_mb_poll_t *polls, uint8_t num_polls );
+
+/**
+ * @brief RS485 7 Modbus slave init function.
+ * @details This function initializes the Modbus RTU engine in slave mode. Read and write
+ * requests are served directly from and into the register map arrays.
+ * @param[out] mb : Modbus engine object.
+ * See #rs4857_mb_t object definition for detailed explanation.
+ * @param[in] baud_rate : UART baud rate used for frame timing.
+ * @param[in] slave_addr : Own slave address (1-247).
+ * @param[in] regmap : Register map, must stay valid while the engine runs.
+ * See #rs4857_mb_regmap_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t rs4857_mb_slave_init ( rs4857_mb_t *mb, uint32_t baud_rate, uint8_t slave_addr, rs4857_mb_regmap_t *regmap );
+
+/**
+ * @brief RS485 7 Modbus process function.
+ * @details This function runs the Modbus RTU engine. Frames are delimited by the 3.5 character
+ * silence derived from the baud rate, or earlier once the expected response length is received.
+ * After a frame is handed to the UART, the driver is released and the receiver enabled as soon
+ * as its transmission time has elapsed, and the next request goes out right after the
+ * inter-frame silence instead of a fixed guard delay.
+ * @param[in] ctx : Click context object.
+ * See #rs4857_t object definition for detailed explanation.
+ * @param[in] mb : Modbus engine object.
+ * See #rs4857_mb_t object definition for detailed explanation.
+ * @param[in] now_us : Free running microsecond timestamp, may wrap around.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Call this function at least once per character time, with the UART in non-blocking mode.
+ */
+err_t rs4857_mb_process ( rs4857_t *ctx, rs4857_mb_t *mb, uint32_t now_us );
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,142 @@
  */
 
 #include "rs4857.h"
+#include "string.h"
+
+/**
+ * @brief Modbus CRC-16 lookup table.
+ * @details Table for the reflected 0xA001 polynomial used by the Modbus RTU CRC.
+ */
+static const uint16_t rs4857_mb_crc_table[ 256 ] =
+{
+    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+
+/**
+ * @brief RS485 7 Modbus init timing function.
+ * @details This function resets the Modbus engine and derives the character time and
+ * the 3.5 character inter-frame silence from the baud rate.
+ * @param[out] mb : Modbus engine object.
+ * @param[in] baud_rate : UART baud rate.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t rs4857_mb_init_timing ( rs4857_mb_t *mb, uint32_t baud_rate );
+
+/**
+ * @brief RS485 7 Modbus merge request function.
+ * @details This function merges a register range into the request if both target the same
+ * slave and function, the ranges touch or overlap and the result fits into a single read.
+ * @param[in,out] req : Request object.
+ * @param[in] slave : Slave address.
+ * @param[in] func : Function code.
+ * @param[in] reg : First register address.
+ * @param[in] count : Number of registers.
+ * @return @li @c 0 - Not merged,
+ *         @li @c 1 - Merged.
+ */
+static uint8_t rs4857_mb_merge_req ( rs4857_mb_req_t *req, uint8_t slave, uint8_t func, uint16_t reg, uint16_t count );
+
+/**
+ * @brief RS485 7 Modbus frame length function.
+ * @details This function returns the length of the frame being received as known from its
+ * header, so the frame can be completed without waiting for the inter-frame silence.
+ * @param[in] mb : Modbus engine object.
+ * @return Expected frame length, 0 if not known yet.
+ */
+static uint16_t rs4857_mb_frame_len ( rs4857_mb_t *mb );
+
+/**
+ * @brief RS485 7 Modbus check crc function.
+ * @details This function checks the CRC of the received frame.
+ * @param[in] mb : Modbus engine object.
+ * @return @li @c 0 - Bad frame,
+ *         @li @c 1 - Valid frame.
+ */
+static uint8_t rs4857_mb_check_crc ( rs4857_mb_t *mb );
+
+/**
+ * @brief RS485 7 Modbus start transmission function.
+ * @details This function appends the CRC to the frame buffer, turns the bus around and
+ * hands the frame to the UART.
+ * @param[in] ctx : Click context object.
+ * @param[in] mb : Modbus engine object.
+ * @param[in] now_us : Microsecond timestamp.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t rs4857_mb_start_tx ( rs4857_t *ctx, rs4857_mb_t *mb, uint32_t now_us );
+
+/**
+ * @brief RS485 7 Modbus master complete function.
+ * @details This function updates the polls covered by the current request with the
+ * response registers or the failure status and advances to the next request.
+ * @param[in] mb : Modbus engine object.
+ * @param[in] status : Request status.
+ * @return Nothing.
+ */
+static void rs4857_mb_master_complete ( rs4857_mb_t *mb, uint8_t status );
+
+/**
+ * @brief RS485 7 Modbus master handle response function.
+ * @details This function validates the received response to the current request.
+ * @param[in] mb : Modbus engine object.
+ * @return Request status.
+ */
+static uint8_t rs4857_mb_master_handle_rsp ( rs4857_mb_t *mb );
+
+/**
+ * @brief RS485 7 Modbus slave registers function.
+ * @details This function returns the register map location of a register range.
+ * @param[in] mb : Modbus engine object.
+ * @param[in] func : Function code.
+ * @param[in] reg : First register address.
+ * @param[in] count : Number of registers.
+ * @return Pointer to the first register, NULL if the range is not mapped.
+ */
+static uint16_t *rs4857_mb_slave_regs ( rs4857_mb_t *mb, uint8_t func, uint16_t reg, uint16_t count );
+
+/**
+ * @brief RS485 7 Modbus slave handle request function.
+ * @details This function serves the received request from the register map and builds
+ * the response in place of the request.
+ * @param[in] mb : Modbus engine object.
+ * @return Response length without CRC.
+ */
+static uint16_t rs4857_mb_slave_handle_req ( rs4857_mb_t *mb );
 
 void rs4857_cfg_setup ( rs4857_cfg_t *cfg ) 
 {
@@ -133,4 +269,498 @@ void rs4857_termination_ab_disable ( rs4857_t *ctx )
     digital_out_low( &ctx->ret );
 }
 
+uint16_t rs4857_mb_crc16 ( uint8_t *data_in, uint16_t len )
+{
+    uint16_t crc = 0xFFFF;
+    while ( len-- )
+    {
+        crc = ( crc >> 8 ) ^ rs4857_mb_crc_table[ ( crc ^ *data_in++ ) & 0xFF ];
+    }
+    return crc;
+}
+
+err_t rs4857_mb_master_init ( rs4857_mb_t *mb, uint32_t baud_rate, rs4857_mb_poll_t *polls, uint8_t num_polls )
+{
+    uint8_t poll_cnt = 0;
+    uint8_t req_cnt = 0;
+    uint8_t merged = 0;
+    if ( RS4857_ERROR == rs4857_mb_init_timing ( mb, baud_rate ) )
+    {
+        return RS4857_ERROR;
+    }
+    mb->polls = polls;
+    mb->num_polls = num_polls;
+    for ( poll_cnt = 0; poll_cnt < num_polls; poll_cnt++ )
+    {
+        rs4857_mb_poll_t *poll = &polls[ poll_cnt ];
+        if ( ( RS4857_MB_BROADCAST_ADDR == poll->slave ) || ( NULL == poll->dest ) || 
+             ( ( RS4857_MB_FC_READ_HOLDING != poll->func ) && ( RS4857_MB_FC_READ_INPUT != poll->func ) ) || 
+             ( 0 == poll->count ) || ( poll->count > RS4857_MB_MAX_READ_REGS ) )
+        {
+            return RS4857_ERROR;
+        }
+        poll->status = RS4857_MB_STATUS_PENDING;
+        for ( req_cnt = 0; req_cnt < mb->num_reqs; req_cnt++ )
+        {
+            if ( rs4857_mb_merge_req ( &mb->reqs[ req_cnt ], poll->slave, poll->func, poll->reg, poll->count ) )
+            {
+                break;
+            }
+        }
+        if ( req_cnt == mb->num_reqs )
+        {
+            if ( mb->num_reqs >= RS4857_MB_MAX_REQUESTS )
+            {
+                return RS4857_ERROR;
+            }
+            mb->reqs[ req_cnt ].slave = poll->slave;
+            mb->reqs[ req_cnt ].func = poll->func;
+            mb->reqs[ req_cnt ].reg = poll->reg;
+            mb->reqs[ req_cnt ].count = poll->count;
+            mb->num_reqs++;
+        }
+    }
+    // A merged request may now touch another one, repeat until nothing merges.
+    do
+    {
+        merged = 0;
+        for ( req_cnt = 0; ( req_cnt < mb->num_reqs ) && !merged; req_cnt++ )
+        {
+            for ( poll_cnt = req_cnt + 1; poll_cnt < mb->num_reqs; poll_cnt++ )
+            {
+                rs4857_mb_req_t *req = &mb->reqs[ poll_cnt ];
+                if ( rs4857_mb_merge_req ( &mb->reqs[ req_cnt ], req->slave, req->func, req->reg, req->count ) )
+                {
+                    mb->num_reqs--;
+                    mb->reqs[ poll_cnt ] = mb->reqs[ mb->num_reqs ];
+                    merged = 1;
+                    break;
+                }
+            }
+        }
+    } while ( merged );
+    return RS4857_OK;
+}
+
+err_t rs4857_mb_slave_init ( rs4857_mb_t *mb, uint32_t baud_rate, uint8_t slave_addr, rs4857_mb_regmap_t *regmap )
+{
+    if ( ( RS4857_MB_BROADCAST_ADDR == slave_addr ) || ( slave_addr > 247 ) || ( NULL == regmap ) || 
+         ( RS4857_ERROR == rs4857_mb_init_timing ( mb, baud_rate ) ) )
+    {
+        return RS4857_ERROR;
+    }
+    mb->slave_addr = slave_addr;
+    mb->regmap = regmap;
+    return RS4857_OK;
+}
+
+err_t rs4857_mb_process ( rs4857_t *ctx, rs4857_mb_t *mb, uint32_t now_us )
+{
+    err_t rx_cnt = 0;
+    uint16_t frame_len = 0;
+    uint8_t complete = 0;
+
+    if ( RS4857_MB_STATE_TX == mb->state )
+    {
+        if ( ( now_us - mb->bus_time_us ) < mb->tx_time_us )
+        {
+            return RS4857_OK;
+        }
+        // Last stop bit is out, release the bus.
+        rs4857_driver_disable ( ctx );
+        rs4857_receiver_enable ( ctx );
+        mb->bus_time_us = now_us;
+        mb->adu_len = 0;
+        if ( mb->slave_addr || ( RS4857_MB_BROADCAST_ADDR == mb->adu[ 0 ] ) )
+        {
+            mb->state = RS4857_MB_STATE_IDLE;
+        }
+        else
+        {
+            mb->state = RS4857_MB_STATE_WAIT_RSP;
+        }
+        return RS4857_OK;
+    }
+
+    if ( RS4857_MB_STATE_RSP_READY == mb->state )
+    {
+        if ( ( now_us - mb->bus_time_us ) < mb->t35_us )
+        {
+            return RS4857_OK;
+        }
+        return rs4857_mb_start_tx ( ctx, mb, now_us );
+    }
+
+    if ( mb->adu_len < RS4857_MB_ADU_MAX_LEN )
+    {
+        rx_cnt = rs4857_generic_read ( ctx, ( char * ) &mb->adu[ mb->adu_len ], RS4857_MB_ADU_MAX_LEN - mb->adu_len );
+    }
+    else
+    {
+        // Oversized frame, drain it and let the length check drop it.
+        uint8_t dummy;
+        rx_cnt = rs4857_generic_read ( ctx, ( char * ) &dummy, 1 );
+        if ( rx_cnt > 0 )
+        {
+            mb->adu_len = RS4857_MB_ADU_MAX_LEN + 1;
+            rx_cnt = 0;
+            mb->bus_time_us = now_us;
+        }
+    }
+    if ( rx_cnt > 0 )
+    {
+        mb->adu_len += rx_cnt;
+        mb->bus_time_us = now_us;
+    }
+
+    if ( mb->adu_len )
+    {
+        frame_len = rs4857_mb_frame_len ( mb );
+        complete = ( ( frame_len && ( mb->adu_len >= frame_len ) ) || 
+                     ( ( now_us - mb->bus_time_us ) >= mb->t35_us ) );
+    }
+
+    if ( mb->slave_addr )
+    {
+        if ( complete )
+        {
+            if ( ( mb->adu_len > RS4857_MB_ADU_MAX_LEN ) || !rs4857_mb_check_crc ( mb ) )
+            {
+                mb->bad_frames++;
+                mb->adu_len = 0;
+            }
+            else if ( ( mb->slave_addr != mb->adu[ 0 ] ) && ( RS4857_MB_BROADCAST_ADDR != mb->adu[ 0 ] ) )
+            {
+                mb->adu_len = 0;
+            }
+            else
+            {
+                mb->adu_len = rs4857_mb_slave_handle_req ( mb );
+                if ( mb->adu_len && ( RS4857_MB_BROADCAST_ADDR != mb->adu[ 0 ] ) )
+                {
+                    mb->state = RS4857_MB_STATE_RSP_READY;
+                }
+                else
+                {
+                    mb->adu_len = 0;
+                }
+            }
+        }
+        return RS4857_OK;
+    }
+
+    if ( RS4857_MB_STATE_WAIT_RSP == mb->state )
+    {
+        if ( complete )
+        {
+            rs4857_mb_master_complete ( mb, rs4857_mb_master_handle_rsp ( mb ) );
+        }
+        else if ( ( 0 == mb->adu_len ) && ( ( now_us - mb->bus_time_us ) >= mb->rsp_timeout_us ) )
+        {
+            mb->timeouts++;
+            rs4857_mb_master_complete ( mb, RS4857_MB_STATUS_TIMEOUT );
+        }
+        return RS4857_OK;
+    }
+
+    if ( complete )
+    {
+        // Unsolicited traffic while idle.
+        mb->adu_len = 0;
+    }
+    if ( mb->num_reqs && !mb->adu_len && ( ( now_us - mb->bus_time_us ) >= mb->t35_us ) )
+    {
+        rs4857_mb_req_t *req = &mb->reqs[ mb->req_idx ];
+        mb->adu[ 0 ] = req->slave;
+        mb->adu[ 1 ] = req->func;
+        mb->adu[ 2 ] = ( uint8_t ) ( ( req->reg >> 8 ) & 0xFF );
+        mb->adu[ 3 ] = ( uint8_t ) ( req->reg & 0xFF );
+        mb->adu[ 4 ] = ( uint8_t ) ( ( req->count >> 8 ) & 0xFF );
+        mb->adu[ 5 ] = ( uint8_t ) ( req->count & 0xFF );
+        mb->adu_len = 6;
+        mb->rsp_len = 5 + req->count * 2;
+        return rs4857_mb_start_tx ( ctx, mb, now_us );
+    }
+    return RS4857_OK;
+}
+
+static err_t rs4857_mb_init_timing ( rs4857_mb_t *mb, uint32_t baud_rate )
+{
+    if ( 0 == baud_rate )
+    {
+        return RS4857_ERROR;
+    }
+    memset ( mb, 0, sizeof ( rs4857_mb_t ) );
+    mb->char_us = ( RS4857_MB_CHAR_BITS * 1000000ul + baud_rate - 1 ) / baud_rate;
+    // Above 19200 baud the specification fixes the silence instead of scaling it.
+    if ( baud_rate > RS4857_MB_FIXED_TIMING_BAUD )
+    {
+        mb->t35_us = RS4857_MB_FIXED_T35_US;
+    }
+    else
+    {
+        mb->t35_us = ( mb->char_us * 7 + 1 ) / 2;
+    }
+    mb->rsp_timeout_us = RS4857_MB_RSP_TIMEOUT_US;
+    mb->state = RS4857_MB_STATE_IDLE;
+    return RS4857_OK;
+}
+
+static uint8_t rs4857_mb_merge_req ( rs4857_mb_req_t *req, uint8_t slave, uint8_t func, uint16_t reg, uint16_t count )
+{
+    uint32_t req_end = ( uint32_t ) req->reg + req->count;
+    uint32_t end = ( uint32_t ) reg + count;
+    uint16_t start = req->reg;
+    if ( ( slave != req->slave ) || ( func != req->func ) || ( reg > req_end ) || ( req->reg > end ) )
+    {
+        return 0;
+    }
+    if ( reg < start )
+    {
+        start = reg;
+    }
+    if ( end < req_end )
+    {
+        end = req_end;
+    }
+    if ( ( end - start ) > RS4857_MB_MAX_READ_REGS )
+    {
+        return 0;
+    }
+    req->reg = start;
+    req->count = ( uint16_t ) ( end - start );
+    return 1;
+}
+
+static uint16_t rs4857_mb_frame_len ( rs4857_mb_t *mb )
+{
+    if ( mb->adu_len < 2 )
+    {
+        return 0;
+    }
+    if ( 0 == mb->slave_addr )
+    {
+        if ( mb->adu[ 1 ] & RS4857_MB_FC_EXCEPTION )
+        {
+            return 5;
+        }
+        return mb->rsp_len;
+    }
+    switch ( mb->adu[ 1 ] )
+    {
+        case RS4857_MB_FC_READ_HOLDING:
+        case RS4857_MB_FC_READ_INPUT:
+        case RS4857_MB_FC_WRITE_SINGLE:
+        {
+            return 8;
+        }
+        case RS4857_MB_FC_WRITE_MULTIPLE:
+        {
+            if ( mb->adu_len < 7 )
+            {
+                return 0;
+            }
+            return 9 + mb->adu[ 6 ];
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
+
+static uint8_t rs4857_mb_check_crc ( rs4857_mb_t *mb )
+{
+    uint16_t crc = 0;
+    if ( mb->adu_len < 4 )
+    {
+        return 0;
+    }
+    crc = rs4857_mb_crc16 ( mb->adu, mb->adu_len - 2 );
+    return ( ( ( crc & 0xFF ) == mb->adu[ mb->adu_len - 2 ] ) && 
+             ( ( crc >> 8 ) == mb->adu[ mb->adu_len - 1 ] ) );
+}
+
+static err_t rs4857_mb_start_tx ( rs4857_t *ctx, rs4857_mb_t *mb, uint32_t now_us )
+{
+    uint16_t crc = rs4857_mb_crc16 ( mb->adu, mb->adu_len );
+    mb->adu[ mb->adu_len++ ] = ( uint8_t ) ( crc & 0xFF );
+    mb->adu[ mb->adu_len++ ] = ( uint8_t ) ( ( crc >> 8 ) & 0xFF );
+    rs4857_receiver_disable ( ctx );
+    rs4857_driver_enable ( ctx );
+    if ( rs4857_generic_write ( ctx, ( char * ) mb->adu, mb->adu_len ) < 0 )
+    {
+        rs4857_driver_disable ( ctx );
+        rs4857_receiver_enable ( ctx );
+        mb->adu_len = 0;
+        mb->state = RS4857_MB_STATE_IDLE;
+        return RS4857_ERROR;
+    }
+    // The UART reports no TX-complete, so the last stop bit is timed from the frame length
+    // with one character of margin for the write latency.
+    mb->tx_time_us = ( mb->adu_len + 1 ) * mb->char_us;
+    mb->bus_time_us = now_us;
+    mb->state = RS4857_MB_STATE_TX;
+    return RS4857_OK;
+}
+
+static void rs4857_mb_master_complete ( rs4857_mb_t *mb, uint8_t status )
+{
+    rs4857_mb_req_t *req = &mb->reqs[ mb->req_idx ];
+    uint8_t poll_cnt = 0;
+    uint16_t reg_cnt = 0;
+    for ( poll_cnt = 0; poll_cnt < mb->num_polls; poll_cnt++ )
+    {
+        rs4857_mb_poll_t *poll = &mb->polls[ poll_cnt ];
+        if ( ( poll->slave != req->slave ) || ( poll->func != req->func ) || ( poll->reg < req->reg ) || 
+             ( ( ( uint32_t ) poll->reg + poll->count ) > ( ( uint32_t ) req->reg + req->count ) ) )
+        {
+            continue;
+        }
+        poll->status = status;
+        if ( RS4857_MB_STATUS_OK == status )
+        {
+            uint8_t *reg_data = &mb->adu[ 3 + ( poll->reg - req->reg ) * 2 ];
+            for ( reg_cnt = 0; reg_cnt < poll->count; reg_cnt++ )
+            {
+                poll->dest[ reg_cnt ] = ( ( uint16_t ) reg_data[ reg_cnt * 2 ] << 8 ) | reg_data[ reg_cnt * 2 + 1 ];
+            }
+        }
+    }
+    mb->adu_len = 0;
+    mb->state = RS4857_MB_STATE_IDLE;
+    if ( ++mb->req_idx >= mb->num_reqs )
+    {
+        mb->req_idx = 0;
+        mb->cycles++;
+    }
+}
+
+static uint8_t rs4857_mb_master_handle_rsp ( rs4857_mb_t *mb )
+{
+    rs4857_mb_req_t *req = &mb->reqs[ mb->req_idx ];
+    if ( ( mb->adu_len > RS4857_MB_ADU_MAX_LEN ) || !rs4857_mb_check_crc ( mb ) || ( req->slave != mb->adu[ 0 ] ) )
+    {
+        mb->bad_frames++;
+        return RS4857_MB_STATUS_BAD_FRAME;
+    }
+    if ( ( ( req->func | RS4857_MB_FC_EXCEPTION ) == mb->adu[ 1 ] ) && ( 5 == mb->adu_len ) )
+    {
+        return mb->adu[ 2 ];
+    }
+    if ( ( req->func != mb->adu[ 1 ] ) || ( mb->rsp_len != mb->adu_len ) || ( ( req->count * 2 ) != mb->adu[ 2 ] ) )
+    {
+        mb->bad_frames++;
+        return RS4857_MB_STATUS_BAD_FRAME;
+    }
+    return RS4857_MB_STATUS_OK;
+}
+
+static uint16_t *rs4857_mb_slave_regs ( rs4857_mb_t *mb, uint8_t func, uint16_t reg, uint16_t count )
+{
+    uint16_t *regs = mb->regmap->holding;
+    uint16_t start = mb->regmap->holding_start;
+    uint16_t num_regs = mb->regmap->holding_count;
+    if ( RS4857_MB_FC_READ_INPUT == func )
+    {
+        regs = mb->regmap->input;
+        start = mb->regmap->input_start;
+        num_regs = mb->regmap->input_count;
+    }
+    if ( ( NULL == regs ) || ( reg < start ) || 
+         ( ( ( uint32_t ) reg + count ) > ( ( uint32_t ) start + num_regs ) ) )
+    {
+        return NULL;
+    }
+    return &regs[ reg - start ];
+}
+
+static uint16_t rs4857_mb_slave_handle_req ( rs4857_mb_t *mb )
+{
+    uint16_t reg = ( ( uint16_t ) mb->adu[ 2 ] << 8 ) | mb->adu[ 3 ];
+    uint16_t count = ( ( uint16_t ) mb->adu[ 4 ] << 8 ) | mb->adu[ 5 ];
+    uint16_t frame_len = rs4857_mb_frame_len ( mb );
+    uint16_t *regs = NULL;
+    uint16_t reg_cnt = 0;
+    uint16_t rsp_len = 0;
+    uint8_t exception = RS4857_MB_STATUS_OK;
+
+    if ( frame_len && ( frame_len != mb->adu_len ) )
+    {
+        mb->bad_frames++;
+        return 0;
+    }
+    switch ( mb->adu[ 1 ] )
+    {
+        case RS4857_MB_FC_READ_HOLDING:
+        case RS4857_MB_FC_READ_INPUT:
+        {
+            if ( ( 0 == count ) || ( count > RS4857_MB_MAX_READ_REGS ) )
+            {
+                exception = RS4857_MB_EX_ILLEGAL_VALUE;
+                break;
+            }
+            regs = rs4857_mb_slave_regs ( mb, mb->adu[ 1 ], reg, count );
+            if ( NULL == regs )
+            {
+                exception = RS4857_MB_EX_ILLEGAL_ADDR;
+                break;
+            }
+            mb->adu[ 2 ] = ( uint8_t ) ( count * 2 );
+            for ( reg_cnt = 0; reg_cnt < count; reg_cnt++ )
+            {
+                mb->adu[ 3 + reg_cnt * 2 ] = ( uint8_t ) ( ( regs[ reg_cnt ] >> 8 ) & 0xFF );
+                mb->adu[ 4 + reg_cnt * 2 ] = ( uint8_t ) ( regs[ reg_cnt ] & 0xFF );
+            }
+            rsp_len = 3 + count * 2;
+            break;
+        }
+        case RS4857_MB_FC_WRITE_SINGLE:
+        {
+            regs = rs4857_mb_slave_regs ( mb, RS4857_MB_FC_READ_HOLDING, reg, 1 );
+            if ( NULL == regs )
+            {
+                exception = RS4857_MB_EX_ILLEGAL_ADDR;
+                break;
+            }
+            // Response echoes the request, the register value is the count field.
+            *regs = count;
+            rsp_len = 6;
+            break;
+        }
+        case RS4857_MB_FC_WRITE_MULTIPLE:
+        {
+            if ( ( 0 == count ) || ( count > RS4857_MB_MAX_WRITE_REGS ) || ( ( count * 2 ) != mb->adu[ 6 ] ) )
+            {
+                exception = RS4857_MB_EX_ILLEGAL_VALUE;
+                break;
+            }
+            regs = rs4857_mb_slave_regs ( mb, RS4857_MB_FC_READ_HOLDING, reg, count );
+            if ( NULL == regs )
+            {
+                exception = RS4857_MB_EX_ILLEGAL_ADDR;
+                break;
+            }
+            for ( reg_cnt = 0; reg_cnt < count; reg_cnt++ )
+            {
+                regs[ reg_cnt ] = ( ( uint16_t ) mb->adu[ 7 + reg_cnt * 2 ] << 8 ) | mb->adu[ 8 + reg_cnt * 2 ];
+            }
+            rsp_len = 6;
+            break;
+        }
+        default:
+        {
+            exception = RS4857_MB_EX_ILLEGAL_FUNC;
+            break;
+        }
+    }
+    if ( RS4857_MB_STATUS_OK != exception )
+    {
+        mb->adu[ 1 ] |= RS4857_MB_FC_EXCEPTION;
+        mb->adu[ 2 ] = exception;
+        rsp_len = 3;
+    }
+    return rsp_len;
+}
+
 // ------------------------------------------------------------------------- END
@@ -116,18 +116,14 @@ err_t rtc11_init ( rtc11_t *ctx, rtc11_cfg_t *cfg ) {
 }
 
 void rtc11_generic_write ( rtc11_t *ctx, uint8_t reg, uint8_t *wr_data, uint16_t n_len ) {
-    uint8_t tx_buf[ 512 ];
-    uint16_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg;
     tx_buf[ 0 ] |= RTC11_WR_BIT_MASK;
 
-    for ( cnt = 0; cnt < n_len; cnt++ ) {
-        tx_buf[ cnt + 1 ] = wr_data[ cnt ];
-    }
-
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, n_len + 1 );
+    spi_master_write( &ctx->spi, tx_buf, 1 );
+    spi_master_write( &ctx->spi, wr_data, n_len );
     spi_master_deselect_device( ctx->chip_select );
 }
 
@@ -138,20 +138,16 @@ err_t rtc13_block_clkout ( rtc13_t *ctx, uint8_t en_clkout )
 
 err_t rtc13_generic_write ( rtc13_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
-    uint8_t tx_buf[ 257 ] = { 0 };
+    uint8_t tx_buf[ 1 ] = { 0 };
 
     tx_buf[ 0 ] = reg;
     tx_buf[ 0 ] &= BIT_MASK_REG_ADDR_RANGE;
     tx_buf[ 0 ] |= BIT_MASK_DATA_WRITE;
     tx_buf[ 0 ] |= BIT_MASK_SUBADDRESS;
     
-    for ( uint8_t cnt = 1; cnt <= len; cnt++ )
-    {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
-
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
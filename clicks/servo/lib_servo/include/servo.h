@@ -267,6 +267,18 @@
 #define SERVO_POSITIVE_CH15                   0xBF
 /** \} */
 
+/**
+ * \defgroup servo_frame Servo Frame
+ * \{
+ */
+#define SERVO_MOTOR_NUM                       16
+#define SERVO_FRAME_SIZE                      64
+#define SERVO_PWM_RESOLUTION                  4096
+#define SERVO_MIN_PULSE                       70
+#define SERVO_STAGGER_OFF                     0x00
+#define SERVO_STAGGER_ON                      0x01
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -342,6 +354,29 @@ typedef struct
     uint8_t i2c_address_of_ltc2497;
 } servo_cfg_t;
 
+/**
+ * @brief Motor frame structure definition.
+ */
+typedef struct
+{
+    uint16_t pulse[ SERVO_MOTOR_NUM ];
+    uint8_t stagger;
+
+} servo_frame_t;
+
+/**
+ * @brief Motor trajectory structure definition.
+ */
+typedef struct
+{
+    servo_frame_t frame;
+
+    int32_t position[ SERVO_MOTOR_NUM ];
+    int32_t step[ SERVO_MOTOR_NUM ];
+    uint16_t ticks_left[ SERVO_MOTOR_NUM ];
+
+} servo_trajectory_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -557,6 +592,83 @@ uint32_t servo_get_channel ( servo_t *ctx, uint8_t channel );
  */
 uint16_t setvo_get_current ( servo_t *ctx, uint8_t channel );
 
+/**
+ * @brief Frame initialization function.
+ *
+ * @param frame     Motor frame.
+ * @param stagger   Phase staggering:
+ * - 0x00 ( SERVO_STAGGER_OFF ) : All pulses start at the beginning of the period;
+ * - 0x01 ( SERVO_STAGGER_ON )  : Pulse start times are spread evenly across the period;
+ *
+ * @description This function turns all motor outputs of the frame off.
+ */
+void servo_frame_init ( servo_frame_t *frame, uint8_t stagger );
+
+/**
+ * @brief Frame set position function.
+ *
+ * @param ctx       Click object.
+ * @param frame     Motor frame.
+ * @param motor     Motor index (0 - 15).
+ * @param position  Position on which the motor will be set.
+ *
+ * @description This function stages the position of one motor in RAM,
+ * without any bus transaction.
+ */
+void servo_frame_set_position ( servo_t *ctx, servo_frame_t *frame, uint8_t motor, uint8_t position );
+
+/**
+ * @brief Frame commit function.
+ *
+ * @param ctx       Click object.
+ * @param frame     Motor frame.
+ *
+ * @description This function writes the registers of all 16 motors in a single
+ * auto-increment I2C transaction, so all motors are updated together.
+ * @note Register auto-increment must be enabled, as done by servo_default_cfg.
+ */
+void servo_frame_commit ( servo_t *ctx, servo_frame_t *frame );
+
+/**
+ * @brief Trajectory initialization function.
+ *
+ * @param ctx       Click object.
+ * @param traj      Motor trajectory.
+ * @param position  Start position of all motors.
+ * @param stagger   Phase staggering, see servo_frame_init.
+ *
+ * @description This function sets all motors of the trajectory to the start
+ * position with no movement in progress.
+ */
+void servo_traj_init ( servo_t *ctx, servo_trajectory_t *traj, uint8_t position, uint8_t stagger );
+
+/**
+ * @brief Trajectory move function.
+ *
+ * @param traj      Motor trajectory.
+ * @param motor     Motor index (0 - 15).
+ * @param position  Target position.
+ * @param n_ticks   Number of ticks in which the target is reached.
+ *
+ * @description This function starts a linear movement of one motor from its
+ * current position to the target position.
+ */
+void servo_traj_move ( servo_trajectory_t *traj, uint8_t motor, uint8_t position, uint16_t n_ticks );
+
+/**
+ * @brief Trajectory tick function.
+ *
+ * @param ctx       Click object.
+ * @param traj      Motor trajectory.
+ *
+ * @return Number of motors still moving.
+ *
+ * @description This function advances all moving motors by one step and commits
+ * the frame in a single burst when any motor has moved. It should be called at
+ * a fixed tick rate, for example once per PWM period.
+ */
+uint8_t servo_traj_tick ( servo_t *ctx, servo_trajectory_t *traj );
+
 #ifdef __cplusplus
 }
 #endif
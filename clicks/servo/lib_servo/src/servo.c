@@ -33,6 +33,8 @@
 
 static uint16_t map_priv ( servo_map_t map );
 
+static uint16_t dev_position_to_pulse ( servo_t *ctx, uint8_t position );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void servo_cfg_setup ( servo_cfg_t *cfg )
@@ -102,9 +104,9 @@ void servo_generic_write_of_pca9685 ( servo_t *ctx, uint8_t reg, uint8_t *data_b
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address_of_pca9685 );
@@ -118,9 +120,9 @@ void servo_generic_write_of_ltc2497 ( servo_t *ctx, uint8_t reg, uint8_t *data_b
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_set_slave_address( &ctx->i2c, ctx->slave_address_of_ltc2497 );
@@ -193,19 +195,8 @@ void servo_set_position ( servo_t *ctx, uint8_t motor, uint8_t position )
     uint8_t write_reg[ 4 ];
     uint16_t set_map;
     uint16_t on = 0x0000;
-    servo_map_t map; 
-    
-    map.x = position;
-    map.in_min = ctx->min_pos ;
-    map.in_max = ctx->max_pos;
-    map.out_min = ctx->low_res;
-    map.out_max = ctx->high_res;
 
-    set_map = map_priv( map ) ;
-    if ( set_map < 70 )
-    {
-        set_map = 70;
-    }
+    set_map = dev_position_to_pulse( ctx, position );
         
     write_reg[ 0 ] = on;
     write_reg[ 1 ] = on >> 8;
@@ -266,6 +257,123 @@ uint16_t setvo_get_current ( servo_t *ctx, uint8_t channel )
     return  current;
 }
 
+void servo_frame_init ( servo_frame_t *frame, uint8_t stagger )
+{
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < SERVO_MOTOR_NUM; cnt++ )
+    {
+        frame->pulse[ cnt ] = 0;
+    }
+    frame->stagger = stagger;
+}
+
+void servo_frame_set_position ( servo_t *ctx, servo_frame_t *frame, uint8_t motor, uint8_t position )
+{
+    if ( motor < SERVO_MOTOR_NUM )
+    {
+        frame->pulse[ motor ] = dev_position_to_pulse( ctx, position );
+    }
+}
+
+void servo_frame_commit ( servo_t *ctx, servo_frame_t *frame )
+{
+    uint8_t write_reg[ SERVO_FRAME_SIZE ];
+    uint16_t on;
+    uint16_t off;
+    uint8_t cnt;
+
+    for ( cnt = 0; cnt < SERVO_MOTOR_NUM; cnt++ )
+    {
+        on = 0;
+        if ( SERVO_STAGGER_ON == frame->stagger )
+        {
+            on = cnt * ( SERVO_PWM_RESOLUTION / SERVO_MOTOR_NUM );
+        }
+        off = ( on + frame->pulse[ cnt ] ) % SERVO_PWM_RESOLUTION;
+
+        write_reg[ cnt * 4 ] = on;
+        write_reg[ cnt * 4 + 1 ] = on >> 8;
+        write_reg[ cnt * 4 + 2 ] = off;
+        write_reg[ cnt * 4 + 3 ] = off >> 8;
+
+        if ( 0 == frame->pulse[ cnt ] )
+        {
+            // Full OFF bit keeps an unused output low.
+            write_reg[ cnt * 4 + 3 ] |= 0x10;
+        }
+    }
+
+    servo_start( ctx );
+    servo_generic_write_of_pca9685( ctx, SERVO_MOTOR_1, write_reg, SERVO_FRAME_SIZE );
+}
+
+void servo_traj_init ( servo_t *ctx, servo_trajectory_t *traj, uint8_t position, uint8_t stagger )
+{
+    uint8_t cnt;
+
+    servo_frame_init( &traj->frame, stagger );
+
+    for ( cnt = 0; cnt < SERVO_MOTOR_NUM; cnt++ )
+    {
+        traj->position[ cnt ] = ( int32_t ) position << 8;
+        traj->step[ cnt ] = 0;
+        traj->ticks_left[ cnt ] = 0;
+        servo_frame_set_position( ctx, &traj->frame, cnt, position );
+    }
+}
+
+void servo_traj_move ( servo_trajectory_t *traj, uint8_t motor, uint8_t position, uint16_t n_ticks )
+{
+    if ( motor >= SERVO_MOTOR_NUM )
+    {
+        return;
+    }
+    if ( 0 == n_ticks )
+    {
+        n_ticks = 1;
+    }
+
+    traj->step[ motor ] = ( ( ( int32_t ) position << 8 ) - traj->position[ motor ] ) / n_ticks;
+    traj->ticks_left[ motor ] = n_ticks;
+
+    // Remainder of the division is applied up front, so the last tick lands on the target.
+    if ( 0 == traj->step[ motor ] )
+    {
+        traj->ticks_left[ motor ] = 1;
+    }
+    traj->position[ motor ] = ( ( int32_t ) position << 8 ) - traj->step[ motor ] * traj->ticks_left[ motor ];
+}
+
+uint8_t servo_traj_tick ( servo_t *ctx, servo_trajectory_t *traj )
+{
+    uint8_t cnt;
+    uint8_t n_moving = 0;
+    uint8_t changed = 0;
+
+    for ( cnt = 0; cnt < SERVO_MOTOR_NUM; cnt++ )
+    {
+        if ( traj->ticks_left[ cnt ] )
+        {
+            traj->position[ cnt ] += traj->step[ cnt ];
+            traj->ticks_left[ cnt ]--;
+            servo_frame_set_position( ctx, &traj->frame, cnt, ( uint8_t ) ( ( traj->position[ cnt ] + 0x80 ) >> 8 ) );
+            changed = 1;
+            if ( traj->ticks_left[ cnt ] )
+            {
+                n_moving++;
+            }
+        }
+    }
+
+    if ( changed )
+    {
+        servo_frame_commit( ctx, &traj->frame );
+    }
+
+    return n_moving;
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static uint16_t map_priv ( servo_map_t map )
@@ -278,5 +386,25 @@ static uint16_t map_priv ( servo_map_t map )
     return val;
 }
 
+static uint16_t dev_position_to_pulse ( servo_t *ctx, uint8_t position )
+{
+    uint16_t set_map;
+    servo_map_t map; 
+    
+    map.x = position;
+    map.in_min = ctx->min_pos ;
+    map.in_max = ctx->max_pos;
+    map.out_min = ctx->low_res;
+    map.out_max = ctx->high_res;
+
+    set_map = map_priv( map ) ;
+    if ( set_map < SERVO_MIN_PULSE )
+    {
+        set_map = SERVO_MIN_PULSE;
+    }
+
+    return set_map;
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -221,6 +221,21 @@ extern "C"{
  */
 #define DRV_BUFFER_SIZE                     256
 
+/**
+ * @brief Smart Mic download settings.
+ * @details Specified binary download settings of Smart Mic Click driver. The chunk size is
+ * the largest transfer of the selected interface: the UART TX ring size, or a single
+ * I2C/SPI transaction.
+ */
+#if ( SMARTMIC_DRIVER_SELECTOR == SMARTMIC_DRIVER_UART )
+    #define SMARTMIC_DOWNLOAD_CHUNK_SIZE    DRV_BUFFER_SIZE
+#else
+    #define SMARTMIC_DOWNLOAD_CHUNK_SIZE    1024
+#endif
+#define SMARTMIC_DOWNLOAD_RETRIES           3
+#define SMARTMIC_DOWNLOAD_TIMEOUT_MS        1000
+#define SMARTMIC_DOWNLOAD_DRAIN_MS          30
+
 /*! @} */ // smartmic_set
 
 /**
@@ -415,6 +430,11 @@ err_t smartmic_send_command ( smartmic_t *ctx, uint16_t cmd, uint16_t data_in, u
 /**
  * @brief Smart Mic download bin function.
  * @details This function downloads system config or firmware binary to the module.
+ * The binary is streamed in chunks of SMARTMIC_DOWNLOAD_CHUNK_SIZE bytes. On UART the next
+ * chunk is queued while the previous one is still being shifted out. The bootloader stream
+ * has no offsets, so only a chunk none of which went out is retried, up to
+ * SMARTMIC_DOWNLOAD_RETRIES times: a failed I2C/SPI transaction or a UART chunk the TX ring
+ * did not take a single byte of. Any partial UART transfer aborts the download.
  * @param[in] ctx : Click context object.
  * See #smartmic_t object definition for detailed explanation.
  * @param[in] data_in : Data to be written.
@@ -423,7 +443,7 @@ err_t smartmic_send_command ( smartmic_t *ctx, uint16_t cmd, uint16_t data_in, u
  *         @li @c  0 - Success,
  *         @li @c -1 - Error.
  * See #err_t definition for detailed explanation.
- * @note None.
+ * @note Returns error if the boot handshake is not answered within SMARTMIC_DOWNLOAD_TIMEOUT_MS.
  */
 err_t smartmic_download_bin ( smartmic_t *ctx, uint8_t *data_in, uint32_t len );
 
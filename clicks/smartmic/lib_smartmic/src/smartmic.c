@@ -53,6 +53,38 @@
  */
 #define DUMMY             0x00
 
+/**
+ * @brief Smart Mic download chunk function.
+ * @details This function writes a single download chunk to the module.
+ * @param[in] ctx : Click context object.
+ * See #smartmic_t object definition for detailed explanation.
+ * @param[in] data_in : Chunk data.
+ * @param[in] len : Chunk length.
+ * @param[out] sent : Number of bytes that reached the module. On I2C/SPI the chunk is a
+ * single transaction, so it is either all of the chunk or none of it.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note On UART the chunk is only queued to the TX ring buffer.
+ */
+static err_t smartmic_download_chunk ( smartmic_t *ctx, uint8_t *data_in, uint16_t len, uint16_t *sent );
+
+#if ( SMARTMIC_DRIVER_SELECTOR == SMARTMIC_DRIVER_UART )
+/**
+ * @brief Smart Mic wait byte function.
+ * @details This function waits for a single byte from the module.
+ * @param[in] ctx : Click context object.
+ * See #smartmic_t object definition for detailed explanation.
+ * @param[out] data_out : Read byte.
+ * @param[in] timeout_ms : Timeout in milliseconds.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t smartmic_wait_byte ( smartmic_t *ctx, uint8_t *data_out, uint16_t timeout_ms );
+#endif
+
 void smartmic_cfg_setup ( smartmic_cfg_t *cfg )
 {
     cfg->rx_pin = HAL_PIN_NC;
@@ -124,8 +156,8 @@ err_t smartmic_init ( smartmic_t *ctx, smartmic_cfg_t *cfg )
     smartmic_write_data ( ctx, dummy_write, 2 );
     Delay_1ms ( );
     smartmic_write_data ( ctx, &sync_byte, 1 );
-    while ( smartmic_read_data ( ctx, &sync_resp, 1 ) <= 0 );
-    if ( sync_resp != sync_byte )
+    if ( ( SMARTMIC_OK != smartmic_wait_byte ( ctx, &sync_resp, SMARTMIC_DOWNLOAD_TIMEOUT_MS ) ) || 
+         ( sync_resp != sync_byte ) )
     {
         return SMARTMIC_ERROR;
     }
@@ -386,8 +418,8 @@ err_t smartmic_download_bin ( smartmic_t *ctx, uint8_t *data_in, uint32_t len )
     uint8_t write_data = SMARTMIC_BOOT_BYTE;
     uint8_t read_data;
     smartmic_write_data ( ctx, &write_data, 1 );
-    while ( smartmic_read_data ( ctx, &read_data, 1 ) <= 0 );
-    if ( read_data != write_data )
+    if ( ( SMARTMIC_OK != smartmic_wait_byte ( ctx, &read_data, SMARTMIC_DOWNLOAD_TIMEOUT_MS ) ) || 
+         ( read_data != write_data ) )
     {
         return SMARTMIC_ERROR;
     }
@@ -416,28 +448,36 @@ err_t smartmic_download_bin ( smartmic_t *ctx, uint8_t *data_in, uint32_t len )
         return SMARTMIC_ERROR;
     }
 #endif
-    uint32_t cnt = 0;
-    while ( cnt < len )
+    uint32_t offset = 0;
+    uint16_t chunk_len = 0;
+    uint16_t sent = 0;
+    uint8_t retries = 0;
+#if ( SMARTMIC_DRIVER_SELECTOR == SMARTMIC_DRIVER_UART )
+    uart_clear ( &ctx->uart );
+#endif
+    while ( offset < len )
     {
-        if ( ( len - cnt ) >= 256 ) 
+        chunk_len = SMARTMIC_DOWNLOAD_CHUNK_SIZE;
+        if ( ( len - offset ) < SMARTMIC_DOWNLOAD_CHUNK_SIZE )
         {
-            if ( SMARTMIC_ERROR == smartmic_write_data ( ctx, &data_in[ cnt ], 256 ) )
-            {
-                return SMARTMIC_ERROR;
-            }
+            chunk_len = ( uint16_t ) ( len - offset );
         }
-        else
+        if ( SMARTMIC_OK != smartmic_download_chunk ( ctx, &data_in[ offset ], chunk_len, &sent ) )
         {
-            if ( SMARTMIC_ERROR == smartmic_write_data ( ctx, &data_in[ cnt ], ( len - cnt ) ) )
+            // The stream has no offsets, a chunk may be repeated only if none of it went out.
+            if ( sent || ( ++retries > SMARTMIC_DOWNLOAD_RETRIES ) )
             {
                 return SMARTMIC_ERROR;
             }
+            Delay_1ms( );
+            continue;
         }
-        cnt += 256;
+        retries = 0;
+        offset += chunk_len;
     }
 #if ( SMARTMIC_DRIVER_SELECTOR == SMARTMIC_DRIVER_UART )
-    Delay_1ms( );
-    if ( smartmic_read_data ( ctx, &read_data, 1 ) > 0 )
+    // The last chunk may still be in the TX ring, allow it to drain before the status byte.
+    if ( SMARTMIC_OK == smartmic_wait_byte ( ctx, &read_data, SMARTMIC_DOWNLOAD_DRAIN_MS ) )
     {
         return read_data;
     }
@@ -752,4 +792,56 @@ uint8_t smartmic_get_irq_pin ( smartmic_t *ctx )
     return digital_in_read ( &ctx->irq );
 }
 
+static err_t smartmic_download_chunk ( smartmic_t *ctx, uint8_t *data_in, uint16_t len, uint16_t *sent )
+{
+#if ( SMARTMIC_DRIVER_SELECTOR == SMARTMIC_DRIVER_UART )
+    uint16_t timeout_cnt = 0;
+    int32_t tx_len = 0;
+    *sent = 0;
+    while ( *sent < len )
+    {
+        tx_len = uart_write ( &ctx->uart, &data_in[ *sent ], len - *sent );
+        if ( tx_len > 0 )
+        {
+            *sent += ( uint16_t ) tx_len;
+            timeout_cnt = 0;
+        }
+        else
+        {
+            // TX ring is full, wait for the previous chunk to be shifted out.
+            if ( ++timeout_cnt > SMARTMIC_DOWNLOAD_TIMEOUT_MS )
+            {
+                return SMARTMIC_ERROR;
+            }
+            Delay_1ms( );
+        }
+    }
+    return SMARTMIC_OK;
+#else
+    *sent = 0;
+    if ( SMARTMIC_OK != smartmic_write_data ( ctx, data_in, len ) )
+    {
+        return SMARTMIC_ERROR;
+    }
+    *sent = len;
+    return SMARTMIC_OK;
+#endif
+}
+
+#if ( SMARTMIC_DRIVER_SELECTOR == SMARTMIC_DRIVER_UART )
+static err_t smartmic_wait_byte ( smartmic_t *ctx, uint8_t *data_out, uint16_t timeout_ms )
+{
+    uint16_t timeout_cnt = 0;
+    while ( smartmic_read_data ( ctx, data_out, 1 ) <= 0 )
+    {
+        if ( ++timeout_cnt > timeout_ms )
+        {
+            return SMARTMIC_ERROR;
+        }
+        Delay_1ms( );
+    }
+    return SMARTMIC_OK;
+}
+#endif
+
 // ------------------------------------------------------------------------ END
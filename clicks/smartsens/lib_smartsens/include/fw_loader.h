@@ -0,0 +1,199 @@
+/****************************************************************************
+** Copyright (C) 2020 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file fw_loader.h
+ * @brief Block based firmware loader with pluggable transport.
+ */
+
+#ifndef FW_LOADER_H
+#define FW_LOADER_H
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+#ifdef MikroCCoreVersion
+    #if MikroCCoreVersion >= 1
+        #include "delays.h"
+    #endif
+#endif
+
+#include "drv_name.h"
+
+/*!
+ * @addtogroup fw_loader Firmware Loader
+ * @brief Transport independent engine that pushes a firmware image to a bootloader
+ * block by block. Up to a window of blocks is kept in flight, the next block is
+ * fetched from the source while the device programs the previous ones, every
+ * block carries a CRC-16 and the acknowledged progress can be saved and resumed.
+ * @{
+ */
+
+/**
+ * @brief Firmware loader error code.
+ */
+#define FW_LOADER_OK                0
+#define FW_LOADER_ERROR            -1
+
+/**
+ * @brief Maximum number of blocks in flight.
+ */
+#define FW_LOADER_MAX_WINDOW        8
+
+/**
+ * @brief Default acknowledge timeout in milliseconds.
+ */
+#define FW_LOADER_ACK_TIMEOUT_MS    5000
+
+/**
+ * @brief CRC-16/CCITT-FALSE seed used for block and progress checksums.
+ */
+#define FW_LOADER_CRC_INIT          0xFFFF
+
+/**
+ * @brief Firmware loader transport.
+ * @details Callbacks connecting the engine to a device bootloader. @b handle is passed
+ * back unchanged, typically the Click context object.
+ */
+typedef struct
+{
+    void *handle;               /**< Transport context. */
+
+    /** Read @b len image bytes at @b offset into @b block, NULL when the image is in memory. */
+    err_t ( *read_block ) ( void *handle, uint32_t offset, uint8_t *block, uint16_t len );
+
+    /** Start programming of one block, must return without waiting for the device.
+     *  The block is left untouched until the following write call returns. */
+    err_t ( *write_block ) ( void *handle, uint32_t offset, uint8_t *block, uint16_t len, uint16_t crc );
+
+    /** Poll for acknowledges, @b acked receives the number of blocks completed since the last call. */
+    err_t ( *poll_ack ) ( void *handle, uint8_t *acked );
+
+} fw_loader_transport_t;
+
+/**
+ * @brief Firmware loader progress.
+ * @details Everything below @b offset is acknowledged by the device, @b crc is the
+ * CRC-16 of that part of the image. Store it to resume an interrupted upload.
+ */
+typedef struct
+{
+    uint32_t offset;            /**< Acknowledged image bytes. */
+    uint16_t crc;               /**< CRC-16 of the acknowledged bytes. */
+
+} fw_loader_progress_t;
+
+/**
+ * @brief Firmware loader object.
+ * @details Set up with #fw_loader_setup, fields are managed by the engine.
+ */
+typedef struct
+{
+    fw_loader_transport_t transport;    /**< Device transport. */
+    const uint8_t *image;               /**< Image in memory, used when there is no read callback. */
+    uint32_t image_size;                /**< Image size in bytes. */
+    uint8_t *buf[ 2 ];                  /**< Fetch buffers of @b block_size bytes, used with a read callback. */
+    uint8_t buf_idx;                    /**< Buffer receiving the next block. */
+    uint16_t block_size;                /**< Block size in bytes. */
+    uint8_t window;                     /**< Blocks kept in flight. */
+    uint16_t ack_timeout_ms;            /**< Acknowledge timeout in milliseconds. */
+
+    fw_loader_progress_t acked;         /**< Acknowledged progress. */
+    fw_loader_progress_t sent;          /**< Sent progress. */
+    uint8_t in_flight;                  /**< Blocks sent and not acknowledged. */
+    uint8_t head;                       /**< Oldest block in flight. */
+    uint16_t flight_len[ FW_LOADER_MAX_WINDOW ];    /**< Length of every block in flight. */
+    uint16_t flight_crc[ FW_LOADER_MAX_WINDOW ];    /**< Progress CRC after every block in flight. */
+
+} fw_loader_t;
+
+/**
+ * @brief Firmware loader setup function.
+ * @details This function prepares the loader for a new upload starting at the image beginning.
+ * @param[out] ldr : Firmware loader object.
+ * See #fw_loader_t object definition for detailed explanation.
+ * @param[in] transport : Device transport.
+ * @param[in] image : Firmware image in memory, NULL when the transport provides a read callback.
+ * @param[in] image_size : Image size in bytes.
+ * @param[in] block_size : Bytes per block.
+ * @param[in] window : Blocks kept in flight, 1 to @b FW_LOADER_MAX_WINDOW.
+ * @return Nothing.
+ * @note With a read callback set @b ldr->buf[ 0 ] and @b ldr->buf[ 1 ] to two
+ * buffers of @b block_size bytes after this call.
+ */
+void fw_loader_setup ( fw_loader_t *ldr, fw_loader_transport_t *transport, const uint8_t *image,
+                       uint32_t image_size, uint16_t block_size, uint8_t window );
+
+/**
+ * @brief Firmware loader resume function.
+ * @details This function continues an interrupted upload from saved progress. The
+ * progress CRC is checked against the image so a changed image is never resumed.
+ * @param[in] ldr : Firmware loader object.
+ * See #fw_loader_t object definition for detailed explanation.
+ * @param[in] progress : Progress saved with #fw_loader_get_progress.
+ * @return @li @c  0 - Success, the next run continues from @b progress,
+ *         @li @c -1 - Error, progress does not match the image and the upload restarts.
+ */
+err_t fw_loader_resume ( fw_loader_t *ldr, fw_loader_progress_t *progress );
+
+/**
+ * @brief Firmware loader run function.
+ * @details This function uploads the rest of the image and returns once every block
+ * is acknowledged. On error the loader rewinds to the acknowledged progress, so
+ * calling it again retries from the first unacknowledged block.
+ * @param[in] ldr : Firmware loader object.
+ * See #fw_loader_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+err_t fw_loader_run ( fw_loader_t *ldr );
+
+/**
+ * @brief Firmware loader progress function.
+ * @details This function reads the acknowledged upload progress.
+ * @param[in] ldr : Firmware loader object.
+ * See #fw_loader_t object definition for detailed explanation.
+ * @param[out] progress : Acknowledged progress.
+ * @return Nothing.
+ */
+void fw_loader_get_progress ( fw_loader_t *ldr, fw_loader_progress_t *progress );
+
+/**
+ * @brief CRC-16 calculation function.
+ * @details This function continues a CRC-16/CCITT-FALSE over @b len bytes.
+ * @param[in] crc : Previous CRC value or @b FW_LOADER_CRC_INIT.
+ * @param[in] data_in : Data to checksum.
+ * @param[in] len : Number of bytes.
+ * @return Updated CRC value.
+ */
+uint16_t fw_loader_crc16 ( uint16_t crc, const uint8_t *data_in, uint32_t len );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // FW_LOADER_H
+
+/*! @} */ // fw_loader
+
+// ------------------------------------------------------------------------ END
@@ -51,6 +51,7 @@ extern "C"{
 #include "drv_i2c_master.h"
 #include "drv_spi_master.h"
 #include "spi_specifics.h"
+#include "fw_loader.h"
 
 /*!
  * @addtogroup smartsens Smart Sens Click Driver
@@ -84,6 +85,19 @@ extern "C"{
 #define SMARTSENS_FLASH                                         1   /*< Boot firmware from flash */
 #define SMARTSENS_RAM                                           0   /*< Upload and boot firmware from RAM */
 
+/**
+ * @brief Smart Sens transfer setting.
+ * @details Specified transfer sizes and timeouts of Smart Sens Click driver.
+ * SPI uploads are streamed in a single chip select window, I2C uploads are split 
+ * into continuation writes of the command input register. Flash writes are 
+ * pushed by the firmware loader with up to @b SMARTSENS_FLASH_WINDOW blocks in flight.
+ */
+#define SMARTSENS_FLASH_WRITE_SIZE                              1024
+#define SMARTSENS_FLASH_WINDOW                                  1
+#define SMARTSENS_I2C_BURST_SIZE                                252
+#define SMARTSENS_FIFO_BURST_SIZE                               252
+#define SMARTSENS_UPLOAD_TIMEOUT_MS                             5000
+
 /**
  * @brief Smart Sens description register.
  * @details Specified register for description of Smart Sens Click driver.
@@ -846,7 +860,9 @@ err_t smartsens_sw_reset ( smartsens_t *ctx );
  * @note If you want to upload firmware to the device Flash you need both 
  * @b SMARTSENS_FLASHIMG and @b SMARTSENS_FLASH to set to 1, but if you 
  * want to use only device RAM both of that macros should be set to 0 and 
- * @b SMARTSENS_RAM should be set to 1.
+ * @b SMARTSENS_RAM should be set to 1. Flash is written in blocks of 
+ * @b SMARTSENS_FLASH_WRITE_SIZE bytes, RAM upload is sent as a single command 
+ * and checked only once the device reports that verification is done.
  */
 err_t smartsens_update_firmware ( smartsens_t *ctx );
 
@@ -921,8 +937,11 @@ err_t smartsens_set_virt_sensor_cfg( smartsens_t *ctx, uint8_t sensor_id, float
  * @brief Get and process the FIFO.
  * @details Function to get and process the FIFOs.
  * @param[in] work_buffer   : Reference to the data buffer where the FIFO 
- * data is copied to before parsing.
+ * data is streamed to while parsing.
  * @param[in] buffer_size   : Size of the data buffer.
+ * @note Events are dispatched as each burst of up to @b SMARTSENS_FIFO_BURST_SIZE 
+ * bytes arrives, so the buffer only needs to hold the largest event plus one burst, 
+ * not the whole FIFO content.
  * @return @li @c  0 - Success,
  *         @li @c -1 - Error.
  * See #err_t definition for detailed explanation.
@@ -0,0 +1,244 @@
+/****************************************************************************
+** Copyright (C) 2020 MikroElektronika d.o.o.
+** Contact: https://www.mikroe.com/contact
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to deal
+** in the Software without restriction, including without limitation the rights
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+** copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+** The above copyright notice and this permission notice shall be
+** included in all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+** EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+** OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+** IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+** DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT
+** OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE
+**  USE OR OTHER DEALINGS IN THE SOFTWARE.
+****************************************************************************/
+
+/*!
+ * @file fw_loader.c
+ * @brief Block based firmware loader with pluggable transport.
+ */
+
+#include "fw_loader.h"
+
+/**
+ * @brief Firmware loader block fetch function.
+ * @details This function returns the image block at @b offset, straight from the
+ * image in memory or read into the next fetch buffer.
+ * @param[in] ldr : Firmware loader object.
+ * @param[in] offset : Image offset.
+ * @param[in] len : Block length.
+ * @return Block data, NULL on read error.
+ */
+static uint8_t *fw_loader_fetch ( fw_loader_t *ldr, uint32_t offset, uint16_t len );
+
+/**
+ * @brief Firmware loader rewind function.
+ * @details This function drops every block in flight and continues from the acknowledged progress.
+ * @param[in] ldr : Firmware loader object.
+ * @return Nothing.
+ */
+static void fw_loader_rewind ( fw_loader_t *ldr );
+
+void fw_loader_setup ( fw_loader_t *ldr, fw_loader_transport_t *transport, const uint8_t *image,
+                       uint32_t image_size, uint16_t block_size, uint8_t window )
+{
+    ldr->transport = *transport;
+    ldr->image = image;
+    ldr->image_size = image_size;
+    ldr->buf[ 0 ] = NULL;
+    ldr->buf[ 1 ] = NULL;
+    ldr->buf_idx = 0;
+    ldr->block_size = block_size;
+    if ( window < 1 )
+    {
+        window = 1;
+    }
+    else if ( window > FW_LOADER_MAX_WINDOW )
+    {
+        window = FW_LOADER_MAX_WINDOW;
+    }
+    ldr->window = window;
+    ldr->ack_timeout_ms = FW_LOADER_ACK_TIMEOUT_MS;
+    ldr->acked.offset = 0;
+    ldr->acked.crc = FW_LOADER_CRC_INIT;
+    fw_loader_rewind( ldr );
+}
+
+err_t fw_loader_resume ( fw_loader_t *ldr, fw_loader_progress_t *progress )
+{
+    uint16_t crc = FW_LOADER_CRC_INIT;
+    uint32_t offset = 0;
+    uint8_t *block = NULL;
+    uint16_t len = 0;
+
+    ldr->acked.offset = 0;
+    ldr->acked.crc = FW_LOADER_CRC_INIT;
+    fw_loader_rewind( ldr );
+
+    // Resume only on a block boundary of the very same image, or after its last short block.
+    if ( ( progress->offset > ldr->image_size ) || 
+         ( ( progress->offset % ldr->block_size ) && ( progress->offset != ldr->image_size ) ) )
+    {
+        return FW_LOADER_ERROR;
+    }
+    while ( offset < progress->offset )
+    {
+        len = ldr->block_size;
+        if ( ( progress->offset - offset ) < len )
+        {
+            len = ( uint16_t ) ( progress->offset - offset );
+        }
+        block = fw_loader_fetch( ldr, offset, len );
+        if ( NULL == block )
+        {
+            return FW_LOADER_ERROR;
+        }
+        crc = fw_loader_crc16( crc, block, len );
+        offset += len;
+    }
+    if ( crc != progress->crc )
+    {
+        return FW_LOADER_ERROR;
+    }
+    ldr->acked = *progress;
+    fw_loader_rewind( ldr );
+    return FW_LOADER_OK;
+}
+
+err_t fw_loader_run ( fw_loader_t *ldr )
+{
+    uint8_t *block = NULL;
+    uint16_t len = 0;
+    uint16_t block_crc = 0;
+    uint8_t acked = 0;
+    uint8_t slot = 0;
+    uint16_t timeout_cnt = 0;
+
+    while ( ldr->acked.offset < ldr->image_size )
+    {
+        // Fetch the next block while the device programs the blocks in flight.
+        if ( ( NULL == block ) && ( ldr->sent.offset < ldr->image_size ) )
+        {
+            len = ldr->block_size;
+            if ( ( ldr->image_size - ldr->sent.offset ) < len )
+            {
+                len = ( uint16_t ) ( ldr->image_size - ldr->sent.offset );
+            }
+            block = fw_loader_fetch( ldr, ldr->sent.offset, len );
+            if ( NULL == block )
+            {
+                fw_loader_rewind( ldr );
+                return FW_LOADER_ERROR;
+            }
+            block_crc = fw_loader_crc16( FW_LOADER_CRC_INIT, block, len );
+        }
+
+        if ( ( NULL != block ) && ( ldr->in_flight < ldr->window ) )
+        {
+            if ( FW_LOADER_OK != ldr->transport.write_block( ldr->transport.handle, ldr->sent.offset,
+                                                             block, len, block_crc ) )
+            {
+                fw_loader_rewind( ldr );
+                return FW_LOADER_ERROR;
+            }
+            slot = ( ldr->head + ldr->in_flight ) % FW_LOADER_MAX_WINDOW;
+            ldr->sent.crc = fw_loader_crc16( ldr->sent.crc, block, len );
+            ldr->sent.offset += len;
+            ldr->flight_len[ slot ] = len;
+            ldr->flight_crc[ slot ] = ldr->sent.crc;
+            ldr->in_flight++;
+            ldr->buf_idx ^= 1;
+            block = NULL;
+            continue;
+        }
+
+        acked = 0;
+        if ( FW_LOADER_OK != ldr->transport.poll_ack( ldr->transport.handle, &acked ) )
+        {
+            fw_loader_rewind( ldr );
+            return FW_LOADER_ERROR;
+        }
+        if ( acked > ldr->in_flight )
+        {
+            acked = ldr->in_flight;
+        }
+        if ( acked )
+        {
+            while ( acked-- )
+            {
+                ldr->acked.offset += ldr->flight_len[ ldr->head ];
+                ldr->acked.crc = ldr->flight_crc[ ldr->head ];
+                ldr->head = ( ldr->head + 1 ) % FW_LOADER_MAX_WINDOW;
+                ldr->in_flight--;
+            }
+            timeout_cnt = 0;
+        }
+        else
+        {
+            if ( ++timeout_cnt > ldr->ack_timeout_ms )
+            {
+                fw_loader_rewind( ldr );
+                return FW_LOADER_ERROR;
+            }
+            Delay_1ms( );
+        }
+    }
+    return FW_LOADER_OK;
+}
+
+void fw_loader_get_progress ( fw_loader_t *ldr, fw_loader_progress_t *progress )
+{
+    *progress = ldr->acked;
+}
+
+uint16_t fw_loader_crc16 ( uint16_t crc, const uint8_t *data_in, uint32_t len )
+{
+    while ( len-- )
+    {
+        crc ^= ( uint16_t ) *data_in++ << 8;
+        for ( uint8_t bit_cnt = 0; bit_cnt < 8; bit_cnt++ )
+        {
+            if ( crc & 0x8000 )
+            {
+                crc = ( crc << 1 ) ^ 0x1021;
+            }
+            else
+            {
+                crc <<= 1;
+            }
+        }
+    }
+    return crc;
+}
+
+static uint8_t *fw_loader_fetch ( fw_loader_t *ldr, uint32_t offset, uint16_t len )
+{
+    uint8_t *block = ldr->buf[ ldr->buf_idx ];
+
+    if ( NULL == ldr->transport.read_block )
+    {
+        return ( uint8_t * ) &ldr->image[ offset ];
+    }
+    if ( ( NULL == block ) ||
+         ( FW_LOADER_OK != ldr->transport.read_block( ldr->transport.handle, offset, block, len ) ) )
+    {
+        return NULL;
+    }
+    return block;
+}
+
+static void fw_loader_rewind ( fw_loader_t *ldr )
+{
+    ldr->sent = ldr->acked;
+    ldr->in_flight = 0;
+    ldr->head = 0;
+}
+
+// ------------------------------------------------------------------------ END
@@ -172,20 +172,6 @@ static err_t smartsens_hif_get_sensor_info ( smartsens_t *ctx, uint8_t sensor_id
 static err_t smartsens_hif_exec_sensor_conf_cmd ( smartsens_t *ctx, uint8_t sensor_id,
                                                    float sample_rate, uint32_t latency );
 
-/**
- * @brief Get data from the Non-wake-up/wake-up FIFO
- * @details Function to get data from the Non-wake-up/wake-up FIFO
- * @param[in] ctx : Click context object.
- * See #smartsens_t object definition for detailed explanation.
- * @param[in] reg           : Non-wake-up/wake-up FIFO reg.
- * @param[out] fifo         : Reference to the data buffer to store data from the FIFO.
- * @param[out] bytes_read   : Number of bytes read into the data buffer.
- * @return @li @c  0 - Success,
- *         @li @c -1 - Error.
- * See #err_t definition for detailed explanation.
- */
-static err_t smartsens_hif_get_fifo ( smartsens_t *ctx, uint8_t reg, uint8_t *fifo, uint16_t *bytes_read );
-
 /**
  * @brief Parse fifo data.
  * @details Function to parse fifo data.
@@ -241,6 +227,83 @@ static err_t get_buffer_status ( struct smartsens_fifo_buffer *fifo_p, uint8_t e
  */
 static err_t get_time_stamp ( smartsens_t *ctx, enum smartsens_fifo_type source, uint32_t **time_stamp );
 
+/**
+ * @brief Smart Sens burst writing function.
+ * @details This function writes a command header followed by a large data block
+ * to the command input register. The data is padded to a multiple of 4 bytes.
+ * @param[in] ctx : Click context object.
+ * See #smartsens_t object definition for detailed explanation.
+ * @param[in] header : Command header.
+ * @param[in] header_len : Command header length.
+ * @param[in] data_in : Data block.
+ * @param[in] len : Data block length.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note SPI sends the whole block in a single chip select window.
+ */
+static err_t smartsens_burst_write ( smartsens_t *ctx, uint8_t *header, uint8_t header_len, 
+                                     const uint8_t *data_in, uint32_t len );
+
+/**
+ * @brief Smart Sens wait status function.
+ * @details This function polls a register until any bit of the mask is set.
+ * @param[in] ctx : Click context object.
+ * See #smartsens_t object definition for detailed explanation.
+ * @param[in] reg : Register to poll.
+ * @param[in] mask : Bit mask to wait for.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Times out after @b SMARTSENS_UPLOAD_TIMEOUT_MS milliseconds.
+ */
+static err_t smartsens_wait_status ( smartsens_t *ctx, uint8_t reg, uint8_t mask );
+
+/**
+ * @brief Smart Sens stream FIFO function.
+ * @details This function reads the selected FIFO in bursts and parses each burst
+ * as it arrives. Only an incomplete trailing event is kept between bursts.
+ * @param[in] ctx : Click context object.
+ * See #smartsens_t object definition for detailed explanation.
+ * @param[in] reg : FIFO register.
+ * @param[in] source : FIFO type.
+ * @param[in] fifo_p : FIFO work buffer.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t smartsens_stream_fifo ( smartsens_t *ctx, uint8_t reg, enum smartsens_fifo_type source, 
+                                     struct smartsens_fifo_buffer *fifo_p );
+
+/**
+ * @brief Smart Sens flash block write function.
+ * @details Firmware loader transport callback, this function sends one flash
+ * write command without waiting for its status.
+ * @param[in] handle : Click context object.
+ * See #smartsens_t object definition for detailed explanation.
+ * @param[in] offset : Image offset of the block.
+ * @param[in] block : Block data.
+ * @param[in] len : Block length.
+ * @param[in] crc : Block CRC, not checked by the bootloader.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t smartsens_flash_write_block ( void *handle, uint32_t offset, uint8_t *block, uint16_t len, uint16_t crc );
+
+/**
+ * @brief Smart Sens flash block acknowledge function.
+ * @details Firmware loader transport callback, this function reports a completed
+ * flash write once the device posts its status.
+ * @param[in] handle : Click context object.
+ * See #smartsens_t object definition for detailed explanation.
+ * @param[out] acked : Number of completed blocks.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ */
+static err_t smartsens_flash_poll_ack ( void *handle, uint8_t *acked );
+
 void smartsens_cfg_setup ( smartsens_cfg_t *cfg ) 
 {
     cfg->scl  = HAL_PIN_NC;
@@ -548,14 +611,15 @@ err_t smartsens_sw_reset ( smartsens_t *ctx )
 err_t smartsens_update_firmware ( smartsens_t *ctx )
 {
     err_t ret_val = SMARTSENS_OK;
-    uint32_t step = 240;
-    uint8_t temp[ 0x1FF ] = { 0 };
-    uint32_t cnt = 0;
+    uint8_t temp[ 8 ] = { 0 };
     uint32_t remaining = sizeof( smartsens_firmware_image );
     uint8_t status;
     
 #if SMARTSENS_FLASH
         volatile uint32_t start_addr = SMARTSENS_START_FLASH_ADR;        
+        volatile uint16_t cmd;
+        volatile uint16_t cmd_len;
+        volatile uint8_t cmd_buf[ 0xFF ] = { 0 };
         //ERASE
         temp[ 0 ] = start_addr;
         temp[ 1 ] = start_addr >> 8;
@@ -577,9 +641,6 @@ err_t smartsens_update_firmware ( smartsens_t *ctx )
             smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &status );
             Delay_10ms( );
         } while ( !( status & 0x20 ) );
-        volatile uint16_t cmd;
-        volatile uint16_t cmd_len;
-        volatile uint8_t cmd_buf[ 0xFF ] = { 0 };
         smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len );
         if ( 0x000F == cmd )
         {
@@ -588,91 +649,32 @@ err_t smartsens_update_firmware ( smartsens_t *ctx )
         //DONE ERASE
         
         //WRITE FLASH 
-        start_addr = SMARTSENS_START_FLASH_ADR; 
+        fw_loader_transport_t transport;
+        fw_loader_t loader;
         
-        do
-        {
-            volatile uint32_t size;
-            if ( remaining > step )
-            {
-                remaining -= step;
-                size = step + 4;
-            }
-            else
-            {
-                size = remaining + 4;
-                remaining = 0;
-            }
-            
-            temp[ 0 ] = start_addr;
-            temp[ 1 ] = start_addr >> 8;
-            temp[ 2 ] = start_addr >> 16;
-            temp[ 3 ] = start_addr >> 24;
-            memcpy( &temp[ 4 ], &smartsens_firmware_image[ cnt ], size );
-            cnt += size - 4;
-            
-            smartsens_cmd_write( ctx, SMARTSENS_CMD_WRITE_FLASH, temp, size );
-            
-            do 
-            {
-                smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &status );
-                Delay_10ms( );
-            } while ( !( status & 0x20 ) );
-            
-            smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len );
-            
-            if ( 0x000F == cmd )
-            {
-                ret_val = SMARTSENS_ERROR;
-                break;
-            }
-            
-            start_addr += ( size - 4 );
-            
-        } while ( remaining );
+        transport.handle = ctx;
+        transport.read_block = NULL;
+        transport.write_block = smartsens_flash_write_block;
+        transport.poll_ack = smartsens_flash_poll_ack;
         
-#elif SMARTSENS_RAM
+        // Block data is sent straight from the image, without a staging copy.
+        fw_loader_setup( &loader, &transport, smartsens_firmware_image, remaining, 
+                         SMARTSENS_FLASH_WRITE_SIZE, SMARTSENS_FLASH_WINDOW );
+        loader.ack_timeout_ms = SMARTSENS_UPLOAD_TIMEOUT_MS;
+        ret_val = fw_loader_run( &loader );
         
-        uint32_t enc = 0;     
-        uint16_t temp_index = 0;
+#elif SMARTSENS_RAM
         
+        // The whole image is a single upload command, the device verifies it once complete.
         temp[ 0 ] = ( uint8_t )SMARTSENS_CMD_UPLOAD_TO_RAM;
         temp[ 1 ] = ( uint8_t )( SMARTSENS_CMD_UPLOAD_TO_RAM >> 8 );
-        uint16_t size = sizeof( smartsens_firmware_image ) / 4;
+        uint16_t size = ( remaining + 3 ) / 4;
         temp[ 2 ] = ( uint8_t )size;
         temp[ 3 ] = ( uint8_t )( size >> 8 );
-        while ( cnt < sizeof( smartsens_firmware_image ) )
-        {
-            if ( !(enc++) )
-            {
-                temp_index = 4;
-            }
-            else
-            {
-                temp_index = 0;
-            }
-
-            while ( 0 != ( cnt % 4 ) )
-            {
-                cnt = ( ( cnt >> 2 ) + 1 ) << 2;
-            }
-            
-            volatile uint32_t limit = step * enc;
-            
-            for ( ; ( cnt < limit ) && ( cnt < sizeof( smartsens_firmware_image ) ); cnt++ )
-            {
-                temp[ temp_index++ ] = smartsens_firmware_image[ cnt ];
-            }
-            
-            smartsens_generic_write( ctx, SMARTSENS_REG_COMMAND_INPUT, temp, temp_index );
-        }
         
-        do
-        {
-            Delay_10ms( );
-            smartsens_byte_read( ctx, SMARTSENS_REG_BOOT_STATUS, &status );
-            
-        } while ( !( status & SMARTSENS_BOOTSTATUS_HOST_FW_VERIFY_DONE ) );
+        ret_val = smartsens_burst_write( ctx, temp, 4, smartsens_firmware_image, remaining );
+        ret_val |= smartsens_wait_status( ctx, SMARTSENS_REG_BOOT_STATUS, 
+                                          SMARTSENS_BOOTSTATUS_HOST_FW_VERIFY_DONE );
         
 #endif
     return ret_val;
@@ -825,8 +827,7 @@ err_t smartsens_set_virt_sensor_cfg( smartsens_t *ctx, uint8_t sensor_id, float
 
 err_t smartsens_get_and_process_fifo( smartsens_t *ctx, uint8_t *work_buffer, uint32_t buffer_size )
 {
-    uint8_t int_status, int_status_bak;
-    uint16_t bytes_read = 0;
+    uint8_t int_status;
     err_t rslt;
     struct smartsens_fifo_buffer fifos;
 
@@ -840,91 +841,39 @@ err_t smartsens_get_and_process_fifo( smartsens_t *ctx, uint8_t *work_buffer, ui
         return SMARTSENS_ERROR;
     }
 
-    memset( work_buffer, 0, buffer_size );
     memset( &fifos, 0, sizeof( struct smartsens_fifo_buffer ) );
 
     fifos.buffer = work_buffer;
     fifos.buffer_size = buffer_size;
 
-    rslt = smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &int_status_bak );
+    rslt = smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &int_status );
     if ( SMARTSENS_OK != rslt )
     {
         return rslt;
     }
 
     /* Get and process the Wake up FIFO */
-    fifos.read_length = 0;
-    int_status = int_status_bak;
-    while ( ( int_status || fifos.remain_length ) && ( SMARTSENS_OK == rslt ) )
+    if ( ( ( SMARTSENS_IS_INT_FIFO_W( int_status ) ) == SMARTSENS_IST_FIFO_W_DRDY ) ||
+         ( ( SMARTSENS_IS_INT_FIFO_W( int_status ) ) == SMARTSENS_IST_FIFO_W_LTCY ) ||
+         ( ( SMARTSENS_IS_INT_FIFO_W( int_status ) ) == SMARTSENS_IST_FIFO_W_WM ) )
     {
-        if ( ( ( SMARTSENS_IS_INT_FIFO_W( int_status ) ) == SMARTSENS_IST_FIFO_W_DRDY ) ||
-             ( ( SMARTSENS_IS_INT_FIFO_W( int_status ) ) == SMARTSENS_IST_FIFO_W_LTCY ) ||
-             ( ( SMARTSENS_IS_INT_FIFO_W( int_status ) ) == SMARTSENS_IST_FIFO_W_WM ) || 
-               ( fifos.remain_length ) )
-        {
-            /* Reset read_pos to the start of the buffer */
-            fifos.read_pos = 0;
-
-            /* Append data into the work_buffer linked through fifos */
-            rslt = smartsens_hif_get_fifo( ctx, SMARTSENS_REG_WAKE_UP_FIFO,
-                                            &fifos.buffer[ fifos.read_length ], &bytes_read );
-            if ( SMARTSENS_OK != rslt )
-            {
-                return rslt;
-            }
-            fifos.read_length += bytes_read;
-        }
-
-        rslt = parse_fifo( ctx, SMARTSENS_FIFO_TYPE_WAKEUP, &fifos );
-        int_status = 0;
+        rslt = smartsens_stream_fifo( ctx, SMARTSENS_REG_WAKE_UP_FIFO, SMARTSENS_FIFO_TYPE_WAKEUP, &fifos );
     }
 
     /* Get and process the Non Wake-up FIFO */
-    fifos.read_length = 0;
-    int_status = int_status_bak;
-    while ( ( int_status || fifos.remain_length ) && ( rslt == SMARTSENS_OK ) )
+    if ( ( SMARTSENS_OK == rslt ) && 
+         ( ( ( SMARTSENS_IS_INT_FIFO_NW( int_status ) ) == SMARTSENS_IST_FIFO_NW_DRDY ) ||
+           ( ( SMARTSENS_IS_INT_FIFO_NW( int_status ) ) == SMARTSENS_IST_FIFO_NW_LTCY ) ||
+           ( ( SMARTSENS_IS_INT_FIFO_NW( int_status ) ) == SMARTSENS_IST_FIFO_NW_WM ) ) )
     {
-        if ( ( ( SMARTSENS_IS_INT_FIFO_NW( int_status ) ) == SMARTSENS_IST_FIFO_NW_DRDY ) ||
-            ( ( SMARTSENS_IS_INT_FIFO_NW( int_status ) ) == SMARTSENS_IST_FIFO_NW_LTCY ) ||
-            ( ( SMARTSENS_IS_INT_FIFO_NW( int_status ) ) == SMARTSENS_IST_FIFO_NW_WM ) || ( fifos.remain_length ) )
-        {
-            /* Reset read_pos to the start of the buffer */
-            fifos.read_pos = 0;
-
-            /* Append data into the work_buffer linked through fifos */
-            rslt = smartsens_hif_get_fifo( ctx, SMARTSENS_REG_NON_WAKE_UP_FIFO,
-                                            &fifos.buffer[ fifos.read_length ], &bytes_read );
-            
-            if ( SMARTSENS_OK != rslt )
-            {
-                return rslt;
-            }
-            fifos.read_length += bytes_read;
-        }
-
-        rslt = parse_fifo( ctx, SMARTSENS_FIFO_TYPE_NON_WAKEUP, &fifos );
-        int_status = 0;
+        rslt = smartsens_stream_fifo( ctx, SMARTSENS_REG_NON_WAKE_UP_FIFO, SMARTSENS_FIFO_TYPE_NON_WAKEUP, &fifos );
     }
 
     /* Get and process the Status fifo */
-    fifos.read_length = 0;
-    int_status = int_status_bak;
-    while ( ( int_status || fifos.remain_length ) && ( SMARTSENS_OK == rslt ) )
+    if ( ( SMARTSENS_OK == rslt ) && 
+         ( ( SMARTSENS_IS_INT_ASYNC_STATUS( int_status ) ) == SMARTSENS_IST_MASK_DEBUG ) )
     {
-        if ( ( ( ( SMARTSENS_IS_INT_ASYNC_STATUS( int_status ) ) == SMARTSENS_IST_MASK_DEBUG ) || ( fifos.remain_length ) ) )
-        {
-            fifos.read_pos = 0;
-            rslt = smartsens_hif_get_fifo( ctx, SMARTSENS_REG_STATUS_DEBUG_FIFO,
-                                            &fifos.buffer[fifos.read_length], &bytes_read );
-            if ( SMARTSENS_OK != rslt )
-            {
-                return rslt;
-            }
-            fifos.read_length += bytes_read;
-        }
-
-        rslt = parse_fifo( ctx, SMARTSENS_FIFO_TYPE_STATUS, &fifos );
-        int_status = 0;
+        rslt = smartsens_stream_fifo( ctx, SMARTSENS_REG_STATUS_DEBUG_FIFO, SMARTSENS_FIFO_TYPE_STATUS, &fifos );
     }
     return rslt;
 }
@@ -951,9 +900,9 @@ static err_t smartsens_i2c_write ( smartsens_t *ctx, uint8_t reg, uint8_t *data_
 
     tx_buf[ 0 ] = reg;
 
-    for ( uint8_t cnt = 1; cnt <= len; cnt++ ) 
+    for ( uint8_t cnt = 0; cnt < len; cnt++ ) 
     {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
+        tx_buf[ cnt + 1 ] = data_in[ cnt ];
     }
 
     return i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
@@ -966,16 +915,13 @@ static err_t smartsens_i2c_read ( smartsens_t *ctx, uint8_t reg, uint8_t *data_o
 
 static err_t smartsens_spi_write ( smartsens_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
-    uint8_t tx_buf[ 257 ] = { 0 };
+    uint8_t tx_buf[ 1 ] = { 0 };
 
     tx_buf[ 0 ] = reg;
-    for ( uint8_t cnt = 1; cnt <= len; cnt++ ) 
-    {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 
     return error_flag;
@@ -1075,51 +1021,6 @@ static err_t smartsens_hif_exec_sensor_conf_cmd ( smartsens_t *ctx, uint8_t sens
     return smartsens_cmd_write( ctx, SMARTSENS_CMD_CONFIGURE_SENSOR, tmp_buf, 8 );
 }
 
-static err_t smartsens_hif_get_fifo ( smartsens_t *ctx, uint8_t reg, uint8_t *fifo, uint16_t *bytes_read )
-{
-    err_t rslt = SMARTSENS_OK;
-    uint8_t n_bytes[ 2 ];
-    uint32_t read_len;
-    uint32_t read_write_len = 64;
-    uint32_t offset;
-    uint32_t bytes_remain;
-
-    if ( ( NULL != ctx ) && ( NULL != fifo ) && ( NULL != bytes_read ) )
-    {
-        rslt = smartsens_generic_read( ctx, reg, n_bytes, 2 ); /* Read the available size */
-        bytes_remain = SMARTSENS_LE2U16(n_bytes);
-
-        if ( bytes_remain && ( SMARTSENS_OK == rslt ) )
-        {
-            *bytes_read = bytes_remain;
-            read_len = *bytes_read;
-            offset = 0;
-            while ( read_len > read_write_len )
-            {
-                rslt = smartsens_generic_read( ctx, reg, &fifo[offset], read_write_len );
-                if ( SMARTSENS_OK != rslt )
-                {
-                    break;
-                }
-                read_len -= read_write_len;
-                offset += read_write_len;
-            }
-
-            if ( read_len )
-            {
-                rslt = smartsens_generic_read( ctx, reg, &fifo[offset], read_len );
-            }
-            bytes_remain -= *bytes_read;
-        }
-    }
-    else
-    {
-        rslt = SMARTSENS_ERROR;
-    }
-
-    return rslt;
-}
-
 static err_t parse_fifo ( smartsens_t *ctx, enum smartsens_fifo_type source, struct smartsens_fifo_buffer *fifo_p )
 {
     uint8_t tmp_sensor_id = 0;
@@ -1295,4 +1196,161 @@ static err_t get_time_stamp ( smartsens_t *ctx, enum smartsens_fifo_type source,
     return rslt;
 }
 
+static err_t smartsens_burst_write ( smartsens_t *ctx, uint8_t *header, uint8_t header_len, 
+                                     const uint8_t *data_in, uint32_t len )
+{
+    uint8_t tx_buf[ SMARTSENS_I2C_BURST_SIZE + 1 ] = { 0 };
+    uint8_t padding[ 4 ] = { 0 };
+    uint8_t pad_len = ( 4 - ( len % 4 ) ) % 4;
+    uint32_t tx_len = 0;
+    uint32_t cnt = 0;
+    err_t error_flag = SMARTSENS_OK;
+
+    if ( SMARTSENS_DRV_SEL_SPI == ctx->drv_sel )
+    {
+        tx_buf[ 0 ] = SMARTSENS_REG_COMMAND_INPUT;
+        memcpy( &tx_buf[ 1 ], header, header_len );
+        spi_master_select_device( ctx->chip_select );
+        error_flag |= spi_master_write( &ctx->spi, tx_buf, header_len + 1 );
+        error_flag |= spi_master_write( &ctx->spi, ( uint8_t * ) data_in, len );
+        if ( pad_len )
+        {
+            error_flag |= spi_master_write( &ctx->spi, padding, pad_len );
+        }
+        spi_master_deselect_device( ctx->chip_select );
+        return error_flag;
+    }
+
+    // I2C: the device accepts the command as consecutive writes of the command input register.
+    tx_buf[ 0 ] = SMARTSENS_REG_COMMAND_INPUT;
+    memcpy( &tx_buf[ 1 ], header, header_len );
+    tx_len = header_len;
+    len += pad_len;
+    while ( ( cnt < len ) && ( SMARTSENS_OK == error_flag ) )
+    {
+        while ( ( tx_len < SMARTSENS_I2C_BURST_SIZE ) && ( cnt < len ) )
+        {
+            tx_buf[ ++tx_len ] = ( cnt < ( len - pad_len ) ) ? data_in[ cnt ] : DUMMY;
+            cnt++;
+        }
+        error_flag |= i2c_master_write( &ctx->i2c, tx_buf, tx_len + 1 );
+        tx_len = 0;
+    }
+    return error_flag;
+}
+
+static err_t smartsens_wait_status ( smartsens_t *ctx, uint8_t reg, uint8_t mask )
+{
+    uint8_t status = 0;
+    uint16_t timeout_cnt = 0;
+
+    for ( ; ; )
+    {
+        if ( SMARTSENS_OK != smartsens_byte_read( ctx, reg, &status ) )
+        {
+            return SMARTSENS_ERROR;
+        }
+        if ( status & mask )
+        {
+            return SMARTSENS_OK;
+        }
+        if ( ++timeout_cnt > SMARTSENS_UPLOAD_TIMEOUT_MS )
+        {
+            return SMARTSENS_ERROR;
+        }
+        Delay_1ms( );
+    }
+}
+
+static err_t smartsens_stream_fifo ( smartsens_t *ctx, uint8_t reg, enum smartsens_fifo_type source, 
+                                     struct smartsens_fifo_buffer *fifo_p )
+{
+    uint8_t n_bytes[ 2 ];
+    uint32_t bytes_remain;
+    uint32_t read_len;
+    err_t rslt;
+
+    fifo_p->read_pos = 0;
+    fifo_p->read_length = 0;
+
+    rslt = smartsens_generic_read( ctx, reg, n_bytes, 2 ); /* Read the available size */
+    bytes_remain = SMARTSENS_LE2U16( n_bytes );
+
+    while ( bytes_remain && ( SMARTSENS_OK == rslt ) )
+    {
+        read_len = fifo_p->buffer_size - fifo_p->read_length;
+        if ( 0 == read_len )
+        {
+            /* Event larger than the work buffer */
+            return SMARTSENS_ERROR;
+        }
+        if ( read_len > bytes_remain )
+        {
+            read_len = bytes_remain;
+        }
+        if ( read_len > SMARTSENS_FIFO_BURST_SIZE )
+        {
+            read_len = SMARTSENS_FIFO_BURST_SIZE;
+        }
+
+        rslt = smartsens_generic_read( ctx, reg, &fifo_p->buffer[ fifo_p->read_length ], read_len );
+        if ( SMARTSENS_OK != rslt )
+        {
+            break;
+        }
+        bytes_remain -= read_len;
+        fifo_p->read_length += read_len;
+
+        /* Dispatch complete events, parse_fifo keeps the incomplete tail at the buffer start */
+        fifo_p->read_pos = 0;
+        rslt = parse_fifo( ctx, source, fifo_p );
+    }
+
+    return rslt;
+}
+
+static err_t smartsens_flash_write_block ( void *handle, uint32_t offset, uint8_t *block, uint16_t len, uint16_t crc )
+{
+    smartsens_t *ctx = ( smartsens_t * ) handle;
+    uint32_t start_addr = SMARTSENS_START_FLASH_ADR + offset;
+    uint8_t header[ 8 ] = { 0 };
+    
+    ( void ) crc;
+    header[ 0 ] = ( uint8_t )SMARTSENS_CMD_WRITE_FLASH;
+    header[ 1 ] = ( uint8_t )( SMARTSENS_CMD_WRITE_FLASH >> 8 );
+    header[ 2 ] = ( uint8_t )( len + 4 );
+    header[ 3 ] = ( uint8_t )( ( len + 4 ) >> 8 );
+    header[ 4 ] = ( uint8_t )start_addr;
+    header[ 5 ] = ( uint8_t )( start_addr >> 8 );
+    header[ 6 ] = ( uint8_t )( start_addr >> 16 );
+    header[ 7 ] = ( uint8_t )( start_addr >> 24 );
+    
+    return smartsens_burst_write( ctx, header, 8, block, len );
+}
+
+static err_t smartsens_flash_poll_ack ( void *handle, uint8_t *acked )
+{
+    smartsens_t *ctx = ( smartsens_t * ) handle;
+    uint16_t cmd = 0;
+    uint16_t cmd_len = 0;
+    uint8_t cmd_buf[ 0xFF ] = { 0 };
+    uint8_t status = 0;
+    
+    *acked = 0;
+    if ( SMARTSENS_OK != smartsens_byte_read( ctx, SMARTSENS_REG_INTERRUPT_STATUS, &status ) )
+    {
+        return SMARTSENS_ERROR;
+    }
+    if ( status & 0x20 )
+    {
+        smartsens_status_read( ctx, &cmd, cmd_buf, &cmd_len );
+        if ( 0x000F == cmd )
+        {
+            return SMARTSENS_ERROR;
+        }
+        *acked = 1;
+    }
+    return SMARTSENS_OK;
+}
+
 // ------------------------------------------------------------------------ END
@@ -77,6 +77,7 @@
 #define SPECTROMETER_RETVAL  uint8_t
 
 #define SPECTROMETER_OK                                0x00
+#define SPECTROMETER_TIMEOUT_ERROR                     0xFE
 #define SPECTROMETER_INIT_ERROR                        0xFF
 /** \} */
 
@@ -299,6 +300,7 @@
  * \defgroup cfg3_register_gain_settings CFG3 Register Gain Settings
  * \{
  */
+#define SPECTROMETER_CFG_3_INT_READ_CLEAR              0x80
 #define SPECTROMETER_CFG_3_SAI                         0x10
 /** \} */
 
@@ -501,6 +503,38 @@
 #define SPECTROMETER_ID_VALUE                          0x24
 /** \} */
 
+/**
+ * \defgroup acquisition Acquisition
+ * \{
+ */
+#define SPECTROMETER_SMUX_RAM                          0x00
+#define SPECTROMETER_SMUX_RAM_SIZE                     20
+#define SPECTROMETER_SMUX_MAP_F1F4                     0x00
+#define SPECTROMETER_SMUX_MAP_F5F8                     0x01
+#define SPECTROMETER_SMUX_MAP_FD                       0x02
+#define SPECTROMETER_SMUX_MAP_NONE                     0xFF
+#define SPECTROMETER_ACQ_TIMEOUT_MS                    1000
+#define SPECTROMETER_ACQ_POLL_MS                       10
+#define SPECTROMETER_ASTATUS_AGAIN_MASK                0x0F
+/** \} */
+
+/**
+ * \defgroup spectrum_channels Spectrum channels
+ * \{
+ */
+#define SPECTROMETER_CH_F1                             0
+#define SPECTROMETER_CH_F2                             1
+#define SPECTROMETER_CH_F3                             2
+#define SPECTROMETER_CH_F4                             3
+#define SPECTROMETER_CH_F5                             4
+#define SPECTROMETER_CH_F6                             5
+#define SPECTROMETER_CH_F7                             6
+#define SPECTROMETER_CH_F8                             7
+#define SPECTROMETER_CH_CLEAR                          8
+#define SPECTROMETER_CH_NIR                            9
+#define SPECTROMETER_CH_NUM                            10
+/** \} */
+
 /** \} */ // End group macro 
 // --------------------------------------------------------------- PUBLIC TYPES
 /**
@@ -525,6 +559,14 @@ typedef struct
 
     uint8_t slave_address;
 
+    // Acquisition state, kept between captures 
+
+    uint8_t acq_ready;
+    uint8_t smux_map;
+    uint8_t atime;
+    uint16_t astep;
+    uint16_t acq_timeout_ms;
+
 } spectrometer_t;
 
 /**
@@ -548,6 +590,17 @@ typedef struct
 
 } spectrometer_cfg_t;
 
+/**
+ * @brief Spectrum structure definition.
+ */
+typedef struct
+{
+    uint16_t ch[ SPECTROMETER_CH_NUM ];     // Raw counts, indexed by SPECTROMETER_CH_x.
+    uint8_t again;                          // Gain code both halves were taken with.
+    uint8_t saturated;                      // ASTATUS saturation flag of either half.
+
+} spectrometer_spectrum_t;
+
 /** \} */ // End types group
 // ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
 
@@ -723,6 +776,7 @@ void spectrometer_def_cfg ( spectrometer_t *ctx );
  * @param adc_data     Output adc values
  *
  * @description This function is used to read out channels with SMUX configration 1; F1-F4, Clear.
+ * @note @b adc_data is zeroed if the measurement does not complete.
 **/
 void spectrometer_raw_rd_val_mode_1 ( spectrometer_t *ctx, uint8_t *adc_data );
 
@@ -733,6 +787,7 @@ void spectrometer_raw_rd_val_mode_1 ( spectrometer_t *ctx, uint8_t *adc_data );
  * @param adc_data     Output adc values
  *
  * @description This function is used to read out channels with SMUX configration 2; F5-F8, Clear.
+ * @note @b adc_data is zeroed if the measurement does not complete.
 **/
 void spectrometer_raw_rd_val_mode_2 ( spectrometer_t *ctx, uint8_t *adc_data );
 
@@ -758,6 +813,62 @@ uint8_t spectrometer_flicker_detection ( spectrometer_t *ctx );
 **/
 uint8_t spectrometer_get_int ( spectrometer_t *ctx );
 
+/**
+ * @brief Acquisition setup function
+ *
+ * @param ctx          Click object.
+ * 
+ * @returns   0 : OK
+ *
+ * @description This function powers the device on for good, caches the integration 
+ *              time and routes SMUX and spectral completion to the INT pin. Call it 
+ *              after the integration time and gain are set.
+**/
+SPECTROMETER_RETVAL spectrometer_acq_setup ( spectrometer_t *ctx );
+
+/**
+ * @brief Acquisition capture function
+ *
+ * @param ctx          Click object.
+ * @param smux_map     SPECTROMETER_SMUX_MAP_F1F4 or SPECTROMETER_SMUX_MAP_F5F8
+ * @param adc_data     Output ASTATUS followed by 12 bytes of channel data
+ * 
+ * @returns   0 : OK,     0xFE : Timeout
+ *
+ * @description This function runs one measurement with the given SMUX map. The map 
+ *              is written in a single burst and skipped when already loaded, completion 
+ *              is taken from the INT pin and ASTATUS with all channels come in one read.
+**/
+SPECTROMETER_RETVAL spectrometer_acq_capture ( spectrometer_t *ctx, uint8_t smux_map, uint8_t *adc_data );
+
+/**
+ * @brief Read Spectrum function
+ *
+ * @param ctx          Click object.
+ * @param spectrum     Output spectrum
+ * 
+ * @returns   0 : OK,     0xFE : Timeout
+ *
+ * @description This function captures F1-F8, Clear and NIR with two measurements, 
+ *              Clear and NIR are the average of both.
+**/
+SPECTROMETER_RETVAL spectrometer_read_spectrum ( spectrometer_t *ctx, spectrometer_spectrum_t *spectrum );
+
+/**
+ * @brief Basic Counts function
+ *
+ * @param ctx          Click object.
+ * @param raw          Raw channel counts
+ * @param again        Gain code, SPECTROMETER_CFG_1_AGAIN_x
+ * 
+ * @returns   Basic counts in thousandths
+ *
+ * @description This function normalises raw counts to 1x gain and 1 ms integration 
+ *              with integer arithmetic only, using the integration time cached by 
+ *              #spectrometer_acq_setup.
+**/
+uint32_t spectrometer_basic_counts ( spectrometer_t *ctx, uint16_t raw, uint8_t again );
+
 #ifdef __cplusplus
 }
 #endif
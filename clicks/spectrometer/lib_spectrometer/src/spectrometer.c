@@ -29,6 +29,34 @@
 
 #include "spectrometer.h"
 
+// ------------------------------------------------------------- PRIVATE MACROS 
+
+// 1000 / 2.78 us integration step, in milli basic counts per step at 1x gain.
+#define SPECTROMETER_BASIC_COUNTS_STEP                 35971ul
+
+// ------------------------------------------------------------------ CONSTANTS
+
+static const uint8_t SMUX_MAP[ 3 ][ SPECTROMETER_SMUX_RAM_SIZE ] =
+{
+    // F1,F2,F3,F4,NIR,Clear
+    { 0x30, 0x01, 0x00, 0x00, 0x00, 0x42, 0x00, 0x00, 0x50, 0x00, 
+      0x00, 0x00, 0x20, 0x04, 0x00, 0x30, 0x01, 0x50, 0x00, 0x06 },
+    // F5,F6,F7,F8,NIR,Clear
+    { 0x00, 0x00, 0x00, 0x40, 0x02, 0x00, 0x10, 0x03, 0x50, 0x10, 
+      0x03, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x50, 0x00, 0x06 },
+    // Flicker detection
+    { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60 }
+};
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS 
+
+static void spectrometer_write_reg ( spectrometer_t *ctx, uint8_t reg, uint8_t reg_val );
+
+static void spectrometer_load_smux ( spectrometer_t *ctx, uint8_t smux_map );
+
+static SPECTROMETER_RETVAL spectrometer_wait_status ( spectrometer_t *ctx, uint8_t status_mask );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void spectrometer_cfg_setup ( spectrometer_cfg_t *cfg )
@@ -69,6 +97,10 @@ SPECTROMETER_RETVAL spectrometer_init ( spectrometer_t *ctx, spectrometer_cfg_t
 
     digital_in_init( &ctx->int_pin, cfg->int_pin );
 
+    ctx->acq_ready = 0;
+    ctx->smux_map = SPECTROMETER_SMUX_MAP_NONE;
+    ctx->acq_timeout_ms = SPECTROMETER_ACQ_TIMEOUT_MS;
+
     return SPECTROMETER_OK;
 }
 
@@ -79,9 +111,9 @@ void spectrometer_generic_write ( spectrometer_t *ctx, uint8_t reg, uint8_t *dat
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buf[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );   
@@ -167,113 +199,18 @@ uint8_t spectrometer_get_data_ready ( spectrometer_t *ctx )
 // SMUX Config for F1,F2,F3,F4,NIR,Clear
 void spectrometer_f1f4_clr_nir ( spectrometer_t *ctx )
 {
-    uint8_t write_data;
-
-    write_data = 0x30;
-    spectrometer_generic_write( ctx, 0x00, &write_data, 1 );
-    write_data = 0x01;
-    spectrometer_generic_write( ctx, 0x01, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x02, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x03, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x04, &write_data, 1 );
-    write_data = 0x42;
-    spectrometer_generic_write( ctx, 0x05, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x06, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x07, &write_data, 1 );
-    write_data = 0x50;
-    spectrometer_generic_write( ctx, 0x08, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x09, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0A, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0B, &write_data, 1 );
-    write_data = 0x20;
-    spectrometer_generic_write( ctx, 0x0C, &write_data, 1 );
-    write_data = 0x04;
-    spectrometer_generic_write( ctx, 0x0D, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x0E, &write_data, 1 );
-    write_data = 0x30;
-    spectrometer_generic_write( ctx, 0x0f, &write_data, 1 );
-    write_data = 0x01;
-    spectrometer_generic_write( ctx, 0x10, &write_data, 1 );
-    write_data = 0x50;
-    spectrometer_generic_write( ctx, 0x11, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x12, &write_data, 1 );
-    write_data = 0x06;
-    spectrometer_generic_write( ctx, 0x13, &write_data, 1 );
+    spectrometer_load_smux( ctx, SPECTROMETER_SMUX_MAP_F1F4 );
 }
 
 // SMUX Config for F5,F6,F7,F8,NIR,Clear
 void spectrometer_f5f8_clr_nir ( spectrometer_t *ctx )
 {
-    uint8_t write_data;
-
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x00, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x01, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x02, &write_data, 1 );
-    write_data = 0x40;
-    spectrometer_generic_write( ctx, 0x03, &write_data, 1 );
-    write_data = 0x02;
-    spectrometer_generic_write( ctx, 0x04, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x05, &write_data, 1 );
-    write_data = 0x10;
-    spectrometer_generic_write( ctx, 0x06, &write_data, 1 );
-    write_data = 0x03;
-    spectrometer_generic_write( ctx, 0x07, &write_data, 1 );
-    write_data = 0x50;
-    spectrometer_generic_write( ctx, 0x08, &write_data, 1 );
-    write_data = 0x10;
-    spectrometer_generic_write( ctx, 0x09, &write_data, 1 );
-    write_data = 0x03;
-    spectrometer_generic_write( ctx, 0x0A, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x0B, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0C, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0D, &write_data, 1 );
-    write_data = 0x24;
-    spectrometer_generic_write( ctx, 0x0E, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x0f, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x10, &write_data, 1 );
-    write_data = 0x50;
-    spectrometer_generic_write( ctx, 0x11, &write_data, 1 );
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x12, &write_data, 1 );
-    write_data = 0x06;
-    spectrometer_generic_write( ctx, 0x13, &write_data, 1 );
+    spectrometer_load_smux( ctx, SPECTROMETER_SMUX_MAP_F5F8 );
 }
 
 void spectrometer_fd_cfg ( spectrometer_t *ctx )
 {
-    uint8_t write_data;
-
-    write_data = 0x00;
-    spectrometer_generic_write( ctx, 0x00, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x01, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x02, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x03, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x04, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x05, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x06, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x07, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x08, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x09, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0A, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0B, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0C, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0D, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0E, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x0F, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x10, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x11, &write_data, 1 );
-    spectrometer_generic_write( ctx, 0x12, &write_data, 1 );
-    write_data = 0x60;
-    spectrometer_generic_write( ctx, 0x13, &write_data, 1 );
+    spectrometer_load_smux( ctx, SPECTROMETER_SMUX_MAP_FD );
 }
 
 // Select Register bank
@@ -291,70 +228,51 @@ void spectrometer_reg_bank_cfg ( spectrometer_t *ctx, uint8_t reg_bank )
 void spectrometer_def_cfg ( spectrometer_t *ctx )
 {
     uint8_t write_data;
+    uint8_t astep[ 2 ];
 
     write_data = 0x64;
     spectrometer_generic_write( ctx, SPECTROMETER_ATIME, &write_data, 1 );
-    write_data = 0xE7;
-    spectrometer_generic_write( ctx, SPECTROMETER_ASTEP_L, &write_data, 1 );
-    write_data = 0x03;
-    spectrometer_generic_write( ctx, SPECTROMETER_ASTEP_L, &write_data, 1 );
+    astep[ 0 ] = 0xE7;
+    astep[ 1 ] = 0x03;
+    spectrometer_generic_write( ctx, SPECTROMETER_ASTEP_L, astep, 2 );
     write_data = SPECTROMETER_CFG_1_AGAIN_256;
     spectrometer_generic_write( ctx, SPECTROMETER_CFG_1, &write_data, 1 );
 }
 
 void spectrometer_raw_rd_val_mode_1 ( spectrometer_t *ctx, uint8_t *adc_data )
 {
-    uint8_t write_data;
-    uint8_t smux_stat = 1;
-    uint8_t data_ready = 0;
-
-    spectrometer_pon( ctx );
-    write_data = SPECTROMETER_CFG_6_SMUX_CMD_2;
-    spectrometer_generic_write( ctx, SPECTROMETER_CFG_6, &write_data, 1 );
-    spectrometer_f1f4_clr_nir( ctx );
-    spectrometer_smux_en( ctx );
+    uint8_t rx_buf[ 13 ];
+    uint8_t cnt;
+    SPECTROMETER_RETVAL error_flag;
 
-    while( smux_stat != 0 )
+    if ( !ctx->acq_ready )
     {
-        smux_stat = spectrometer_get_smux_en( ctx );
+        spectrometer_acq_setup( ctx );
     }
+    error_flag = spectrometer_acq_capture( ctx, SPECTROMETER_SMUX_MAP_F1F4, rx_buf );
 
-    spectrometer_sp_en( ctx, 1 );
-
-    while ( data_ready != 1 )
+    for ( cnt = 0; cnt < 12; cnt++ )
     {
-        data_ready = spectrometer_get_data_ready( ctx );
+        adc_data[ cnt ] = ( error_flag == SPECTROMETER_OK ) ? rx_buf[ cnt + 1 ] : 0;
     }
-
-    spectrometer_generic_read ( ctx, SPECTROMETER_CH0_ADC_DATA_L, adc_data, 12 );
 }
 
 void spectrometer_raw_rd_val_mode_2 ( spectrometer_t *ctx, uint8_t *adc_data )
 {
-    uint8_t write_data;
-    uint8_t smux_stat = 1;
-    uint8_t data_ready = 0;
-
-    spectrometer_pon( ctx );
-    spectrometer_sp_en( ctx, 0 );
-    write_data = SPECTROMETER_CFG_6_SMUX_CMD_2;
-    spectrometer_generic_write( ctx, SPECTROMETER_CFG_6, &write_data, 1 );
-    spectrometer_f5f8_clr_nir( ctx );
-    spectrometer_smux_en( ctx );
+    uint8_t rx_buf[ 13 ];
+    uint8_t cnt;
+    SPECTROMETER_RETVAL error_flag;
 
-    while( smux_stat != 0 )
+    if ( !ctx->acq_ready )
     {
-        smux_stat = spectrometer_get_smux_en( ctx );
+        spectrometer_acq_setup( ctx );
     }
+    error_flag = spectrometer_acq_capture( ctx, SPECTROMETER_SMUX_MAP_F5F8, rx_buf );
 
-    spectrometer_sp_en( ctx, 1 );
-
-    while ( data_ready != 1 )
+    for ( cnt = 0; cnt < 12; cnt++ )
     {
-        data_ready = spectrometer_get_data_ready( ctx );
+        adc_data[ cnt ] = ( error_flag == SPECTROMETER_OK ) ? rx_buf[ cnt + 1 ] : 0;
     }
-
-    spectrometer_generic_read ( ctx, SPECTROMETER_CH0_ADC_DATA_L, adc_data, 12 );
 }
 
 uint8_t spectrometer_flicker_detection ( spectrometer_t *ctx )
@@ -365,6 +283,7 @@ uint8_t spectrometer_flicker_detection ( spectrometer_t *ctx )
     
     write_data = 0x00;
     spectrometer_generic_write( ctx, SPECTROMETER_ENABLE, &write_data, 1 );
+    ctx->acq_ready = 0;
     spectrometer_pon( ctx );
     write_data = SPECTROMETER_CFG_6_SMUX_CMD_2;
     spectrometer_generic_write( ctx, SPECTROMETER_CFG_6, &write_data, 1 );
@@ -414,5 +333,170 @@ uint8_t spectrometer_get_int ( spectrometer_t *ctx )
     return digital_in_read( &ctx->int_pin );
 }
 
+SPECTROMETER_RETVAL spectrometer_acq_setup ( spectrometer_t *ctx )
+{
+    uint8_t rx_buf[ 2 ];
+    uint8_t status;
+
+    spectrometer_write_reg( ctx, SPECTROMETER_ENABLE, SPECTROMETER_EN_PON );
+    Delay_500us( );
+
+    spectrometer_generic_read( ctx, SPECTROMETER_ATIME, &ctx->atime, 1 );
+    spectrometer_generic_read( ctx, SPECTROMETER_ASTEP_L, rx_buf, 2 );
+    ctx->astep = ( ( uint16_t ) rx_buf[ 1 ] << 8 ) | rx_buf[ 0 ];
+
+    // Interrupt on SMUX completion and on every spectral cycle, cleared by reading STATUS.
+    spectrometer_write_reg( ctx, SPECTROMETER_CFG_6, SPECTROMETER_CFG_6_SMUX_CMD_2 );
+    spectrometer_write_reg( ctx, SPECTROMETER_CFG_3, SPECTROMETER_CFG_3_INT_READ_CLEAR );
+    spectrometer_write_reg( ctx, SPECTROMETER_CFG_9, SPECTROMETER_CFG_9_SIEN_SMUX );
+    spectrometer_write_reg( ctx, SPECTROMETER_PERS, SPECTROMETER_PERS_APERS );
+    spectrometer_write_reg( ctx, SPECTROMETER_INTENAB, SPECTROMETER_INTENAB_SP_IEN | 
+                                                       SPECTROMETER_INTENAB_SIEN );
+    spectrometer_generic_read( ctx, SPECTROMETER_STATUS, &status, 1 );
+
+    ctx->smux_map = SPECTROMETER_SMUX_MAP_NONE;
+    ctx->acq_ready = 1;
+
+    return SPECTROMETER_OK;
+}
+
+SPECTROMETER_RETVAL spectrometer_acq_capture ( spectrometer_t *ctx, uint8_t smux_map, uint8_t *adc_data )
+{
+    SPECTROMETER_RETVAL error_flag;
+
+    if ( smux_map != ctx->smux_map )
+    {
+        spectrometer_load_smux( ctx, smux_map );
+        spectrometer_write_reg( ctx, SPECTROMETER_ENABLE, SPECTROMETER_EN_PON | SPECTROMETER_EN_SMUXEN );
+        error_flag = spectrometer_wait_status( ctx, SPECTROMETER_STATUS_SINT );
+        if ( error_flag != SPECTROMETER_OK )
+        {
+            ctx->smux_map = SPECTROMETER_SMUX_MAP_NONE;
+            return error_flag;
+        }
+        ctx->smux_map = smux_map;
+    }
+
+    spectrometer_write_reg( ctx, SPECTROMETER_ENABLE, SPECTROMETER_EN_PON | SPECTROMETER_EN_SP_EN );
+    error_flag = spectrometer_wait_status( ctx, SPECTROMETER_STATUS_AINT );
+
+    // SMUX can only run with the measurement stopped, power stays on.
+    spectrometer_write_reg( ctx, SPECTROMETER_ENABLE, SPECTROMETER_EN_PON );
+    if ( error_flag != SPECTROMETER_OK )
+    {
+        return error_flag;
+    }
+
+    // Reading ASTATUS latches the channel data read in the same transaction.
+    spectrometer_generic_read( ctx, SPECTROMETER_ASTATUS, adc_data, 13 );
+
+    return SPECTROMETER_OK;
+}
+
+SPECTROMETER_RETVAL spectrometer_read_spectrum ( spectrometer_t *ctx, spectrometer_spectrum_t *spectrum )
+{
+    uint8_t rx_buf[ 2 ][ 13 ];
+    uint16_t ch[ 2 ][ 6 ];
+    SPECTROMETER_RETVAL error_flag;
+    uint8_t half;
+    uint8_t cnt;
+
+    if ( !ctx->acq_ready )
+    {
+        spectrometer_acq_setup( ctx );
+    }
+
+    // Start with the map left loaded by the previous call to save a SMUX run.
+    half = ( ctx->smux_map == SPECTROMETER_SMUX_MAP_F5F8 );
+    error_flag = spectrometer_acq_capture( ctx, half ? SPECTROMETER_SMUX_MAP_F5F8 : 
+                                                       SPECTROMETER_SMUX_MAP_F1F4, rx_buf[ half ] );
+    if ( error_flag == SPECTROMETER_OK )
+    {
+        half ^= 1;
+        error_flag = spectrometer_acq_capture( ctx, half ? SPECTROMETER_SMUX_MAP_F5F8 : 
+                                                           SPECTROMETER_SMUX_MAP_F1F4, rx_buf[ half ] );
+    }
+    if ( error_flag != SPECTROMETER_OK )
+    {
+        return error_flag;
+    }
+
+    for ( half = 0; half < 2; half++ )
+    {
+        for ( cnt = 0; cnt < 6; cnt++ )
+        {
+            ch[ half ][ cnt ] = ( ( uint16_t ) rx_buf[ half ][ cnt * 2 + 2 ] << 8 ) | 
+                                rx_buf[ half ][ cnt * 2 + 1 ];
+        }
+    }
+    for ( cnt = 0; cnt < 4; cnt++ )
+    {
+        spectrum->ch[ SPECTROMETER_CH_F1 + cnt ] = ch[ 0 ][ cnt ];
+        spectrum->ch[ SPECTROMETER_CH_F5 + cnt ] = ch[ 1 ][ cnt ];
+    }
+    spectrum->ch[ SPECTROMETER_CH_CLEAR ] = ( ( uint32_t ) ch[ 0 ][ 4 ] + ch[ 1 ][ 4 ] + 1 ) / 2;
+    spectrum->ch[ SPECTROMETER_CH_NIR ] = ( ( uint32_t ) ch[ 0 ][ 5 ] + ch[ 1 ][ 5 ] + 1 ) / 2;
+    spectrum->again = rx_buf[ 1 ][ 0 ] & SPECTROMETER_ASTATUS_AGAIN_MASK;
+    spectrum->saturated = ( ( rx_buf[ 0 ][ 0 ] | rx_buf[ 1 ][ 0 ] ) & SPECTROMETER_STATUS_ASAT ) != 0;
+
+    return SPECTROMETER_OK;
+}
+
+uint32_t spectrometer_basic_counts ( spectrometer_t *ctx, uint16_t raw, uint8_t again )
+{
+    uint32_t steps = ( ( uint32_t ) ctx->atime + 1 ) * ( ( uint32_t ) ctx->astep + 1 );
+    uint32_t tmp = raw * SPECTROMETER_BASIC_COUNTS_STEP;
+    uint32_t quot = tmp / steps;
+    uint32_t basic;
+
+    // raw * 1000 / ( gain * steps * 2.78 us ), gain being 2^again / 2, kept within 32 bits.
+    if ( quot > ( 0xFFFFFFFFul / 20 ) )
+    {
+        return 0xFFFFFFFFul;
+    }
+    basic = quot * 20 + ( ( tmp % steps ) * 20 ) / steps;
+
+    return basic >> again;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void spectrometer_write_reg ( spectrometer_t *ctx, uint8_t reg, uint8_t reg_val )
+{
+    spectrometer_generic_write( ctx, reg, &reg_val, 1 );
+}
+
+static void spectrometer_load_smux ( spectrometer_t *ctx, uint8_t smux_map )
+{
+    // SMUX RAM auto increments, the whole map goes in one transaction.
+    spectrometer_generic_write( ctx, SPECTROMETER_SMUX_RAM, ( uint8_t * ) SMUX_MAP[ smux_map ], 
+                                SPECTROMETER_SMUX_RAM_SIZE );
+}
+
+static SPECTROMETER_RETVAL spectrometer_wait_status ( spectrometer_t *ctx, uint8_t status_mask )
+{
+    uint16_t timeout_cnt = 0;
+    uint8_t status = 0;
+
+    for ( ; ; )
+    {
+        // INT is active low, STATUS is polled every few ms in case it is not wired.
+        if ( ( 0 == digital_in_read( &ctx->int_pin ) ) || 
+             ( 0 == ( timeout_cnt % SPECTROMETER_ACQ_POLL_MS ) ) )
+        {
+            spectrometer_generic_read( ctx, SPECTROMETER_STATUS, &status, 1 );
+            if ( status & status_mask )
+            {
+                return SPECTROMETER_OK;
+            }
+        }
+        if ( ++timeout_cnt > ctx->acq_timeout_ms )
+        {
+            return SPECTROMETER_TIMEOUT_ERROR;
+        }
+        Delay_1ms( );
+    }
+}
+
 // ------------------------------------------------------------------------- END
 
@@ -316,20 +316,10 @@ uint8_t spiextend_rmt_read ( spiextend_t *ctx, uint8_t reg, uint8_t sel_slave )
 }
 
 void spiextend_rmt_multi_write ( spiextend_t *ctx, uint8_t reg, uint8_t *p_tx_data, uint16_t n_bytes, uint8_t sel_slave ) {
-    
-    uint16_t n_cnt;
-    uint8_t tx_buf[ 10000 ];
-
-    tx_buf[ 0 ] = reg;
 
-    for ( n_cnt = 0; n_cnt < n_bytes; n_cnt++ ) {
-       
-        tx_buf[ n_cnt + 1 ] = p_tx_data[ n_cnt ];
-    }
-
-    
     dev_start_spi_transfer( ctx, sel_slave );
-    spi_master_write( &ctx->spi, tx_buf, n_bytes + 1);
+    spi_master_write( &ctx->spi, &reg, 1 );
+    spi_master_write( &ctx->spi, p_tx_data, n_bytes );
     dev_stop_spi_transfer( ctx, sel_slave );
 }
 
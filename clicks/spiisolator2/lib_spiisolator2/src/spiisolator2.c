@@ -85,14 +85,9 @@ err_t spiisolator2_init ( spiisolator2_t *ctx, spiisolator2_cfg_t *cfg )
 
 err_t spiisolator2_generic_write ( spiisolator2_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) 
 {
-    uint8_t tx_buf[ 256 ] = { 0 };
-    tx_buf[ 0 ] = reg;
-    for ( uint8_t cnt = 0; cnt < len; cnt++ ) 
-    {
-        tx_buf[ cnt + 1 ] = data_in[ cnt ];
-    }
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, &reg, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
     return error_flag;
 }
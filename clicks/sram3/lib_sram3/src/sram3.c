@@ -106,16 +106,13 @@ err_t sram3_init ( sram3_t *ctx, sram3_cfg_t *cfg ) {
 }
 
 err_t sram3_generic_write ( sram3_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) {
-    uint8_t tx_buf[ 257 ] = { 0 };
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ] = { 0 };
 
     tx_buf[ 0 ] = reg;
-    for ( cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
     return error_flag;
 }
@@ -294,39 +291,31 @@ err_t sram3_secure_read( sram3_t *ctx, uint32_t mem_adr, uint8_t *read_buf, uint
 }
 
 void sram3_write( sram3_t *ctx, uint32_t mem_adr, uint8_t *write_buf, uint8_t buf_size ) {   
-    uint8_t tx_buf[ 260 ] = { 0 };
-    uint16_t cnt = 0;
+    uint8_t tx_buf[ 4 ] = { 0 };
     
     tx_buf[ 0 ] = SRAM3_OPCODE_WRITE;
     tx_buf[ 1 ] = mem_adr >> 16;
     tx_buf[ 2 ] = mem_adr >> 8;
     tx_buf[ 3 ] = mem_adr;
-
-    for( cnt = 0 ; cnt < buf_size; cnt++ ) {        
-        tx_buf[ cnt + 4 ] = write_buf[ cnt ];
-    }
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, buf_size + 4 );
+    spi_master_write( &ctx->spi, tx_buf, 4 );
+    spi_master_write( &ctx->spi, write_buf, buf_size );
     spi_master_deselect_device( ctx->chip_select );
 }
 
 err_t sram3_secure_write( sram3_t *ctx, uint32_t mem_adr, uint8_t *write_buf, uint8_t buf_size ) {    
-    uint8_t tx_buf[ 260 ] = { 0 };
-    uint16_t cnt = 0;
+    uint8_t tx_buf[ 4 ] = { 0 };
     err_t err_flag;
     
     tx_buf[ 0 ] = SRAM3_OPCODE_SECURE_WRITE;
     tx_buf[ 1 ] = mem_adr >> 16;
     tx_buf[ 2 ] = mem_adr >> 8;
     tx_buf[ 3 ] = mem_adr;
-
-    for( cnt = 0 ; cnt < buf_size; cnt++ ) {
-        tx_buf[ cnt + 4 ] = write_buf[ cnt ];
-    }
     
     spi_master_select_device( ctx->chip_select );
-    spi_master_write( &ctx->spi, tx_buf, buf_size + 4 );
+    spi_master_write( &ctx->spi, tx_buf, 4 );
+    spi_master_write( &ctx->spi, write_buf, buf_size );
     spi_master_deselect_device( ctx->chip_select );    
         return err_flag;
 }
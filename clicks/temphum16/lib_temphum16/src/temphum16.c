@@ -528,8 +528,8 @@ static err_t temphum16_i2c_write ( temphum16_t *ctx, uint8_t reg, uint8_t *data_
         tx_buf[ 0 ] |= I2C_AUTO_INCREMENT_RW_BIT;   
     }
 
-    for ( cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
+    for ( cnt = 0; cnt < len; cnt++ ) {
+        tx_buf[ cnt + 1 ] = data_in[ cnt ];
     }
 
     return i2c_master_write( &ctx->i2c, tx_buf, len + 1 );
@@ -544,17 +544,14 @@ static err_t temphum16_i2c_read ( temphum16_t *ctx, uint8_t reg, uint8_t *data_o
 }
 
 static err_t temphum16_spi_write ( temphum16_t *ctx, uint8_t reg, uint8_t *data_in, uint8_t len ) {
-    uint8_t tx_buf[ 257 ];
-    uint8_t cnt;
+    uint8_t tx_buf[ 1 ];
 
     tx_buf[ 0 ] = reg;
     tx_buf[ 0 ] &= SPI_WRITE_BIT;
-    for ( cnt = 1; cnt <= len; cnt++ ) {
-        tx_buf[ cnt ] = data_in[ cnt - 1 ];
-    }
 
     spi_master_select_device( ctx->chip_select );
-    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, len + 1 );
+    err_t error_flag = spi_master_write( &ctx->spi, tx_buf, 1 );
+    error_flag |= spi_master_write( &ctx->spi, data_in, len );
     spi_master_deselect_device( ctx->chip_select );
 Delay_1ms( );
     return error_flag;
@@ -94,9 +94,9 @@ void temphum8_generic_write ( temphum8_t *ctx, uint8_t reg, uint8_t *data_buffer
     
     tx_buf[ 0 ] = reg;
     
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buf[ cnt ] = data_buffer[ cnt - 1 ]; 
+        tx_buf[ cnt + 1 ] = data_buffer[ cnt ]; 
     }
     
     i2c_master_write( &ctx->i2c, tx_buf, len + 1 );   
@@ -94,9 +94,9 @@ void thermo15_generic_write ( thermo15_t *ctx, uint8_t reg, uint8_t *data_buffer
 
     tx_buffer[ 0 ] = reg;
 
-    for ( cnt = 1; cnt <= len; cnt++ )
+    for ( cnt = 0; cnt < len; cnt++ )
     {
-        tx_buffer[ cnt ] = data_buffer[ cnt - 1 ];
+        tx_buffer[ cnt + 1 ] = data_buffer[ cnt ];
     }
 
     i2c_master_write( &ctx->i2c, tx_buffer, len + 1 );
@@ -160,6 +160,22 @@ extern "C"{
 #define THERMO19_DEFAULT_TEMP_HIGH_ALARM            0xFFFF
 #define THERMO19_DEFAULT_TEMP_LOW_ALARM             0x0000
 
+/**
+ * @brief Thermo 19 conversion timing values.
+ * @details Specified conversion polling timing values of Thermo 19 Click driver.
+ */
+#define THERMO19_CONVERSION_TIMEOUT_MS              400
+#define THERMO19_CONVERSION_DONE                    0x00
+
+/**
+ * @brief Thermo 19 network settings.
+ * @details Specified 1-Wire network settings of Thermo 19 Click driver.
+ * @note Increase the number of devices if needed.
+ */
+#define THERMO19_NET_MAX_DEVICES                    20
+#define THERMO19_NET_DEVICE_VALID                   0x01
+#define THERMO19_NET_DEVICE_INVALID                 0x00
+
 /*! @} */ // thermo19_set
 
 /**
@@ -239,6 +255,20 @@ typedef enum
 
 } thermo19_return_value_t;
 
+/**
+ * @brief Thermo 19 Click 1-Wire network object.
+ * @details 1-Wire network object definition of Thermo 19 Click driver, holds the cached
+ * ROM addresses and the last temperatures of all devices found on the bus.
+ */
+typedef struct
+{
+    one_wire_rom_address_t rom_addr[ THERMO19_NET_MAX_DEVICES ];    /**< ROM addresses of devices. */
+    float temperature[ THERMO19_NET_MAX_DEVICES ];                  /**< Last temperatures in Celsius. */
+    uint8_t valid[ THERMO19_NET_MAX_DEVICES ];                      /**< Last scratchpad read valid flags. */
+    uint8_t num_devices;                                            /**< Number of devices found. */
+
+} thermo19_net_t;
+
 /*!
  * @addtogroup thermo19 Thermo 19 Click Driver
  * @brief API for configuring and manipulating Thermo 19 Click driver.
@@ -392,6 +422,78 @@ err_t thermo19_read_temperature ( thermo19_t *ctx, float *temperature );
  */
 uint8_t thermo19_get_alert_pin ( thermo19_t *ctx );
 
+/**
+ * @brief Thermo 19 wait conversion function.
+ * @details This function polls read time slots until the devices report the end of the
+ * temperature conversion, instead of waiting for the worst case conversion time.
+ * @param[in] ctx : Click context object.
+ * See #thermo19_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Returns error if the conversion has not finished within THERMO19_CONVERSION_TIMEOUT_MS.
+ * Read slot polling requires devices with external supply, not parasite power.
+ */
+err_t thermo19_wait_conversion ( thermo19_t *ctx );
+
+/**
+ * @brief Thermo 19 network search function.
+ * @details This function enumerates all Thermo 19 devices on the bus by using the Search ROM
+ * command and caches their ROM addresses.
+ * @param[in] ctx : Click context object.
+ * See #thermo19_t object definition for detailed explanation.
+ * @param[out] net : 1-Wire network object.
+ * See #thermo19_net_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Devices with a ROM CRC error or a different family code are skipped.
+ */
+err_t thermo19_net_search ( thermo19_t *ctx, thermo19_net_t *net );
+
+/**
+ * @brief Thermo 19 network start conversion function.
+ * @details This function starts the temperature conversion on all devices at once by
+ * broadcasting the Convert Temperature command with the Skip ROM command.
+ * @param[in] ctx : Click context object.
+ * See #thermo19_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t thermo19_net_start_conversion ( thermo19_t *ctx );
+
+/**
+ * @brief Thermo 19 network read temperatures function.
+ * @details This function reads the scratchpads of all cached devices back-to-back by using
+ * the Match ROM command and updates their temperatures and valid flags.
+ * @param[in] ctx : Click context object.
+ * See #thermo19_t object definition for detailed explanation.
+ * @param[in,out] net : 1-Wire network object.
+ * See #thermo19_net_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note Returns error if any of the scratchpads failed the CRC check.
+ */
+err_t thermo19_net_read_temperatures ( thermo19_t *ctx, thermo19_net_t *net );
+
+/**
+ * @brief Thermo 19 network update function.
+ * @details This function updates the temperatures of all cached devices within a single
+ * conversion time: broadcast conversion, read slot polling, and back-to-back scratchpad reads.
+ * @param[in] ctx : Click context object.
+ * See #thermo19_t object definition for detailed explanation.
+ * @param[in,out] net : 1-Wire network object.
+ * See #thermo19_net_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t thermo19_net_update ( thermo19_t *ctx, thermo19_net_t *net );
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,30 @@
 
 #include "thermo19.h"
 
+/**
+ * @brief Maxim CRC 8 lookup table.
+ * @details Table for the reflected 0x8C polynomial used by the 1-Wire ROM and scratchpad CRC.
+ */
+static const uint8_t thermo19_crc8_maxim_table[ 256 ] =
+{
+    0x00, 0x5E, 0xBC, 0xE2, 0x61, 0x3F, 0xDD, 0x83, 0xC2, 0x9C, 0x7E, 0x20, 0xA3, 0xFD, 0x1F, 0x41,
+    0x9D, 0xC3, 0x21, 0x7F, 0xFC, 0xA2, 0x40, 0x1E, 0x5F, 0x01, 0xE3, 0xBD, 0x3E, 0x60, 0x82, 0xDC,
+    0x23, 0x7D, 0x9F, 0xC1, 0x42, 0x1C, 0xFE, 0xA0, 0xE1, 0xBF, 0x5D, 0x03, 0x80, 0xDE, 0x3C, 0x62,
+    0xBE, 0xE0, 0x02, 0x5C, 0xDF, 0x81, 0x63, 0x3D, 0x7C, 0x22, 0xC0, 0x9E, 0x1D, 0x43, 0xA1, 0xFF,
+    0x46, 0x18, 0xFA, 0xA4, 0x27, 0x79, 0x9B, 0xC5, 0x84, 0xDA, 0x38, 0x66, 0xE5, 0xBB, 0x59, 0x07,
+    0xDB, 0x85, 0x67, 0x39, 0xBA, 0xE4, 0x06, 0x58, 0x19, 0x47, 0xA5, 0xFB, 0x78, 0x26, 0xC4, 0x9A,
+    0x65, 0x3B, 0xD9, 0x87, 0x04, 0x5A, 0xB8, 0xE6, 0xA7, 0xF9, 0x1B, 0x45, 0xC6, 0x98, 0x7A, 0x24,
+    0xF8, 0xA6, 0x44, 0x1A, 0x99, 0xC7, 0x25, 0x7B, 0x3A, 0x64, 0x86, 0xD8, 0x5B, 0x05, 0xE7, 0xB9,
+    0x8C, 0xD2, 0x30, 0x6E, 0xED, 0xB3, 0x51, 0x0F, 0x4E, 0x10, 0xF2, 0xAC, 0x2F, 0x71, 0x93, 0xCD,
+    0x11, 0x4F, 0xAD, 0xF3, 0x70, 0x2E, 0xCC, 0x92, 0xD3, 0x8D, 0x6F, 0x31, 0xB2, 0xEC, 0x0E, 0x50,
+    0xAF, 0xF1, 0x13, 0x4D, 0xCE, 0x90, 0x72, 0x2C, 0x6D, 0x33, 0xD1, 0x8F, 0x0C, 0x52, 0xB0, 0xEE,
+    0x32, 0x6C, 0x8E, 0xD0, 0x53, 0x0D, 0xEF, 0xB1, 0xF0, 0xAE, 0x4C, 0x12, 0x91, 0xCF, 0x2D, 0x73,
+    0xCA, 0x94, 0x76, 0x28, 0xAB, 0xF5, 0x17, 0x49, 0x08, 0x56, 0xB4, 0xEA, 0x69, 0x37, 0xD5, 0x8B,
+    0x57, 0x09, 0xEB, 0xB5, 0x36, 0x68, 0x8A, 0xD4, 0x95, 0xCB, 0x29, 0x77, 0xF4, 0xAA, 0x48, 0x16,
+    0xE9, 0xB7, 0x55, 0x0B, 0x88, 0xD6, 0x34, 0x6A, 0x2B, 0x75, 0x97, 0xC9, 0x4A, 0x14, 0xF6, 0xA8,
+    0x74, 0x2A, 0xC8, 0x96, 0x15, 0x4B, 0xA9, 0xF7, 0xB6, 0xE8, 0x0A, 0x54, 0xD7, 0x89, 0x6B, 0x35
+};
+
 /** 
  * @brief Calculation for Maxim CRC 8 function.
  * @details This function calculates Maxim CRC 8 with parameteres: 
@@ -43,6 +67,21 @@
  */
 static uint8_t thermo19_calculate_crc8_maxim( uint8_t *data_buf, uint8_t len );
 
+/** 
+ * @brief Thermo 19 read device scratchpad function.
+ * @details This function selects the device with the Match ROM command and reads its
+ * scratchpad bytes with CRC check.
+ * @param[in] ctx : Click context object.
+ * See #thermo19_t object definition for detailed explanation.
+ * @param[in] rom_addr : ROM address of the device.
+ * @param[out] scratchpad : Scratchpad [8-bytes] of the device.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+static err_t thermo19_read_device_scratchpad ( thermo19_t *ctx, one_wire_rom_address_t *rom_addr, uint8_t *scratchpad );
+
 void thermo19_cfg_setup ( thermo19_cfg_t *cfg ) 
 {
     // Communication gpio pins
@@ -174,74 +213,127 @@ err_t thermo19_read_temperature ( thermo19_t *ctx, float *temperature )
 {
     err_t error_flag = THERMO19_OK;
     error_flag |= thermo19_start_measurement( ctx );
-    // Wait for temperature conversion to be done.
-    switch ( ctx->config & THERMO19_CONFIG_RESOLUTION_BIT_MASK )
+    error_flag |= thermo19_wait_conversion( ctx );
+    uint8_t scratchpad[ 8 ];
+    error_flag |= thermo19_read_scratchpad ( ctx, scratchpad );
+    int16_t raw_temp = ( ( int16_t ) scratchpad[ 1 ] << 8 ) | scratchpad[ 0 ];
+    *temperature = raw_temp * THERMO19_DATA_RESOLUTION;
+    return error_flag;
+}
+
+uint8_t thermo19_get_alert_pin ( thermo19_t *ctx )
+{
+    return digital_in_read ( &ctx->alt );
+}
+
+err_t thermo19_wait_conversion ( thermo19_t *ctx )
+{
+    uint8_t slots = THERMO19_CONVERSION_DONE;
+    for ( uint16_t cnt = 0; cnt < THERMO19_CONVERSION_TIMEOUT_MS; cnt++ )
     {
-        case THERMO19_CONFIG_RESOLUTION_8BIT:
+        // Devices hold the read slots low until the conversion is done.
+        if ( ONE_WIRE_ERROR == one_wire_read_byte( &ctx->ow, &slots, 1 ) )
         {
-            // At least 20ms delay is required for conversion                                    
-            Delay_10ms();
-            Delay_10ms();
-            Delay_10ms();                        
-            break;
+            return THERMO19_ERROR;
         }
-        case THERMO19_CONFIG_RESOLUTION_9BIT:
+        if ( THERMO19_CONVERSION_DONE != slots )
         {
-            // At least 40ms delay is required for conversion                        
-            Delay_10ms();
-            Delay_10ms();
-            Delay_10ms(); 
-            Delay_10ms(); 
-            Delay_10ms();             
-            break;
-        }
-        case THERMO19_CONFIG_RESOLUTION_10BIT:
-        {            
-            // At least 80ms delay is required for conversion
-            Delay_100ms();                        
-            break;
+            return THERMO19_OK;
         }
-        case THERMO19_CONFIG_RESOLUTION_12BIT:
+        Delay_1ms( );
+    }
+    return THERMO19_ERROR;
+}
+
+err_t thermo19_net_search ( thermo19_t *ctx, thermo19_net_t *net )
+{
+    one_wire_rom_address_t rom_addr;
+    err_t search_flag = one_wire_search_first_device ( &ctx->ow, &rom_addr );
+    net->num_devices = 0;
+    while ( ( ONE_WIRE_ERROR != search_flag ) && ( net->num_devices < THERMO19_NET_MAX_DEVICES ) )
+    {
+        if ( ( THERMO19_FAMILY_CODE == rom_addr.address[ 0 ] ) && 
+             ( rom_addr.address[ 7 ] == thermo19_calculate_crc8_maxim ( rom_addr.address, 7 ) ) )
         {
-            // At least 320ms delay is required for conversion                        
-            Delay_100ms( );
-            Delay_100ms( );
-            Delay_100ms( );
-            Delay_100ms();                                                
-            break;
+            memcpy ( &net->rom_addr[ net->num_devices ], &rom_addr, sizeof ( one_wire_rom_address_t ) );
+            net->valid[ net->num_devices ] = THERMO19_NET_DEVICE_INVALID;
+            net->temperature[ net->num_devices ] = 0;
+            net->num_devices++;
         }
+        search_flag = one_wire_search_next_device ( &ctx->ow, &rom_addr );
     }
+    if ( 0 == net->num_devices )
+    {
+        return THERMO19_ERROR;
+    }
+    return THERMO19_OK;
+}
+
+err_t thermo19_net_start_conversion ( thermo19_t *ctx )
+{
+    err_t error_flag = THERMO19_OK;
+    uint8_t command = THERMO19_CMD_CONVERT_TEMPERATURE;
+    error_flag |= one_wire_skip_rom( &ctx->ow );
+    error_flag |= one_wire_write_byte( &ctx->ow, &command, 1 );
+    return error_flag;
+}
+
+err_t thermo19_net_read_temperatures ( thermo19_t *ctx, thermo19_net_t *net )
+{
+    err_t error_flag = THERMO19_OK;
     uint8_t scratchpad[ 8 ];
-    error_flag |= thermo19_read_scratchpad ( ctx, scratchpad );
-    int16_t raw_temp = ( ( int16_t ) scratchpad[ 1 ] << 8 ) | scratchpad[ 0 ];
-    *temperature = raw_temp * THERMO19_DATA_RESOLUTION;
+    for ( uint8_t cnt = 0; cnt < net->num_devices; cnt++ )
+    {
+        net->valid[ cnt ] = THERMO19_NET_DEVICE_INVALID;
+        if ( THERMO19_OK != thermo19_read_device_scratchpad ( ctx, &net->rom_addr[ cnt ], scratchpad ) )
+        {
+            error_flag = THERMO19_ERROR;
+            continue;
+        }
+        int16_t raw_temp = ( ( int16_t ) scratchpad[ 1 ] << 8 ) | scratchpad[ 0 ];
+        net->temperature[ cnt ] = raw_temp * THERMO19_DATA_RESOLUTION;
+        net->valid[ cnt ] = THERMO19_NET_DEVICE_VALID;
+    }
     return error_flag;
 }
 
-uint8_t thermo19_get_alert_pin ( thermo19_t *ctx )
+err_t thermo19_net_update ( thermo19_t *ctx, thermo19_net_t *net )
 {
-    return digital_in_read ( &ctx->alt );
+    if ( ( THERMO19_OK != thermo19_net_start_conversion ( ctx ) ) || 
+         ( THERMO19_OK != thermo19_wait_conversion ( ctx ) ) )
+    {
+        return THERMO19_ERROR;
+    }
+    return thermo19_net_read_temperatures ( ctx, net );
 }
 
 static uint8_t thermo19_calculate_crc8_maxim( uint8_t *data_buf, uint8_t len )
 {
     uint8_t crc = 0x00;
     
-    for ( uint8_t cnt_0 = 0; cnt_0 < len; cnt_0++ ) 
+    for ( uint8_t cnt = 0; cnt < len; cnt++ ) 
     {
-        uint8_t in_byte = data_buf[ cnt_0 ];
-        for ( uint8_t cnt_1 = 0; cnt_1 < 8; cnt_1++ ) 
-        {
-            uint8_t mix = ( crc ^ in_byte ) & 0x01;
-            crc >>= 1;
-            if ( 0 != mix ) 
-            {
-                crc ^= 0x8C;
-            }
-            in_byte >>= 1;
-        }
+        crc = thermo19_crc8_maxim_table[ crc ^ data_buf[ cnt ] ];
     }
     return crc;
 }
 
+static err_t thermo19_read_device_scratchpad ( thermo19_t *ctx, one_wire_rom_address_t *rom_addr, uint8_t *scratchpad )
+{
+    err_t error_flag = THERMO19_OK;
+    uint8_t data_buf[ 9 ];
+    uint8_t command = THERMO19_CMD_READ_SCRATCHPAD;
+    
+    error_flag |= one_wire_match_rom( &ctx->ow, rom_addr );
+    error_flag |= one_wire_write_byte( &ctx->ow, &command, 1 );
+    error_flag |= one_wire_read_byte( &ctx->ow, data_buf, 9 );
+
+    if ( ( THERMO19_OK == error_flag ) && ( data_buf[ 8 ] == thermo19_calculate_crc8_maxim ( data_buf, 8 ) ) )
+    {
+        memcpy ( scratchpad, data_buf, 8 );
+        return THERMO19_OK;
+    }
+    return THERMO19_ERROR;
+}
+
 // ------------------------------------------------------------------------- END
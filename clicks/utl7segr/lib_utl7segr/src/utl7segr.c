@@ -119,9 +119,6 @@ void utl7segr_default_cfg ( utl7segr_t *ctx ) {
 }
 
 err_t utl7segr_generic_write ( utl7segr_t *ctx, uint8_t *data_in ) {
-    uint8_t tx_buf[ 257 ];
-    uint8_t cnt;
-
     spi_master_select_device( ctx->chip_select );
     err_t error_flag = spi_master_write( &ctx->spi, data_in, 2 );
     spi_master_deselect_device( ctx->chip_select );
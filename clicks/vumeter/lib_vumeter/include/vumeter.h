@@ -87,6 +87,28 @@ extern "C"{
 #define VUMETER_VCC_3V3                     3.3
 #define VUMETER_VCC_5V                      5.0
 
+/**
+ * @brief VU Meter level engine settings.
+ * @details Specified settings of the block level engine of VU Meter Click driver.
+ */
+#define VUMETER_LEVEL_RING_SIZE             64  /**< Must be a power of two not above 128. */
+#define VUMETER_LEVEL_BLOCK_MAX             512
+#define VUMETER_LEVEL_DC_SHIFT              10
+#define VUMETER_LEVEL_COEF_SHIFT            10
+#define VUMETER_LEVEL_VU_TAU_MS             65.0
+#define VUMETER_LEVEL_PPM_ATTACK_TAU_MS     1.7
+#define VUMETER_LEVEL_PPM_RELEASE_DB_S      8.6
+#define VUMETER_LEVEL_PEAK_HOLD_MS          1500
+#define VUMETER_LEVEL_MIN_DBU               -60.0
+
+/**
+ * @brief VU Meter level engine meter selection.
+ * @details Specified meter selection of the block level engine of VU Meter Click driver.
+ */
+#define VUMETER_METER_VU                    0
+#define VUMETER_METER_PPM                   1
+#define VUMETER_METER_PEAK_HOLD             2
+
 /**
  * @brief Data sample selection.
  * @details This macro sets data samples for SPI modules.
@@ -172,6 +194,43 @@ typedef enum
 
 } vumeter_return_value_t;
 
+/**
+ * @brief VU Meter Click level engine object.
+ * @details Block level engine object definition of VU Meter Click driver. Samples are
+ * queued at a fixed rate and reduced per block to RMS and peak values in ADC counts,
+ * which drive the VU and PPM ballistics.
+ */
+typedef struct
+{
+    // Sample ring, free running indices with a single writer each
+    uint16_t ring[ VUMETER_LEVEL_RING_SIZE ];   /**< Raw ADC sample ring. */
+    volatile uint8_t ring_head;                 /**< Read index, written by process only. */
+    volatile uint8_t ring_tail;                 /**< Write index, written by push only. */
+    uint16_t overruns;                          /**< Samples dropped on full ring, written by push only. */
+
+    // Block accumulators
+    int32_t  dc_q8;                             /**< DC estimate, Q8 ADC counts. */
+    uint64_t sum_sq;                            /**< Sum of squares of the block. */
+    uint16_t block_peak;                        /**< Absolute peak of the block. */
+    uint16_t block_cnt;                         /**< Samples accumulated in the block. */
+    uint16_t block_len;                         /**< Samples per block. */
+
+    // Block results and ballistics
+    uint16_t rms;                               /**< RMS of the last block. */
+    uint16_t peak;                              /**< Peak of the last block. */
+    int32_t  vu_q8;                             /**< VU meter level, Q8 ADC counts RMS. */
+    int32_t  ppm_q8;                            /**< PPM level, Q8 ADC counts peak. */
+    int32_t  vu_coef;                           /**< VU integration coefficient. */
+    int32_t  ppm_attack;                        /**< PPM attack coefficient. */
+    int32_t  ppm_release;                       /**< PPM release coefficient. */
+    uint16_t peak_hold;                         /**< Held peak. */
+    uint16_t hold_blocks;                       /**< Peak hold time in blocks. */
+    uint16_t hold_cnt;                          /**< Blocks left until the held peak is released. */
+
+    float    lsb_voltage;                       /**< Voltage of one ADC count. */
+
+} vumeter_level_t;
+
 /*!
  * @addtogroup vumeter VU Meter Click Driver
  * @brief API for configuring and manipulating VU Meter Click driver.
@@ -262,6 +321,76 @@ err_t vumeter_set_gain_level ( vumeter_t *ctx, uint8_t gain_lvl );
  */
 float vumeter_calculate_vu_level ( vumeter_t *ctx, uint16_t sample_rate_ms );
 
+/**
+ * @brief VU Meter level engine init function.
+ * @details This function initializes the block level engine and its ballistics.
+ * @param[out] level : Level engine object.
+ * See #vumeter_level_t object definition for detailed explanation.
+ * @param[in] sample_rate : Sample rate in Hz of the fixed rate sampling.
+ * @param[in] block_len : Samples per block [1-512], the block time is the level update period.
+ * @param[in] lsb_voltage : Voltage of one ADC count, i.e. vref divided by the ADC range.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note None.
+ */
+err_t vumeter_level_init ( vumeter_level_t *level, uint16_t sample_rate, uint16_t block_len, float lsb_voltage );
+
+/**
+ * @brief VU Meter level engine push function.
+ * @details This function queues a raw sample to the level engine ring.
+ * @param[in,out] level : Level engine object.
+ * See #vumeter_level_t object definition for detailed explanation.
+ * @param[in] sample : Raw ADC sample.
+ * @return Nothing.
+ * @note Can be fed from any fixed rate ADC source, e.g. a timer interrupt or DMA callback.
+ * Push and #vumeter_level_process each own one ring index, so no critical section is needed
+ * as long as only one context pushes.
+ */
+void vumeter_level_push ( vumeter_level_t *level, uint16_t sample );
+
+/**
+ * @brief VU Meter level engine sample function.
+ * @details This function reads one ADC sample and queues it to the level engine ring.
+ * @param[in] ctx : Click context object.
+ * See #vumeter_t object definition for detailed explanation.
+ * @param[in,out] level : Level engine object.
+ * See #vumeter_level_t object definition for detailed explanation.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note Call this function at the fixed sample rate, e.g. from a timer interrupt.
+ */
+err_t vumeter_level_sample ( vumeter_t *ctx, vumeter_level_t *level );
+
+/**
+ * @brief VU Meter level engine process function.
+ * @details This function consumes the queued samples with integer DC removal, sum of squares
+ * and peak accumulation, and updates the ballistics on each completed block.
+ * @param[in,out] level : Level engine object.
+ * See #vumeter_level_t object definition for detailed explanation.
+ * @return Number of blocks completed.
+ * @note Call this function from the main loop often enough to keep the ring from overrunning.
+ */
+uint8_t vumeter_level_process ( vumeter_level_t *level );
+
+/**
+ * @brief VU Meter level engine get level function.
+ * @details This function converts the selected meter level to dBu, the VU meter is
+ * reported in VU units.
+ * @param[in] level : Level engine object.
+ * See #vumeter_level_t object definition for detailed explanation.
+ * @param[in] meter : Meter selection.
+ * @li @c 0 - VU meter [VU],
+ * @li @c 1 - PPM [dBu],
+ * @li @c 2 - Peak hold [dBu].
+ * @return Level value, limited to -20 VU or -60 dBu.
+ * @note Peak meters are scaled to the RMS of a sine with the same peak.
+ */
+float vumeter_level_get ( vumeter_level_t *level, uint8_t meter );
+
 #ifdef __cplusplus
 }
 #endif
@@ -27,6 +27,7 @@
 
 #include "vumeter.h"
 #include "math.h"
+#include "string.h"
 
 /**
  * @brief Dummy data.
@@ -34,6 +35,26 @@
  */
 #define DUMMY  0x00
 
+/**
+ * @brief VU Meter integer square root function.
+ * @details This function calculates the integer square root of the input value.
+ * @param[in] value : Input value.
+ * @return Integer square root.
+ * @note None.
+ */
+static uint16_t vumeter_isqrt ( uint32_t value );
+
+/**
+ * @brief VU Meter level block done function.
+ * @details This function reduces the completed block to RMS and peak values and updates
+ * the VU, PPM and peak hold ballistics.
+ * @param[in,out] level : Level engine object.
+ * See #vumeter_level_t object definition for detailed explanation.
+ * @return None.
+ * @note None.
+ */
+static void vumeter_level_block_done ( vumeter_level_t *level );
+
 void vumeter_cfg_setup ( vumeter_cfg_t *cfg ) 
 {
     cfg->sck  = HAL_PIN_NC;
@@ -133,6 +154,7 @@ float vumeter_calculate_vu_level ( vumeter_t *ctx, uint16_t sample_rate_ms )
 {
     float rms_voltage = 0;
     float an_voltage = 0;
+    float vu_level = 0;
     uint32_t timeout = ( uint32_t ) sample_rate_ms * 2;
     uint32_t cnt = 0;
     
@@ -140,21 +162,223 @@ float vumeter_calculate_vu_level ( vumeter_t *ctx, uint16_t sample_rate_ms )
     {
         if ( ADC_ERROR != vumeter_read_an_pin_voltage ( ctx, &an_voltage ) ) 
         {
-            if ( ( an_voltage > ( ( ctx->adc.config.vref_value / 2.0 ) + VUMETER_RMS_FOR_20VU ) ) || 
-                 ( an_voltage < ( ( ctx->adc.config.vref_value / 2.0 ) - VUMETER_RMS_FOR_20VU ) ) )
-            {
-                rms_voltage += pow ( an_voltage - ( ctx->adc.config.vref_value / 2.0 ), 2.0 );
-                cnt++;
-            }
+            // Every sample counts towards the RMS, quiet ones included.
+            an_voltage -= ( ctx->adc.config.vref_value / 2.0 );
+            rms_voltage += an_voltage * an_voltage;
+            cnt++;
         }
         Delay_500us( );
     }
     if ( cnt > 0 )
     {
         rms_voltage = sqrt ( rms_voltage / cnt );
-        return ( ( 20.0 * log10 ( rms_voltage / VUMETER_DBU_VREF ) ) - VUMETER_DBU_TO_VU );
+        if ( rms_voltage > VUMETER_RMS_FOR_20VU )
+        {
+            vu_level = ( 20.0 * log10 ( rms_voltage / VUMETER_DBU_VREF ) ) - VUMETER_DBU_TO_VU;
+            if ( vu_level > VUMETER_MIN_VU )
+            {
+                return vu_level;
+            }
+        }
     }
     return VUMETER_MIN_VU;
 }
 
+err_t vumeter_level_init ( vumeter_level_t *level, uint16_t sample_rate, uint16_t block_len, float lsb_voltage )
+{
+    float block_ms = 0;
+    if ( ( 0 == sample_rate ) || ( 0 == block_len ) || ( block_len > VUMETER_LEVEL_BLOCK_MAX ) || ( lsb_voltage <= 0 ) )
+    {
+        return VUMETER_ERROR;
+    }
+    memset ( level, 0, sizeof ( vumeter_level_t ) );
+    level->block_len = block_len;
+    level->lsb_voltage = lsb_voltage;
+    level->dc_q8 = -1;
+    
+    // Ballistics run once per block, the coefficients are the only floating point work.
+    block_ms = ( 1000.0 * block_len ) / sample_rate;
+    level->vu_coef = ( int32_t ) ( ( 1.0 - exp ( -block_ms / VUMETER_LEVEL_VU_TAU_MS ) ) * 
+                                   ( 1ul << VUMETER_LEVEL_COEF_SHIFT ) + 0.5 );
+    level->ppm_attack = ( int32_t ) ( ( 1.0 - exp ( -block_ms / VUMETER_LEVEL_PPM_ATTACK_TAU_MS ) ) * 
+                                      ( 1ul << VUMETER_LEVEL_COEF_SHIFT ) + 0.5 );
+    level->ppm_release = ( int32_t ) ( pow ( 10.0, -VUMETER_LEVEL_PPM_RELEASE_DB_S * block_ms / 20000.0 ) * 
+                                       ( 1ul << VUMETER_LEVEL_COEF_SHIFT ) + 0.5 );
+    level->hold_blocks = ( uint16_t ) ( VUMETER_LEVEL_PEAK_HOLD_MS / block_ms + 0.5 );
+    return VUMETER_OK;
+}
+
+void vumeter_level_push ( vumeter_level_t *level, uint16_t sample )
+{
+    uint8_t tail = level->ring_tail;
+    if ( ( uint8_t ) ( tail - level->ring_head ) >= VUMETER_LEVEL_RING_SIZE )
+    {
+        level->overruns++;
+        return;
+    }
+    level->ring[ tail % VUMETER_LEVEL_RING_SIZE ] = sample;
+    // Publish the index only after the sample is stored.
+    level->ring_tail = tail + 1;
+}
+
+err_t vumeter_level_sample ( vumeter_t *ctx, vumeter_level_t *level )
+{
+    uint16_t sample = 0;
+    if ( ADC_ERROR == vumeter_read_an_pin_value ( ctx, &sample ) )
+    {
+        return VUMETER_ERROR;
+    }
+    vumeter_level_push ( level, sample );
+    return VUMETER_OK;
+}
+
+uint8_t vumeter_level_process ( vumeter_level_t *level )
+{
+    uint8_t blocks = 0;
+    uint8_t head = level->ring_head;
+    int32_t ac = 0;
+    while ( head != level->ring_tail )
+    {
+        int32_t sample = level->ring[ head % VUMETER_LEVEL_RING_SIZE ];
+        level->ring_head = ++head;
+        
+        if ( level->dc_q8 < 0 )
+        {
+            level->dc_q8 = sample << 8;
+        }
+        // Slow first order DC tracker, corner far below the audio band.
+        level->dc_q8 += ( ( sample << 8 ) - level->dc_q8 ) >> VUMETER_LEVEL_DC_SHIFT;
+        ac = sample - ( ( level->dc_q8 + 128 ) >> 8 );
+        if ( ac < 0 )
+        {
+            ac = -ac;
+        }
+        level->sum_sq += ( uint32_t ) ac * ( uint32_t ) ac;
+        if ( ac > level->block_peak )
+        {
+            level->block_peak = ( uint16_t ) ac;
+        }
+        if ( ++level->block_cnt >= level->block_len )
+        {
+            vumeter_level_block_done ( level );
+            blocks++;
+        }
+    }
+    return blocks;
+}
+
+float vumeter_level_get ( vumeter_level_t *level, uint8_t meter )
+{
+    float voltage = 0;
+    float dbu = VUMETER_LEVEL_MIN_DBU;
+    switch ( meter )
+    {
+        case VUMETER_METER_VU:
+        {
+            voltage = level->vu_q8 * level->lsb_voltage / 256.0;
+            break;
+        }
+        case VUMETER_METER_PPM:
+        {
+            voltage = level->ppm_q8 * level->lsb_voltage / ( 256.0 * sqrt ( 2.0 ) );
+            break;
+        }
+        case VUMETER_METER_PEAK_HOLD:
+        {
+            voltage = level->peak_hold * level->lsb_voltage / sqrt ( 2.0 );
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    if ( voltage > 0 )
+    {
+        dbu = 20.0 * log10 ( voltage / VUMETER_DBU_VREF );
+        if ( dbu < VUMETER_LEVEL_MIN_DBU )
+        {
+            dbu = VUMETER_LEVEL_MIN_DBU;
+        }
+    }
+    if ( VUMETER_METER_VU == meter )
+    {
+        dbu -= VUMETER_DBU_TO_VU;
+        if ( dbu < VUMETER_MIN_VU )
+        {
+            dbu = VUMETER_MIN_VU;
+        }
+    }
+    return dbu;
+}
+
+static uint16_t vumeter_isqrt ( uint32_t value )
+{
+    uint32_t root = 0;
+    uint32_t bit = 1ul << 30;
+    while ( bit > value )
+    {
+        bit >>= 2;
+    }
+    while ( bit )
+    {
+        if ( value >= root + bit )
+        {
+            value -= root + bit;
+            root = ( root >> 1 ) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return ( uint16_t ) root;
+}
+
+static void vumeter_level_block_done ( vumeter_level_t *level )
+{
+    int32_t peak_q8 = 0;
+    level->rms = vumeter_isqrt ( ( uint32_t ) ( level->sum_sq / level->block_cnt ) );
+    level->peak = level->block_peak;
+    level->sum_sq = 0;
+    level->block_peak = 0;
+    level->block_cnt = 0;
+    
+    // VU: symmetric first order integration of the RMS.
+    // Q8 levels of a 16 bit ADC times a Q10 coefficient exceed 32 bits, hence the wide products.
+    level->vu_q8 += ( int32_t ) ( ( ( int64_t ) ( ( ( int32_t ) level->rms << 8 ) - level->vu_q8 ) * 
+                                    level->vu_coef ) >> VUMETER_LEVEL_COEF_SHIFT );
+    
+    // PPM: fast attack on peaks, logarithmic release.
+    peak_q8 = ( int32_t ) level->peak << 8;
+    if ( peak_q8 > level->ppm_q8 )
+    {
+        level->ppm_q8 += ( int32_t ) ( ( ( int64_t ) ( peak_q8 - level->ppm_q8 ) * level->ppm_attack ) >> 
+                                       VUMETER_LEVEL_COEF_SHIFT );
+    }
+    else
+    {
+        level->ppm_q8 = ( int32_t ) ( ( ( int64_t ) level->ppm_q8 * level->ppm_release ) >> VUMETER_LEVEL_COEF_SHIFT );
+        if ( level->ppm_q8 < peak_q8 )
+        {
+            level->ppm_q8 = peak_q8;
+        }
+    }
+    
+    if ( level->peak >= level->peak_hold )
+    {
+        level->peak_hold = level->peak;
+        level->hold_cnt = level->hold_blocks;
+    }
+    else if ( level->hold_cnt )
+    {
+        level->hold_cnt--;
+    }
+    else
+    {
+        level->peak_hold = level->peak;
+    }
+}
+
 // ------------------------------------------------------------------------- END
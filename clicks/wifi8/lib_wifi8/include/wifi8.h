@@ -573,6 +573,44 @@ err_t wifi8_socket_connect(wifi8_t *ctx, int8_t sock, wifi8_sockaddr_t *pstr_add
  */
 err_t wifi8_socket_send(wifi8_t *ctx, int8_t sock, void *pv_send_buffer, uint16_t u16_send_length);
 
+/**
+ * @brief Stream sending function.
+ * @details Sends a buffer of any length on a TCP socket. The buffer is segmented
+ * into requests of up to @b SOCKET_BUFFER_MAX_LENGTH bytes and up to
+ * @b SOCKET_TX_WINDOW requests are kept in flight.
+ * @param[in] ctx : Click context object.
+ * See #wifi8_t object definition for detailed explanation.
+ * @param[in] sock : Socket ID, must hold a non negative value.
+ * @param[in] pv_send_buffer : Pointer to a buffer holding data to be transmitted.
+ * @param[in] u32_send_length : The buffer size in bytes.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note Processes events with @ref wifi8_handle_events while waiting for
+ * send completions, so the application socket callback may be invoked.
+ */
+err_t wifi8_socket_send_stream(wifi8_t *ctx, int8_t sock, void *pv_send_buffer, uint32_t u32_send_length);
+
+/**
+ * @brief Scatter-gather sending function.
+ * @details Sends the concatenation of several buffers on a TCP socket without
+ * copying them together. Segments are gathered straight into the module
+ * packet memory, requests of up to @b SOCKET_BUFFER_MAX_LENGTH bytes are kept
+ * in flight up to @b SOCKET_TX_WINDOW per socket.
+ * @param[in] ctx : Click context object.
+ * See #wifi8_t object definition for detailed explanation.
+ * @param[in] sock : Socket ID, must hold a non negative value.
+ * @param[in] pstr_iov : Array of buffer segments.
+ * @param[in] u8_iov_cnt : Number of segments.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ * @note A single request gathers at most @b SOCKET_TX_IOV_MAX segments.
+ */
+err_t wifi8_socket_send_iov(wifi8_t *ctx, int8_t sock, wifi8_iovec_t *pstr_iov, uint8_t u8_iov_cnt);
+
 /**
  * @brief Asynchronous sending function.
  * @details The asynchronous sending function, used to send data on a UDP socket.
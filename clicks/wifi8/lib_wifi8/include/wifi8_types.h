@@ -296,6 +296,13 @@ Usage restrictions (eg STA mode only) should always be made clear at the API lay
  * The OTA messages have their own group so op codes can extended from 1 to M2M_MAX_GRP_NUM_REQ.
 */
 #define SOCKET_BUFFER_MAX_LENGTH 1400
+
+/*!< Stream send: SOCKET_CMD_SEND requests kept in flight per socket,
+ * gather segments per request and credit wait timeout.
+*/
+#define SOCKET_TX_WINDOW 4
+#define SOCKET_TX_IOV_MAX 8
+#define SOCKET_TX_TIMEOUT_MS 5000
 #define M2M_MAX_GRP_NUM_REQ (127)
 
 #define SOCKET_CMD_RAW_SET_SOCK_OPT 0x54
@@ -983,8 +990,15 @@ typedef struct
     uint8_t u8_alpn_status;
     uint8_t u8_err_source;
     uint8_t u8_err_code;
+    uint8_t u8_tx_pending;
 } wifi8_socket_t;
 
+typedef struct
+{
+    void *pv_base;
+    uint16_t u16_len;
+} wifi8_iovec_t;
+
 typedef struct
 {
     int8_t sock;
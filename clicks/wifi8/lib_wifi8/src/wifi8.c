@@ -387,6 +387,45 @@ static err_t hif_check_code(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_op_code);
 static err_t hif_send(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *pu8_ctrl_buf, uint16_t u16_ctrl_buf_size,
                       uint8_t *pu8_data_buf, uint16_t u16_data_size, uint16_t u16_data_offset);
 
+/**
+ * @brief Send packet with gathered data.
+ * @details Same as @ref hif_send, but the packet data is gathered from several segments
+ * which are written back to back into the module packet memory.
+ * @param[in] ctx : Click context object.
+ * See #wifi8_t object definition for detailed explanation.
+ * @param[in] u8_gid : Group ID.
+ * @param[in] u8_opcode : Operation ID.
+ * @param[in] pu8_ctrl_buf : Pointer to the Control buffer.
+ * @param[in] u16_ctrl_buf_size : Control buffer size.
+ * @param[in] pstr_iov : Data segments, NULL if there is no data.
+ * @param[in] u8_iov_cnt : Number of data segments.
+ * @param[in] u16_data_offset : Packet buffer size (including the HIF header).
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ */
+static err_t hif_send_iov(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *pu8_ctrl_buf, uint16_t u16_ctrl_buf_size,
+                          wifi8_iovec_t *pstr_iov, uint8_t u8_iov_cnt, uint16_t u16_data_offset);
+
+/**
+ * @brief Send a single socket TX request.
+ * @details Issues one SOCKET_CMD_SEND (or SSL send) request with gathered data and
+ * takes one credit of the socket TX window.
+ * @param[in] ctx : Click context object.
+ * See #wifi8_t object definition for detailed explanation.
+ * @param[in] sock : Socket ID.
+ * @param[in] pstr_iov : Data segments.
+ * @param[in] u8_iov_cnt : Number of data segments.
+ * @param[in] u16_send_length : Total data length, at most SOCKET_BUFFER_MAX_LENGTH.
+ * @return @li @c  0 - Success,
+ *         @li @c -1 - Error.
+ *
+ * See #err_t definition for detailed explanation.
+ */
+static err_t socket_send_request(wifi8_t *ctx, int8_t sock, wifi8_iovec_t *pstr_iov, uint8_t u8_iov_cnt,
+                                 uint16_t u16_send_length);
+
 /**
  * @brief To set Callback function for every component.
  * @param[in] u8_grp : Group to which the Callback function should be set.
@@ -1467,30 +1506,109 @@ err_t wifi8_socket_send(wifi8_t *ctx, int8_t sock, void *pv_send_buffer, uint16_
 {
     if ((sock >= 0) && (pv_send_buffer !=  ((void *)0) ) && (u16_send_length <=  1400 ) && (ctx->sockets[sock].b_is_used == 1))
     {
-        uint16_t u16_data_offset;
-        wifi8_send_cmd_t str_send;
-        uint8_t u8_cmd;
+        wifi8_iovec_t str_iov;
 
-        u8_cmd =  0x45 ;
-        u16_data_offset =  ( ( (14) + (34) - (sizeof(wifi8_hif_hdr_t) + 4) ) + (40) ) ;
+        str_iov.pv_base = pv_send_buffer;
+        str_iov.u16_len = u16_send_length;
 
-        str_send.sock = sock;
-        str_send.u16_data_size =  (u16_send_length) ;
-        str_send.u16_session_id = ctx->sockets[sock].u16_session_id;
+        return socket_send_request(ctx, sock, &str_iov, 1, u16_send_length);
+    }
+    return WIFI8_ERROR;
+}
+
+err_t wifi8_socket_send_stream(wifi8_t *ctx, int8_t sock, void *pv_send_buffer, uint32_t u32_send_length)
+{
+    wifi8_iovec_t str_iov;
+    uint8_t *pu8_buf = (uint8_t *)pv_send_buffer;
 
-        if (sock >=  (7) )
+    if (pv_send_buffer == NULL)
+    {
+        return WIFI8_ERROR;
+    }
+    while (u32_send_length > 0)
+    {
+        /* Segment lengths are 16 bit, split very large buffers on a request boundary */
+        str_iov.pv_base = pu8_buf;
+        str_iov.u16_len = (u32_send_length > 0xFFFF) ? (0xFFFF - (0xFFFF % SOCKET_BUFFER_MAX_LENGTH)) :
+                                                       (uint16_t)u32_send_length;
+
+        if (wifi8_socket_send_iov(ctx, sock, &str_iov, 1) != WIFI8_OK)
+        {
+            return WIFI8_ERROR;
+        }
+        pu8_buf += str_iov.u16_len;
+        u32_send_length -= str_iov.u16_len;
+    }
+    return WIFI8_OK;
+}
+
+err_t wifi8_socket_send_iov(wifi8_t *ctx, int8_t sock, wifi8_iovec_t *pstr_iov, uint8_t u8_iov_cnt)
+{
+    wifi8_iovec_t str_pkt_iov[SOCKET_TX_IOV_MAX];
+    uint8_t u8_pkt_cnt;
+    uint16_t u16_pkt_len;
+    uint16_t u16_take;
+    uint16_t u16_seg_off = 0;
+    uint8_t u8_seg = 0;
+    uint16_t u16_timeout;
+
+    if ((sock < 0) || (sock >= MAX_SOCKET) || (pstr_iov == NULL) || (ctx->sockets[sock].b_is_used != 1))
+    {
+        return WIFI8_ERROR;
+    }
+
+    while (u8_seg < u8_iov_cnt)
+    {
+        /* Gather the next request from as many segments as fit */
+        u8_pkt_cnt = 0;
+        u16_pkt_len = 0;
+        while ((u8_seg < u8_iov_cnt) && (u16_pkt_len < SOCKET_BUFFER_MAX_LENGTH) && (u8_pkt_cnt < SOCKET_TX_IOV_MAX))
+        {
+            u16_take = pstr_iov[u8_seg].u16_len - u16_seg_off;
+            if (u16_take > (SOCKET_BUFFER_MAX_LENGTH - u16_pkt_len))
+            {
+                u16_take = SOCKET_BUFFER_MAX_LENGTH - u16_pkt_len;
+            }
+            if (u16_take > 0)
+            {
+                str_pkt_iov[u8_pkt_cnt].pv_base = (uint8_t *)pstr_iov[u8_seg].pv_base + u16_seg_off;
+                str_pkt_iov[u8_pkt_cnt].u16_len = u16_take;
+                u8_pkt_cnt++;
+                u16_pkt_len += u16_take;
+                u16_seg_off += u16_take;
+            }
+            if (u16_seg_off >= pstr_iov[u8_seg].u16_len)
+            {
+                u8_seg++;
+                u16_seg_off = 0;
+            }
+        }
+        if (u16_pkt_len == 0)
         {
-            u16_data_offset =  ( ( (14) + (34) - (sizeof(wifi8_hif_hdr_t) + 4) ) + (28) ) ;
+            break;
         }
-        if (ctx->sockets[sock].u8ssl_flags &  (0x00000001ul) )
+
+        /* Wait for a send completion to free a credit of the TX window */
+        u16_timeout = 0;
+        while (ctx->sockets[sock].u8_tx_pending >= SOCKET_TX_WINDOW)
         {
-            u8_cmd =  0x4C ;
-            u16_data_offset = ctx->sockets[sock].u16_data_offset;
+            if ((wifi8_handle_events(ctx) != WIFI8_OK) || (++u16_timeout > SOCKET_TX_TIMEOUT_MS) ||
+                (ctx->sockets[sock].b_is_used != 1))
+            {
+                return WIFI8_ERROR;
+            }
+            if (ctx->sockets[sock].u8_tx_pending >= SOCKET_TX_WINDOW)
+            {
+                Delay_1ms();
+            }
         }
 
-        return  hif_send(ctx, M2M_REQ_GROUP_IP, u8_cmd | M2M_REQ_DATA_PKT, (uint8_t *)&str_send, sizeof(wifi8_send_cmd_t), pv_send_buffer, u16_send_length, u16_data_offset) ;
+        if (socket_send_request(ctx, sock, str_pkt_iov, u8_pkt_cnt, u16_pkt_len) != WIFI8_OK)
+        {
+            return WIFI8_ERROR;
+        }
     }
-    return WIFI8_ERROR;
+    return WIFI8_OK;
 }
 
 err_t wifi8_socket_send_to(wifi8_t *ctx, int8_t sock, void *pv_send_buffer, uint16_t u16_send_length,
@@ -2583,9 +2701,23 @@ static err_t hif_enable_access(wifi8_t *ctx)
 
 static err_t hif_send(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *pu8_ctrl_buf, uint16_t u16_ctrl_buf_size,
                       uint8_t *pu8_data_buf, uint16_t u16_data_size, uint16_t u16_data_offset)
+{
+    wifi8_iovec_t str_iov;
+
+    str_iov.pv_base = pu8_data_buf;
+    str_iov.u16_len = u16_data_size;
+
+    return hif_send_iov(ctx, u8_gid, u8_opcode, pu8_ctrl_buf, u16_ctrl_buf_size,
+                        (pu8_data_buf != NULL) ? &str_iov : NULL, 1, u16_data_offset);
+}
+
+static err_t hif_send_iov(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *pu8_ctrl_buf, uint16_t u16_ctrl_buf_size,
+                          wifi8_iovec_t *pstr_iov, uint8_t u8_iov_cnt, uint16_t u16_data_offset)
 {
     wifi8_hif_hdr_t str_hif;
     uint32_t u32_ctrl_data_gap = u16_data_offset;
+    uint32_t u32_data_size = 0;
+    uint8_t u8_cnt;
 
     str_hif.u8_opcode = u8_opcode & (~NBIT7);
     str_hif.u8_gid = u8_gid;
@@ -2600,13 +2732,17 @@ static err_t hif_send(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *
         str_hif.u16_length += u16_ctrl_buf_size;
         u32_ctrl_data_gap -= u16_ctrl_buf_size;
     }
-    if (pu8_data_buf != NULL)
+    if (pstr_iov != NULL)
     {
-        if ((uint32_t)u16_data_offset + u16_data_size > M2M_HIF_MAX_PACKET_SIZE - M2M_HIF_HDR_OFFSET)
+        for (u8_cnt = 0; u8_cnt < u8_iov_cnt; u8_cnt++)
+        {
+            u32_data_size += pstr_iov[u8_cnt].u16_len;
+        }
+        if ((uint32_t)u16_data_offset + u32_data_size > M2M_HIF_MAX_PACKET_SIZE - M2M_HIF_HDR_OFFSET)
         {
             return WIFI8_ERROR;
         }
-        str_hif.u16_length += u32_ctrl_data_gap + u16_data_size;
+        str_hif.u16_length += u32_ctrl_data_gap + u32_data_size;
     }
     if (hif_check_code( ctx, str_hif.u8_gid, str_hif.u8_opcode) != WIFI8_OK)
     {
@@ -2690,14 +2826,23 @@ static err_t hif_send(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *
                     }
                     u32_curr_addr += u16_ctrl_buf_size;
                 }
-                if (pu8_data_buf != NULL)
+                if (pstr_iov != NULL)
                 {
                     u32_curr_addr += u32_ctrl_data_gap;
-                    if (WIFI8_OK != wifi8_block_write(ctx, u32_curr_addr, pu8_data_buf, u16_data_size))
+                    /* Gather the segments back to back into the packet memory */
+                    for (u8_cnt = 0; u8_cnt < u8_iov_cnt; u8_cnt++)
                     {
-                        return WIFI8_ERROR;
+                        if (pstr_iov[u8_cnt].u16_len == 0)
+                        {
+                            continue;
+                        }
+                        if (WIFI8_OK != wifi8_block_write(ctx, u32_curr_addr, (uint8_t *)pstr_iov[u8_cnt].pv_base,
+                                                          pstr_iov[u8_cnt].u16_len))
+                        {
+                            return WIFI8_ERROR;
+                        }
+                        u32_curr_addr += pstr_iov[u8_cnt].u16_len;
                     }
-                    u32_curr_addr += u16_data_size;
                 }
 
                 reg = dma_addr << 2;
@@ -2736,6 +2881,44 @@ static err_t hif_send(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_opcode, uint8_t *
     return chip_sleep(ctx);
 }
 
+static err_t socket_send_request(wifi8_t *ctx, int8_t sock, wifi8_iovec_t *pstr_iov, uint8_t u8_iov_cnt,
+                                 uint16_t u16_send_length)
+{
+    uint16_t u16_data_offset;
+    wifi8_send_cmd_t str_send;
+    uint8_t u8_cmd;
+
+    u8_cmd = SOCKET_CMD_SEND;
+    u16_data_offset = TCP_TX_PACKET_OFFSET;
+
+    str_send.sock = sock;
+    str_send.u16_data_size = NM_BSP_B_L_16(u16_send_length);
+    str_send.u16_session_id = ctx->sockets[sock].u16_session_id;
+
+    if (sock >= TCP_SOCK_MAX)
+    {
+        u16_data_offset = UDP_TX_PACKET_OFFSET;
+    }
+    if (ctx->sockets[sock].u8ssl_flags & SSL_FLAGS_ACTIVE)
+    {
+        u8_cmd = SOCKET_CMD_SSL_SEND;
+        u16_data_offset = ctx->sockets[sock].u16_data_offset;
+    }
+
+    if (hif_send_iov(ctx, M2M_REQ_GROUP_IP, u8_cmd | M2M_REQ_DATA_PKT, (uint8_t *)&str_send, sizeof(wifi8_send_cmd_t),
+                     pstr_iov, u8_iov_cnt, u16_data_offset) != WIFI8_OK)
+    {
+        return WIFI8_ERROR;
+    }
+    /* Plain sends do not wait for a credit, saturate instead of wrapping */
+    if (ctx->sockets[sock].u8_tx_pending < 0xFF)
+    {
+        ctx->sockets[sock].u8_tx_pending++;
+    }
+
+    return WIFI8_OK;
+}
+
 static err_t hif_receive(wifi8_t *ctx, uint32_t u32_addr, uint8_t *pu8_buf, uint16_t u16_sz, uint8_t is_done)
 {
     if ((u32_addr == 0) || (pu8_buf == NULL) || (u16_sz == 0))
@@ -2970,6 +3153,8 @@ err_t hif_handle_isr(wifi8_t *ctx)
             }
         }
     }
+
+    return WIFI8_OK;
 }
 
 static err_t hif_check_code(wifi8_t *ctx, uint8_t u8_gid, uint8_t u8_op_code)
@@ -3423,6 +3608,11 @@ static void m2m_ip_cb(wifi8_t *ctx, uint8_t u8_op_code, uint16_t u16_buffer_size
 
             if (u16_session_id == ctx->sockets[sock].u16_session_id)
             {
+                /* Every send reply returns one credit of the socket TX window */
+                if ((u8_op_code != SOCKET_CMD_SENDTO) && (ctx->sockets[sock].u8_tx_pending > 0))
+                {
+                    ctx->sockets[sock].u8_tx_pending--;
+                }
                 if (ctx->app_socket_cb)
                 {
                     ctx->app_socket_cb(sock, u8_callback_msg_id, &s16_rcvd);